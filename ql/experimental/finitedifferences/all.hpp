@@ -3,7 +3,10 @@
 
 #include <ql/experimental/finitedifferences/bsmrndcalculator.hpp>
 #include <ql/experimental/finitedifferences/dynprogvppintrinsicvalueengine.hpp>
+#include <ql/experimental/finitedifferences/fdblackscholesfwdchainengine.hpp>
 #include <ql/experimental/finitedifferences/fdextoujumpvanillaengine.hpp>
+#include <ql/experimental/finitedifferences/fdfwdvanillachainengine.hpp>
+#include <ql/experimental/finitedifferences/fdhestonfwdchainengine.hpp>
 #include <ql/experimental/finitedifferences/fdklugeextouspreadengine.hpp>
 #include <ql/experimental/finitedifferences/fdmblackscholesfwdop.hpp>
 #include <ql/experimental/finitedifferences/fdmdupire1dop.hpp>
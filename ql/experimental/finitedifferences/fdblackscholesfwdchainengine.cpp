@@ -0,0 +1,106 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdblackscholesfwdchainengine.cpp
+*/
+
+#include <ql/math/comparison.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/experimental/finitedifferences/fdmblackscholesfwdop.hpp>
+#include <ql/experimental/finitedifferences/fdblackscholesfwdchainengine.hpp>
+
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        // unit mass at x0, split between the two closest grid points
+        Disposable<Array> diracDelta(const Array& x, Real x0) {
+            QL_REQUIRE(x.size() > 3 && x[1] <= x0 && x[x.size()-2] >= x0,
+                       "insufficient mesher");
+
+            Array p(x.size(), 0.0);
+
+            const Size upper =
+                std::upper_bound(x.begin(), x.end(), x0) - x.begin();
+            const Size lower = upper-1;
+
+            if (close_enough(x[upper], x0)) {
+                p[upper] = 2.0/(x[upper+1]-x[upper-1]);
+            }
+            else if (close_enough(x[lower], x0)) {
+                p[lower] = 2.0/(x[lower+1]-x[lower-1]);
+            }
+            else {
+                const Real dx = x[upper] - x[lower];
+                p[lower] = (x[upper] - x0)/dx * 2.0/(x[lower+1]-x[lower-1]);
+                p[upper] = (x0 - x[lower])/dx * 2.0/(x[upper+1]-x[upper-1]);
+            }
+
+            return p;
+        }
+
+    }
+
+    FdBlackScholesFwdChainEngine::FdBlackScholesFwdChainEngine(
+        const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        const std::vector<Date>& maturities,
+        Size tGrid, Size xGrid, Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc,
+        bool localVol, Real illegalLocalVolOverwrite)
+    : FdFwdVanillaChainEngine(maturities, tGrid, dampingSteps, schemeDesc),
+      process_(process), xGrid_(xGrid),
+      localVol_(localVol),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+        registerWith(process_);
+    }
+
+    Real FdBlackScholesFwdChainEngine::underlying() const {
+        return process_->x0();
+    }
+
+    Handle<YieldTermStructure>
+    FdBlackScholesFwdChainEngine::riskFreeRate() const {
+        return process_->riskFreeRate();
+    }
+
+    void FdBlackScholesFwdChainEngine::calculateDensities(
+        const std::vector<Time>& times,
+        Array& x, std::vector<Array>& densities) const {
+
+        const Real spot = process_->x0();
+
+        const boost::shared_ptr<FdmMesher> mesher(
+            new FdmMesherComposite(boost::shared_ptr<Fdm1dMesher>(
+                new FdmBlackScholesMesher(
+                    xGrid_, process_, times.back(), spot,
+                    Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                    std::pair<Real, Real>(spot, 0.1)))));
+
+        const boost::shared_ptr<FdmLinearOpComposite> op(
+            new FdmBlackScholesFwdOp(mesher, process_, spot,
+                                     localVol_, illegalLocalVolOverwrite_));
+
+        x = mesher->locations(0);
+        Array p = diracDelta(x, std::log(spot));
+        evolve(op, p, 0.0, times, densities);
+    }
+
+}
@@ -0,0 +1,74 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdblackscholesfwdchainengine.hpp
+    \brief Black-Scholes and local-volatility forward-equation chain engine
+*/
+
+#ifndef quantlib_fd_black_scholes_fwd_chain_engine_hpp
+#define quantlib_fd_black_scholes_fwd_chain_engine_hpp
+
+#include <ql/experimental/finitedifferences/fdfwdvanillachainengine.hpp>
+
+namespace QuantLib {
+
+    class GeneralizedBlackScholesProcess;
+
+    //! Black-Scholes and local-volatility forward-equation chain engine
+    /*! The density of the logarithm of the underlying is evolved with
+        FdmBlackScholesFwdOp from a Dirac delta at the spot value.
+        With local volatility, this is the Dupire forward equation and
+        the whole smile of the process is reproduced in one solve;
+        otherwise, the Black volatility at the spot level is used for
+        all strikes.
+
+        The grid is built for the longest maturity of the chain, and
+        tGrid is the number of time steps up to it.
+
+        \ingroup vanillaengines
+
+        \test the prices of a chain are checked against the analytic
+              Black-Scholes values and against the backward
+              finite-difference engine with local volatility.
+    */
+    class FdBlackScholesFwdChainEngine : public FdFwdVanillaChainEngine {
+      public:
+        FdBlackScholesFwdChainEngine(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const std::vector<Date>& maturities = std::vector<Date>(),
+            Size tGrid = 100, Size xGrid = 100, Size dampingSteps = 0,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
+            bool localVol = true,
+            Real illegalLocalVolOverwrite = -Null<Real>());
+
+      protected:
+        Real underlying() const;
+        Handle<YieldTermStructure> riskFreeRate() const;
+        void calculateDensities(const std::vector<Time>& times,
+                                Array& x,
+                                std::vector<Array>& densities) const;
+
+      private:
+        const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        const Size xGrid_;
+        const bool localVol_;
+        const Real illegalLocalVolOverwrite_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,279 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdfwdvanillachainengine.cpp
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/settings.hpp>
+#include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/methodoflinesscheme.hpp>
+#include <ql/experimental/finitedifferences/fdfwdvanillachainengine.hpp>
+
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        template <class Scheme>
+        void evolveWith(Scheme& scheme, Array& p,
+                        Time from, Time to, Size steps) {
+            const Time dt = (to - from)/steps;
+            scheme.setStep(dt);
+            for (Size i=1; i < steps; ++i)
+                scheme.step(p, from + i*dt);
+            scheme.step(p, to);
+        }
+
+        void evolveWith(const FdmSchemeDesc& desc,
+                        const boost::shared_ptr<FdmLinearOpComposite>& op,
+                        Array& p, Time from, Time to, Size steps) {
+            switch (desc.type) {
+              case FdmSchemeDesc::HundsdorferType:
+                {
+                    HundsdorferScheme scheme(desc.theta, desc.mu, op);
+                    evolveWith(scheme, p, from, to, steps);
+                }
+                break;
+              case FdmSchemeDesc::DouglasType:
+                {
+                    DouglasScheme scheme(desc.theta, op);
+                    evolveWith(scheme, p, from, to, steps);
+                }
+                break;
+              case FdmSchemeDesc::CraigSneydType:
+                {
+                    CraigSneydScheme scheme(desc.theta, desc.mu, op);
+                    evolveWith(scheme, p, from, to, steps);
+                }
+                break;
+              case FdmSchemeDesc::ModifiedCraigSneydType:
+                {
+                    ModifiedCraigSneydScheme scheme(desc.theta, desc.mu, op);
+                    evolveWith(scheme, p, from, to, steps);
+                }
+                break;
+              case FdmSchemeDesc::ImplicitEulerType:
+                {
+                    ImplicitEulerScheme scheme(op);
+                    evolveWith(scheme, p, from, to, steps);
+                }
+                break;
+              case FdmSchemeDesc::ExplicitEulerType:
+                {
+                    ExplicitEulerScheme scheme(op);
+                    evolveWith(scheme, p, from, to, steps);
+                }
+                break;
+              case FdmSchemeDesc::MethodOfLinesType:
+                {
+                    MethodOfLinesScheme scheme(desc.theta, desc.mu, op);
+                    evolveWith(scheme, p, from, to, steps);
+                }
+                break;
+              default:
+                QL_FAIL("unknown scheme type");
+            }
+        }
+
+        /* integrals of the linearly interpolated density p and of
+           its product with exp(x) below and above k, and value of
+           the density at k */
+        struct DensityIntegrals {
+            Real massBelow, massAbove, expBelow, expAbove, densityAtK;
+        };
+
+        void addPiece(Real a, Real b, Real pa, Real pb, Real slope,
+                      Real& mass, Real& expectation) {
+            const Real ea = std::exp(a), eb = std::exp(b);
+            mass += 0.5*(b-a)*(pa+pb);
+            // integration by parts of exp(x)*p(x), with p linear
+            expectation += eb*pb - ea*pa - slope*(eb-ea);
+        }
+
+        DensityIntegrals integrate(const Array& x, const Array& p, Real k) {
+            DensityIntegrals result = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+            for (Size i=1; i < x.size(); ++i) {
+                const Real xl = x[i-1], xr = x[i];
+                const Real pl = p[i-1], pr = p[i];
+                const Real slope = (pr - pl)/(xr - xl);
+
+                if (xr <= k)
+                    addPiece(xl, xr, pl, pr, slope,
+                             result.massBelow, result.expBelow);
+                else if (xl >= k)
+                    addPiece(xl, xr, pl, pr, slope,
+                             result.massAbove, result.expAbove);
+                else {
+                    const Real pk = pl + slope*(k - xl);
+                    addPiece(xl, k, pl, pk, slope,
+                             result.massBelow, result.expBelow);
+                    addPiece(k, xr, pk, pr, slope,
+                             result.massAbove, result.expAbove);
+                }
+            }
+
+            if (k >= x.front() && k <= x.back()) {
+                const Size i = std::min<Size>(
+                    std::upper_bound(x.begin(), x.end(), k) - x.begin(),
+                    x.size()-1);
+                result.densityAtK = p[i-1]
+                    + (p[i]-p[i-1])*(k-x[i-1])/(x[i]-x[i-1]);
+            }
+
+            return result;
+        }
+
+    }
+
+    FdFwdVanillaChainEngine::FdFwdVanillaChainEngine(
+        const std::vector<Date>& maturities,
+        Size tGrid, Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc)
+    : tGrid_(tGrid), dampingSteps_(dampingSteps), schemeDesc_(schemeDesc),
+      maturities_(maturities), calculated_(false) {
+        QL_REQUIRE(tGrid_ > 0, "at least one time step is required");
+        std::sort(maturities_.begin(), maturities_.end());
+        maturities_.erase(std::unique(maturities_.begin(), maturities_.end()),
+                          maturities_.end());
+    }
+
+    void FdFwdVanillaChainEngine::update() {
+        calculated_ = false;
+        VanillaOption::engine::update();
+    }
+
+    void FdFwdVanillaChainEngine::evolve(
+        const boost::shared_ptr<FdmLinearOpComposite>& op,
+        Array& p, Time t0, const std::vector<Time>& times,
+        std::vector<Array>& solutions) const {
+
+        QL_REQUIRE(!times.empty() && times.front() > t0,
+                   "times after " << t0 << " required");
+        const Time length = times.back() - t0;
+
+        solutions.clear();
+        solutions.reserve(times.size());
+
+        Time t = t0;
+        Size dampingSteps = dampingSteps_;
+        for (Size i=0; i < times.size(); ++i) {
+            QL_REQUIRE(times[i] >= t, "times must be sorted");
+            if (times[i] > t) {
+                const Size steps = std::max<Size>(
+                    1, Size(tGrid_*(times[i]-t)/length + 0.5));
+                const Size damping = std::min(dampingSteps, steps);
+                const Time tDamping = t + ((times[i]-t)*damping)/steps;
+
+                if (damping > 0)
+                    evolveWith(FdmSchemeDesc::ImplicitEuler(),
+                               op, p, t, tDamping, damping);
+                if (steps > damping)
+                    evolveWith(schemeDesc_, op, p, tDamping, times[i],
+                               steps-damping);
+
+                dampingSteps -= damping;
+                t = times[i];
+            }
+            solutions.push_back(p);
+        }
+    }
+
+    void FdFwdVanillaChainEngine::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+        const boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                        arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain-vanilla payoff given");
+
+        const Handle<YieldTermStructure> rTS = riskFreeRate();
+        const Date maturity = arguments_.exercise->lastDate();
+        QL_REQUIRE(rTS->timeFromReference(maturity) > 0.0,
+                   "maturity " << maturity << " is not after the "
+                   "reference date " << rTS->referenceDate());
+
+        const Date today = Settings::instance().evaluationDate();
+        if (evaluationDate_ != today) {
+            calculated_ = false;
+            // drop the maturities which have expired since
+            std::vector<Date>::iterator expired = maturities_.begin();
+            while (expired != maturities_.end()
+                   && rTS->timeFromReference(*expired) <= 0.0)
+                ++expired;
+            maturities_.erase(maturities_.begin(), expired);
+        }
+
+        std::vector<Date>::iterator iter =
+            std::lower_bound(maturities_.begin(), maturities_.end(),
+                             maturity);
+        if (iter == maturities_.end() || *iter != maturity) {
+            calculated_ = false;
+            iter = maturities_.insert(iter, maturity);
+        }
+        const Size idx = iter - maturities_.begin();
+
+        if (!calculated_) {
+            std::vector<Time> times(maturities_.size());
+            for (Size i=0; i < maturities_.size(); ++i)
+                times[i] = rTS->timeFromReference(maturities_[i]);
+
+            calculateDensities(times, x_, densities_);
+            QL_ENSURE(densities_.size() == times.size(),
+                      "wrong number of densities returned");
+            evaluationDate_ = today;
+            calculated_ = true;
+        }
+
+        const Real strike = payoff->strike();
+        const Real spot = underlying();
+        const DiscountFactor df = rTS->discount(maturity);
+        const DensityIntegrals integrals =
+            integrate(x_, densities_[idx], std::log(strike));
+
+        Real forwardValue, itmProbability, strikeSensitivity;
+        switch (payoff->optionType()) {
+          case Option::Call:
+            forwardValue = integrals.expAbove - strike*integrals.massAbove;
+            itmProbability = integrals.massAbove;
+            strikeSensitivity = -df*integrals.massAbove;
+            break;
+          case Option::Put:
+            forwardValue = strike*integrals.massBelow - integrals.expBelow;
+            itmProbability = integrals.massBelow;
+            strikeSensitivity = df*integrals.massBelow;
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+
+        results_.value = df*forwardValue;
+        results_.strikeSensitivity = strikeSensitivity;
+        results_.itmCashProbability = itmProbability;
+        results_.delta =
+            (results_.value - strike*strikeSensitivity)/spot;
+        results_.gamma = df*strike*integrals.densityAtK/(spot*spot);
+    }
+
+}
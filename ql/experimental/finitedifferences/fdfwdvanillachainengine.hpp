@@ -0,0 +1,113 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdfwdvanillachainengine.hpp
+    \brief base class for forward-equation engines pricing option chains
+*/
+
+#ifndef quantlib_fd_fwd_vanilla_chain_engine_hpp
+#define quantlib_fd_fwd_vanilla_chain_engine_hpp
+
+#include <ql/handle.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class FdmLinearOpComposite;
+
+    //! base class for forward-equation engines pricing option chains
+    /*! Backward engines solve the pricing equation once per option.
+        Engines derived from this class solve the Fokker-Planck
+        forward equation instead, once for all the maturities of a
+        chain, and store the density of the logarithm of the
+        underlying at each of them.  An option is then priced by
+        integrating its payoff against the density at its maturity,
+        so that a whole chain of European options costs about as
+        much as a single backward solve.
+
+        The density is interpolated linearly between grid points and
+        the payoff is integrated exactly against the interpolated
+        density; the density is taken as null outside the grid.
+        Besides the value, the results include the sensitivity to
+        the strike and the in-the-money probability.  Delta and gamma
+        are obtained from the strike derivatives by the homogeneity
+        of the value in spot and strike,
+        \f[ V = S \frac{\partial V}{\partial S}
+              + K \frac{\partial V}{\partial K}; \f]
+        this is exact for the Black-Scholes and Heston models and
+        corresponds to sticky-moneyness Greeks for local volatility.
+
+        The densities are kept until the engine is notified of a
+        change or the evaluation date moves.  Maturities not passed
+        to the constructor are added to the chain when first
+        requested; this causes a new forward solve, after which the
+        prices at the former maturities can change within the
+        discretization error since the time grid is different.
+
+        \ingroup vanillaengines
+    */
+    class FdFwdVanillaChainEngine : public VanillaOption::engine {
+      public:
+        void calculate() const;
+        void update();
+
+        //! maturities of the chain
+        const std::vector<Date>& maturities() const { return maturities_; }
+
+      protected:
+        FdFwdVanillaChainEngine(const std::vector<Date>& maturities,
+                                Size tGrid, Size dampingSteps,
+                                const FdmSchemeDesc& schemeDesc);
+
+        virtual Real underlying() const = 0;
+        virtual Handle<YieldTermStructure> riskFreeRate() const = 0;
+        /*! returns in x the grid for the logarithm of the underlying
+            and in densities its density at each of the given times,
+            which are positive and sorted in increasing order.
+        */
+        virtual void calculateDensities(const std::vector<Time>& times,
+                                        Array& x,
+                                        std::vector<Array>& densities)
+                                                                   const = 0;
+
+        /*! evolves p with the given operator from t0 through the
+            given times, storing a copy of the solution at each of
+            them.  The tGrid steps are distributed among the intervals
+            between consecutive times in proportion to their length,
+            with at least one step per interval; the first
+            dampingSteps steps use the implicit Euler scheme.
+        */
+        void evolve(const boost::shared_ptr<FdmLinearOpComposite>& op,
+                    Array& p, Time t0, const std::vector<Time>& times,
+                    std::vector<Array>& solutions) const;
+
+        const Size tGrid_, dampingSteps_;
+        const FdmSchemeDesc schemeDesc_;
+
+      private:
+        mutable std::vector<Date> maturities_;
+        mutable bool calculated_;
+        mutable Date evaluationDate_;
+        mutable Array x_;
+        mutable std::vector<Array> densities_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,185 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdhestonfwdchainengine.cpp
+*/
+
+#include <ql/math/functional.hpp>
+#include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/integrals/discreteintegrals.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/experimental/exoticoptions/analyticpdfhestonengine.hpp>
+#include <ql/experimental/finitedifferences/fdmhestonfwdop.hpp>
+#include <ql/experimental/finitedifferences/fdmhestongreensfct.hpp>
+#include <ql/experimental/finitedifferences/squarerootprocessrndcalculator.hpp>
+#include <ql/experimental/finitedifferences/fdhestonfwdchainengine.hpp>
+
+#include <boost/bind.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        // underlying level with the given cumulative probability
+        Real hestonQuantile(const AnalyticPDFHestonEngine& pdfEngine,
+                            Real s0, Time t, Real q) {
+            return Brent().solve(
+                boost::bind(std::minus<Real>(),
+                            boost::bind(&AnalyticPDFHestonEngine::cdf,
+                                        &pdfEngine, _1, t), q),
+                s0*1e-3, s0, s0*0.001, 1000*s0);
+        }
+
+        boost::shared_ptr<Fdm1dMesher> varianceMesher(
+            const SquareRootProcessRNDCalculator& rnd,
+            Time maturity, Real v0, Size vGrid,
+            FdmSquareRootFwdOp::TransformationType trafoType) {
+
+            // the grid covers both the stationary distribution and
+            // the distribution at the longest maturity
+            const Real upperBound = std::max(rnd.stationary_invcdf(0.9995),
+                                             rnd.invcdf(0.9995, maturity));
+
+            std::vector<boost::tuple<Real, Real, bool> > cPoints;
+            switch (trafoType) {
+              case FdmSquareRootFwdOp::Log:
+                {
+                    const Real lowerBound = std::log(0.00001);
+                    cPoints.push_back(
+                        boost::make_tuple(lowerBound, 1.0, false));
+                    cPoints.push_back(
+                        boost::make_tuple(std::log(v0), 10.0, true));
+                    cPoints.push_back(
+                        boost::make_tuple(std::log(upperBound), 100.0, false));
+                    return boost::shared_ptr<Fdm1dMesher>(
+                        new Concentrating1dMesher(lowerBound,
+                                                  std::log(upperBound),
+                                                  vGrid, cPoints, 1e-12));
+                }
+              case FdmSquareRootFwdOp::Plain:
+                {
+                    const Real lowerBound = std::min(
+                        rnd.stationary_invcdf(1e-5), 0.5*v0);
+                    cPoints.push_back(
+                        boost::make_tuple(lowerBound, 0.0001, false));
+                    cPoints.push_back(boost::make_tuple(v0, 0.1, true));
+                    return boost::shared_ptr<Fdm1dMesher>(
+                        new Concentrating1dMesher(lowerBound, upperBound,
+                                                  vGrid, cPoints, 1e-12));
+                }
+              case FdmSquareRootFwdOp::Power:
+                {
+                    const Real lowerBound = 0.000075;
+                    cPoints.push_back(
+                        boost::make_tuple(lowerBound, 0.005, false));
+                    cPoints.push_back(boost::make_tuple(v0, 1.0, true));
+                    return boost::shared_ptr<Fdm1dMesher>(
+                        new Concentrating1dMesher(lowerBound, upperBound,
+                                                  vGrid, cPoints, 1e-12));
+                }
+              default:
+                QL_FAIL("unknown transformation type");
+            }
+        }
+
+    }
+
+    FdHestonFwdChainEngine::FdHestonFwdChainEngine(
+        const boost::shared_ptr<HestonModel>& model,
+        const std::vector<Date>& maturities,
+        Size tGrid, Size xGrid, Size vGrid, Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc,
+        FdmSquareRootFwdOp::TransformationType trafoType)
+    : FdFwdVanillaChainEngine(maturities, tGrid, dampingSteps, schemeDesc),
+      model_(model), xGrid_(xGrid), vGrid_(vGrid), trafoType_(trafoType) {
+        registerWith(model_);
+    }
+
+    Real FdHestonFwdChainEngine::underlying() const {
+        return model_->process()->s0()->value();
+    }
+
+    Handle<YieldTermStructure> FdHestonFwdChainEngine::riskFreeRate() const {
+        return model_->process()->riskFreeRate();
+    }
+
+    void FdHestonFwdChainEngine::calculateDensities(
+        const std::vector<Time>& times,
+        Array& x, std::vector<Array>& densities) const {
+
+        const boost::shared_ptr<HestonProcess> process = model_->process();
+        const Real s0 = process->s0()->value();
+        const Real v0 = process->v0(), kappa = process->kappa(),
+                   theta = process->theta(), sigma = process->sigma();
+        const Time maturity = times.back();
+
+        // 1. Mesher
+        const AnalyticPDFHestonEngine pdfEngine(model_);
+        const Real eps = 1e-5;
+        const boost::shared_ptr<Fdm1dMesher> spotMesher(
+            new Concentrating1dMesher(
+                std::log(hestonQuantile(pdfEngine, s0, maturity, eps)),
+                std::log(hestonQuantile(pdfEngine, s0, maturity, 1-eps)),
+                xGrid_, std::make_pair(std::log(s0), 0.1), true));
+
+        const SquareRootProcessRNDCalculator rnd(v0, kappa, theta, sigma);
+        const boost::shared_ptr<Fdm1dMesher> vMesher =
+            varianceMesher(rnd, maturity, v0, vGrid_, trafoType_);
+
+        const boost::shared_ptr<FdmMesher> mesher(
+            new FdmMesherComposite(spotMesher, vMesher));
+
+        // 2. Operator and initial density after a short period
+        const boost::shared_ptr<FdmLinearOpComposite> op(
+            new FdmHestonFwdOp(mesher, process, trafoType_));
+
+        const Time eT = std::min(1.0/365, 0.5*times.front());
+        Array p = FdmHestonGreensFct(mesher, process, trafoType_)
+            .get(eT, FdmHestonGreensFct::Gaussian);
+
+        // 3. Evolution and marginal densities
+        std::vector<Array> solutions;
+        evolve(op, p, eT, times, solutions);
+
+        x = Array(spotMesher->locations().begin(),
+                  spotMesher->locations().end());
+        Array v(vMesher->locations().begin(), vMesher->locations().end());
+
+        // with the power transformation, the solution is the density
+        // divided by v^alpha
+        Array weights(vGrid_, 1.0);
+        if (trafoType_ == FdmSquareRootFwdOp::Power) {
+            const Real alpha = 1.0 - 2*kappa*theta/(sigma*sigma);
+            weights = Pow(v, -alpha);
+        }
+
+        densities.resize(solutions.size());
+        Array slice(vGrid_);
+        for (Size i=0; i < solutions.size(); ++i) {
+            densities[i] = Array(xGrid_);
+            for (Size j=0; j < xGrid_; ++j) {
+                for (Size k=0; k < vGrid_; ++k)
+                    slice[k] = solutions[i][j + k*xGrid_]*weights[k];
+                densities[i][j] = DiscreteSimpsonIntegral()(v, slice);
+            }
+        }
+    }
+
+}
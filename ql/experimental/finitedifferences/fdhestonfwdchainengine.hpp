@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdhestonfwdchainengine.hpp
+    \brief Heston forward-equation chain engine
+*/
+
+#ifndef quantlib_fd_heston_fwd_chain_engine_hpp
+#define quantlib_fd_heston_fwd_chain_engine_hpp
+
+#include <ql/experimental/finitedifferences/fdmsquarerootfwdop.hpp>
+#include <ql/experimental/finitedifferences/fdfwdvanillachainengine.hpp>
+
+namespace QuantLib {
+
+    class HestonModel;
+
+    //! Heston forward-equation chain engine
+    /*! The joint density of the logarithm of the underlying and of
+        the variance is evolved with FdmHestonFwdOp, starting from
+        the Green's function of the process after a short initial
+        period; the density of the underlying is then obtained by
+        integrating over the variance.
+
+        The grids are built for the longest maturity of the chain,
+        as in the Fokker-Planck tests of the Heston stochastic local
+        volatility model; tGrid is the number of time steps up to the
+        longest maturity.  The variance grid must be fine enough to
+        resolve the initial density, which is very narrow; coarser
+        grids lose probability mass during the evolution.
+
+        \ingroup vanillaengines
+
+        \test the prices of a chain are checked against the analytic
+              Heston engine.
+    */
+    class FdHestonFwdChainEngine : public FdFwdVanillaChainEngine {
+      public:
+        FdHestonFwdChainEngine(
+            const boost::shared_ptr<HestonModel>& model,
+            const std::vector<Date>& maturities = std::vector<Date>(),
+            Size tGrid = 100, Size xGrid = 201, Size vGrid = 501,
+            Size dampingSteps = 0,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
+            FdmSquareRootFwdOp::TransformationType trafoType
+                = FdmSquareRootFwdOp::Log);
+
+      protected:
+        Real underlying() const;
+        Handle<YieldTermStructure> riskFreeRate() const;
+        void calculateDensities(const std::vector<Time>& times,
+                                Array& x,
+                                std::vector<Array>& densities) const;
+
+      private:
+        const boost::shared_ptr<HestonModel> model_;
+        const Size xGrid_, vGrid_;
+        const FdmSquareRootFwdOp::TransformationType trafoType_;
+    };
+
+}
+
+#endif
@@ -110,7 +110,7 @@ namespace QuantLib {
 
         // 5. set-up solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
-                                     calculator, maturity, tGrid_, 0 };
+                                     calculator, maturity, tGrid_, 0, 0.0 };
 
         const boost::shared_ptr<FdmKlugeExtOUSolver<3> > solver(
             new FdmKlugeExtOUSolver<3>(
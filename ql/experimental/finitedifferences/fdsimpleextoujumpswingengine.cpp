@@ -112,7 +112,7 @@ namespace QuantLib {
 
         // 6. set-up solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
-                                     calculator, maturity, tGrid_, 0 };
+                                     calculator, maturity, tGrid_, 0, 0.0 };
 
         const boost::shared_ptr<FdmSimple3dExtOUJumpSolver> solver(
             new FdmSimple3dExtOUJumpSolver(
@@ -168,7 +168,8 @@ namespace QuantLib {
 
         // 6. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
-                                     storageCalculator, maturity, tGrid_, 0 };
+                                     storageCalculator, maturity, tGrid_, 0,
+                                     0.0 };
 
         boost::shared_ptr<FdmSimple2dExtOUSolver> solver(
                 new FdmSimple2dExtOUSolver(
@@ -178,7 +178,7 @@ namespace QuantLib {
 
         // 6. set-up solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
-                                     zeroInnerValue, maturity, tGrid_, 0 };
+                                     zeroInnerValue, maturity, tGrid_, 0, 0.0 };
 
         const boost::shared_ptr<FdmKlugeExtOUSolver<4> > solver(
             new FdmKlugeExtOUSolver<4>(Handle<KlugeExtOUProcess>(process_),
@@ -56,6 +56,11 @@ namespace QuantLib {
         sample_type next() const {
             return sample_type(nextGaussian(),1.0);
         }
+        //! advance the generator as if n numbers had been drawn
+        void discard(boost::uint64_t n) {
+            for (; n>0; --n)
+                nextGaussian();
+        }
       private:
         mutable MersenneTwisterUniformRng mt32_;
         Real nextGaussian() const;
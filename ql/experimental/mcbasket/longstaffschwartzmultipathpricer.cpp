@@ -183,7 +183,8 @@ namespace QuantLib {
 
         lowerBounds_[len - 1] = *std::min_element(prices.begin(), prices.end());
 
-        std::vector<bool> lsExercise(n);
+        Array payments(n, 0.0);
+        std::vector<Array> states(n);
 
         for (Integer i = len - 2; i >= 0; --i) {
             std::vector<Real>  y;
@@ -197,20 +198,22 @@ namespace QuantLib {
             //roll back step
             for (Size j = 0; j < n; ++j) {
                 exercise[j] = paths_[j].exercises[i];
+                payments[j] = paths_[j].payments[i];
 
                 // If states is empty, no exercise in this path
                 // and the path will not partecipate to the Lesat Square regression
 
-                const Array & states = paths_[j].states[i];
-                QL_REQUIRE(states.empty() || states.size() == basisDimension, 
+                states[j] = paths_[j].states[i];
+                QL_REQUIRE(states[j].empty() ||
+                           states[j].size() == basisDimension,
                            "Invalid size of basis system");
 
                 // only paths that could potentially create exercise opportunities
                 // partecipate to the regression
 
                 // if exercise is lower than minimum continuation value, no point in considering it
-                if (!states.empty() && exercise[j] > lowerBounds_[i + 1]) {
-                    x.push_back(states);
+                if (!states[j].empty() && exercise[j] > lowerBounds_[i + 1]) {
+                    x.push_back(states[j]);
                     y.push_back(prices[j]);
                 }
             }
@@ -225,89 +228,138 @@ namespace QuantLib {
                 coeff_[i] = Array(0);
             }
 
-            /* attempt to avoid static arbitrage given by always or never exercising.
+            rollback(i, prices, exercise, payments, states);
+        }
 
-               always is absolute: regardless of the lowerBoundContinuationValue_ (this could be changed)
-               but it still honours "canExercise"
-             */
-            Real sumOptimized = 0.0;
-            Real sumNoExercise = 0.0;
-            Real sumAlwaysExercise = 0.0; // always, if allowed
-
-            for (Size j = 0, k = 0; j < n; ++j) {
-                sumNoExercise += prices[j];
-                lsExercise[j] = false;
-
-                const bool canExercise = !paths_[j].states[i].empty();
-                if (canExercise) {
-                    sumAlwaysExercise += exercise[j];
-                    if (!coeff_[i].empty() && exercise[j] > lowerBounds_[i + 1]) {
-                        Real continuationValue = 0.0;
-                        for (Size l = 0; l < v_.size(); ++l) {
-                            continuationValue += coeff_[i][l] * v_[l](x[k]);
-                        }
-                        
-                        if (continuationValue < exercise[j]) {
-                            lsExercise[j] = true;
-                        }
-                        ++k;
-                    }
-                }
-                else {
-                    sumAlwaysExercise += prices[j];
-                }
+        // remove calibration paths
+        paths_.clear();
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
 
-                sumOptimized += lsExercise[j] ? exercise[j] : prices[j];
-            }
+    void LongstaffSchwartzMultiPathPricer::rollback(
+                                        Integer i,
+                                        Array& prices,
+                                        const Array& exercise,
+                                        const Array& payments,
+                                        const std::vector<Array>& states) {
+        const Size n = prices.size();
+        std::vector<bool> lsExercise(n);
 
-            sumOptimized /= n;
-            sumNoExercise /= n;
-            sumAlwaysExercise /= n;
-
-            QL_TRACE(   "Time index: " << i 
-                     << ", LowerBound: " << lowerBounds_[i + 1] 
-                     << ", Optimum: " << sumOptimized 
-                     << ", Continuation: " << sumNoExercise 
-                     << ", Termination: " << sumAlwaysExercise);
-
-            if (  sumOptimized >= sumNoExercise 
-                && sumOptimized >= sumAlwaysExercise) {
-                
-                QL_TRACE("Accepted LS decision");
-                for (Size j = 0; j < n; ++j) {
-                    // lsExercise already contains "canExercise"
-                    prices[j] = lsExercise[j] ? exercise[j] : prices[j];
-                }
-            }
-            else if (sumAlwaysExercise > sumNoExercise) {
-                QL_TRACE("Overridden bad LS decision: ALWAYS");
-                for (Size j = 0; j < n; ++j) {
-                    const bool canExercise = !paths_[j].states[i].empty();
-                    prices[j] = canExercise ? exercise[j] : prices[j];
+        /* attempt to avoid static arbitrage given by always or never exercising.
+
+           always is absolute: regardless of the lowerBoundContinuationValue_ (this could be changed)
+           but it still honours "canExercise"
+         */
+        Real sumOptimized = 0.0;
+        Real sumNoExercise = 0.0;
+        Real sumAlwaysExercise = 0.0; // always, if allowed
+
+        for (Size j = 0; j < n; ++j) {
+            sumNoExercise += prices[j];
+            lsExercise[j] = false;
+
+            const bool canExercise = !states[j].empty();
+            if (canExercise) {
+                sumAlwaysExercise += exercise[j];
+                if (!coeff_[i].empty() && exercise[j] > lowerBounds_[i + 1]) {
+                    Real continuationValue = 0.0;
+                    for (Size l = 0; l < v_.size(); ++l) {
+                        continuationValue += coeff_[i][l] * v_[l](states[j]);
+                    }
+                    
+                    if (continuationValue < exercise[j]) {
+                        lsExercise[j] = true;
+                    }
                 }
-                // special value to indicate always exercise
-                coeff_[i] = Array(v_.size() + 1); 
             }
             else {
-                QL_TRACE("Overridden bad LS decision: NEVER");
-                // prices already contain the continuation value
-                // special value to indicate never exercise
-                coeff_[i] = Array(0); 
+                sumAlwaysExercise += prices[j];
             }
 
-            // then we add in any case the payment at time t
-            // which is made even if cancellation happens at t
+            sumOptimized += lsExercise[j] ? exercise[j] : prices[j];
+        }
+
+        sumOptimized /= n;
+        sumNoExercise /= n;
+        sumAlwaysExercise /= n;
+
+        QL_TRACE(   "Time index: " << i 
+                 << ", LowerBound: " << lowerBounds_[i + 1] 
+                 << ", Optimum: " << sumOptimized 
+                 << ", Continuation: " << sumNoExercise 
+                 << ", Termination: " << sumAlwaysExercise);
+
+        if (  sumOptimized >= sumNoExercise 
+            && sumOptimized >= sumAlwaysExercise) {
+            
+            QL_TRACE("Accepted LS decision");
             for (Size j = 0; j < n; ++j) {
-                const Real payoff = paths_[j].payments[i];
-                prices[j] += payoff;
+                // lsExercise already contains "canExercise"
+                prices[j] = lsExercise[j] ? exercise[j] : prices[j];
             }
+        }
+        else if (sumAlwaysExercise > sumNoExercise) {
+            QL_TRACE("Overridden bad LS decision: ALWAYS");
+            for (Size j = 0; j < n; ++j) {
+                const bool canExercise = !states[j].empty();
+                prices[j] = canExercise ? exercise[j] : prices[j];
+            }
+            // special value to indicate always exercise
+            coeff_[i] = Array(v_.size() + 1); 
+        }
+        else {
+            QL_TRACE("Overridden bad LS decision: NEVER");
+            // prices already contain the continuation value
+            // special value to indicate never exercise
+            coeff_[i] = Array(0); 
+        }
 
-            lowerBounds_[i] = *std::min_element(prices.begin(), prices.end());
+        // then we add in any case the payment at time t
+        // which is made even if cancellation happens at t
+        for (Size j = 0; j < n; ++j) {
+            prices[j] += payments[j];
         }
 
-        // remove calibration paths
-        paths_.clear();
-        // entering the calculation phase
-        calibrationPhase_ = false;
+        lowerBounds_[i] = *std::min_element(prices.begin(), prices.end());
+    }
+
+
+    LongstaffSchwartzMultiPathPricer::CalibrationVisitor::CalibrationVisitor(
+                            const LongstaffSchwartzMultiPathPricer& pricer,
+                            Size first,
+                            Size last,
+                            Array& prices,
+                            std::vector<Array>& exercise,
+                            std::vector<Array>& payments,
+                            std::vector<std::vector<Array> >& states)
+    : pricer_(pricer), first_(first), last_(last), prices_(prices),
+      exercise_(exercise), payments_(payments), states_(states) {}
+
+    void LongstaffSchwartzMultiPathPricer::CalibrationVisitor::operator()(
+                                                   Size,
+                                                   Size j,
+                                                   const MultiPath& path) {
+        const PathInfo info = pricer_.transformPath(path);
+        const Size len = info.pathLength();
+
+        if (last_ == len - 2) {
+            // at the end the continuation value is 0.0
+            prices_[j] = 0.0;
+            if (!info.states[len - 1].empty() && info.exercises[len - 1] > 0.0)
+                prices_[j] += info.exercises[len - 1];
+            prices_[j] += info.payments[len - 1];
+        }
+
+        for (Size i = first_; i <= last_; ++i) {
+            QL_REQUIRE(info.states[i].empty() ||
+                       info.states[i].size() ==
+                                     pricer_.payoff_->basisSystemDimension(),
+                       "Invalid size of basis system");
+            exercise_[i - first_][j] = info.exercises[i];
+            payments_[i - first_][j] = info.payments[i];
+            states_[i - first_][j] = info.states[i];
+        }
     }
+
 }
@@ -25,6 +25,7 @@
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/methods/montecarlo/longstaffschwartzpathpricer.hpp>
 #include <ql/experimental/mcbasket/pathpayoff.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -63,6 +64,22 @@ namespace QuantLib {
 
         Real operator()(const MultiPath& multiPath) const;
         virtual void calibrate();
+        //! calibrates the exercise strategy without storing the paths
+        /*! Each path is generated once for each group of datesPerPass
+            exercise dates (by default, one) and only its
+            discounted cash flow and its data at the dates of the
+            group are kept in memory; the regressions are performed by
+            accumulating their normal equations.  Both the generation
+            and the regressions can be split among a number of
+            parallel workers.  The path generator is copied, so that
+            the passed instance is not modified.
+        */
+        template <class PathGenerator>
+        void calibrate(const PathGenerator& generator,
+                       Size samples,
+                       bool antitheticVariate,
+                       Size workers = 1,
+                       Size datesPerPass = 1);
 
       protected:
         struct PathInfo {
@@ -75,7 +92,35 @@ namespace QuantLib {
             std::vector<Array>      states;
         };
 
+        // stores the data needed by the regressions at the exercise
+        // dates between first and last, and initializes the cash
+        // flows if the last date is the one before maturity
+        class CalibrationVisitor {
+          public:
+            CalibrationVisitor(const LongstaffSchwartzMultiPathPricer& pricer,
+                               Size first,
+                               Size last,
+                               Array& prices,
+                               std::vector<Array>& exercise,
+                               std::vector<Array>& payments,
+                               std::vector<std::vector<Array> >& states);
+            void operator()(Size worker, Size j, const MultiPath& path);
+          private:
+            const LongstaffSchwartzMultiPathPricer& pricer_;
+            Size first_, last_;
+            Array& prices_;
+            std::vector<Array>& exercise_;
+            std::vector<Array>& payments_;
+            std::vector<std::vector<Array> >& states_;
+        };
+
         PathInfo transformPath(const MultiPath& path) const;
+        // decides the exercise at the i-th date and rolls back the prices
+        void rollback(Integer i,
+                      Array& prices,
+                      const Array& exercise,
+                      const Array& payments,
+                      const std::vector<Array>& states);
 
         bool  calibrationPhase_;
 
@@ -92,6 +137,73 @@ namespace QuantLib {
         const   std::vector<boost::function1<Real, Array> > v_;
     };
 
+
+    template <class PathGenerator>
+    inline void LongstaffSchwartzMultiPathPricer::calibrate(
+                                            const PathGenerator& generator,
+                                            Size samples,
+                                            bool antitheticVariate,
+                                            Size workers,
+                                            Size datesPerPass) {
+        QL_REQUIRE(samples > 0, "no calibration samples given");
+        QL_REQUIRE(datesPerPass > 0, "at least one date per pass required");
+        const Size n = antitheticVariate ? 2*samples : samples;
+        const Size len = timePositions_.size();
+        const Size dates = std::min(datesPerPass, len - 1);
+        Array prices(n, 0.0);
+        std::vector<Array> exercise(dates, Array(n, 0.0));
+        std::vector<Array> payments(dates, Array(n, 0.0));
+        std::vector<std::vector<Array> > states(dates, std::vector<Array>(n));
+        std::vector<bool> selected(n);
+
+        for (Size last = len - 1; last > 0; last -= dates) {
+            // the paths are generated once for each group of dates
+            const Size first = last > dates ? last - dates : 0;
+            CalibrationVisitor visitor(*this, first, last - 1, prices,
+                                       exercise, payments, states);
+            detail::visitCalibrationPaths(generator, samples,
+                                          antitheticVariate, workers,
+                                          visitor);
+
+            if (last == len - 1)
+                lowerBounds_[len - 1] =
+                    *std::min_element(prices.begin(), prices.end());
+
+            for (Integer i = last - 1; i >= Integer(first); --i) {
+                // prices are discounted up to time i
+                const Real discountRatio = dF_[i + 1] / dF_[i];
+                prices *= discountRatio;
+                lowerBounds_[i + 1] *= discountRatio;
+
+                const Array& exercise_i = exercise[i - first];
+                const std::vector<Array>& states_i = states[i - first];
+                for (Size j = 0; j < n; ++j)
+                    selected[j] = !states_i[j].empty() &&
+                                  exercise_i[j] > lowerBounds_[i + 1];
+
+                const detail::LsmNormalEquations<Array> equations =
+                    detail::accumulateNormalEquations(v_, states_i, prices,
+                                                      selected, workers);
+                if (v_.size() <= equations.samples()) {
+                    coeff_[i] = equations.coefficients();
+                }
+                else {
+                // if number of itm paths is smaller then the number of
+                // calibration functions -> never exercise
+                    coeff_[i] = Array(0);
+                }
+
+                rollback(i, prices, exercise_i, payments[i - first],
+                         states_i);
+            }
+            if (first == 0)
+                break;
+        }
+
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
 }
 
 
@@ -52,7 +52,10 @@ namespace QuantLib {
                                Real requiredTolerance,
                                Size maxSamples,
                                BigNatural seed,
-                               Size nCalibrationSamples = Null<Size>());
+                               Size nCalibrationSamples = Null<Size>(),
+                               bool streamingCalibration = false,
+                               Size calibrationWorkers = 1,
+                               Size calibrationDatesPerPass = 1);
       protected:
         boost::shared_ptr<LongstaffSchwartzMultiPathPricer>
                                                       lsmPathPricer() const;
@@ -76,6 +79,9 @@ namespace QuantLib {
         MakeMCAmericanPathEngine& withMaxSamples(Size samples);
         MakeMCAmericanPathEngine& withSeed(BigNatural seed);
         MakeMCAmericanPathEngine& withCalibrationSamples(Size samples);
+        MakeMCAmericanPathEngine& withStreamingCalibration(bool b = true);
+        MakeMCAmericanPathEngine& withCalibrationWorkers(Size workers);
+        MakeMCAmericanPathEngine& withCalibrationDatesPerPass(Size dates);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -84,6 +90,8 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_, calibrationSamples_;
         Real tolerance_;
         BigNatural seed_;
+        bool streamingCalibration_;
+        Size calibrationWorkers_, calibrationDatesPerPass_;
     };
 
 
@@ -99,7 +107,10 @@ namespace QuantLib {
                    Real requiredTolerance,
                    Size maxSamples,
                    BigNatural seed,
-                   Size nCalibrationSamples)
+                   Size nCalibrationSamples,
+                   bool streamingCalibration,
+                   Size calibrationWorkers,
+                   Size calibrationDatesPerPass)
         : MCLongstaffSchwartzPathEngine<PathMultiAssetOption::engine,
                                     MultiVariate,RNG>(processes,
                                                       timeSteps,
@@ -111,7 +122,10 @@ namespace QuantLib {
                                                       requiredTolerance,
                                                       maxSamples,
                                                       seed,
-                                                      nCalibrationSamples) {}
+                                                      nCalibrationSamples,
+                                                      streamingCalibration,
+                                                      calibrationWorkers,
+                                                      calibrationDatesPerPass) {}
 
     template <class RNG>
     inline boost::shared_ptr<LongstaffSchwartzMultiPathPricer>
@@ -171,7 +185,9 @@ namespace QuantLib {
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
       calibrationSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0),
+      streamingCalibration_(false), calibrationWorkers_(1),
+      calibrationDatesPerPass_(1) {}
 
     template <class RNG>
     inline MakeMCAmericanPathEngine<RNG>&
@@ -250,6 +266,27 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanPathEngine<RNG>&
+    MakeMCAmericanPathEngine<RNG>::withStreamingCalibration(bool b) {
+        streamingCalibration_ = b;
+        return *this;
+    }
+
+    template <class RNG>
+    inline MakeMCAmericanPathEngine<RNG>&
+    MakeMCAmericanPathEngine<RNG>::withCalibrationWorkers(Size workers) {
+        calibrationWorkers_ = workers;
+        return *this;
+    }
+
+    template <class RNG>
+    inline MakeMCAmericanPathEngine<RNG>&
+    MakeMCAmericanPathEngine<RNG>::withCalibrationDatesPerPass(Size dates) {
+        calibrationDatesPerPass_ = dates;
+        return *this;
+    }
+
     template <class RNG>
     inline
     MakeMCAmericanPathEngine<RNG>::operator
@@ -269,7 +306,10 @@ namespace QuantLib {
                                         tolerance_,
                                         maxSamples_,
                                         seed_,
-                                        calibrationSamples_));
+                                        calibrationSamples_,
+                                        streamingCalibration_,
+                                        calibrationWorkers_,
+                                        calibrationDatesPerPass_));
     }
 
 }
@@ -32,6 +32,11 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        If streamingCalibration is true, the calibration paths are
+        not stored; only the data needed by the regressions are
+        (see LongstaffSchwartzMultiPathPricer).  In this case, they can be
+        split among a number of parallel calibration workers.
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
     */
@@ -59,7 +64,10 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples = Null<Size>());
+            Size nCalibrationSamples = Null<Size>(),
+            bool streamingCalibration = false,
+            Size calibrationWorkers = 1,
+            Size calibrationDatesPerPass = 1);
 
         void calculate() const;
 
@@ -80,6 +88,9 @@ namespace QuantLib {
         const Size maxSamples_;
         const Size seed_;
         const Size nCalibrationSamples_;
+        const bool streamingCalibration_;
+        const Size calibrationWorkers_;
+        const Size calibrationDatesPerPass_;
 
         mutable boost::shared_ptr<LongstaffSchwartzMultiPathPricer> pathPricer_;
     };
@@ -98,7 +109,10 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples)
+            Size nCalibrationSamples,
+            bool streamingCalibration,
+            Size calibrationWorkers,
+            Size calibrationDatesPerPass)
     : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate),
       process_            (process),
       timeSteps_          (timeSteps),
@@ -109,7 +123,10 @@ namespace QuantLib {
       maxSamples_         (maxSamples),
       seed_               (seed),
       nCalibrationSamples_( (nCalibrationSamples == Null<Size>())
-                            ? 2048 : nCalibrationSamples) {
+                            ? 2048 : nCalibrationSamples),
+      streamingCalibration_(streamingCalibration),
+      calibrationWorkers_(calibrationWorkers),
+      calibrationDatesPerPass_(calibrationDatesPerPass) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -122,6 +139,13 @@ namespace QuantLib {
         QL_REQUIRE(timeStepsPerYear != 0,
                    "timeStepsPerYear must be positive, " 
                     << timeStepsPerYear << " not allowed");
+        QL_REQUIRE(calibrationWorkers > 0,
+                   "at least one calibration worker required");
+        QL_REQUIRE(calibrationWorkers == 1 || streamingCalibration,
+                   "multiple calibration workers require "
+                   "streaming calibration");
+        QL_REQUIRE(calibrationDatesPerPass > 0,
+                   "at least one calibration date per pass required");
         this->registerWith(process_);
     }
 
@@ -143,13 +167,21 @@ namespace QuantLib {
     void MCLongstaffSchwartzPathEngine<GenericEngine,MC,RNG,S>::calculate() 
     const {
         pathPricer_ = this->lsmPathPricer();
-        this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
-                          new MonteCarloModel<MC,RNG,S>
-                              (pathGenerator(), pathPricer_,
-                               stats_type(), this->antitheticVariate_));
-
-        this->mcModel_->addSamples(nCalibrationSamples_);
-        this->pathPricer_->calibrate();
+        if (streamingCalibration_) {
+            this->pathPricer_->calibrate(*pathGenerator(),
+                                         nCalibrationSamples_,
+                                         this->antitheticVariate_,
+                                         calibrationWorkers_,
+                                         calibrationDatesPerPass_);
+        } else {
+            this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                              new MonteCarloModel<MC,RNG,S>
+                                  (pathGenerator(), pathPricer_,
+                                   stats_type(), this->antitheticVariate_));
+
+            this->mcModel_->addSamples(nCalibrationSamples_);
+            this->pathPricer_->calibrate();
+        }
 
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
                                           requiredSamples_,
@@ -90,4 +90,11 @@ namespace QuantLib {
         }
     }
 
+    void ExtendedBlackScholesMertonProcess::evolve(Time t0, const Real* x0,
+                                                   Time dt, const Real* dw,
+                                                   Real* x, Size n) const {
+        // bypass the exact evolution of the base class
+        StochasticProcess1D::evolve(t0, x0, dt, dw, x, n);
+    }
+
 }
@@ -0,0 +1,165 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/instruments/portfoliovaluation.hpp>
+#include <ql/patterns/pricingcontext.hpp>
+#include <ql/termstructure.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        typedef boost::posix_time::ptime timestamp;
+
+        timestamp now() {
+            return boost::posix_time::microsec_clock::universal_time();
+        }
+
+        Real secondsBetween(const timestamp& start, const timestamp& end) {
+            return (end - start).total_microseconds() * 1.0e-6;
+        }
+
+        void value(const boost::shared_ptr<Instrument>& instrument,
+                   PortfolioValuation::Result& result) {
+            timestamp start = now();
+            try {
+                result.NPV = instrument->NPV();
+            } catch (std::exception& e) {
+                result.NPV = Null<Real>();
+                result.error = e.what();
+                if (result.error.empty())
+                    result.error = "unknown error";
+            } catch (...) {
+                result.NPV = Null<Real>();
+                result.error = "unknown error";
+            }
+            result.time = secondsBetween(start, now());
+        }
+
+        // freezes the calculated dependencies for the lifetime of
+        // the instance, leaving alone the ones that were already
+        // frozen by the user; unfreezing them doesn't notify their
+        // observers unless they changed, so that the NPVs just
+        // calculated stay cached
+        class DependencyFreeze {
+          public:
+            explicit DependencyFreeze(
+                const std::vector<boost::shared_ptr<Observable> >& deps) {
+                for (Size i=0; i<deps.size(); ++i) {
+                    try {
+                        freeze(deps[i]);
+                    } catch (std::exception& e) {
+                        unfreeze();
+                        QL_FAIL("dependency " << i << " failed: "
+                                << e.what());
+                    } catch (...) {
+                        unfreeze();
+                        throw;
+                    }
+                }
+            }
+            ~DependencyFreeze() {
+                unfreeze();
+            }
+          private:
+            void freeze(const boost::shared_ptr<Observable>& dependency) {
+                // moving term structures set their reference date
+                // the first time it's asked for
+                boost::shared_ptr<TermStructure> ts =
+                    boost::dynamic_pointer_cast<TermStructure>(dependency);
+                if (ts)
+                    ts->referenceDate();
+                boost::shared_ptr<LazyObject> lazy =
+                    boost::dynamic_pointer_cast<LazyObject>(dependency);
+                if (lazy && !lazy->isFrozen()) {
+                    lazy->ensureCalculated();
+                    lazy->freeze();
+                    frozen_.push_back(lazy);
+                }
+            }
+            void unfreeze() {
+                for (Size i=0; i<frozen_.size(); ++i)
+                    frozen_[i]->unfreezeQuietly();
+                frozen_.clear();
+            }
+            std::vector<boost::shared_ptr<LazyObject> > frozen_;
+        };
+
+    }
+
+    PortfolioValuation::PortfolioValuation(
+              const std::vector<boost::shared_ptr<Instrument> >& instruments,
+              const std::vector<boost::shared_ptr<Observable> >&
+                                                          sharedDependencies)
+    : instruments_(instruments), dependencies_(sharedDependencies),
+      results_(instruments.size()), elapsedTime_(0.0) {
+        for (Size i=0; i<instruments_.size(); ++i)
+            QL_REQUIRE(instruments_[i], "null instrument " << i);
+        for (Size i=0; i<dependencies_.size(); ++i)
+            QL_REQUIRE(dependencies_[i], "null dependency " << i);
+    }
+
+    void PortfolioValuation::calculate() {
+        timestamp start = now();
+        const long n = long(instruments_.size());
+        std::fill(results_.begin(), results_.end(), Result());
+
+        {
+            DependencyFreeze freeze(dependencies_);
+
+            if (n > 0)
+                value(instruments_[0], results_[0]);
+
+            PricingContext* context = PricingContext::current();
+            #pragma omp parallel for schedule(dynamic)
+            for (long i=1; i<n; ++i) {
+                PricingContextSwitch inContext(context);
+                value(instruments_[i], results_[i]);
+            }
+        }
+
+        elapsedTime_ = secondsBetween(start, now());
+    }
+
+    const PortfolioValuation::Result&
+    PortfolioValuation::result(Size i) const {
+        QL_REQUIRE(i < results_.size(),
+                   "instrument " << i << " not available; only "
+                   << results_.size() << " instruments");
+        return results_[i];
+    }
+
+    Real PortfolioValuation::NPV() const {
+        Real total = 0.0;
+        for (Size i=0; i<results_.size(); ++i) {
+            if (results_[i].error.empty())
+                total += results_[i].NPV;
+        }
+        return total;
+    }
+
+    Size PortfolioValuation::failures() const {
+        Size count = 0;
+        for (Size i=0; i<results_.size(); ++i) {
+            if (!results_[i].error.empty())
+                ++count;
+        }
+        return count;
+    }
+
+}
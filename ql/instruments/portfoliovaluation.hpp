@@ -0,0 +1,109 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file portfoliovaluation.hpp
+    \brief parallel valuation of a portfolio of instruments
+*/
+
+#ifndef quantlib_portfolio_valuation_hpp
+#define quantlib_portfolio_valuation_hpp
+
+#include <ql/instrument.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! parallel valuation of a portfolio of instruments
+    /*! The instruments are valued in three steps:
+        - the shared dependencies (e.g., term structures or
+          volatility surfaces used by several instruments) are
+          calculated by the calling thread, if needed, and frozen
+          if they are lazy objects, so that they are only read
+          afterwards; the ones already frozen are left alone;
+        - the first instrument is valued by the calling thread, so
+          that any lazily initialized state shared by the
+          instruments (e.g., singletons or function-local statics
+          used by their engines) is set up before the worker
+          threads start;
+        - the other instruments are valued in parallel when the
+          library is compiled with OpenMP support, with dynamic
+          scheduling so that idle threads take the next instruments
+          in line.  The dependencies are unfrozen at the end,
+          without invalidating the results unless they changed.
+
+        The NPV, the wall-clock time and the error message (if any)
+        of each instrument are stored; a failure doesn't stop the
+        valuation of the others.  The workers use the pricing context
+        of the calling thread.
+
+        \warning Each instrument must have its own pricing engine,
+                 and the instruments must not share any lazy object
+                 that is not among the given dependencies.  No
+                 observable should be modified, nor any observer
+                 registered with the shared ones, while the valuation
+                 runs; for instance, engines that build term
+                 structures in their calculations should only be used
+                 with the thread-safe observer pattern.
+
+        \test the results are checked against the serial valuation
+              of the instruments, and failures are checked to be
+              reported.
+
+        \ingroup instruments
+    */
+    class PortfolioValuation {
+      public:
+        //! valuation of a single instrument
+        struct Result {
+            Result() : NPV(Null<Real>()), time(0.0) {}
+            //! null if the valuation failed
+            Real NPV;
+            //! wall-clock time in seconds
+            Real time;
+            //! empty unless the valuation failed
+            std::string error;
+        };
+        PortfolioValuation(
+              const std::vector<boost::shared_ptr<Instrument> >& instruments,
+              const std::vector<boost::shared_ptr<Observable> >&
+                  sharedDependencies =
+                              std::vector<boost::shared_ptr<Observable> >());
+        //! values the instruments
+        void calculate();
+        //! \name Inspectors
+        //@{
+        Size size() const { return instruments_.size(); }
+        const std::vector<Result>& results() const { return results_; }
+        const Result& result(Size i) const;
+        //! sum of the NPVs of the successful valuations
+        Real NPV() const;
+        //! number of failed valuations
+        Size failures() const;
+        //! wall-clock time in seconds of the last call to calculate()
+        Real elapsedTime() const { return elapsedTime_; }
+        //@}
+      private:
+        std::vector<boost::shared_ptr<Instrument> > instruments_;
+        std::vector<boost::shared_ptr<Observable> > dependencies_;
+        std::vector<Result> results_;
+        Real elapsedTime_;
+    };
+
+}
+
+
+#endif
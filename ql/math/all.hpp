@@ -3,6 +3,7 @@
 
 #include <ql/math/abcdmathfunction.hpp>
 #include <ql/math/array.hpp>
+#include <ql/math/arraykernels.hpp>
 #include <ql/math/autocovariance.hpp>
 #include <ql/math/bernsteinpolynomial.hpp>
 #include <ql/math/beta.hpp>
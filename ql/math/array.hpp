@@ -28,6 +28,8 @@
 
 #include <ql/types.hpp>
 #include <ql/errors.hpp>
+#include <ql/math/arraykernels.hpp>
+#include <ql/utilities/alignedbuffer.hpp>
 #include <ql/utilities/disposable.hpp>
 #include <ql/utilities/null.hpp>
 #include <boost/iterator/reverse_iterator.hpp>
@@ -46,6 +48,10 @@ namespace QuantLib {
         As such, it is <b>not</b> meant to be used as a container -
         <tt>std::vector</tt> should be used instead.
 
+        Elements are stored in a buffer aligned to 64 bytes, and the
+        algebraic operators are performed by the vectorised kernels
+        declared in arraykernels.hpp.
+
         \test construction of arrays is checked in a number of cases
     */
     class Array {
@@ -62,12 +68,18 @@ namespace QuantLib {
         Array(Size size, Real value, Real increment);
         Array(const Array&);
         Array(const Disposable<Array>&);
+        #if defined(QL_HAS_RVALUE_REFERENCES)
+        Array(Array&&);
+        #endif
         //! creates the array from an iterable sequence
         template <class ForwardIterator>
         Array(ForwardIterator begin, ForwardIterator end);
 
         Array& operator=(const Array&);
         Array& operator=(const Disposable<Array>&);
+        #if defined(QL_HAS_RVALUE_REFERENCES)
+        Array& operator=(Array&&);
+        #endif
         bool operator==(const Array&) const;
         bool operator!=(const Array&) const;
         //@}
@@ -136,7 +148,7 @@ namespace QuantLib {
         //@}
 
       private:
-        boost::scoped_array<Real> data_;
+        AlignedBuffer<Real> data_;
         Size n_;
     };
 
@@ -188,6 +200,65 @@ namespace QuantLib {
     /*! \relates Array */
     const Disposable<Array> operator/(Real, const Array&);
 
+    /* The overloads below write their result in the storage of
+       their disposable argument (e.g., the result of another
+       operator) instead of allocating a new array; see
+       DisposableRvalue for the arguments they accept. */
+    /*! \relates Array */
+    const Disposable<Array> operator-(DisposableRvalue<Array>::type v);
+    /*! \relates Array */
+    const Disposable<Array> operator+(DisposableRvalue<Array>::type,
+                                      const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator+(const Array&,
+                                      DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator+(DisposableRvalue<Array>::type,
+                                      DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator+(DisposableRvalue<Array>::type, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator+(Real, DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator-(DisposableRvalue<Array>::type,
+                                      const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator-(const Array&,
+                                      DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator-(DisposableRvalue<Array>::type,
+                                      DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator-(DisposableRvalue<Array>::type, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator-(Real, DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator*(DisposableRvalue<Array>::type,
+                                      const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator*(const Array&,
+                                      DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator*(DisposableRvalue<Array>::type,
+                                      DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator*(DisposableRvalue<Array>::type, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator*(Real, DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator/(DisposableRvalue<Array>::type,
+                                      const Array&);
+    /*! \relates Array */
+    const Disposable<Array> operator/(const Array&,
+                                      DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator/(DisposableRvalue<Array>::type,
+                                      DisposableRvalue<Array>::type);
+    /*! \relates Array */
+    const Disposable<Array> operator/(DisposableRvalue<Array>::type, Real);
+    /*! \relates Array */
+    const Disposable<Array> operator/(Real, DisposableRvalue<Array>::type);
+
     // math functions
     /*! \relates Array */
     const Disposable<Array> Abs(const Array&);
@@ -212,21 +283,21 @@ namespace QuantLib {
     // inline definitions
 
     inline Array::Array(Size size)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {}
+    : data_(size), n_(size) {}
 
     inline Array::Array(Size size, Real value)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : data_(size), n_(size) {
         std::fill(begin(),end(),value);
     }
 
     inline Array::Array(Size size, Real value, Real increment)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : data_(size), n_(size) {
         for (iterator i=begin(); i!=end(); ++i, value+=increment)
             *i = value;
     }
 
     inline Array::Array(const Array& from)
-    : data_(from.n_ ? new Real[from.n_] : (Real*)(0)), n_(from.n_) {
+    : data_(from.n_), n_(from.n_) {
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
         if (n_)
         #endif
@@ -234,15 +305,22 @@ namespace QuantLib {
     }
 
     inline Array::Array(const Disposable<Array>& from)
-    : data_((Real*)(0)), n_(0) {
+    : data_(), n_(0) {
         swap(const_cast<Disposable<Array>&>(from));
     }
 
+    #if defined(QL_HAS_RVALUE_REFERENCES)
+    inline Array::Array(Array&& from)
+    : data_(), n_(0) {
+        swap(from);
+    }
+    #endif
+
     namespace detail {
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
+                                 AlignedBuffer<Real>& data_,
                                  Size& n_,
                                  I begin, I end,
                                  const boost::true_type&) {
@@ -252,20 +330,20 @@ namespace QuantLib {
             // Array with a given value, which we do here.
             Size n = begin;
             Real value = end;
-            data_.reset(n ? new Real[n] : (Real*)(0));
+            data_.reset(n);
             n_ = n;
             std::fill(a.begin(),a.end(),value);
         }
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
+                                 AlignedBuffer<Real>& data_,
                                  Size& n_,
                                  I begin, I end,
                                  const boost::false_type&) {
             // true iterators
             Size n = std::distance(begin, end);
-            data_.reset(n ? new Real[n] : (Real*)(0));
+            data_.reset(n);
             n_ = n;
             #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
             if (n_)
@@ -303,19 +381,24 @@ namespace QuantLib {
         return *this;
     }
 
+    #if defined(QL_HAS_RVALUE_REFERENCES)
+    inline Array& Array::operator=(Array&& from) {
+        swap(from);
+        return *this;
+    }
+    #endif
+
     inline const Array& Array::operator+=(const Array& v) {
         QL_REQUIRE(n_ == v.n_,
                    "arrays with different sizes (" << n_ << ", "
                    << v.n_ << ") cannot be added");
-        std::transform(begin(),end(),v.begin(),begin(),
-                       std::plus<Real>());
+        detail::vectorAdd(n_, begin(), v.begin(), begin());
         return *this;
     }
 
 
     inline const Array& Array::operator+=(Real x) {
-        std::transform(begin(),end(),begin(),
-                       std::bind2nd(std::plus<Real>(),x));
+        detail::vectorAdd(n_, begin(), x, begin());
         return *this;
     }
 
@@ -323,14 +406,12 @@ namespace QuantLib {
         QL_REQUIRE(n_ == v.n_,
                    "arrays with different sizes (" << n_ << ", "
                    << v.n_ << ") cannot be subtracted");
-        std::transform(begin(),end(),v.begin(),begin(),
-                       std::minus<Real>());
+        detail::vectorSubtract(n_, begin(), v.begin(), begin());
         return *this;
     }
 
     inline const Array& Array::operator-=(Real x) {
-        std::transform(begin(),end(),begin(),
-                       std::bind2nd(std::minus<Real>(),x));
+        detail::vectorSubtract(n_, begin(), x, begin());
         return *this;
     }
 
@@ -338,14 +419,12 @@ namespace QuantLib {
         QL_REQUIRE(n_ == v.n_,
                    "arrays with different sizes (" << n_ << ", "
                    << v.n_ << ") cannot be multiplied");
-        std::transform(begin(),end(),v.begin(),begin(),
-                       std::multiplies<Real>());
+        detail::vectorMultiply(n_, begin(), v.begin(), begin());
         return *this;
     }
 
     inline const Array& Array::operator*=(Real x) {
-        std::transform(begin(),end(),begin(),
-                       std::bind2nd(std::multiplies<Real>(),x));
+        detail::vectorMultiply(n_, begin(), x, begin());
         return *this;
     }
 
@@ -353,14 +432,12 @@ namespace QuantLib {
         QL_REQUIRE(n_ == v.n_,
                    "arrays with different sizes (" << n_ << ", "
                    << v.n_ << ") cannot be divided");
-        std::transform(begin(),end(),v.begin(),begin(),
-                       std::divides<Real>());
+        detail::vectorDivide(n_, begin(), v.begin(), begin());
         return *this;
     }
 
     inline const Array& Array::operator/=(Real x) {
-        std::transform(begin(),end(),begin(),
-                       std::bind2nd(std::divides<Real>(),x));
+        detail::vectorDivide(n_, begin(), x, begin());
         return *this;
     }
 
@@ -487,7 +564,7 @@ namespace QuantLib {
         QL_REQUIRE(v1.size() == v2.size(),
                    "arrays with different sizes (" << v1.size() << ", "
                    << v2.size() << ") cannot be multiplied");
-        return std::inner_product(v1.begin(),v1.end(),v2.begin(),0.0);
+        return detail::vectorDotProduct(v1.size(), v1.begin(), v2.begin());
     }
 
     inline Real Norm2(const Array& v) {
@@ -505,8 +582,7 @@ namespace QuantLib {
 
     inline const Disposable<Array> operator-(const Array& v) {
         Array result(v.size());
-        std::transform(v.begin(),v.end(),result.begin(),
-                       std::negate<Real>());
+        detail::vectorNegate(v.size(), v.begin(), result.begin());
         return result;
     }
 
@@ -519,22 +595,19 @@ namespace QuantLib {
                    "arrays with different sizes (" << v1.size() << ", "
                    << v2.size() << ") cannot be added");
         Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::plus<Real>());
+        detail::vectorAdd(v1.size(), v1.begin(), v2.begin(), result.begin());
         return result;
     }
 
     inline const Disposable<Array> operator+(const Array& v1, Real a) {
         Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::plus<Real>(),a));
+        detail::vectorAdd(v1.size(), v1.begin(), a, result.begin());
         return result;
     }
 
     inline const Disposable<Array> operator+(Real a, const Array& v2) {
         Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::plus<Real>(),a));
+        detail::vectorAdd(v2.size(), v2.begin(), a, result.begin());
         return result;
     }
 
@@ -544,22 +617,20 @@ namespace QuantLib {
                    "arrays with different sizes (" << v1.size() << ", "
                    << v2.size() << ") cannot be subtracted");
         Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::minus<Real>());
+        detail::vectorSubtract(v1.size(), v1.begin(),
+                               v2.begin(), result.begin());
         return result;
     }
 
     inline const Disposable<Array> operator-(const Array& v1, Real a) {
         Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::minus<Real>(),a));
+        detail::vectorSubtract(v1.size(), v1.begin(), a, result.begin());
         return result;
     }
 
     inline const Disposable<Array> operator-(Real a, const Array& v2) {
         Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::minus<Real>(),a));
+        detail::vectorSubtract(v2.size(), a, v2.begin(), result.begin());
         return result;
     }
 
@@ -569,22 +640,20 @@ namespace QuantLib {
                    "arrays with different sizes (" << v1.size() << ", "
                    << v2.size() << ") cannot be multiplied");
         Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::multiplies<Real>());
+        detail::vectorMultiply(v1.size(), v1.begin(),
+                               v2.begin(), result.begin());
         return result;
     }
 
     inline const Disposable<Array> operator*(const Array& v1, Real a) {
         Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::multiplies<Real>(),a));
+        detail::vectorMultiply(v1.size(), v1.begin(), a, result.begin());
         return result;
     }
 
     inline const Disposable<Array> operator*(Real a, const Array& v2) {
         Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::multiplies<Real>(),a));
+        detail::vectorMultiply(v2.size(), v2.begin(), a, result.begin());
         return result;
     }
 
@@ -594,22 +663,200 @@ namespace QuantLib {
                    "arrays with different sizes (" << v1.size() << ", "
                    << v2.size() << ") cannot be divided");
         Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::divides<Real>());
+        detail::vectorDivide(v1.size(), v1.begin(),
+                             v2.begin(), result.begin());
         return result;
     }
 
     inline const Disposable<Array> operator/(const Array& v1, Real a) {
         Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::divides<Real>(),a));
+        detail::vectorDivide(v1.size(), v1.begin(), a, result.begin());
         return result;
     }
 
     inline const Disposable<Array> operator/(Real a, const Array& v2) {
         Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::divides<Real>(),a));
+        detail::vectorDivide(v2.size(), a, v2.begin(), result.begin());
+        return result;
+    }
+
+    // binary operators reusing disposable arguments
+
+    inline const Disposable<Array> operator-(DisposableRvalue<Array>::type v) {
+        Array result = v;
+        detail::vectorNegate(result.size(), result.begin(), result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(DisposableRvalue<Array>::type v1,
+                                             const Array& v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be added");
+        Array result = v1;
+        detail::vectorAdd(result.size(), result.begin(),
+                          v2.begin(), result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(const Array& v1,
+                                             DisposableRvalue<Array>::type v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be added");
+        Array result = v2;
+        detail::vectorAdd(v1.size(), v1.begin(),
+                          result.begin(), result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(DisposableRvalue<Array>::type v1,
+                                             DisposableRvalue<Array>::type v2) {
+        return static_cast<DisposableRvalue<Array>::type>(v1)
+            + static_cast<const Array&>(v2);
+    }
+
+    inline const Disposable<Array> operator+(DisposableRvalue<Array>::type v1,
+                                             Real a) {
+        Array result = v1;
+        detail::vectorAdd(result.size(), result.begin(), a, result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator+(Real a,
+                                             DisposableRvalue<Array>::type v2) {
+        Array result = v2;
+        detail::vectorAdd(result.size(), result.begin(), a, result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(DisposableRvalue<Array>::type v1,
+                                             const Array& v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be subtracted");
+        Array result = v1;
+        detail::vectorSubtract(result.size(), result.begin(),
+                               v2.begin(), result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(const Array& v1,
+                                             DisposableRvalue<Array>::type v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be subtracted");
+        Array result = v2;
+        detail::vectorSubtract(v1.size(), v1.begin(),
+                               result.begin(), result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(DisposableRvalue<Array>::type v1,
+                                             DisposableRvalue<Array>::type v2) {
+        return static_cast<DisposableRvalue<Array>::type>(v1)
+            - static_cast<const Array&>(v2);
+    }
+
+    inline const Disposable<Array> operator-(DisposableRvalue<Array>::type v1,
+                                             Real a) {
+        Array result = v1;
+        detail::vectorSubtract(result.size(), result.begin(),
+                               a, result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator-(Real a,
+                                             DisposableRvalue<Array>::type v2) {
+        Array result = v2;
+        detail::vectorSubtract(result.size(), a,
+                               result.begin(), result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(DisposableRvalue<Array>::type v1,
+                                             const Array& v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be multiplied");
+        Array result = v1;
+        detail::vectorMultiply(result.size(), result.begin(),
+                               v2.begin(), result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(const Array& v1,
+                                             DisposableRvalue<Array>::type v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be multiplied");
+        Array result = v2;
+        detail::vectorMultiply(v1.size(), v1.begin(),
+                               result.begin(), result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(DisposableRvalue<Array>::type v1,
+                                             DisposableRvalue<Array>::type v2) {
+        return static_cast<DisposableRvalue<Array>::type>(v1)
+            * static_cast<const Array&>(v2);
+    }
+
+    inline const Disposable<Array> operator*(DisposableRvalue<Array>::type v1,
+                                             Real a) {
+        Array result = v1;
+        detail::vectorMultiply(result.size(), result.begin(),
+                               a, result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator*(Real a,
+                                             DisposableRvalue<Array>::type v2) {
+        Array result = v2;
+        detail::vectorMultiply(result.size(), result.begin(),
+                               a, result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(DisposableRvalue<Array>::type v1,
+                                             const Array& v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be divided");
+        Array result = v1;
+        detail::vectorDivide(result.size(), result.begin(),
+                             v2.begin(), result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(const Array& v1,
+                                             DisposableRvalue<Array>::type v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                   << v2.size() << ") cannot be divided");
+        Array result = v2;
+        detail::vectorDivide(v1.size(), v1.begin(),
+                             result.begin(), result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(DisposableRvalue<Array>::type v1,
+                                             DisposableRvalue<Array>::type v2) {
+        return static_cast<DisposableRvalue<Array>::type>(v1)
+            / static_cast<const Array&>(v2);
+    }
+
+    inline const Disposable<Array> operator/(DisposableRvalue<Array>::type v1,
+                                             Real a) {
+        Array result = v1;
+        detail::vectorDivide(result.size(), result.begin(), a, result.begin());
+        return result;
+    }
+
+    inline const Disposable<Array> operator/(Real a,
+                                             DisposableRvalue<Array>::type v2) {
+        Array result = v2;
+        detail::vectorDivide(result.size(), a, result.begin(), result.begin());
         return result;
     }
 
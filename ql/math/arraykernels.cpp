@@ -0,0 +1,330 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/arraykernels.hpp>
+#include <algorithm>
+
+#if defined(QL_USE_BLAS)
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <cblas.h>
+#endif
+
+/* Clones for different instruction sets are generated where gcc
+   can dispatch among them at run time, i.e., on x86 platforms with
+   support for indirect functions.  Vectorisation is also enabled
+   for this file, since gcc doesn't perform it (or only in trivial
+   cases) at -O2; contraction into fused multiply-adds is disabled,
+   since the clones for instruction sets providing them would
+   otherwise round differently from the default one. */
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 6) \
+    && (defined(__x86_64__) || defined(__i386__)) && defined(__linux__)
+#pragma GCC optimize ("tree-vectorize", "fp-contract=off")
+#define QL_VECTOR_KERNEL \
+    __attribute__((target_clones("avx512f","avx2","default")))
+#else
+#define QL_VECTOR_KERNEL
+#endif
+
+namespace QuantLib {
+
+    namespace detail {
+
+      namespace kernels {
+
+        QL_VECTOR_KERNEL
+        void vectorAdd(Size n, const Real* x, const Real* y, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = x[i] + y[i];
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorSubtract(Size n, const Real* x, const Real* y, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = x[i] - y[i];
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorMultiply(Size n, const Real* x, const Real* y, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = x[i] * y[i];
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorDivide(Size n, const Real* x, const Real* y, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = x[i] / y[i];
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorAdd(Size n, const Real* x, Real a, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = x[i] + a;
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorSubtract(Size n, const Real* x, Real a, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = x[i] - a;
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorSubtract(Size n, Real a, const Real* x, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = a - x[i];
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorMultiply(Size n, const Real* x, Real a, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = x[i] * a;
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorDivide(Size n, const Real* x, Real a, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = x[i] / a;
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorDivide(Size n, Real a, const Real* x, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = a / x[i];
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorNegate(Size n, const Real* x, Real* z) {
+            for (Size i=0; i<n; ++i)
+                z[i] = -x[i];
+        }
+
+      }
+
+        Real vectorDotProduct(Size n, const Real* x, const Real* y) {
+            // the terms are summed in order, as in std::inner_product,
+            // so that results don't change with the instruction set
+            Real result = 0.0;
+            for (Size i=0; i<n; ++i)
+                result += x[i] * y[i];
+            return result;
+        }
+
+        namespace {
+
+            // elements per task in vectorAxpy
+            const Size axpyBlock = 4096;
+
+            QL_VECTOR_KERNEL
+            void axpy(Size n, Real a, const Real* x, const Real* y,
+                      Real* z) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = y[i] + a*x[i];
+            }
+
+        }
+
+        void vectorAxpy(Size n, Real a, const Real* x, const Real* y,
+                        Real* z) {
+            const long blocks = long((n + axpyBlock - 1)/axpyBlock);
+            #pragma omp parallel for if(n >= parallelThreshold)
+            for (long b=0; b<blocks; ++b) {
+                const Size begin = Size(b)*axpyBlock;
+                axpy(std::min(axpyBlock, n-begin), a,
+                     x+begin, y+begin, z+begin);
+            }
+        }
+
+        #if defined(QL_USE_BLAS)
+
+        BOOST_STATIC_ASSERT((boost::is_same<Real, double>::value));
+
+        void matrixVectorProduct(Size m, Size n,
+                                 const Real* M, const Real* v, Real* z) {
+            if (n == 0) {
+                std::fill(z, z+m, 0.0);
+                return;
+            }
+            if (m > 0)
+                cblas_dgemv(CblasRowMajor, CblasNoTrans,
+                            int(m), int(n), 1.0, M, int(n), v, 1,
+                            0.0, z, 1);
+        }
+
+        void vectorMatrixProduct(Size m, Size n,
+                                 const Real* v, const Real* M, Real* z) {
+            if (m == 0) {
+                std::fill(z, z+n, 0.0);
+                return;
+            }
+            if (n > 0)
+                cblas_dgemv(CblasRowMajor, CblasTrans,
+                            int(m), int(n), 1.0, M, int(n), v, 1,
+                            0.0, z, 1);
+        }
+
+        void matrixProduct(Size m, Size k, Size n,
+                           const Real* A, const Real* B, Real* C) {
+            if (k == 0) {
+                std::fill(C, C+m*n, 0.0);
+                return;
+            }
+            if (m > 0 && n > 0)
+                cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans,
+                            int(m), int(n), int(k), 1.0, A, int(k),
+                            B, int(n), 0.0, C, int(n));
+        }
+
+        #else
+
+        QL_VECTOR_KERNEL
+        void matrixVectorProduct(Size m, Size n,
+                                 const Real* M, const Real* v, Real* z) {
+            // four rows at a time, so that each element of v is
+            // loaded once for all of them; each row is still summed
+            // in order
+            Size i = 0;
+            for (; i+4<=m; i+=4) {
+                const Real* r0 = M + i*n;
+                const Real* r1 = r0 + n;
+                const Real* r2 = r1 + n;
+                const Real* r3 = r2 + n;
+                Real s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+                for (Size j=0; j<n; ++j) {
+                    s0 += r0[j]*v[j];
+                    s1 += r1[j]*v[j];
+                    s2 += r2[j]*v[j];
+                    s3 += r3[j]*v[j];
+                }
+                z[i] = s0;
+                z[i+1] = s1;
+                z[i+2] = s2;
+                z[i+3] = s3;
+            }
+            for (; i<m; ++i)
+                z[i] = vectorDotProduct(n, M + i*n, v);
+        }
+
+        QL_VECTOR_KERNEL
+        void vectorMatrixProduct(Size m, Size n,
+                                 const Real* v, const Real* M, Real* z) {
+            // the rows of M are accumulated into z, which vectorises
+            // along the row and sums the terms of each element in order
+            std::fill(z, z+n, 0.0);
+            for (Size i=0; i<m; ++i) {
+                const Real vi = v[i];
+                const Real* row = M + i*n;
+                for (Size j=0; j<n; ++j)
+                    z[j] += vi*row[j];
+            }
+        }
+
+        QL_VECTOR_KERNEL
+        void matrixProduct(Size m, Size k, Size n,
+                           const Real* A, const Real* B, Real* C) {
+            // B is traversed in blocks of kBlock rows and nBlock
+            // columns (128 KB in double precision) which are reused
+            // for all the rows of C; within a block, the inner loop
+            // vectorises along the rows of B and C.  The blocks are
+            // visited in order of k, so that each element of C sums
+            // its terms in order.
+            const Size kBlock = 64, nBlock = 256;
+            std::fill(C, C+m*n, 0.0);
+            for (Size kk=0; kk<k; kk+=kBlock) {
+                const Size kEnd = std::min(kk+kBlock, k);
+                for (Size jj=0; jj<n; jj+=nBlock) {
+                    const Size jEnd = std::min(jj+nBlock, n);
+                    for (Size i=0; i<m; ++i) {
+                        Real* c = C + i*n;
+                        const Real* a = A + i*k;
+                        for (Size l=kk; l<kEnd; ++l) {
+                            const Real ail = a[l];
+                            const Real* b = B + l*n;
+                            for (Size j=jj; j<jEnd; ++j)
+                                c[j] += ail*b[j];
+                        }
+                    }
+                }
+            }
+        }
+
+        #endif
+
+        QL_VECTOR_KERNEL
+        void sparseMatrixVectorProduct(Size begin, Size end,
+                                       const Size* rowStarts,
+                                       const Size* columnIndices,
+                                       const Real* values,
+                                       const Real* x, Real* y) {
+            // each row is summed in order, as in
+            // prod(const SparseMatrix&, const Array&)
+            for (Size i=begin; i<end; ++i) {
+                Real t = 0.0;
+                for (Size k=rowStarts[i]; k<rowStarts[i+1]; ++k)
+                    t += values[k]*x[columnIndices[k]];
+                y[i] = t;
+            }
+        }
+
+        QL_VECTOR_KERNEL
+        void tripleBandProduct(Size n, Size stride,
+                               const Real* lower, const Real* diag,
+                               const Real* upper, const Real* x, Real* y) {
+            const Real* xm = x - stride;
+            const Real* xp = x + stride;
+            for (Size i=0; i<n; ++i)
+                y[i] = xm[i]*lower[i] + x[i]*diag[i] + xp[i]*upper[i];
+        }
+
+        QL_VECTOR_KERNEL
+        bool tridiagonalSolve(Size n, Size stride, Size width,
+                              Real a, Real b,
+                              const Real* lower, const Real* diag,
+                              const Real* upper, const Real* r,
+                              Real* y, Real* work) {
+            // Thomas algorithm; r[i] is read before y[i] is written
+            int singular = 0;
+            for (Size j=0; j<width; ++j) {
+                const Real den = a*diag[j]+b;
+                singular |= (den == 0.0);
+                const Real bet = 1.0/den;
+                y[j] = r[j]*bet;
+                if (n > 1)
+                    work[stride+j] = a*upper[j]*bet;
+            }
+            for (Size k=1; k<n; ++k) {
+                const bool last = (k == n-1);
+                const Size row = k*stride;
+                for (Size i=row; i<row+width; ++i) {
+                    const Real den = b+a*(diag[i]-work[i]*lower[i]);
+                    singular |= (den == 0.0);
+                    const Real bet = 1.0/den;
+                    y[i] = (r[i]-a*lower[i]*y[i-stride])*bet;
+                    if (!last)
+                        work[i+stride] = a*upper[i]*bet;
+                }
+            }
+            for (Size k=n-1; k-- > 0;) {
+                const Size row = k*stride;
+                for (Size i=row; i<row+width; ++i)
+                    y[i] -= work[i+stride]*y[i+stride];
+            }
+            return singular == 0;
+        }
+
+    }
+
+}
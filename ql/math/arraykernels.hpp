@@ -0,0 +1,268 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file arraykernels.hpp
+    \brief vectorised kernels for arrays and matrices
+*/
+
+#ifndef quantlib_array_kernels_hpp
+#define quantlib_array_kernels_hpp
+
+#include <ql/types.hpp>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        /*! \name Array and matrix kernels
+
+            These are the loops used by the Array and Matrix operators.
+            They are compiled out of line so that, with gcc on x86
+            platforms, each of them is cloned for the AVX-512, AVX2 and
+            baseline instruction sets, and the clone to be used is
+            selected at run time according to the capabilities of the
+            processor.  With other compilers, the loops are vectorised
+            for the instruction set given at compile time, provided
+            that the optimization level enables vectorisation.
+
+            The element-wise kernels allow the output to coincide with
+            any of the inputs.  Reductions, including the ones in
+            matrix products, sum the terms in their natural order;
+            therefore, the results are the same for every instruction
+            set.  If the library is compiled with QL_USE_BLAS defined,
+            matrix products are delegated to a CBLAS library instead,
+            and the order of the summations is decided by the latter.
+
+            Matrices are passed as row-major arrays of contiguous
+            elements.
+        */
+        //@{
+        /*! size from which vectorAxpy and the finite-difference
+            operators split their loops among OpenMP threads; below
+            it, starting the threads costs more than it saves.
+        */
+        const Size parallelThreshold = 16384;
+
+        /*! arrays shorter than this are processed by inline loops
+            rather than by the out-of-line kernels, whose call would
+            cost more than their vectorisation saves; the results are
+            the same either way.
+        */
+        const Size inlineKernelSize = 16;
+
+        namespace kernels {
+
+            void vectorAdd(Size n, const Real* x, const Real* y, Real* z);
+            void vectorSubtract(Size n, const Real* x, const Real* y, Real* z);
+            void vectorMultiply(Size n, const Real* x, const Real* y, Real* z);
+            void vectorDivide(Size n, const Real* x, const Real* y, Real* z);
+            void vectorAdd(Size n, const Real* x, Real a, Real* z);
+            void vectorSubtract(Size n, const Real* x, Real a, Real* z);
+            void vectorSubtract(Size n, Real a, const Real* x, Real* z);
+            void vectorMultiply(Size n, const Real* x, Real a, Real* z);
+            void vectorDivide(Size n, const Real* x, Real a, Real* z);
+            void vectorDivide(Size n, Real a, const Real* x, Real* z);
+            void vectorNegate(Size n, const Real* x, Real* z);
+        }
+
+        //! \f$ z_i = x_i + y_i \f$
+        inline void vectorAdd(Size n, const Real* x, const Real* y, Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = x[i] + y[i];
+            } else {
+                kernels::vectorAdd(n, x, y, z);
+            }
+        }
+
+        //! \f$ z_i = x_i - y_i \f$
+        inline void vectorSubtract(Size n, const Real* x, const Real* y,
+                                   Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = x[i] - y[i];
+            } else {
+                kernels::vectorSubtract(n, x, y, z);
+            }
+        }
+
+        //! \f$ z_i = x_i y_i \f$
+        inline void vectorMultiply(Size n, const Real* x, const Real* y,
+                                   Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = x[i] * y[i];
+            } else {
+                kernels::vectorMultiply(n, x, y, z);
+            }
+        }
+
+        //! \f$ z_i = x_i / y_i \f$
+        inline void vectorDivide(Size n, const Real* x, const Real* y,
+                                 Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = x[i] / y[i];
+            } else {
+                kernels::vectorDivide(n, x, y, z);
+            }
+        }
+
+        //! \f$ z_i = x_i + a \f$
+        inline void vectorAdd(Size n, const Real* x, Real a, Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = x[i] + a;
+            } else {
+                kernels::vectorAdd(n, x, a, z);
+            }
+        }
+
+        //! \f$ z_i = x_i - a \f$
+        inline void vectorSubtract(Size n, const Real* x, Real a, Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = x[i] - a;
+            } else {
+                kernels::vectorSubtract(n, x, a, z);
+            }
+        }
+
+        //! \f$ z_i = a - x_i \f$
+        inline void vectorSubtract(Size n, Real a, const Real* x, Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = a - x[i];
+            } else {
+                kernels::vectorSubtract(n, a, x, z);
+            }
+        }
+
+        //! \f$ z_i = a x_i \f$
+        inline void vectorMultiply(Size n, const Real* x, Real a, Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = x[i] * a;
+            } else {
+                kernels::vectorMultiply(n, x, a, z);
+            }
+        }
+
+        //! \f$ z_i = x_i / a \f$
+        inline void vectorDivide(Size n, const Real* x, Real a, Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = x[i] / a;
+            } else {
+                kernels::vectorDivide(n, x, a, z);
+            }
+        }
+
+        //! \f$ z_i = a / x_i \f$
+        inline void vectorDivide(Size n, Real a, const Real* x, Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = a / x[i];
+            } else {
+                kernels::vectorDivide(n, a, x, z);
+            }
+        }
+
+        //! \f$ z_i = -x_i \f$
+        inline void vectorNegate(Size n, const Real* x, Real* z) {
+            if (n < inlineKernelSize) {
+                for (Size i=0; i<n; ++i)
+                    z[i] = -x[i];
+            } else {
+                kernels::vectorNegate(n, x, z);
+            }
+        }
+
+        //! \f$ \sum_i x_i y_i \f$
+        Real vectorDotProduct(Size n, const Real* x, const Real* y);
+        /*! \f$ z_i = y_i + a x_i \f$, split among OpenMP threads
+            for at least parallelThreshold elements.  This is the
+            update performed at each stage of the ADI schemes; calling
+            it on arrays kept by the caller avoids the temporaries of
+            the corresponding array expression, which it reproduces
+            exactly.
+        */
+        void vectorAxpy(Size n, Real a, const Real* x, const Real* y,
+                        Real* z);
+        /*! \f$ z = M v \f$ for a \f$ m \times n \f$ matrix; the
+            output must not coincide with the input.
+        */
+        void matrixVectorProduct(Size m, Size n,
+                                 const Real* M, const Real* v, Real* z);
+        /*! \f$ z = v M \f$ for a \f$ m \times n \f$ matrix; the
+            output must not coincide with the input.
+        */
+        void vectorMatrixProduct(Size m, Size n,
+                                 const Real* v, const Real* M, Real* z);
+        /*! \f$ C = A B \f$ for a \f$ m \times k \f$ matrix \f$ A \f$
+            and a \f$ k \times n \f$ matrix \f$ B \f$; the output
+            must not coincide with the inputs.  Without BLAS, the
+            product is blocked so that the rows of \f$ B \f$ being
+            used stay in cache.
+        */
+        void matrixProduct(Size m, Size k, Size n,
+                           const Real* A, const Real* B, Real* C);
+        /*! \f$ y_i = \sum_k a_k x_{c_k} \f$ for the rows
+            \f$ i \f$ in [begin, end) of a matrix in compressed-row
+            storage, the sum running over the positions from
+            rowStarts[i] to rowStarts[i+1]; the output must not
+            coincide with the input.
+        */
+        void sparseMatrixVectorProduct(Size begin, Size end,
+                                       const Size* rowStarts,
+                                       const Size* columnIndices,
+                                       const Real* values,
+                                       const Real* x, Real* y);
+        /*! \f$ y_i = l_i x_{i-s} + d_i x_i + u_i x_{i+s} \f$ for
+            \f$ i \f$ in [0, n), where \f$ s \f$ is the given stride;
+            x must be accessible from \f$ -s \f$ to \f$ n+s-1 \f$.
+            The output must not coincide with the input.
+        */
+        void tripleBandProduct(Size n, Size stride,
+                               const Real* lower, const Real* diag,
+                               const Real* upper, const Real* x, Real* y);
+        /*! solves \f$ (a T + b I) y = r \f$ for a number of
+            tridiagonal systems \f$ T \f$ of size n stored
+            interleaved: element \f$ k \f$ of system \f$ j \f$,
+            with \f$ j \f$ in [0, width), is at position
+            \f$ k \cdot stride + j \f$ of each array.  The loops run
+            across the systems, so that they vectorise when
+            width > 1.  The lower element of the first row and the
+            upper element of the last row of each system are not used.
+
+            The intermediate coefficients are stored in work; y can
+            coincide with r.  The function returns false if a null
+            pivot was found.
+        */
+        bool tridiagonalSolve(Size n, Size stride, Size width,
+                              Real a, Real b,
+                              const Real* lower, const Real* diag,
+                              const Real* upper, const Real* r,
+                              Real* y, Real* work);
+        //@}
+
+    }
+
+}
+
+
+#endif
@@ -22,6 +22,7 @@
 
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
+#include <algorithm>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -126,6 +127,37 @@ namespace QuantLib {
         return z;
     }
 
+    void InverseCumulativeNormal::standard_values(const Real* x, Real* z,
+                                                  Size n) {
+        Real t[blockSize_], w[blockSize_];
+        for (Size start=0; start<n; start+=blockSize_) {
+            Size m = std::min<Size>(blockSize_, n-start);
+            std::copy(x+start, x+start+m, t);
+            std::fill(t+m, t+blockSize_, 0.5);
+
+            // the central approximation is applied to the whole
+            // block, without branches, so that it can be vectorized...
+            for (Size i=0; i<blockSize_; ++i) {
+                Real u = t[i] - 0.5;
+                Real r = u*u;
+                w[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*u /
+                    (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+            }
+
+            // ...and the values in the tails are replaced afterwards
+            for (Size i=0; i<m; ++i) {
+                if (t[i] < x_low_ || x_high_ < t[i])
+                    w[i] = tail_value(t[i]);
+                #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+                const Real r = (f_(w[i]) - t[i]) * M_SQRT2 * M_SQRTPI
+                             * exp(0.5 * w[i]*w[i]);
+                w[i] -= r/(1+0.5*w[i]*r);
+                #endif
+                z[start+i] = w[i];
+            }
+        }
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
@@ -161,22 +193,58 @@ namespace QuantLib {
                 (((a3_*result+a2_)*result+a1_)*result+a0_) /
                 ((((b3_*result+b2_)*result+b1_)*result+b0_)*result+1.0);
         } else {
-            // improved approximation for the tail (Moro 1995)
-            if (x<0.5)
-                result = x;
-            else
-                result=1.0-x;
-            result = std::log(-std::log(result));
-            result = c0_+result*(c1_+result*(c2_+result*(c3_+result*
-                                   (c4_+result*(c5_+result*(c6_+result*
-                                                       (c7_+result*c8_)))))));
-            if (x<0.5)
-                result=-result;
+            result = tail_value(x);
         }
 
         return average_ + result*sigma_;
     }
 
+    void MoroInverseCumulativeNormal::standard_values(const Real* x, Real* z,
+                                                      Size n) {
+        Real t[blockSize_], w[blockSize_];
+        for (Size start=0; start<n; start+=blockSize_) {
+            Size m = std::min<Size>(blockSize_, n-start);
+            std::copy(x+start, x+start+m, t);
+            std::fill(t+m, t+blockSize_, 0.5);
+
+            // Beasley and Springer on the whole block...
+            for (Size i=0; i<blockSize_; ++i) {
+                Real temp = t[i]-0.5;
+                Real r = temp*temp;
+                w[i] = temp*
+                    (((a3_*r+a2_)*r+a1_)*r+a0_) /
+                    ((((b3_*r+b2_)*r+b1_)*r+b0_)*r+1.0);
+            }
+
+            // ...and Moro's approximation for the tails
+            for (Size i=0; i<m; ++i) {
+                if (!(std::fabs(t[i]-0.5) < 0.42)) {
+                    QL_REQUIRE(t[i] > 0.0 && t[i] < 1.0,
+                               "MoroInverseCumulativeNormal(" << t[i]
+                               << ") undefined: must be 0<x<1");
+                    w[i] = tail_value(t[i]);
+                }
+                z[start+i] = w[i];
+            }
+        }
+    }
+
+    Real MoroInverseCumulativeNormal::tail_value(Real x) {
+        // improved approximation for the tail (Moro 1995)
+        Real result;
+        if (x<0.5)
+            result = x;
+        else
+            result=1.0-x;
+        result = std::log(-std::log(result));
+        result = c0_+result*(c1_+result*(c2_+result*(c3_+result*
+                               (c4_+result*(c5_+result*(c6_+result*
+                                                   (c7_+result*c8_)))))));
+        if (x<0.5)
+            result=-result;
+        return result;
+    }
+
     MaddockInverseCumulativeNormal::MaddockInverseCumulativeNormal(
         Real average, Real sigma)
     : average_(average), sigma_(sigma) {}
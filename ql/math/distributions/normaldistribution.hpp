@@ -97,6 +97,12 @@ namespace QuantLib {
       in this case the traditional Box-Muller approach and its
       variants would not preserve the sequence's low-discrepancy.
 
+      Ranges of values can be transformed at once; in this case,
+      the rational approximation for the central region is applied
+      to fixed-size blocks of values without branching, so that the
+      compiler can vectorize it, and only the values in the tails
+      are corrected afterwards.  The results are the same as the
+      ones returned for single values.
     */
     class InverseCumulativeNormal
         : public std::unary_function<Real,Real> {
@@ -107,6 +113,20 @@ namespace QuantLib {
         Real operator()(Real x) const {
             return average_ + sigma_*standard_value(x);
         }
+        //! transforms the values in [begin,end); can work in place
+        template <class InputIterator, class OutputIterator>
+        void operator()(InputIterator begin, InputIterator end,
+                        OutputIterator out) const {
+            Real x[blockSize_], z[blockSize_];
+            while (begin != end) {
+                Size n = 0;
+                for (; n<blockSize_ && begin != end; ++n, ++begin)
+                    x[n] = *begin;
+                standard_values(x, z, n);
+                for (Size i=0; i<n; ++i, ++out)
+                    *out = average_ + sigma_*z[i];
+            }
+        }
         // value for average=0, sigma=1
         /* Compared to operator(), this method avoids 2 floating point
            operations (we use average=0 and sigma=1 most of the
@@ -136,6 +156,8 @@ namespace QuantLib {
 
             return z;
         }
+        //! values for average=0, sigma=1 of the given n inputs
+        static void standard_values(const Real* x, Real* z, Size n);
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
@@ -143,6 +165,7 @@ namespace QuantLib {
            inlined.
         */
         static Real tail_value(Real x);
+        static const Size blockSize_ = 64;
         #if defined(QL_PATCH_SOLARIS)
         CumulativeNormalDistribution f_;
         #else
@@ -196,6 +219,9 @@ namespace QuantLib {
 
         Peter J. Acklam's approximation is better and is available
         as QuantLib::InverseCumulativeNormal
+
+        As for the latter, ranges of values can be transformed at
+        once with the same results.
     */
     class MoroInverseCumulativeNormal
     : public std::unary_function<Real,Real> {
@@ -204,7 +230,25 @@ namespace QuantLib {
                                     Real sigma   = 1.0);
         // function
         Real operator()(Real x) const;
+        //! transforms the values in [begin,end); can work in place
+        template <class InputIterator, class OutputIterator>
+        void operator()(InputIterator begin, InputIterator end,
+                        OutputIterator out) const {
+            Real x[blockSize_], z[blockSize_];
+            while (begin != end) {
+                Size n = 0;
+                for (; n<blockSize_ && begin != end; ++n, ++begin)
+                    x[n] = *begin;
+                standard_values(x, z, n);
+                for (Size i=0; i<n; ++i, ++out)
+                    *out = average_ + z[i]*sigma_;
+            }
+        }
+        //! values for average=0, sigma=1 of the given n inputs
+        static void standard_values(const Real* x, Real* z, Size n);
       private:
+        static Real tail_value(Real x);
+        static const Size blockSize_ = 64;
         Real average_, sigma_;
         static const Real a0_;
         static const Real a1_;
@@ -35,6 +35,12 @@ namespace QuantLib {
     /*! This class implements the concept of Matrix as used in linear
         algebra. As such, it is <b>not</b> meant to be used as a
         container.
+
+        Elements are stored by rows in a buffer aligned to 64 bytes;
+        products with matrices and vectors are performed by the
+        kernels declared in arraykernels.hpp.
+
+        \test products are checked against straightforward loops.
     */
     class Matrix {
       public:
@@ -55,8 +61,14 @@ namespace QuantLib {
         Matrix(Size rows, Size columns, Iterator begin, Iterator end);
         Matrix(const Matrix &);
         Matrix(const Disposable<Matrix>&);
+        #if defined(QL_HAS_RVALUE_REFERENCES)
+        Matrix(Matrix&&);
+        #endif
         Matrix& operator=(const Matrix&);
         Matrix& operator=(const Disposable<Matrix>&);
+        #if defined(QL_HAS_RVALUE_REFERENCES)
+        Matrix& operator=(Matrix&&);
+        #endif
         //@}
 
         //! \name Algebraic operators
@@ -137,7 +149,7 @@ namespace QuantLib {
         void swap(Matrix&);
         //@}
       private:
-        boost::scoped_array<Real> data_;
+        AlignedBuffer<Real> data_;
         Size rows_, columns_;
     };
 
@@ -154,6 +166,34 @@ namespace QuantLib {
     /*! \relates Matrix */
     const Disposable<Matrix> operator/(const Matrix&, Real);
 
+    /* The overloads below write their result in the storage of
+       their disposable argument instead of allocating a new
+       matrix; see DisposableRvalue for the arguments they accept. */
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator+(DisposableRvalue<Matrix>::type,
+                                       const Matrix&);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator+(const Matrix&,
+                                       DisposableRvalue<Matrix>::type);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator+(DisposableRvalue<Matrix>::type,
+                                       DisposableRvalue<Matrix>::type);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator-(DisposableRvalue<Matrix>::type,
+                                       const Matrix&);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator-(const Matrix&,
+                                       DisposableRvalue<Matrix>::type);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator-(DisposableRvalue<Matrix>::type,
+                                       DisposableRvalue<Matrix>::type);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator*(DisposableRvalue<Matrix>::type, Real);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator*(Real, DisposableRvalue<Matrix>::type);
+    /*! \relates Matrix */
+    const Disposable<Matrix> operator/(DisposableRvalue<Matrix>::type, Real);
+
 
     // vectorial products
 
@@ -192,14 +232,14 @@ namespace QuantLib {
     // inline definitions
 
     inline Matrix::Matrix()
-    : data_((Real*)(0)), rows_(0), columns_(0) {}
+    : data_(), rows_(0), columns_(0) {}
 
     inline Matrix::Matrix(Size rows, Size columns)
-    : data_(rows*columns > 0 ? new Real[rows*columns] : (Real*)(0)),
+    : data_(rows*columns),
       rows_(rows), columns_(columns) {}
 
     inline Matrix::Matrix(Size rows, Size columns, Real value)
-    : data_(rows*columns > 0 ? new Real[rows*columns] : (Real*)(0)),
+    : data_(rows*columns),
       rows_(rows), columns_(columns) {
         std::fill(begin(),end(),value);
     }
@@ -207,13 +247,13 @@ namespace QuantLib {
     template <class Iterator>
     inline Matrix::Matrix(Size rows, Size columns,
                           Iterator begin, Iterator end)
-        : data_(rows * columns > 0 ? new Real[rows * columns] : (Real *)(0)),
+        : data_(rows*columns),
           rows_(rows), columns_(columns) {
         std::copy(begin, end, this->begin());
     }
 
     inline Matrix::Matrix(const Matrix& from)
-    : data_(!from.empty() ? new Real[from.rows_*from.columns_] : (Real*)(0)),
+    : data_(from.rows_*from.columns_),
       rows_(from.rows_), columns_(from.columns_) {
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
         if (!from.empty())
@@ -222,10 +262,17 @@ namespace QuantLib {
     }
 
     inline Matrix::Matrix(const Disposable<Matrix>& from)
-    : data_((Real*)(0)), rows_(0), columns_(0) {
+    : data_(), rows_(0), columns_(0) {
         swap(const_cast<Disposable<Matrix>&>(from));
     }
 
+    #if defined(QL_HAS_RVALUE_REFERENCES)
+    inline Matrix::Matrix(Matrix&& from)
+    : data_(), rows_(0), columns_(0) {
+        swap(from);
+    }
+    #endif
+
     inline Matrix& Matrix::operator=(const Matrix& from) {
         // strong guarantee
         Matrix temp(from);
@@ -238,6 +285,13 @@ namespace QuantLib {
         return *this;
     }
 
+    #if defined(QL_HAS_RVALUE_REFERENCES)
+    inline Matrix& Matrix::operator=(Matrix&& from) {
+        swap(from);
+        return *this;
+    }
+    #endif
+
     inline void Matrix::swap(Matrix& from) {
         using std::swap;
         data_.swap(from.data_);
@@ -251,8 +305,7 @@ namespace QuantLib {
                    m.rows_ << "x" << m.columns_ << ", " <<
                    rows_ << "x" << columns_ << ") cannot be "
                    "added");
-        std::transform(begin(),end(),m.begin(),
-                       begin(),std::plus<Real>());
+        detail::vectorAdd(rows_*columns_, begin(), m.begin(), begin());
         return *this;
     }
 
@@ -262,20 +315,17 @@ namespace QuantLib {
                    m.rows_ << "x" << m.columns_ << ", " <<
                    rows_ << "x" << columns_ << ") cannot be "
                    "subtracted");
-        std::transform(begin(),end(),m.begin(),begin(),
-                       std::minus<Real>());
+        detail::vectorSubtract(rows_*columns_, begin(), m.begin(), begin());
         return *this;
     }
 
     inline const Matrix& Matrix::operator*=(Real x) {
-        std::transform(begin(),end(),begin(),
-                       std::bind2nd(std::multiplies<Real>(),x));
+        detail::vectorMultiply(rows_*columns_, begin(), x, begin());
         return *this;
     }
 
     inline const Matrix& Matrix::operator/=(Real x) {
-        std::transform(begin(),end(),begin(),
-                       std::bind2nd(std::divides<Real>(),x));
+        detail::vectorDivide(rows_*columns_, begin(), x, begin());
         return *this;
     }
 
@@ -370,7 +420,7 @@ namespace QuantLib {
     Matrix::column_begin(Size i) const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(i<columns_,
-                   "column index (" << i << ") must be less than " << columns_ <<
+                  "column index (" << i << ") must be less than " << columns_ <<
                    ": matrix cannot be accessed out of range");
         #endif
         return const_column_iterator(data_.get()+i,columns_);
@@ -379,7 +429,7 @@ namespace QuantLib {
     inline Matrix::column_iterator Matrix::column_begin(Size i) {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(i<columns_,
-                   "column index (" << i << ") must be less than " << columns_ <<
+                  "column index (" << i << ") must be less than " << columns_ <<
                    ": matrix cannot be accessed out of range");
         #endif
         return column_iterator(data_.get()+i,columns_);
@@ -389,7 +439,7 @@ namespace QuantLib {
     Matrix::column_end(Size i) const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(i<columns_,
-                   "column index (" << i << ") must be less than " << columns_ <<
+                  "column index (" << i << ") must be less than " << columns_ <<
                    ": matrix cannot be accessed out of range");
         #endif
         return const_column_iterator(data_.get()+i+rows_*columns_,columns_);
@@ -398,7 +448,7 @@ namespace QuantLib {
     inline Matrix::column_iterator Matrix::column_end(Size i) {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(i<columns_,
-                   "column index (" << i << ") must be less than " << columns_ <<
+                  "column index (" << i << ") must be less than " << columns_ <<
                    ": matrix cannot be accessed out of range");
         #endif
         return column_iterator(data_.get()+i+rows_*columns_,columns_);
@@ -485,8 +535,8 @@ namespace QuantLib {
                    m2.rows() << "x" << m2.columns() << ") cannot be "
                    "added");
         Matrix temp(m1.rows(),m1.columns());
-        std::transform(m1.begin(),m1.end(),m2.begin(),temp.begin(),
-                       std::plus<Real>());
+        detail::vectorAdd(m1.rows()*m1.columns(), m1.begin(),
+                          m2.begin(), temp.begin());
         return temp;
     }
 
@@ -499,29 +549,117 @@ namespace QuantLib {
                    m2.rows() << "x" << m2.columns() << ") cannot be "
                    "subtracted");
         Matrix temp(m1.rows(),m1.columns());
-        std::transform(m1.begin(),m1.end(),m2.begin(),temp.begin(),
-                       std::minus<Real>());
+        detail::vectorSubtract(m1.rows()*m1.columns(), m1.begin(),
+                               m2.begin(), temp.begin());
         return temp;
     }
 
     inline const Disposable<Matrix> operator*(const Matrix& m, Real x) {
         Matrix temp(m.rows(),m.columns());
-        std::transform(m.begin(),m.end(),temp.begin(),
-                       std::bind2nd(std::multiplies<Real>(),x));
+        detail::vectorMultiply(m.rows()*m.columns(), m.begin(),
+                               x, temp.begin());
         return temp;
     }
 
     inline const Disposable<Matrix> operator*(Real x, const Matrix& m) {
         Matrix temp(m.rows(),m.columns());
-        std::transform(m.begin(),m.end(),temp.begin(),
-                       std::bind2nd(std::multiplies<Real>(),x));
+        detail::vectorMultiply(m.rows()*m.columns(), m.begin(),
+                               x, temp.begin());
         return temp;
     }
 
     inline const Disposable<Matrix> operator/(const Matrix& m, Real x) {
         Matrix temp(m.rows(),m.columns());
-        std::transform(m.begin(),m.end(),temp.begin(),
-                       std::bind2nd(std::divides<Real>(),x));
+        detail::vectorDivide(m.rows()*m.columns(), m.begin(), x, temp.begin());
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator+(DisposableRvalue<Matrix>::type m1,
+                                              const Matrix& m2) {
+        QL_REQUIRE(m1.rows() == m2.rows() &&
+                   m1.columns() == m2.columns(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "added");
+        Matrix temp = m1;
+        detail::vectorAdd(temp.rows()*temp.columns(), temp.begin(),
+                          m2.begin(), temp.begin());
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator+(const Matrix& m1,
+                                            DisposableRvalue<Matrix>::type m2) {
+        QL_REQUIRE(m1.rows() == m2.rows() &&
+                   m1.columns() == m2.columns(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "added");
+        Matrix temp = m2;
+        detail::vectorAdd(m1.rows()*m1.columns(), m1.begin(),
+                          temp.begin(), temp.begin());
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator+(DisposableRvalue<Matrix>::type m1,
+                                            DisposableRvalue<Matrix>::type m2) {
+        return static_cast<DisposableRvalue<Matrix>::type>(m1)
+            + static_cast<const Matrix&>(m2);
+    }
+
+    inline const Disposable<Matrix> operator-(DisposableRvalue<Matrix>::type m1,
+                                              const Matrix& m2) {
+        QL_REQUIRE(m1.rows() == m2.rows() &&
+                   m1.columns() == m2.columns(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "subtracted");
+        Matrix temp = m1;
+        detail::vectorSubtract(temp.rows()*temp.columns(), temp.begin(),
+                               m2.begin(), temp.begin());
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator-(const Matrix& m1,
+                                            DisposableRvalue<Matrix>::type m2) {
+        QL_REQUIRE(m1.rows() == m2.rows() &&
+                   m1.columns() == m2.columns(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "subtracted");
+        Matrix temp = m2;
+        detail::vectorSubtract(m1.rows()*m1.columns(), m1.begin(),
+                               temp.begin(), temp.begin());
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator-(DisposableRvalue<Matrix>::type m1,
+                                            DisposableRvalue<Matrix>::type m2) {
+        return static_cast<DisposableRvalue<Matrix>::type>(m1)
+            - static_cast<const Matrix&>(m2);
+    }
+
+    inline const Disposable<Matrix> operator*(DisposableRvalue<Matrix>::type m,
+                                              Real x) {
+        Matrix temp = m;
+        temp *= x;
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator*(Real x,
+                                             DisposableRvalue<Matrix>::type m) {
+        Matrix temp = m;
+        temp *= x;
+        return temp;
+    }
+
+    inline const Disposable<Matrix> operator/(DisposableRvalue<Matrix>::type m,
+                                              Real x) {
+        Matrix temp = m;
+        temp /= x;
         return temp;
     }
 
@@ -531,10 +669,8 @@ namespace QuantLib {
                    << v.size() << ", " << m.rows() << "x" << m.columns() <<
                    ") cannot be multiplied");
         Array result(m.columns());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),
-                                   m.column_begin(i),0.0);
+        detail::vectorMatrixProduct(m.rows(), m.columns(),
+                                    v.begin(), m.begin(), result.begin());
         return result;
     }
 
@@ -544,9 +680,8 @@ namespace QuantLib {
                    << v.size() << ", " << m.rows() << "x" << m.columns() <<
                    ") cannot be multiplied");
         Array result(m.rows());
-        for (Size i=0; i<result.size(); i++)
-            result[i] =
-                std::inner_product(v.begin(),v.end(),m.row_begin(i),0.0);
+        detail::matrixVectorProduct(m.rows(), m.columns(),
+                                    m.begin(), v.begin(), result.begin());
         return result;
     }
 
@@ -557,14 +692,9 @@ namespace QuantLib {
                    m1.rows() << "x" << m1.columns() << ", " <<
                    m2.rows() << "x" << m2.columns() << ") cannot be "
                    "multiplied");
-        Matrix result(m1.rows(),m2.columns(),0.0);
-        for (Size i=0; i<result.rows(); ++i) {
-            for (Size k=0; k<m1.columns(); ++k) {
-                for (Size j=0; j<result.columns(); ++j) {
-                    result[i][j] += m1[i][k]*m2[k][j];
-                }
-            }
-        }
+        Matrix result(m1.rows(),m2.columns());
+        detail::matrixProduct(m1.rows(), m1.columns(), m2.columns(),
+                              m1.begin(), m2.begin(), result.begin());
         return result;
     }
 
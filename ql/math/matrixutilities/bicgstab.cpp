@@ -24,6 +24,8 @@
 
 
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <boost/bind.hpp>
 
 namespace QuantLib {
 
@@ -34,6 +36,13 @@ namespace QuantLib {
       maxIter_(maxIter), relTol_(relTol) {
     }
 
+    BiCGstab::BiCGstab(const boost::shared_ptr<CsrMatrix>& A,
+                       Size maxIter, Real relTol,
+                       const BiCGstab::MatrixMult& preConditioner)
+    : A_(boost::bind(&detail::csrProduct, A, _1)), M_(preConditioner),
+      maxIter_(maxIter), relTol_(relTol) {
+    }
+
     BiCGStabResult BiCGstab::solve(const Array& b, const Array& x0) const {
         Real bnorm2 = Norm2(b);
         if (bnorm2 == 0.0) {
@@ -41,11 +50,12 @@ namespace QuantLib {
             return result;
         }
 
-        Array x = ((!x0.empty()) ? x0 : Array(b.size(), 0.0));
+        const Size n = b.size();
+        Array x = ((!x0.empty()) ? x0 : Array(n, 0.0));
         Array r = b - A_(x);
 
         Array rTld = r;
-        Array p, pTld, v, s, sTld, t;
+        Array p(n), pTld, v, s(n), sTld, t;
         Real omega = 1.0;
         Real rho, rhoTld=1.0;
         Real alpha = 0.0, beta;
@@ -59,19 +69,22 @@ namespace QuantLib {
 
            if (i) {
               beta = (rho/rhoTld)*(alpha/omega);
-              p = r + beta*(p - omega*v);
+              for (Size k=0; k<n; ++k)
+                  p[k] = r[k] + beta*(p[k] - omega*v[k]);
            }
            else {
-              p = r;
+              std::copy(r.begin(), r.end(), p.begin());
            }
 
            pTld = ((M_)? M_(p) : p);
            v     = A_(pTld);
 
            alpha = rho/DotProduct(rTld, v);
-           s     = r-alpha*v;
+           for (Size k=0; k<n; ++k)
+               s[k] = r[k] - alpha*v[k];
            if (Norm2(s) < relTol_*bnorm2) {
-              x += alpha*pTld;
+              for (Size k=0; k<n; ++k)
+                  x[k] += alpha*pTld[k];
               error = Norm2(s)/bnorm2;
               break;
            }
@@ -79,8 +92,10 @@ namespace QuantLib {
            sTld = ((M_) ? M_(s) : s);
            t = A_(sTld);
            omega = DotProduct(t,s)/DotProduct(t,t);
-           x += alpha*pTld + omega*sTld;
-           r = s - omega*t;
+           for (Size k=0; k<n; ++k) {
+               x[k] += alpha*pTld[k] + omega*sTld[k];
+               r[k] = s[k] - omega*t[k];
+           }
            error = Norm2(r)/bnorm2;
            rhoTld = rho;
         }
@@ -27,9 +27,12 @@
 
 #include <ql/math/array.hpp>
 #include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace QuantLib {
 
+    class CsrMatrix;
+
     struct BiCGStabResult {
         Size iterations;
         Real error;
@@ -42,6 +45,11 @@ namespace QuantLib {
         
         BiCGstab(const MatrixMult& A, Size maxIter, Real relTol,
                  const MatrixMult& preConditioner = MatrixMult());
+        /*! solver for a system given as a CSR matrix; the matrix
+            is shared, not copied.
+        */
+        BiCGstab(const boost::shared_ptr<CsrMatrix>& A, Size maxIter, Real relTol,
+                 const MatrixMult& preConditioner = MatrixMult());
         
         BiCGStabResult solve(const Array& b, const Array& x0 = Array()) const;
         
@@ -0,0 +1,159 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <ql/math/arraykernels.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        typedef std::pair<Size, Real> entry;
+
+        struct column_less {
+            bool operator()(const entry& e1, const entry& e2) const {
+                return e1.first < e2.first;
+            }
+        };
+
+        // rows are assigned to threads in blocks of this size
+        const Size rowBlock = 4096;
+
+    }
+
+    CsrMatrix::CsrMatrix(Size rows, Size columns)
+    : rows_(rows), columns_(columns), rowStarts_(rows+1, 0) {}
+
+    CsrMatrix::CsrMatrix(Size rows, Size columns,
+                         const std::vector<Size>& rowIndices,
+                         const std::vector<Size>& columnIndices,
+                         const std::vector<Real>& values)
+    : rows_(rows), columns_(columns), rowStarts_(rows+1, 0) {
+        const Size n = values.size();
+        QL_REQUIRE(rowIndices.size() == n && columnIndices.size() == n,
+                   "mismatch between row indices (" << rowIndices.size()
+                   << "), column indices (" << columnIndices.size()
+                   << ") and values (" << n << ")");
+
+        // entries are bucketed by row...
+        std::vector<Size> starts(rows+1, 0);
+        for (Size k=0; k<n; ++k) {
+            QL_REQUIRE(rowIndices[k] < rows && columnIndices[k] < columns,
+                       "entry (" << rowIndices[k] << ","
+                       << columnIndices[k] << ") out of a "
+                       << rows << "x" << columns << " matrix");
+            ++starts[rowIndices[k]+1];
+        }
+        for (Size i=0; i<rows; ++i)
+            starts[i+1] += starts[i];
+
+        std::vector<entry> entries(n);
+        std::vector<Size> next(starts.begin(), starts.end()-1);
+        for (Size k=0; k<n; ++k)
+            entries[next[rowIndices[k]]++] =
+                std::make_pair(columnIndices[k], values[k]);
+
+        // ...then sorted by column within each row; duplicates are
+        // kept in their original order and summed in that order
+        columnIndices_.reserve(n);
+        values_.reserve(n);
+        for (Size i=0; i<rows; ++i) {
+            std::vector<entry>::iterator begin = entries.begin()+starts[i],
+                                         end = entries.begin()+starts[i+1];
+            std::stable_sort(begin, end, column_less());
+            for (std::vector<entry>::iterator e=begin; e!=end; ++e) {
+                if (e != begin && e->first == columnIndices_.back())
+                    values_.back() += e->second;
+                else {
+                    columnIndices_.push_back(e->first);
+                    values_.push_back(e->second);
+                }
+            }
+            rowStarts_[i+1] = values_.size();
+        }
+    }
+
+    #if !defined(QL_NO_UBLAS_SUPPORT)
+
+    CsrMatrix::CsrMatrix(const SparseMatrix& m)
+    : rows_(m.size1()), columns_(m.size2()), rowStarts_(m.size1()+1, 0) {
+        // compressed_matrix already stores its elements by rows;
+        // the rows after the last filled one are empty
+        const Size filledRows = m.filled1() > 0 ? m.filled1()-1 : 0;
+        const Size n = m.nnz();
+        columnIndices_.assign(m.index2_data().begin(),
+                              m.index2_data().begin()+n);
+        values_.assign(m.value_data().begin(), m.value_data().begin()+n);
+        for (Size i=0; i<filledRows; ++i)
+            rowStarts_[i+1] = m.index1_data()[i+1];
+        for (Size i=filledRows; i<rows_; ++i)
+            rowStarts_[i+1] = n;
+    }
+
+    Disposable<SparseMatrix> CsrMatrix::toSparseMatrix() const {
+        SparseMatrix m(rows_, columns_, values_.size());
+        // elements are appended in order, which doesn't require
+        // any search or reallocation in the ublas storage
+        for (Size i=0; i<rows_; ++i)
+            for (Size k=rowStarts_[i]; k<rowStarts_[i+1]; ++k)
+                m.push_back(i, columnIndices_[k], values_[k]);
+        return m;
+    }
+
+    #endif
+
+    Real CsrMatrix::operator()(Size i, Size j) const {
+        QL_REQUIRE(i < rows_ && j < columns_,
+                   "element (" << i << "," << j << ") out of a "
+                   << rows_ << "x" << columns_ << " matrix");
+        std::vector<Size>::const_iterator
+            begin = columnIndices_.begin()+rowStarts_[i],
+            end = columnIndices_.begin()+rowStarts_[i+1],
+            k = std::lower_bound(begin, end, j);
+        return (k != end && *k == j) ?
+            values_[k-columnIndices_.begin()] : 0.0;
+    }
+
+    void CsrMatrix::apply(const Array& x, Array& y) const {
+        QL_REQUIRE(x.size() == columns_,
+                   "vector of size " << x.size() << " cannot be "
+                   "multiplied by a " << rows_ << "x" << columns_
+                   << " matrix");
+        QL_REQUIRE(&x != &y, "output must not be the input vector");
+        if (y.size() != rows_)
+            y = Array(rows_);
+        if (values_.empty()) {
+            std::fill(y.begin(), y.end(), 0.0);
+            return;
+        }
+
+        const Size* starts = &rowStarts_[0];
+        const Size* indices = &columnIndices_[0];
+        const Real* values = &values_[0];
+        const long blocks = long((rows_ + rowBlock - 1)/rowBlock);
+
+        #pragma omp parallel for if(blocks > 1)
+        for (long b=0; b<blocks; ++b) {
+            const Size begin = Size(b)*rowBlock;
+            const Size end = std::min(begin+rowBlock, rows_);
+            detail::sparseMatrixVectorProduct(begin, end, starts, indices,
+                                              values, x.begin(), y.begin());
+        }
+    }
+
+}
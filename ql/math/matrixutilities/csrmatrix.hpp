@@ -0,0 +1,141 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrmatrix.hpp
+    \brief sparse matrix in compressed-row storage
+*/
+
+#ifndef quantlib_csr_matrix_hpp
+#define quantlib_csr_matrix_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! sparse matrix in compressed-row storage
+    /*! The non-null elements of each row are stored contiguously and
+        sorted by column, and the rows are stored in order; this is
+        the layout used by the ublas \c compressed_matrix behind
+        SparseMatrix, but without its element-access machinery, so
+        that the matrix-vector product and the access to the
+        elements of a row reduce to plain loops over arrays.
+
+        The matrix is immutable once built.  It can be assembled in
+        linear time from a list of entries in any order, in which
+        case duplicate entries are summed, or converted from a
+        SparseMatrix; in the latter case, the elements of each row
+        are in the same order, so that products give the same results
+        as prod(const SparseMatrix&, const Array&).
+
+        The product with a vector is cloned for the available
+        instruction sets as the kernels in arraykernels.hpp; if the
+        library is compiled with OpenMP support, the rows of large
+        matrices are distributed among threads.  The elements of each
+        row are summed in order in both cases.
+
+        \test
+        - products are checked against the ones of the corresponding
+          SparseMatrix for Heston and Heston-Hull-White operators.
+        - assembly from unordered entries is checked.
+    */
+    class CsrMatrix {
+      public:
+        //! \name Constructors
+        //@{
+        //! null matrix
+        CsrMatrix(Size rows = 0, Size columns = 0);
+        /*! builds the matrix from its entries, given in any order;
+            entries with the same indices are summed.
+        */
+        CsrMatrix(Size rows, Size columns,
+                  const std::vector<Size>& rowIndices,
+                  const std::vector<Size>& columnIndices,
+                  const std::vector<Real>& values);
+        #if !defined(QL_NO_UBLAS_SUPPORT)
+        explicit CsrMatrix(const SparseMatrix& m);
+        #endif
+        //@}
+        //! \name Inspectors
+        //@{
+        Size rows() const { return rows_; }
+        Size columns() const { return columns_; }
+        //! number of stored elements
+        Size nonZeros() const { return values_.size(); }
+        //! element (i,j); null if not stored
+        Real operator()(Size i, Size j) const;
+        /*! positions in columnIndices() and values() of the first
+            element of each row; the last one is nonZeros().
+        */
+        const std::vector<Size>& rowStarts() const { return rowStarts_; }
+        const std::vector<Size>& columnIndices() const {
+            return columnIndices_;
+        }
+        const std::vector<Real>& values() const { return values_; }
+        //@}
+        //! \name Algebra
+        //@{
+        //! writes \f$ A x \f$ into y, which is resized if needed
+        void apply(const Array& x, Array& y) const;
+        #if !defined(QL_NO_UBLAS_SUPPORT)
+        //! converts to ublas storage
+        Disposable<SparseMatrix> toSparseMatrix() const;
+        #endif
+        //@}
+        void swap(CsrMatrix&);
+      private:
+        Size rows_, columns_;
+        std::vector<Size> rowStarts_, columnIndices_;
+        std::vector<Real> values_;
+    };
+
+
+    // inline definitions
+
+    //! product of a CSR matrix and a vector
+    /*! \relates CsrMatrix */
+    inline Disposable<Array> prod(const CsrMatrix& A, const Array& x) {
+        Array y(A.rows());
+        A.apply(x, y);
+        return y;
+    }
+
+    namespace detail {
+
+        // not overloaded, so that it can be bound to a MatrixMult
+        inline Disposable<Array> csrProduct(
+                                  const boost::shared_ptr<CsrMatrix>& A,
+                                  const Array& x) {
+            return prod(*A, x);
+        }
+
+    }
+
+    inline void CsrMatrix::swap(CsrMatrix& m) {
+        std::swap(rows_, m.rows_);
+        std::swap(columns_, m.columns_);
+        rowStarts_.swap(m.rowStarts_);
+        columnIndices_.swap(m.columnIndices_);
+        values_.swap(m.values_);
+    }
+
+}
+
+
+#endif
@@ -24,8 +24,10 @@
 
 #include <ql/math/functional.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/qrdecomposition.hpp>
 
+#include <boost/bind.hpp>
 #include <numeric>
 
 namespace QuantLib {
@@ -39,6 +41,15 @@ namespace QuantLib {
         QL_REQUIRE(maxIter_ > 0, "maxIter must be greater then zero");
     }
 
+    GMRES::GMRES(const boost::shared_ptr<CsrMatrix>& A,
+                 Size maxIter, Real relTol,
+                 const GMRES::MatrixMult& preConditioner)
+    : A_(boost::bind(&detail::csrProduct, A, _1)), M_(preConditioner),
+      maxIter_(maxIter), relTol_(relTol) {
+
+        QL_REQUIRE(maxIter_ > 0, "maxIter must be greater then zero");
+    }
+
     GMRESResult GMRES::solve(const Array& b, const Array& x0) const {
         const GMRESResult result = solveImpl(b, x0);
 
@@ -73,7 +84,8 @@ namespace QuantLib {
             return result;
         }
 
-        Array x = ((!x0.empty()) ? x0 : Array(b.size(), 0.0));
+        const Size n = b.size();
+        Array x = ((!x0.empty()) ? x0 : Array(n, 0.0));
         Array r = b - A_(x);
 
         const Real g = Norm2(r);
@@ -94,9 +106,12 @@ namespace QuantLib {
             h.push_back(Array(maxIter_, 0.0));
             Array w = A_((M_)? M_(v[j]) : v[j]);
 
+            // Gram-Schmidt orthogonalization, updating w in place
             for (Size i=0; i <= j; ++i) {
-                h[i][j] = DotProduct(w, v[i]);
-                w -= h[i][j] * v[i];
+                const Real hij = h[i][j] = DotProduct(w, v[i]);
+                const Array& vi = v[i];
+                for (Size l=0; l < n; ++l)
+                    w[l] -= hij * vi[l];
             }
 
             h[j+1][j] = Norm2(w);
@@ -139,8 +154,12 @@ namespace QuantLib {
                  h[i].begin()+i+1, h[i].begin()+k, y.begin()+i+1, 0.0))/h[i][i];
         }
 
-        Array xm = std::inner_product(
-            v.begin(), v.begin()+k, y.begin(), Array(x.size(), 0.0));
+        Array xm(n, 0.0);
+        for (Size i=0; i < k; ++i) {
+            const Array& vi = v[i];
+            for (Size l=0; l < n; ++l)
+                xm[l] += vi[l] * y[i];
+        }
 
         xm = x + ((M_)? M_(xm) : xm);
 
@@ -26,11 +26,14 @@
 
 #include <ql/math/array.hpp>
 #include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <list>
 
 namespace QuantLib {
 
+    class CsrMatrix;
+
     /*! References:
         Saad, Yousef. 1996, Iterative methods for sparse linear systems,
         http://www-users.cs.umn.edu/~saad/books.html
@@ -57,6 +60,11 @@ namespace QuantLib {
 
         GMRES(const MatrixMult& A, Size maxIter, Real relTol,
                  const MatrixMult& preConditioner = MatrixMult());
+        /*! solver for a system given as a CSR matrix; the matrix
+            is shared, not copied.
+        */
+        GMRES(const boost::shared_ptr<CsrMatrix>& A, Size maxIter, Real relTol,
+              const MatrixMult& preConditioner = MatrixMult());
 
         GMRESResult solve(const Array& b, const Array& x0 = Array()) const;
         GMRESResult solveWithRestart(
@@ -32,25 +32,33 @@ namespace QuantLib {
 
     SparseILUPreconditioner::SparseILUPreconditioner(const SparseMatrix& A,
                                                      Integer lfil)
-    : L_(A.size1(),A.size2()),
-      U_(A.size1(),A.size2()) {
+    : U_(A.size1(),A.size2()) {
 
         QL_REQUIRE(A.size1() == A.size2(),
                    "sparse ILU preconditioner works only with square matrices");
 
-        for (SparseMatrix::size_type i=0; i < L_.size1(); ++i)
-            L_(i,i) = 1.0;
+        // the rows of A are read from compressed-row storage, and the
+        // elements of L, which are not read during the factorization,
+        // are collected and assembled at the end
+        const CsrMatrix a(A);
+        std::vector<Size> lRows, lColumns;
+        std::vector<Real> lValues;
+        for (Size i=0; i < A.size1(); ++i) {
+            lRows.push_back(i);
+            lColumns.push_back(i);
+            lValues.push_back(1.0);
+        }
 
         const Integer n = A.size1();
-        std::set<Integer> lBandSet, uBandSet;
+        std::set<Integer> uBandSet;
 
         compressed_matrix<Integer> levs(n,n);
         Integer lfilp = lfil + 1;
 
         for (Integer ii=0; ii<n; ++ii) {
-            Array w(n);
-            for(Integer k=0; k<n; ++k) {
-                w[k] = A(ii,k);
+            Array w(n, 0.0);
+            for (Size k=a.rowStarts()[ii]; k<a.rowStarts()[ii+1]; ++k) {
+                w[a.columnIndices()[k]] = a.values()[k];
             }
 
             std::vector<Integer> levii(n, 0);
@@ -132,8 +140,9 @@ namespace QuantLib {
             for (Size k=0; k<wNonZeros.size(); ++k) {
                 Integer j = wNonZeros[k];
                 if (j < ii) {
-                    L_(ii,j) = wNonZeroEntries[k];
-                    lBandSet.insert(ii-j);
+                    lRows.push_back(ii);
+                    lColumns.push_back(j);
+                    lValues.push_back(wNonZeroEntries[k]);
                 }
                 else {
                     U_(ii,j) = wNonZeroEntries[k];
@@ -144,10 +153,9 @@ namespace QuantLib {
                 }
             }
         }
-        lBands_.resize(lBandSet.size());
-        uBands_.resize(uBandSet.size());
-        std::copy(lBandSet.begin(), lBandSet.end(), lBands_.begin());
-        std::copy(uBandSet.begin(), uBandSet.end(), uBands_.begin());
+        lCsr_ = CsrMatrix(n, n, lRows, lColumns, lValues);
+        L_ = lCsr_.toSparseMatrix();
+        uCsr_ = CsrMatrix(U_);
     }
 
     const SparseMatrix& SparseILUPreconditioner::L() const {
@@ -164,30 +172,35 @@ namespace QuantLib {
 
     Disposable<Array> SparseILUPreconditioner::forwardSolve(
                                                        const Array& b) const {
-        Integer n = b.size();
+        // the elements of each row are visited by increasing column;
+        // the diagonal is the last one
+        const std::vector<Size>& starts = lCsr_.rowStarts();
+        const std::vector<Size>& columns = lCsr_.columnIndices();
+        const std::vector<Real>& values = lCsr_.values();
+        Size n = b.size();
         Array y(n, 0.0);
-        y[0]=b[0]/L_(0,0);
-        for (Integer i=1; i<=n-1; ++i) {
-            y[i] = b[i]/L_(i,i);
-            for (Integer j=lBands_.size()-1;
-                 j>=0 && i-Integer(lBands_[j]) <= i-1; --j) {
-                const Integer k = i-Integer(lBands_[j]);
-                if (k >= 0)
-                    y[i]-=L_(i,k)*y[k]/L_(i,i);
-            }
+        for (Size i=0; i<n; ++i) {
+            const Real diagonal = lCsr_(i,i);
+            y[i] = b[i]/diagonal;
+            for (Size k=starts[i]; k<starts[i+1] && columns[k]<i; ++k)
+                y[i] -= values[k]*y[columns[k]]/diagonal;
         }
         return y;
     }
 
     Disposable<Array> SparseILUPreconditioner::backwardSolve(
                                                        const Array& y) const {
+        const std::vector<Size>& starts = uCsr_.rowStarts();
+        const std::vector<Size>& columns = uCsr_.columnIndices();
+        const std::vector<Real>& values = uCsr_.values();
         Size n = y.size();
         Array x(n, 0.0);
-        x[n-1] = y[n-1]/U_(n-1,n-1);
-        for (Integer i=n-2; i>=0; --i) {
-            x[i] = y[i]/U_(i,i);
-            for (Size j=0; j<uBands_.size() && i+uBands_[j] <= n-1; ++j) {
-                x[i] -= U_(i,i+uBands_[j])*x[i+uBands_[j]]/U_(i,i);
+        for (Integer i=n-1; i>=0; --i) {
+            const Real diagonal = uCsr_(i,i);
+            x[i] = y[i]/diagonal;
+            for (Size k=starts[i]; k<starts[i+1]; ++k) {
+                if (columns[k] > Size(i))
+                    x[i] -= values[k]*x[columns[k]]/diagonal;
             }
         }
         return x;
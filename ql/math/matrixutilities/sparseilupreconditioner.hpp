@@ -29,13 +29,16 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #if !defined(QL_NO_UBLAS_SUPPORT)
 
 #include <ql/math/array.hpp>
-#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 
 namespace QuantLib {
 
     /*! References:
         Saad, Yousef. 1996, Iterative methods for sparse linear systems,
         http://www-users.cs.umn.edu/~saad/books.html
+
+        The factors are also stored as CSR matrices, on which the
+        forward and backward substitutions of apply() are performed.
     */
     class SparseILUPreconditioner  {
       public:
@@ -48,7 +51,7 @@ namespace QuantLib {
 
       private:
         SparseMatrix L_, U_;
-        std::vector<Size> lBands_, uBands_;
+        CsrMatrix lCsr_, uCsr_;
 
         Disposable<Array> forwardSolve(const Array& b) const;
         Disposable<Array> backwardSolve(const Array& y) const;
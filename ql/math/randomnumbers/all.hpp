@@ -17,6 +17,7 @@
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/ranluxuniformrng.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/randomnumbers/scrambledsobolrsg.hpp>
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/sobolbrownianbridgersg.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
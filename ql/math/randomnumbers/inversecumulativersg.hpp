@@ -26,10 +26,39 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        template <class IC>
+        inline void inverseCumulativeTransform(const IC& ic,
+                                               const std::vector<Real>& x,
+                                               std::vector<Real>& y) {
+            for (Size i=0; i<x.size(); i++)
+                y[i] = ic(x[i]);
+        }
+
+        // the normal distributions can transform the whole sequence
+
+        inline void inverseCumulativeTransform(
+                                       const InverseCumulativeNormal& ic,
+                                       const std::vector<Real>& x,
+                                       std::vector<Real>& y) {
+            ic(x.begin(), x.end(), y.begin());
+        }
+
+        inline void inverseCumulativeTransform(
+                                       const MoroInverseCumulativeNormal& ic,
+                                       const std::vector<Real>& x,
+                                       std::vector<Real>& y) {
+            ic(x.begin(), x.end(), y.begin());
+        }
+
+    }
+
     //! Inverse cumulative random sequence generator
     /*! It uses a sequence of uniform deviate in (0, 1) as the
         source of cumulative distribution values.
@@ -43,8 +72,14 @@ namespace QuantLib {
             USG::sample_type USG::nextSequence() const;
             Size USG::dimension() const;
         \endcode
+        and, if the discard method is used,
+        \code
+            void USG::discard(Size);
+        \endcode
 
-        The inverse cumulative distribution is supplied by IC.
+        The inverse cumulative distribution is supplied by IC; the
+        normal distributions are applied to the whole sequence at
+        once.
 
         Class IC must implement the following interface:
         \code
@@ -62,6 +97,8 @@ namespace QuantLib {
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
+        //! advance the generator as if n sequences had been drawn
+        void discard(Size n) { uniformSequenceGenerator_.discard(n); }
         Size dimension() const { return dimension_; }
       private:
         USG uniformSequenceGenerator_;
@@ -90,9 +127,7 @@ namespace QuantLib {
         typename USG::sample_type sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
-        }
+        detail::inverseCumulativeTransform(ICD_, sample.value, x_.value);
         return x_;
     }
 
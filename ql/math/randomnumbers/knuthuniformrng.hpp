@@ -25,6 +25,7 @@
 #define quantlib_knuth_uniform_rng_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <boost/cstdint.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -50,6 +51,11 @@ namespace QuantLib {
         /*! returns a sample with weight 1.0 containing a random number
           uniformly chosen from (0.0,1.0) */
         sample_type next() const;
+        //! advance the generator as if n numbers had been drawn
+        void discard(boost::uint64_t n) {
+            for (; n>0; --n)
+                next();
+        }
       private:
         static const int KK, LL, TT, QUALITY;
         mutable std::vector<double> ranf_arr_buf;
@@ -25,6 +25,7 @@
 #define quantlib_lecuyer_uniform_rng_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <boost/cstdint.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -46,6 +47,11 @@ namespace QuantLib {
         /*! returns a sample with weight 1.0 containing a random number
              uniformly chosen from (0.0,1.0) */
         sample_type next() const;
+        //! advance the generator as if n numbers had been drawn
+        void discard(boost::uint64_t n) {
+            for (; n>0; --n)
+                next();
+        }
       private:
         mutable long temp1, temp2;
         mutable long y;
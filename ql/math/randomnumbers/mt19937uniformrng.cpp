@@ -68,9 +68,234 @@
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        const Size stateSize = 624;
+        const Size shiftSize = 397;
+        // degree of the characteristic polynomial of the generator
+        const Size mexp = 19937;
+        // below this number of words, twisting is faster than jumping
+        const boost::uint64_t jumpThreshold =
+            static_cast<boost::uint64_t>(1) << 26;
+
+        /* polynomials over GF(2) are stored as bit vectors, the i-th
+           bit being the coefficient of x^i */
+        typedef boost::uint64_t word_type;
+        typedef std::vector<word_type> Polynomial;
+        const Size polynomialWords = mexp/64 + 1;
+
+        bool testBit(const Polynomial& p, Size i) {
+            return ((p[i/64] >> (i%64)) & 1) != 0;
+        }
+
+        void flipBit(Polynomial& p, Size i) {
+            p[i/64] ^= word_type(1) << (i%64);
+        }
+
+        // the 64 bits starting at the given offset
+        word_type extractWord(const Polynomial& p, Size offset) {
+            Size q = offset/64, r = offset%64;
+            word_type x = p[q] >> r;
+            if (r != 0)
+                x |= p[q+1] << (64-r);
+            return x;
+        }
+
+        bool parity(word_type x) {
+            x ^= x >> 32;
+            x ^= x >> 16;
+            x ^= x >> 8;
+            x ^= x >> 4;
+            x ^= x >> 2;
+            x ^= x >> 1;
+            return (x & 1) != 0;
+        }
+
+        // p += q * x^shift
+        void addShifted(Polynomial& p, const Polynomial& q, Size shift) {
+            Size w = shift/64, r = shift%64;
+            for (Size i=0; i+w<p.size() && i<q.size(); ++i) {
+                p[i+w] ^= q[i] << r;
+                if (r != 0 && i+w+1 < p.size())
+                    p[i+w+1] ^= q[i] >> (64-r);
+            }
+        }
+
+        // interleaves the lower 32 bits of x with zeros
+        word_type spreadBits(word_type x) {
+            const word_type m16 = (word_type(0x0000FFFFUL) << 32)|0x0000FFFFUL;
+            const word_type m8  = (word_type(0x00FF00FFUL) << 32)|0x00FF00FFUL;
+            const word_type m4  = (word_type(0x0F0F0F0FUL) << 32)|0x0F0F0F0FUL;
+            const word_type m2  = (word_type(0x33333333UL) << 32)|0x33333333UL;
+            const word_type m1  = (word_type(0x55555555UL) << 32)|0x55555555UL;
+            x &= 0xFFFFFFFFUL;
+            x = (x | (x << 16)) & m16;
+            x = (x | (x << 8)) & m8;
+            x = (x | (x << 4)) & m4;
+            x = (x | (x << 2)) & m2;
+            x = (x | (x << 1)) & m1;
+            return x;
+        }
+
+        /* linear state of the generator, stored as a circular buffer
+           whose oldest word is at the given position; next() performs
+           the same recurrence as twist(), one word at a time. */
+        class LinearState {
+          public:
+            LinearState() : position_(0) {
+                std::fill(mt_, mt_+stateSize, 0UL);
+            }
+            LinearState(const unsigned long* mt) : position_(0) {
+                std::copy(mt, mt+stateSize, mt_);
+            }
+            unsigned long next() {
+                Size i = position_, j = (i+1) % stateSize,
+                     k = (i+shiftSize) % stateSize;
+                unsigned long y = (mt_[i]&0x80000000UL)|(mt_[j]&0x7fffffffUL);
+                mt_[i] = mt_[k] ^ (y >> 1) ^ ((y & 0x1UL) ? 0x9908b0dfUL : 0UL);
+                position_ = j;
+                return mt_[i];
+            }
+            void add(const LinearState& other) {
+                Size i = position_, j = other.position_;
+                for (Size k=0; k<stateSize; ++k) {
+                    mt_[i] ^= other.mt_[j];
+                    if (++i == stateSize) i = 0;
+                    if (++j == stateSize) j = 0;
+                }
+            }
+            // the i-th word in the buffer, starting from the oldest
+            unsigned long word(Size i) const {
+                return mt_[(position_+i) % stateSize];
+            }
+          private:
+            unsigned long mt_[stateSize];
+            Size position_;
+        };
+
+        class JumpPolynomials {
+          public:
+            JumpPolynomials() : shiftedCharPoly_(64) {
+                Polynomial charPoly = characteristicPolynomial();
+                for (Size i=0; i<64; ++i) {
+                    shiftedCharPoly_[i] = Polynomial(polynomialWords+1, 0);
+                    addShifted(shiftedCharPoly_[i], charPoly, i);
+                }
+            }
+            // x^n modulo the characteristic polynomial
+            Polynomial power(boost::uint64_t n) const {
+                Polynomial p(polynomialWords, 0);
+                flipBit(p, 0);
+                Size topBit = 63;
+                while (topBit > 0 && ((n >> topBit) & 1) == 0)
+                    --topBit;
+                for (Size i=topBit+1; i-- > 0; ) {
+                    square(p);
+                    if ((n >> i) & 1)
+                        multiplyByX(p);
+                }
+                return p;
+            }
+          private:
+            /* Berlekamp-Massey algorithm applied to the lowest bits of
+               2*mexp successive words of the generator */
+            static Polynomial characteristicPolynomial() {
+                const Size length = 2*mexp;
+                const Size words = length/64 + 2;
+
+                unsigned long mt[stateSize];
+                mt[0] = 5489UL;
+                for (Size i=1; i<stateSize; ++i)
+                    mt[i] = (1812433253UL * (mt[i-1] ^ (mt[i-1] >> 30)) + i)
+                          & 0xffffffffUL;
+                LinearState state(mt);
+
+                // sequence stored in reverse order
+                Polynomial sequence(words, 0);
+                for (Size k=0; k<length; ++k) {
+                    if (state.next() & 0x1UL)
+                        flipBit(sequence, length-1-k);
+                }
+
+                Polynomial c(words, 0), b(words, 0);
+                flipBit(c, 0);
+                flipBit(b, 0);
+                Size l = 0, m = 1;
+                for (Size k=0; k<length; ++k) {
+                    word_type d = 0;
+                    Size offset = length-1-k;
+                    for (Size w=0; w<=l/64; ++w)
+                        d ^= c[w] & extractWord(sequence, offset+64*w);
+                    if (parity(d)) {
+                        if (2*l <= k) {
+                            Polynomial t = c;
+                            addShifted(c, b, m);
+                            l = k+1-l;
+                            b.swap(t);
+                            m = 1;
+                        } else {
+                            addShifted(c, b, m);
+                            ++m;
+                        }
+                    } else {
+                        ++m;
+                    }
+                }
+                QL_ENSURE(l == mexp,
+                          "wrong degree (" << l << ") of the "
+                          "Mersenne-twister characteristic polynomial");
+
+                // reciprocal of the connection polynomial
+                Polynomial p(polynomialWords, 0);
+                for (Size i=0; i<=l; ++i) {
+                    if (testBit(c, i))
+                        flipBit(p, l-i);
+                }
+                return p;
+            }
+            void reduce(Polynomial& p, Size topBit) const {
+                for (Size i=topBit+1; i-- > mexp; ) {
+                    if (testBit(p, i)) {
+                        Size shift = i - mexp;
+                        const Polynomial& q = shiftedCharPoly_[shift%64];
+                        Size w = shift/64;
+                        for (Size j=0; j<q.size(); ++j)
+                            p[j+w] ^= q[j];
+                    }
+                }
+                p.resize(polynomialWords);
+            }
+            void square(Polynomial& p) const {
+                Polynomial s(2*polynomialWords+1, 0);
+                for (Size i=0; i<polynomialWords; ++i) {
+                    s[2*i] = spreadBits(p[i]);
+                    s[2*i+1] = spreadBits(p[i] >> 32);
+                }
+                reduce(s, 2*(mexp-1));
+                p.swap(s);
+            }
+            void multiplyByX(Polynomial& p) const {
+                p.push_back(0);
+                for (Size i=p.size()-1; i>0; --i)
+                    p[i] = (p[i] << 1) | (p[i-1] >> 63);
+                p[0] <<= 1;
+                reduce(p, mexp);
+            }
+            std::vector<Polynomial> shiftedCharPoly_;
+        };
+
+        const JumpPolynomials& jumpPolynomials() {
+            static const JumpPolynomials polynomials;
+            return polynomials;
+        }
+
+    }
+
     // constant vector a
     const unsigned long MersenneTwisterUniformRng::MATRIX_A = 0x9908b0dfUL;
     // most significant w-r bits
@@ -142,4 +367,44 @@ namespace QuantLib {
         mti = 0;
     }
 
+    void MersenneTwisterUniformRng::discard(boost::uint64_t n) {
+        // words generated by the last twist and not used yet
+        Size available = N - mti;
+        if (n <= available) {
+            mti += static_cast<Size>(n);
+            return;
+        }
+        n -= available;
+        mti = N;
+
+        if (n < jumpThreshold) {
+            for (; n >= N; n -= N)
+                twist();
+            mti = N;
+            if (n > 0) {
+                twist();
+                mti = static_cast<Size>(n);
+            }
+            return;
+        }
+
+        /* the state after n steps is p(T) applied to the current
+           state, T being the one-word transition and p(x) = x^n
+           modulo its characteristic polynomial.  The polynomial is
+           evaluated with Horner's scheme; we use x^(n-1) and apply
+           one more step at the end, since this also discards the
+           bits of the oldest word which don't belong to the state. */
+        Polynomial p = jumpPolynomials().power(n-1);
+        LinearState state(mt), result;
+        for (Size i=mexp; i-- > 0; ) {
+            result.next();
+            if (testBit(p, i))
+                result.add(state);
+        }
+        result.next();
+        for (Size i=0; i<N; ++i)
+            mt[i] = result.word(i);
+        mti = N;
+    }
+
 }
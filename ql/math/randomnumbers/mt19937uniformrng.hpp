@@ -26,6 +26,7 @@
 #define quantlib_mersennetwister_uniform_rng_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <boost/cstdint.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -70,6 +71,17 @@ namespace QuantLib {
             y ^= (y >> 18);
             return y;
         }
+        //! advance the generator as if n numbers had been drawn
+        /*! For large n, the jump is performed in O(log n) operations
+            by multiplying the state by the polynomial x^n modulo the
+            characteristic polynomial of the generator, as described
+            in H. Haramoto, M. Matsumoto, T. Nishimura, F. Panneton
+            and P. L'Ecuyer, "Efficient jump ahead for F2-linear
+            random number generators", INFORMS Journal on Computing
+            20(3), 2008.  This allows one to cut the sequence into
+            non-overlapping blocks for different threads or processes.
+        */
+        void discard(boost::uint64_t n);
       private:
         void seedInitialization(unsigned long seed);
         void twist() const;
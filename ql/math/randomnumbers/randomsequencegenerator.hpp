@@ -26,6 +26,7 @@
 
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
+#include <boost/cstdint.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -43,6 +44,10 @@ namespace QuantLib {
         \code
             unsigned long RNG::nextInt32() const;
         \endcode
+        and if it wants to use the discard method,
+        \code
+            void RNG::discard(boost::uint64_t);
+        \endcode
 
         \warning do not use with low-discrepancy sequence generator.
     */
@@ -83,6 +88,10 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return sequence_;
         }
+        //! advance the generator as if n sequences had been drawn
+        void discard(Size n) {
+            rng_.discard(static_cast<boost::uint64_t>(n)*dimensionality_);
+        }
         Size dimension() const {return dimensionality_;}
       private:
         Size dimensionality_;
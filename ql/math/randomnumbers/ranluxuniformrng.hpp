@@ -26,6 +26,7 @@
 
 #include <ql/methods/montecarlo/sample.hpp>
 #include <boost/random/ranlux.hpp>
+#include <boost/cstdint.hpp>
 
 namespace QuantLib {
 
@@ -52,6 +53,11 @@ namespace QuantLib {
         sample_type next() const {
             return sample_type(ranlux3_(), 1.0);
         }
+        //! advance the generator as if n numbers had been drawn
+        void discard(boost::uint64_t n) {
+            for (; n>0; --n)
+                ranlux3_();
+        }
 
       private:
         mutable boost::ranlux64_3_01 ranlux3_;
@@ -67,6 +73,11 @@ namespace QuantLib {
         sample_type next() const {
             return sample_type(ranlux4_(), 1.0);
         }
+        //! advance the generator as if n numbers had been drawn
+        void discard(boost::uint64_t n) {
+            for (; n>0; --n)
+                ranlux4_();
+        }
 
       private:
         mutable boost::ranlux64_4_01 ranlux4_;
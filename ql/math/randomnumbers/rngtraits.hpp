@@ -31,6 +31,7 @@
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/scrambledsobolrsg.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
@@ -104,6 +105,15 @@ namespace QuantLib {
     typedef GenericLowDiscrepancy<SobolRsg,
                                   InverseCumulativeNormal> LowDiscrepancy;
 
+    //! traits for scrambled low-discrepancy sequence generation
+    /*! The seed passed to the factory selects the scramble; a
+        single scramble doesn't allow an error estimate, which can be
+        obtained from a few independent ones (see RandomizedQmcModel.)
+    */
+    typedef GenericLowDiscrepancy<ScrambledSobolRsg,
+                                  InverseCumulativeNormal>
+                                                  ScrambledLowDiscrepancy;
+
 }
 
 
@@ -0,0 +1,75 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/randomnumbers/scrambledsobolrsg.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+
+namespace QuantLib {
+
+    ScrambledSobolRsg::ScrambledSobolRsg(
+                           Size dimensionality,
+                           unsigned long seed,
+                           SobolRsg::DirectionIntegers directionIntegers)
+    : sobol_(dimensionality, seed, directionIntegers),
+      matrices_(dimensionality, std::vector<boost::uint_least32_t>(32)),
+      digitalShifts_(dimensionality),
+      integerSequence_(dimensionality),
+      sequence_(std::vector<Real>(dimensionality), 1.0) {
+
+        MersenneTwisterUniformRng rng(seed);
+        for (Size k=0; k<dimensionality; ++k) {
+            // the column multiplying bit j has a unit in position j
+            // and random entries in the less significant positions
+            for (Size j=0; j<32; ++j) {
+                boost::uint_least32_t unit = boost::uint_least32_t(1) << j;
+                boost::uint_least32_t random =
+                    boost::uint_least32_t(rng.nextInt32()) & 0xffffffffUL;
+                matrices_[k][j] = unit | (random & (unit-1));
+            }
+            digitalShifts_[k] =
+                boost::uint_least32_t(rng.nextInt32()) & 0xffffffffUL;
+        }
+    }
+
+    const std::vector<boost::uint_least32_t>&
+    ScrambledSobolRsg::nextInt32Sequence() const {
+        const std::vector<boost::uint_least32_t>& v =
+            sobol_.nextInt32Sequence();
+        for (Size k=0; k<integerSequence_.size(); ++k) {
+            const std::vector<boost::uint_least32_t>& m = matrices_[k];
+            boost::uint_least32_t x = v[k], y = digitalShifts_[k];
+            for (Size j=0; x != 0; ++j, x >>= 1) {
+                if (x & 1)
+                    y ^= m[j];
+            }
+            integerSequence_[k] = y;
+        }
+        return integerSequence_;
+    }
+
+    const ScrambledSobolRsg::sample_type&
+    ScrambledSobolRsg::nextSequence() const {
+        const std::vector<boost::uint_least32_t>& v = nextInt32Sequence();
+        // scrambled points can be null; the shift by half a unit in
+        // the last place maps them to the center of their interval,
+        // which is in (0,1)
+        for (Size k=0; k<v.size(); ++k)
+            sequence_.value[k] = (Real(v[k]) + 0.5)/4294967296.0;
+        return sequence_;
+    }
+
+}
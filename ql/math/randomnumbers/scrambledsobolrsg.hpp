@@ -0,0 +1,93 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scrambledsobolrsg.hpp
+    \brief Scrambled Sobol low-discrepancy sequence generator
+*/
+
+#ifndef quantlib_scrambled_sobol_rsg_hpp
+#define quantlib_scrambled_sobol_rsg_hpp
+
+#include <ql/math/randomnumbers/sobolrsg.hpp>
+
+namespace QuantLib {
+
+    //! Scrambled Sobol low-discrepancy sequence generator
+    /*! The integer points of a Sobol sequence are randomized by
+        means of a linear matrix scrambling followed by a digital
+        shift, as described in
+        <i>
+        J. Matoušek, On the L2-discrepancy for anchored boxes,
+        Journal of Complexity 14, pp. 527-556, 1998
+        </i>
+        For each dimension, the binary digits of each point are
+        multiplied (modulo 2) by a random lower-triangular matrix with
+        unit diagonal, and the result is added (modulo 2) to a random
+        digital shift.  Each digit of the result depends on the
+        corresponding digit of the original point and on the more
+        significant ones, as in Owen's nested scrambling; the net
+        properties of the sequence are preserved, while each point is
+        uniformly distributed in the unit hypercube.
+
+        Scrambles obtained with different seeds are independent, so
+        that the dispersion of the results of a few replications can
+        be used to estimate the error of a quasi-Monte Carlo
+        simulation; see RandomizedQmcModel.
+
+        \test
+        - the stratification of the scrambled points is checked.
+        - the independence of different scrambles is checked.
+    */
+    class ScrambledSobolRsg {
+      public:
+        typedef Sample<std::vector<Real> > sample_type;
+        /*! if the given seed is 0, a random seed will be chosen
+            based on clock time.
+        */
+        ScrambledSobolRsg(Size dimensionality,
+                          unsigned long seed = 0,
+                          SobolRsg::DirectionIntegers directionIntegers
+                                                          = SobolRsg::Jaeckel);
+        /*! skip to the n-th sample in the low-discrepancy sequence */
+        void skipTo(boost::uint_least32_t n);
+        /*! advance the sequence as if n samples had been drawn */
+        void discard(boost::uint64_t n);
+        const std::vector<boost::uint_least32_t>& nextInt32Sequence() const;
+        const sample_type& nextSequence() const;
+        const sample_type& lastSequence() const { return sequence_; }
+        Size dimension() const { return sobol_.dimension(); }
+      private:
+        SobolRsg sobol_;
+        // for each dimension, the columns of the scrambling matrix,
+        // indexed by the bit of the unscrambled point they multiply
+        std::vector<std::vector<boost::uint_least32_t> > matrices_;
+        std::vector<boost::uint_least32_t> digitalShifts_;
+        mutable std::vector<boost::uint_least32_t> integerSequence_;
+        mutable sample_type sequence_;
+    };
+
+    inline void ScrambledSobolRsg::skipTo(boost::uint_least32_t n) {
+        sobol_.skipTo(n);
+    }
+
+    inline void ScrambledSobolRsg::discard(boost::uint64_t n) {
+        sobol_.discard(n);
+    }
+
+}
+
+#endif
@@ -53,6 +53,10 @@ namespace QuantLib {
         return seq_;
     }
 
+    void SobolBrownianBridgeRsg::discard(Size n) {
+        gen_.discard(n);
+    }
+
     Size SobolBrownianBridgeRsg::dimension() const {
         return dim_;
     }
@@ -42,6 +42,8 @@ namespace QuantLib {
 
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const;
+        //! advance the generator as if n sequences had been drawn
+        void discard(Size n);
         Size dimension() const;
 
       private:
@@ -27,6 +27,7 @@
 #define quantlib_sobol_ld_rsg_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/errors.hpp>
 #include <boost/cstdint.hpp>
 #include <vector>
 
@@ -120,6 +121,17 @@ namespace QuantLib {
                  DirectionIntegers directionIntegers = Jaeckel);
         /*! skip to the n-th sample in the low-discrepancy sequence */
         void skipTo(boost::uint_least32_t n);
+        /*! advance the sequence as if n samples had been drawn; the
+            integer sequence is rebuilt from the Gray code of the
+            new position, so the cost doesn't depend on n.  This
+            allows to cut the sequence in contiguous blocks to be
+            generated independently.  Afterwards, lastSequence()
+            returns the last of the discarded samples.
+
+            \pre the new position must be within the period of the
+                 sequence, i.e., less than 2^32-1.
+        */
+        void discard(boost::uint64_t n);
         const std::vector<boost::uint_least32_t>& nextInt32Sequence() const;
 
         const SobolRsg::sample_type& nextSequence() const {
@@ -142,6 +154,33 @@ namespace QuantLib {
         std::vector<std::vector<boost::uint_least32_t> > directionIntegers_;
     };
 
+    inline void SobolRsg::discard(boost::uint64_t n) {
+        if (n == 0)
+            return;
+        // index of the next sample to be drawn
+        boost::uint64_t next =
+            firstDraw_ ? sequenceCounter_ : boost::uint64_t(sequenceCounter_)+1;
+        QL_REQUIRE(n < 0xFFFFFFFFUL - next,
+                   "period exceeded: cannot discard " << n
+                   << " samples after " << next << " were drawn");
+        // index of the last discarded sample; as in the regular
+        // sequence, the i-th sample uses the Gray code of i+1
+        boost::uint_least32_t last = boost::uint_least32_t(next + n - 1);
+        boost::uint_least32_t gray = (last+1) ^ ((last+1) >> 1);
+        for (Size k=0; k<dimensionality_; ++k) {
+            integerSequence_[k] = 0;
+            boost::uint_least32_t g = gray;
+            for (Size j=0; g != 0; ++j, g >>= 1) {
+                if (g & 1)
+                    integerSequence_[k] ^= directionIntegers_[k][j];
+            }
+            sequence_.value[k] = integerSequence_[k] * normalizationFactor_;
+        }
+        // the next draw continues from the last discarded sample
+        sequenceCounter_ = last;
+        firstDraw_ = false;
+    }
+
 }
 
 #endif
@@ -44,21 +44,9 @@ namespace QuantLib {
         const Real S = process->x0();
         QL_REQUIRE(S > 0.0, "negative or null underlying given");
 
-        std::vector<std::pair<Time, Real> > intermediateSteps;
-        for (Size i=0; i < dividendSchedule.size()
-            && process->time(dividendSchedule[i]->date()) <= maturity; ++i)
-            intermediateSteps.push_back(
-                std::make_pair(
-                    process->time(dividendSchedule[i]->date()),
-                    dividendSchedule[i]->amount()
-                ) );
-
-        const Size intermediateTimeSteps = std::max<Size>(2, 24.0*maturity);
-        for (Size i=0; i < intermediateTimeSteps; ++i)
-            intermediateSteps.push_back(
-                std::make_pair((i+1)*(maturity/intermediateTimeSteps), 0.0));
-
-        std::sort(intermediateSteps.begin(), intermediateSteps.end());
+        const std::vector<std::pair<Time, Real> > intermediateSteps =
+            FdmBlackScholesMesher::intermediateSteps(
+                                       process, maturity, dividendSchedule);
 
         const Handle<YieldTermStructure> rTS = process->riskFreeRate();
         const Handle<YieldTermStructure> qTS = process->dividendYield();
@@ -120,6 +108,29 @@ namespace QuantLib {
         }
     }
             
+    std::vector<std::pair<Time, Real> >
+    FdmBlackScholesMesher::intermediateSteps(
+        const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        Time maturity, const DividendSchedule& dividendSchedule) {
+
+        std::vector<std::pair<Time, Real> > intermediateSteps;
+        for (Size i=0; i < dividendSchedule.size()
+            && process->time(dividendSchedule[i]->date()) <= maturity; ++i)
+            intermediateSteps.push_back(
+                std::make_pair(
+                    process->time(dividendSchedule[i]->date()),
+                    dividendSchedule[i]->amount()
+                ) );
+
+        const Size intermediateTimeSteps = std::max<Size>(2, 24.0*maturity);
+        for (Size i=0; i < intermediateTimeSteps; ++i)
+            intermediateSteps.push_back(
+                std::make_pair((i+1)*(maturity/intermediateTimeSteps), 0.0));
+
+        std::sort(intermediateSteps.begin(), intermediateSteps.end());
+        return intermediateSteps;
+    }
+
     boost::shared_ptr<GeneralizedBlackScholesProcess> 
     FdmBlackScholesMesher::processHelper(const Handle<Quote>& s0,
                                          const Handle<YieldTermStructure>& rTS,
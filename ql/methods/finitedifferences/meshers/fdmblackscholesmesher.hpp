@@ -49,6 +49,14 @@ namespace QuantLib {
                         = (std::pair<Real, Real>(Null<Real>(), Null<Real>())),
             const DividendSchedule& dividendSchedule = DividendSchedule());
 
+        /*! times and dividend amounts, sorted by time, at which the
+            forward is sampled in order to find the grid boundaries
+        */
+        static std::vector<std::pair<Time, Real> > intermediateSteps(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Time maturity,
+            const DividendSchedule& dividendSchedule = DividendSchedule());
+
         static boost::shared_ptr<GeneralizedBlackScholesProcess> processHelper(
              const Handle<Quote>& s0,
              const Handle<YieldTermStructure>& rTS,
@@ -0,0 +1,161 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmmeshercache.cpp
+*/
+
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercache.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
+
+namespace QuantLib {
+
+    FdmMesherCache::FdmMesherCache(Size capacity)
+    : hestonVarianceMeshers_(capacity), blackScholesMeshers_(capacity),
+      composites_(capacity), hits_(0), misses_(0) {}
+
+    boost::shared_ptr<FdmHestonVarianceMesher>
+    FdmMesherCache::hestonVarianceMesher(
+        Size size,
+        const boost::shared_ptr<HestonProcess>& process,
+        Time maturity, Size tAvgSteps, Real epsilon) {
+
+        Key key;
+        key.push_back(size);
+        key.push_back(maturity);
+        key.push_back(process->v0());
+        key.push_back(process->kappa());
+        key.push_back(process->theta());
+        key.push_back(process->sigma());
+        key.push_back(tAvgSteps);
+        key.push_back(epsilon);
+
+        boost::shared_ptr<FdmHestonVarianceMesher> mesher =
+            hestonVarianceMeshers_.find(key);
+        if (mesher) {
+            ++hits_;
+        } else {
+            ++misses_;
+            mesher = boost::shared_ptr<FdmHestonVarianceMesher>(
+                new FdmHestonVarianceMesher(size, process, maturity,
+                                            tAvgSteps, epsilon));
+            hestonVarianceMeshers_.add(key, mesher);
+        }
+        return mesher;
+    }
+
+    boost::shared_ptr<Fdm1dMesher> FdmMesherCache::blackScholesMesher(
+        Size size,
+        const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        Time maturity, Real strike,
+        Real xMinConstraint, Real xMaxConstraint,
+        Real eps, Real scaleFactor,
+        const std::pair<Real, Real>& cPoint,
+        const DividendSchedule& dividendSchedule) {
+
+        Key key;
+        key.push_back(size);
+        key.push_back(maturity);
+        key.push_back(strike);
+        key.push_back(xMinConstraint);
+        key.push_back(xMaxConstraint);
+        key.push_back(eps);
+        key.push_back(scaleFactor);
+        key.push_back(cPoint.first);
+        key.push_back(cPoint.second);
+        key.push_back(process->x0());
+        key.push_back(process->blackVolatility()->blackVol(maturity, strike));
+
+        // the same values used by the mesher for the forward
+        const std::vector<std::pair<Time, Real> > steps =
+            FdmBlackScholesMesher::intermediateSteps(
+                                       process, maturity, dividendSchedule);
+        for (Size i=0; i < steps.size(); ++i) {
+            key.push_back(steps[i].first);
+            key.push_back(steps[i].second);
+            key.push_back(process->riskFreeRate()->discount(steps[i].first));
+            key.push_back(process->dividendYield()->discount(steps[i].first));
+        }
+
+        boost::shared_ptr<Fdm1dMesher> mesher =
+            blackScholesMeshers_.find(key);
+        if (mesher) {
+            ++hits_;
+        } else {
+            ++misses_;
+            mesher = boost::shared_ptr<Fdm1dMesher>(
+                new FdmBlackScholesMesher(size, process, maturity, strike,
+                                          xMinConstraint, xMaxConstraint,
+                                          eps, scaleFactor, cPoint,
+                                          dividendSchedule));
+            blackScholesMeshers_.add(key, mesher);
+        }
+        return mesher;
+    }
+
+    boost::shared_ptr<FdmMesher> FdmMesherCache::composite(
+        const boost::shared_ptr<Fdm1dMesher>& mesher) {
+
+        const CompositeKey key(1, mesher.get());
+
+        boost::shared_ptr<FdmMesher> result = composites_.find(key);
+        if (result) {
+            ++hits_;
+        } else {
+            ++misses_;
+            result = boost::shared_ptr<FdmMesher>(
+                new FdmMesherComposite(mesher));
+            composites_.add(key, result);
+        }
+        return result;
+    }
+
+    boost::shared_ptr<FdmMesher> FdmMesherCache::composite(
+        const boost::shared_ptr<Fdm1dMesher>& m1,
+        const boost::shared_ptr<Fdm1dMesher>& m2) {
+
+        CompositeKey key;
+        key.push_back(m1.get());
+        key.push_back(m2.get());
+
+        boost::shared_ptr<FdmMesher> result = composites_.find(key);
+        if (result) {
+            ++hits_;
+        } else {
+            ++misses_;
+            result = boost::shared_ptr<FdmMesher>(
+                new FdmMesherComposite(m1, m2));
+            composites_.add(key, result);
+        }
+        return result;
+    }
+
+    Size FdmMesherCache::size() const {
+        return hestonVarianceMeshers_.size() + blackScholesMeshers_.size()
+            + composites_.size();
+    }
+
+    void FdmMesherCache::clear() {
+        hestonVarianceMeshers_.clear();
+        blackScholesMeshers_.clear();
+        composites_.clear();
+    }
+
+}
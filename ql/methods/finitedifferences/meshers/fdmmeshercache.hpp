@@ -0,0 +1,160 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmmeshercache.hpp
+    \brief cache of meshers for repeated finite-difference pricing
+*/
+
+#ifndef quantlib_fdm_mesher_cache_hpp
+#define quantlib_fdm_mesher_cache_hpp
+
+#include <ql/instruments/dividendschedule.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/noncopyable.hpp>
+#include <list>
+
+namespace QuantLib {
+
+    class FdmMesher;
+    class Fdm1dMesher;
+    class FdmHestonVarianceMesher;
+    class HestonProcess;
+    class GeneralizedBlackScholesProcess;
+
+    //! cache of meshers for repeated finite-difference pricing
+    /*! Finite-difference engines build their meshers at every
+        calculation.  Engines given an instance of this class take
+        them from the cache instead, whenever the inputs defining the
+        grid are the same as in a former calculation; this is the
+        case, e.g., for options differing only by their type or
+        exercise, or when an option is repriced after a notification
+        that didn't change its grid.  Composite meshers are cached as
+        well, and with them their layouts.  The Heston variance
+        mesher doesn't depend on the strike, so that it is shared by
+        all the options with the same maturity; it is also the most
+        expensive to build, since it inverts the non-central
+        chi-squared distribution at every grid point.
+
+        The keys are made of the values which determine the grids,
+        not of the identity of the objects providing them:
+        - for the Heston variance mesher, the size, the maturity,
+          the process parameters, the number of averaging steps and
+          epsilon;
+        - for the Black-Scholes mesher, its arguments, the value of
+          the underlying, the Black volatility at the strike and
+          maturity, and the times, dividends and discount factors
+          used to find the boundaries of the grid;
+        - for composite meshers, their one-dimensional meshers.
+
+        Therefore, changes in market data or model parameters don't
+        cause stale meshers to be returned; they only cause new
+        entries to be added.  The least recently used entries of each
+        kind are dropped when their number exceeds the capacity, and
+        clear() drops all of them, e.g., to release memory after a
+        batch of calculations.  A null capacity disables caching.
+
+        \warning the cache is not thread-safe; engines used by
+                 different threads at the same time must not share it.
+
+        \test the prices are checked against the ones obtained
+              without cache, and the reuse of the meshers is checked.
+    */
+    class FdmMesherCache : private boost::noncopyable {
+      public:
+        explicit FdmMesherCache(Size capacity = 32);
+
+        //! \name Cached meshers
+        //@{
+        boost::shared_ptr<FdmHestonVarianceMesher> hestonVarianceMesher(
+            Size size,
+            const boost::shared_ptr<HestonProcess>& process,
+            Time maturity, Size tAvgSteps = 10, Real epsilon = 0.0001);
+
+        boost::shared_ptr<Fdm1dMesher> blackScholesMesher(
+            Size size,
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Time maturity, Real strike,
+            Real xMinConstraint = Null<Real>(),
+            Real xMaxConstraint = Null<Real>(),
+            Real eps = 0.0001,
+            Real scaleFactor = 1.5,
+            const std::pair<Real, Real>& cPoint
+                        = (std::pair<Real, Real>(Null<Real>(), Null<Real>())),
+            const DividendSchedule& dividendSchedule = DividendSchedule());
+
+        boost::shared_ptr<FdmMesher> composite(
+            const boost::shared_ptr<Fdm1dMesher>& mesher);
+        boost::shared_ptr<FdmMesher> composite(
+            const boost::shared_ptr<Fdm1dMesher>& m1,
+            const boost::shared_ptr<Fdm1dMesher>& m2);
+        //@}
+
+        //! \name Inspectors
+        //@{
+        //! number of cached meshers
+        Size size() const;
+        //! number of requests served from the cache
+        Size hits() const { return hits_; }
+        //! number of requests that required a new mesher
+        Size misses() const { return misses_; }
+        //@}
+
+        //! drops all the cached meshers
+        void clear();
+
+      private:
+        // entries kept from the most to the least recently used
+        template <class Key, class T>
+        class Entries {
+          public:
+            explicit Entries(Size capacity) : capacity_(capacity) {}
+            boost::shared_ptr<T> find(const Key& key) {
+                for (iterator i = entries_.begin(); i != entries_.end(); ++i)
+                    if (i->first == key) {
+                        entries_.splice(entries_.begin(), entries_, i);
+                        return i->second;
+                    }
+                return boost::shared_ptr<T>();
+            }
+            void add(const Key& key, const boost::shared_ptr<T>& value) {
+                entries_.push_front(std::make_pair(key, value));
+                if (entries_.size() > capacity_)
+                    entries_.pop_back();
+            }
+            Size size() const { return entries_.size(); }
+            void clear() { entries_.clear(); }
+          private:
+            typedef std::list<std::pair<Key, boost::shared_ptr<T> > > list;
+            typedef typename list::iterator iterator;
+            Size capacity_;
+            list entries_;
+        };
+
+        typedef std::vector<Real> Key;
+        typedef std::vector<const Fdm1dMesher*> CompositeKey;
+
+        Entries<Key, FdmHestonVarianceMesher> hestonVarianceMeshers_;
+        Entries<Key, Fdm1dMesher> blackScholesMeshers_;
+        // the cached composites keep their one-dimensional meshers
+        // alive, so that the addresses in their keys can't be reused
+        Entries<CompositeKey, FdmMesher> composites_;
+        Size hits_, misses_;
+    };
+
+}
+
+#endif
@@ -127,6 +127,36 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply(const Array& r, Array& out) const {
+        mapT_.apply(r, out);
+    }
+
+    void FdmBlackScholesOp::apply_direction(Size direction,
+                                            const Array& r,
+                                            Array& out) const {
+        if (direction == direction_)
+            mapT_.apply(r, out);
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmBlackScholesOp::apply_mixed(const Array& r, Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::solve_splitting(Size direction, const Array& r,
+                                            Real dt, Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, dt, 1.0, out, work_);
+        else if (&out != &r) {
+            out.resize(r.size());
+            std::copy(r.begin(), r.end(), out.begin());
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmBlackScholesOp::toMatrixDecomp() const {
@@ -55,6 +55,13 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+        void solve_splitting(Size direction, const Array& r,
+                             Real s, Array& out) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -70,6 +77,7 @@ namespace QuantLib {
         const Real strike_;
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
+        mutable Array work_;
     };
 }
 
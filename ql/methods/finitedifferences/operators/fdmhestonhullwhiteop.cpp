@@ -26,10 +26,20 @@
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmhestonhullwhiteop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
+#include <ql/math/arraykernels.hpp>
 #include <boost/make_shared.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        void addTo(Array& out, const Array& y) {
+            detail::vectorAxpy(out.size(), 1.0, y.begin(),
+                               out.begin(), out.begin());
+        }
+
+    }
+
     FdmHestonHullWhiteEquityPart::FdmHestonHullWhiteEquityPart(
         const boost::shared_ptr<FdmMesher>& mesher,
         const boost::shared_ptr<HullWhite>& hwModel,
@@ -157,6 +167,50 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonHullWhiteOp::apply(const Array& u, Array& out) const {
+        dyMap_.apply(u, out);
+        dxMap_.getMap().apply(u, work_);
+        addTo(out, work_);
+        hullWhiteOp_.apply(u, work_);
+        addTo(out, work_);
+        hestonCorrMap_.apply(u, work_);
+        addTo(out, work_);
+        equityIrCorrMap_.apply(u, work_);
+        addTo(out, work_);
+    }
+
+    void FdmHestonHullWhiteOp::apply_mixed(const Array& r, Array& out) const {
+        hestonCorrMap_.apply(r, out);
+        equityIrCorrMap_.apply(r, work_);
+        addTo(out, work_);
+    }
+
+    void FdmHestonHullWhiteOp::apply_direction(Size direction,
+                                               const Array& r,
+                                               Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply(r, out);
+        else if (direction == 1)
+            dyMap_.apply(r, out);
+        else if (direction == 2)
+            hullWhiteOp_.apply(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonHullWhiteOp::solve_splitting(Size direction,
+                                               const Array& r, Real a,
+                                               Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting(r, a, 1.0, out, work_);
+        else if (direction == 1)
+            dyMap_.solve_splitting(r, a, 1.0, out, work_);
+        else if (direction == 2)
+            hullWhiteOp_.solve_splitting(2, r, a, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHestonHullWhiteOp::toMatrixDecomp() const {
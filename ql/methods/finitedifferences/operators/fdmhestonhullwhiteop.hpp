@@ -60,6 +60,10 @@ namespace QuantLib {
         const boost::shared_ptr<YieldTermStructure> qTS_;
     };
 
+    /*! \warning the const methods of this operator share an internal
+                 work array; concurrent calls on the same instance are
+                 not allowed.
+    */
     class FdmHestonHullWhiteOp : public FdmLinearOpComposite {
       public:
         FdmHestonHullWhiteOp(
@@ -80,6 +84,13 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+        void solve_splitting(Size direction, const Array& r,
+                             Real s, Array& out) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -92,6 +103,7 @@ namespace QuantLib {
         TripleBandLinearOp dyMap_;
         FdmHestonHullWhiteEquityPart dxMap_;
         FdmHullWhiteOp hullWhiteOp_;
+        mutable Array work_;
     };
 }
 
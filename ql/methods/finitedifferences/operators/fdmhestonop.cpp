@@ -200,6 +200,39 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonOp::apply(const Array& u, Array& out) const {
+        dyMap_.getMap().apply(u, out);
+        dxMap_.getMap().apply(u, work_);
+        out += work_;
+        apply_mixed(u, work_);
+        out += work_;
+    }
+
+    void FdmHestonOp::apply_mixed(const Array& r, Array& out) const {
+        correlationMap_.apply(r, out);
+        out *= dxMap_.getL();
+    }
+
+    void FdmHestonOp::apply_direction(Size direction,
+                                      const Array& r, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply(r, out);
+        else if (direction == 1)
+            dyMap_.getMap().apply(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::solve_splitting(Size direction, const Array& r,
+                                      Real a, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting(r, a, 1.0, out, work_);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting(r, a, 1.0, out, work_);
+        else
+            QL_FAIL("direction too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHestonOp::toMatrixDecomp() const {
@@ -94,6 +94,31 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmHullWhiteOp::apply(const Array& r, Array& out) const {
+        mapT_.apply(r, out);
+    }
+
+    void FdmHullWhiteOp::apply_mixed(const Array& r, Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction(Size direction,
+                                         const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapT_.apply(r, out);
+        else
+            apply_mixed(r, out);
+    }
+
+    void FdmHullWhiteOp::solve_splitting(Size direction, const Array& r,
+                                         Real a, Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splitting(r, a, 1.0, out, work_);
+        else
+            apply_mixed(r, out);
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHullWhiteOp::toMatrixDecomp() const {
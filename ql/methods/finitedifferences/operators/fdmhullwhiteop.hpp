@@ -32,6 +32,10 @@ namespace QuantLib {
     class FdmMesher;
     class HullWhite;
 
+    /*! \warning the const methods of this operator share an internal
+                 work array; concurrent calls on the same instance are
+                 not allowed.
+    */
     class FdmHullWhiteOp : public FdmLinearOpComposite {
       public:
 
@@ -52,6 +56,13 @@ namespace QuantLib {
             solve_splitting(Size direction, const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+        void solve_splitting(Size direction, const Array& r,
+                             Real s, Array& out) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -61,6 +72,7 @@ namespace QuantLib {
         const TripleBandLinearOp dzMap_;
         TripleBandLinearOp mapT_;
         const boost::shared_ptr<HullWhite> model_;
+        mutable Array work_;
     };
 }
 
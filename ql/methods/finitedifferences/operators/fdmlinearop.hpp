@@ -36,6 +36,14 @@ namespace QuantLib {
         typedef Array array_type;
         virtual ~FdmLinearOp() { }
         virtual Disposable<array_type> apply(const array_type& r) const = 0;
+        /*! writes the result in the given array, which is resized
+            if needed; operators used in time stepping should
+            override it so that no memory is allocated.  The output
+            must not be the input array.
+        */
+        virtual void apply(const array_type& r, array_type& out) const {
+            out = apply(r);
+        }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<SparseMatrix> toMatrix() const = 0;
@@ -51,6 +51,26 @@ namespace QuantLib {
         virtual Disposable<Array> 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name Output-parameter variants
+            They write the result in the given array, which is resized
+            if needed; the default implementations call the ones
+            above, and should be overridden so that no memory is
+            allocated.  The output must not be the input array.
+        */
+        //@{
+        virtual void apply_mixed(const Array& r, Array& out) const {
+            out = apply_mixed(r);
+        }
+        virtual void apply_direction(Size direction,
+                                     const Array& r, Array& out) const {
+            out = apply_direction(direction, r);
+        }
+        virtual void solve_splitting(Size direction, const Array& r,
+                                     Real s, Array& out) const {
+            out = solve_splitting(direction, r, s);
+        }
+        //@}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
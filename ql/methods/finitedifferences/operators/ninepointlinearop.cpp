@@ -22,6 +22,8 @@
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/ninepointlinearop.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <ql/math/arraykernels.hpp>
 
 namespace QuantLib {
 
@@ -130,12 +132,19 @@ namespace QuantLib {
 
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
+        Array retVal;
+        apply(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply(const Array& u, Array& retVal) const {
 
         const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(&retVal != &u, "output cannot be the input array");
 
-        Array retVal(u.size());
+        retVal.resize(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -144,8 +153,9 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
+        const long size = long(retVal.size());
+        #pragma omp parallel for if(size >= long(detail::parallelThreshold))
+        for (long i=0; i < size; ++i) {
             retVal[i] =   a00[i]*u[i00[i]]
                         + a01[i]*u[i01[i]]
                         + a02[i]*u[i02[i]]
@@ -156,7 +166,6 @@ namespace QuantLib {
                         + a21[i]*u[i21[i]]
                         + a22[i]*u[i22[i]];
         }
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -164,20 +173,24 @@ namespace QuantLib {
         const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
         const Size n = index->size();
 
-        SparseMatrix retVal(n, n, 9*n);
-        for (Size i=0; i < index->size(); ++i) {
-            retVal(i, i00_[i]) += a00_[i];
-            retVal(i, i01_[i]) += a01_[i];
-            retVal(i, i02_[i]) += a02_[i];
-            retVal(i, i10_[i]) += a10_[i];
-            retVal(i, i      ) += a11_[i];
-            retVal(i, i12_[i]) += a12_[i];
-            retVal(i, i20_[i]) += a20_[i];
-            retVal(i, i21_[i]) += a21_[i];
-            retVal(i, i22_[i]) += a22_[i];
+        // assembled in compressed-row form, which avoids the
+        // element-by-element insertion into the ublas storage
+        std::vector<Size> rows, columns;
+        std::vector<Real> values;
+        rows.reserve(9*n); columns.reserve(9*n); values.reserve(9*n);
+        for (Size i=0; i < n; ++i) {
+            const Size c[] = { i00_[i], i01_[i], i02_[i],
+                               i10_[i], i,       i12_[i],
+                               i20_[i], i21_[i], i22_[i] };
+            const Real a[] = { a00_[i], a01_[i], a02_[i],
+                               a10_[i], a11_[i], a12_[i],
+                               a20_[i], a21_[i], a22_[i] };
+            rows.insert(rows.end(), 9, i);
+            columns.insert(columns.end(), c, c+9);
+            values.insert(values.end(), a, a+9);
         }
 
-        return retVal;
+        return CsrMatrix(n, n, rows, columns, values).toSparseMatrix();
     }
 #endif
 
@@ -44,6 +44,7 @@ namespace QuantLib {
         NinePointLinearOp& operator=(const Disposable<NinePointLinearOp>& m);
 
         Disposable<Array> apply(const Array& r) const;
+        void apply(const Array& r, Array& out) const;
         Disposable<NinePointLinearOp> mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m);
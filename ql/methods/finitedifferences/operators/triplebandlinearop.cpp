@@ -24,9 +24,19 @@
 #include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <ql/math/arraykernels.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        // elements per task in apply() and lines per task in
+        // solve_splitting()
+        const Size applyBlock = 4096, lineBlock = 64;
+
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -246,9 +256,17 @@ namespace QuantLib {
     }
 
     Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+        Array retVal;
+        apply(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply(const Array& r, Array& out) const {
         const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
+        const Size size = index->size();
 
-        QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(r.size() == size, "inconsistent length of r");
+        QL_REQUIRE(&out != &r, "output cannot be the input array");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -256,13 +274,42 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
-        array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        out.resize(size);
+
+        // The layout is a sequence of blocks of dim rows, each row
+        // holding stride contiguous elements with the same coordinate
+        // along the direction.  The neighbours of the inner rows are
+        // at -/+ stride, so that they're handled by unit-stride loops;
+        // the boundary rows use the index maps.
+        const Size stride = index->spacing()[direction_];
+        const Size dim = index->dim()[direction_];
+        const Size blockSize = stride*dim;
+        const Size blocks = size/blockSize;
+        const Size inner = (dim > 2) ? (dim-2)*stride : 0;
+        const Size pieces = (inner + applyBlock - 1)/applyBlock;
+
+        #pragma omp parallel for if(size >= detail::parallelThreshold)
+        for (long p=0; p < long(blocks*pieces); ++p) {
+            const Size offset = Size(p)%pieces*applyBlock;
+            const Size begin = Size(p)/pieces*blockSize + stride + offset;
+            detail::tripleBandProduct(std::min(applyBlock, inner-offset),
+                                      stride, lptr+begin, dptr+begin,
+                                      uptr+begin, r.begin()+begin,
+                                      out.begin()+begin);
         }
 
-        return retVal;
+        #pragma omp parallel for if(size >= detail::parallelThreshold)
+        for (long o=0; o < long(blocks); ++o) {
+            const Size first = Size(o)*blockSize;
+            const Size last = first + (dim-1)*stride;
+            for (Size i=first; i < first+stride; ++i)
+                out[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+            if (last != first) {
+                for (Size i=last; i < last+stride; ++i)
+                    out[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]
+                        + r[i2ptr[i]]*uptr[i];
+            }
+        }
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -270,20 +317,31 @@ namespace QuantLib {
         const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
         const Size n = index->size();
 
-        SparseMatrix retVal(n, n, 3*n);
+        // assembled in compressed-row form, which avoids the
+        // element-by-element insertion into the ublas storage
+        std::vector<Size> rows(3*n), columns(3*n);
+        std::vector<Real> values(3*n);
         for (Size i=0; i < n; ++i) {
-            retVal(i, i0_[i]) += lower_[i];
-            retVal(i, i     ) += diag_[i];
-            retVal(i, i2_[i]) += upper_[i];
+            rows[3*i] = rows[3*i+1] = rows[3*i+2] = i;
+            columns[3*i] = i0_[i];   values[3*i]   = lower_[i];
+            columns[3*i+1] = i;      values[3*i+1] = diag_[i];
+            columns[3*i+2] = i2_[i]; values[3*i+2] = upper_[i];
         }
 
-        return retVal;
+        return CsrMatrix(n, n, rows, columns, values).toSparseMatrix();
     }
 #endif
 
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal, tmp;
+        solve_splitting(r, a, b, retVal, tmp);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b,
+                                             Array& retVal, Array& tmp) const {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
 
@@ -298,36 +356,44 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        QL_REQUIRE(&tmp != &r && &tmp != &retVal,
+                   "work array cannot be the input or output array");
+        retVal.resize(r.size());
+        tmp.resize(r.size());
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
-
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
-
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
-
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+        // Thomas algorithm for each line along the direction.  With
+        // the layout described in apply(), the lines of a block are
+        // interleaved; they're solved in groups of lineBlock, whose
+        // sweeps vectorise across the lines.  Lines along the first
+        // direction are contiguous and solved one at a time.  The
+        // boundary elements linking consecutive lines are null, so
+        // the results are the same as for a single sweep over the
+        // whole grid.
+        const Size stride = layout->spacing()[direction_];
+        const Size dim = layout->dim()[direction_];
+        const Size blockSize = stride*dim;
+        const Size blocks = layout->size()/blockSize;
+        const Size width = std::min(stride, lineBlock);
+        const Size groups = (stride + width - 1)/width;
+
+        int singular = 0;
+        #pragma omp parallel for reduction(|:singular) \
+            if(layout->size() >= detail::parallelThreshold)
+        for (long g=0; g < long(blocks*groups); ++g) {
+            const Size offset = Size(g)%groups*width;
+            const Size begin = Size(g)/groups*blockSize + offset;
+            if (!detail::tridiagonalSolve(dim, stride,
+                                          std::min(width, stride-offset),
+                                          a, b, lptr+begin, dptr+begin,
+                                          uptr+begin, r.begin()+begin,
+                                          retVal.begin()+begin,
+                                          tmp.begin()+begin))
+                singular = 1;
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
-
-        return retVal;
+        QL_ENSURE(!singular, "division by zero");
     }
 }
@@ -45,8 +45,16 @@ namespace QuantLib {
         TripleBandLinearOp& operator=(const Disposable<TripleBandLinearOp>& m);
 
         Disposable<Array> apply(const Array& r) const;
+        void apply(const Array& r, Array& out) const;
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
+        /*! writes the solution in the given array, using the given
+            work array for the intermediate coefficients; both are
+            resized if needed.  The solution can be written in place
+            of the right-hand side.
+        */
+        void solve_splitting(const Array& r, Real a, Real b,
+                             Array& out, Array& work) const;
 
         Disposable<TripleBandLinearOp> mult(const Array& u) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on LHS
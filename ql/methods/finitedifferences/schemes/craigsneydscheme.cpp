@@ -20,6 +20,7 @@
 */
 
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/math/arraykernels.hpp>
 
 namespace QuantLib {
 
@@ -40,28 +41,43 @@ namespace QuantLib {
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        const Size n = a.size();
+        const Real thetaDt = theta_*dt_;
+        y_.resize(n);
+        rhs_.resize(n);
+
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply(a, work_);
+        detail::vectorAxpy(n, dt_, work_.begin(), a.begin(), y_.begin());
+        bcSet_.applyAfterApplying(y_);
 
-        Array y0 = y;
+        y0_.resize(n);
+        std::copy(y_.begin(), y_.end(), y0_.begin());
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction(i, a, work_);
+            detail::vectorAxpy(n, -thetaDt, work_.begin(),
+                               y_.begin(), rhs_.begin());
+            map_->solve_splitting(i, rhs_, -thetaDt, y_);
         }
 
+        // the corrector is accumulated into y0_
+        const Real muDt = mu_*dt_;
         bcSet_.applyBeforeApplying(*map_);
-        Array yt = y0 + mu_*dt_*map_->apply_mixed(y-a);
-        bcSet_.applyAfterApplying(yt);
+        detail::vectorAxpy(n, -1.0, a.begin(), y_.begin(), rhs_.begin());
+        map_->apply_mixed(rhs_, work_);
+        detail::vectorAxpy(n, muDt, work_.begin(), y0_.begin(), y0_.begin());
+        bcSet_.applyAfterApplying(y0_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, a);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction(i, a, work_);
+            detail::vectorAxpy(n, -thetaDt, work_.begin(),
+                               y0_.begin(), rhs_.begin());
+            map_->solve_splitting(i, rhs_, -thetaDt, y0_);
         }
-        bcSet_.applyAfterSolving(yt);
+        bcSet_.applyAfterSolving(y0_);
 
-        a = yt;
+        a.swap(y0_);
     }
 
     void CraigSneydScheme::setStep(Time dt) {
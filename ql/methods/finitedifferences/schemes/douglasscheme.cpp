@@ -20,6 +20,7 @@
 */
 
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
+#include <ql/math/arraykernels.hpp>
 
 namespace QuantLib {
     DouglasScheme::DouglasScheme(
@@ -37,17 +38,25 @@ namespace QuantLib {
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        const Size n = a.size();
+        const Real thetaDt = theta_*dt_;
+        y_.resize(n);
+        rhs_.resize(n);
+
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply(a, work_);
+        detail::vectorAxpy(n, dt_, work_.begin(), a.begin(), y_.begin());
+        bcSet_.applyAfterApplying(y_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction(i, a, work_);
+            detail::vectorAxpy(n, -thetaDt, work_.begin(),
+                               y_.begin(), rhs_.begin());
+            map_->solve_splitting(i, rhs_, -thetaDt, y_);
         }
-        bcSet_.applyAfterSolving(y);
+        bcSet_.applyAfterSolving(y_);
 
-        a = y;
+        a.swap(y_);
     }
 
     void DouglasScheme::setStep(Time dt) {
@@ -54,6 +54,7 @@ namespace QuantLib {
         const Real theta_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        Array y_, rhs_, work_;
     };
 }
 
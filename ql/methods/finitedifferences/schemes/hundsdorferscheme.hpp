@@ -59,6 +59,7 @@ namespace QuantLib {
 
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        Array y_, y0_, rhs_, work_;
     };
 }
 
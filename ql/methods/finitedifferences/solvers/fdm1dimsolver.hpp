@@ -43,6 +43,8 @@ namespace QuantLib {
 
         Real interpolateAt(Real x) const;
         Real thetaAt(Real x) const;
+        //! number of time steps taken, including the damping steps
+        Size timeStepsTaken() const;
 
         Real derivativeX(Real x) const;
         Real derivativeXX(Real x) const;
@@ -59,6 +61,7 @@ namespace QuantLib {
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
 
         std::vector<Real> x_, initialValues_;
+        mutable Size timeStepsTaken_;
         mutable Array resultValues_;
         mutable boost::shared_ptr<CubicInterpolation> interpolation_;
     };
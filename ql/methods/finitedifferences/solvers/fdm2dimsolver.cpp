@@ -74,9 +74,9 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-            .rollback(rhs, solverDesc_.maturity, 0.0,
-                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        timeStepsTaken_ =
+            FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
+                .rollback(rhs, solverDesc_);
 
         std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
         interpolation_ = boost::make_shared<BicubicSpline>(x_.begin(), x_.end(),
@@ -89,6 +89,11 @@ namespace QuantLib {
         return interpolation_->operator()(x, y);
     }
 
+    Size Fdm2DimSolver::timeStepsTaken() const {
+        calculate();
+        return timeStepsTaken_;
+    }
+
     Real Fdm2DimSolver::thetaAt(Real x, Real y) const {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
@@ -43,6 +43,8 @@ namespace QuantLib {
 
         Real interpolateAt(Real x, Real y) const;
         Real thetaAt(Real x, Real y) const;
+        //! number of time steps taken, including the damping steps
+        Size timeStepsTaken() const;
 
         Real derivativeX(Real x, Real y) const;
         Real derivativeY(Real x, Real y) const;
@@ -62,6 +64,7 @@ namespace QuantLib {
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
 
         std::vector<Real> x_, y_, initialValues_;
+        mutable Size timeStepsTaken_;
         mutable Matrix resultValues_;
         mutable boost::shared_ptr<BicubicSpline> interpolation_;
     };
@@ -81,9 +81,9 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-             .rollback(rhs, solverDesc_.maturity, 0.0,
-                       solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        timeStepsTaken_ =
+            FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
+                .rollback(rhs, solverDesc_);
 
         for (Size i=0; i < z_.size(); ++i) {
             std::copy(rhs.begin()+i    *y_.size()*x_.size(),
@@ -107,6 +107,11 @@ namespace QuantLib {
                                            zArray.begin())(z);
     }
 
+    Size Fdm3DimSolver::timeStepsTaken() const {
+        calculate();
+        return timeStepsTaken_;
+    }
+
     Real Fdm3DimSolver::thetaAt(Real x, Real y, Rate z) const {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
@@ -44,6 +44,8 @@ namespace QuantLib {
 
         Real interpolateAt(Real x, Real y, Rate z) const;
         Real thetaAt(Real x, Real y, Rate z) const;
+        //! number of time steps taken, including the damping steps
+        Size timeStepsTaken() const;
 
       private:
         const FdmSolverDesc solverDesc_;
@@ -54,6 +56,7 @@ namespace QuantLib {
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
 
         std::vector<Real> x_, y_, z_, initialValues_;
+        mutable Size timeStepsTaken_;
         mutable std::vector<Matrix> resultValues_;
         mutable std::vector<boost::shared_ptr<BicubicSpline> > interpolation_;
     };
@@ -35,7 +35,107 @@
 
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
+#include <functional>
+
 namespace QuantLib {
+
+    namespace {
+
+        // order of convergence of the scheme in time
+        Size schemeOrder(const FdmSchemeDesc& desc) {
+            switch (desc.type) {
+              case FdmSchemeDesc::HundsdorferType:
+              case FdmSchemeDesc::ModifiedCraigSneydType:
+                return 2;
+              case FdmSchemeDesc::DouglasType:
+              case FdmSchemeDesc::CraigSneydType:
+                return (desc.theta == 0.5) ? 2 : 1;
+              default:
+                return 1;
+            }
+        }
+
+        /* rolls a back from t towards to, taking at most maxSteps
+           accepted steps; t and the proposed step size dt are
+           updated on exit */
+        template <class Evolver>
+        Size adaptiveRollbackImpl(Evolver& evolver, Size order,
+                                  const FdmStepConditionComposite& condition,
+                                  Array& a, Time& t, Time to, Time& dt,
+                                  Real tolerance, Size maxSteps) {
+
+            // intervals between the stopping times, backwards
+            std::vector<Time> stops;
+            const std::vector<Time>& stoppingTimes =
+                condition.stoppingTimes();
+            for (Size i=0; i < stoppingTimes.size(); ++i)
+                if (stoppingTimes[i] > to && stoppingTimes[i] < t)
+                    stops.push_back(stoppingTimes[i]);
+            std::sort(stops.begin(), stops.end(), std::greater<Time>());
+            stops.erase(std::unique(stops.begin(), stops.end()),
+                        stops.end());
+            stops.push_back(to);
+
+            // the difference between the results of a whole step and
+            // of two half steps is 2^order-1 times the error of the latter
+            const Real errorFactor = 1.0/((1 << order) - 1);
+            const Time minStep = (t - to)*QL_EPSILON;
+
+            Array whole(a.size()), halves(a.size());
+            Size steps = 0;
+            for (Size i=0; i < stops.size() && steps < maxSteps; ++i) {
+                const Time next = stops[i];
+                while (t > next && steps < maxSteps) {
+                    Time h = std::min(dt, t - next);
+                    if (t - h - next < std::sqrt(QL_EPSILON))
+                        h = t - next;
+                    const Time end = (h == t - next) ? next : t - h;
+
+                    // the conditions are part of both candidates, so that
+                    // the error of applying them at discrete times is
+                    // controlled as well.  The half steps come last, so
+                    // that conditions keeping state (e.g., snapshots)
+                    // end up with the accepted solution.
+                    whole = a;
+                    evolver.setStep(h);
+                    evolver.step(whole, t);
+                    condition.applyTo(whole, end);
+
+                    halves = a;
+                    evolver.setStep(0.5*h);
+                    evolver.step(halves, t);
+                    condition.applyTo(halves, t - 0.5*h);
+                    evolver.step(halves, t - 0.5*h);
+                    condition.applyTo(halves, end);
+
+                    Real diff = 0.0, norm = 0.0;
+                    for (Size j=0; j < a.size(); ++j) {
+                        diff = std::max(diff, std::fabs(halves[j]-whole[j]));
+                        norm = std::max(norm, std::fabs(halves[j]));
+                    }
+                    const Real error =
+                        errorFactor*diff/std::max(norm, QL_EPSILON);
+
+                    if (error <= tolerance) {
+                        a.swap(halves);
+                        t = end;
+                        ++steps;
+                    }
+
+                    const Real factor = (error > 0.0)
+                        ? 0.9*std::pow(tolerance/error, 1.0/(order+1))
+                        : 5.0;
+                    dt = h*std::min(5.0, std::max(0.2, factor));
+                    QL_REQUIRE(dt > minStep,
+                               "step size " << dt << " too small at time "
+                               << t << " to reach tolerance " << tolerance);
+                }
+            }
+            return steps;
+        }
+
+    }
     
     FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
     : type(aType), theta(aTheta), mu(aMu) { }
@@ -172,4 +272,108 @@ namespace QuantLib {
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    Size FdmBackwardSolver::adaptiveRollback(
+        FdmBackwardSolver::array_type& rhs, Time from, Time to,
+        Size initialSteps, Size dampingSteps, Real tolerance) {
+
+        QL_REQUIRE(from >= to,
+                   "trying to roll back from " << from << " to " << to);
+        QL_REQUIRE(initialSteps > 0, "at least one initial step required");
+        QL_REQUIRE(tolerance > 0.0,
+                   "positive tolerance required, " << tolerance << " given");
+
+        const std::vector<Time>& stoppingTimes = condition_->stoppingTimes();
+        if (std::find(stoppingTimes.begin(), stoppingTimes.end(), from)
+                != stoppingTimes.end())
+            condition_->applyTo(rhs, from);
+
+        Time t = from, dt = (from - to)/initialSteps;
+        Size steps = 0;
+
+        if (   dampingSteps
+            && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
+            ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+            steps = adaptiveRollbackImpl(implicitEvolver, 1, *condition_,
+                                         rhs, t, to, dt,
+                                         tolerance, dampingSteps);
+        }
+
+        const Size order = schemeOrder(schemeDesc_);
+        const Size maxSteps = QL_MAX_INTEGER;
+        switch (schemeDesc_.type) {
+          case FdmSchemeDesc::HundsdorferType:
+            {
+                HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu,
+                                            map_, bcSet_);
+                steps += adaptiveRollbackImpl(hsEvolver, order, *condition_,
+                                              rhs, t, to, dt,
+                                              tolerance, maxSteps);
+            }
+            break;
+          case FdmSchemeDesc::DouglasType:
+            {
+                DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
+                steps += adaptiveRollbackImpl(dsEvolver, order, *condition_,
+                                              rhs, t, to, dt,
+                                              tolerance, maxSteps);
+            }
+            break;
+          case FdmSchemeDesc::CraigSneydType:
+            {
+                CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu,
+                                           map_, bcSet_);
+                steps += adaptiveRollbackImpl(csEvolver, order, *condition_,
+                                              rhs, t, to, dt,
+                                              tolerance, maxSteps);
+            }
+            break;
+          case FdmSchemeDesc::ModifiedCraigSneydType:
+            {
+                ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta,
+                                                   schemeDesc_.mu,
+                                                   map_, bcSet_);
+                steps += adaptiveRollbackImpl(csEvolver, order, *condition_,
+                                              rhs, t, to, dt,
+                                              tolerance, maxSteps);
+            }
+            break;
+          case FdmSchemeDesc::ImplicitEulerType:
+            {
+                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+                steps += adaptiveRollbackImpl(implicitEvolver, order,
+                                              *condition_, rhs, t, to, dt,
+                                              tolerance, maxSteps);
+            }
+            break;
+          case FdmSchemeDesc::ExplicitEulerType:
+            {
+                ExplicitEulerScheme explicitEvolver(map_, bcSet_);
+                steps += adaptiveRollbackImpl(explicitEvolver, order,
+                                              *condition_, rhs, t, to, dt,
+                                              tolerance, maxSteps);
+            }
+            break;
+          case FdmSchemeDesc::MethodOfLinesType:
+            QL_FAIL("the method-of-lines scheme adapts its step sizes "
+                    "already");
+          default:
+            QL_FAIL("Unknown scheme type");
+        }
+
+        return steps;
+    }
+
+    Size FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs,
+                                     const FdmSolverDesc& solverDesc) {
+        if (solverDesc.adaptiveTolerance > 0.0)
+            return adaptiveRollback(rhs, solverDesc.maturity, 0.0,
+                                    solverDesc.timeSteps,
+                                    solverDesc.dampingSteps,
+                                    solverDesc.adaptiveTolerance);
+
+        rollback(rhs, solverDesc.maturity, 0.0,
+                 solverDesc.timeSteps, solverDesc.dampingSteps);
+        return solverDesc.timeSteps + solverDesc.dampingSteps;
+    }
 }
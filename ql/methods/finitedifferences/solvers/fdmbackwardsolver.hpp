@@ -25,7 +25,7 @@
 #ifndef quantlib_fdm_backward_solver_hpp
 #define quantlib_fdm_backward_solver_hpp
 
-#include <ql/methods/finitedifferences/utilities/fdmboundaryconditionset.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 
 namespace QuantLib {
 
@@ -69,6 +69,46 @@ namespace QuantLib {
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        //! rollback with adaptive step sizes
+        /*! The step size is controlled by step doubling: each step is
+            taken both as a whole and as two half steps, and the
+            difference between the results, relative to the maximum
+            absolute value of the solution, estimates the local error.
+            The step is accepted if the estimate doesn't exceed the
+            given tolerance, the solution after the two half steps
+            being kept; in any case, the next step size is chosen
+            according to the order of the scheme.  Steps never cross
+            the stopping times of the step conditions; the conditions
+            are applied after the whole step and after each half step,
+            so that the estimate includes the error of applying them
+            at discrete times, e.g., for early exercise.
+
+            The first step size is (from-to)/initialSteps.  The first
+            dampingSteps accepted steps, if any, use the implicit Euler
+            scheme, with the same error control.  Each accepted step
+            costs three steps of the scheme.
+
+            \return the number of accepted steps, including the
+                    damping steps.
+
+            \note the method-of-lines scheme is not supported, since
+                  it adapts its step sizes already.
+        */
+        Size adaptiveRollback(array_type& a,
+                              Time from, Time to,
+                              Size initialSteps, Size dampingSteps,
+                              Real tolerance);
+
+        //! rollback from the maturity to time zero
+        /*! The steps are set by the given solver description; the
+            adaptive rollback is used if the description sets a
+            positive adaptive tolerance.
+
+            \return the number of steps taken, including the damping
+                    steps.
+        */
+        Size rollback(array_type& a, const FdmSolverDesc& solverDesc);
+
       protected:
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
@@ -71,4 +71,9 @@ namespace QuantLib {
     Real FdmBlackScholesSolver::thetaAt(Real s) const {
         return solver_->thetaAt(std::log(s));
     }
+
+    Size FdmBlackScholesSolver::timeStepsTaken() const {
+        calculate();
+        return solver_->timeStepsTaken();
+    }
 }
@@ -50,6 +50,8 @@ namespace QuantLib {
         Real deltaAt(Real s) const;
         Real gammaAt(Real s) const;
         Real thetaAt(Real s) const;
+        //! number of time steps taken, including the damping steps
+        Size timeStepsTaken() const;
 
       protected:
         void performCalculations() const;
@@ -49,6 +49,8 @@ namespace QuantLib {
 
         Real interpolateAt(const std::vector<Real>& x) const;
         Real thetaAt(const std::vector<Real>& x) const;
+        //! number of time steps taken, including the damping steps
+        Size timeStepsTaken() const;
 
         // template meta programming
         typedef typename MultiCubicSpline<N>::data_table data_table;
@@ -67,6 +69,7 @@ namespace QuantLib {
         std::vector<Real> initialValues_;
         const std::vector<bool> extrapolation_;
 
+        mutable Size timeStepsTaken_;
         mutable boost::shared_ptr<data_table> f_;
         mutable boost::shared_ptr<MultiCubicSpline<N> > interp_;
     };
@@ -125,9 +128,9 @@ namespace QuantLib {
         Array rhs(initialValues_.size());
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-                 .rollback(rhs, solverDesc_.maturity, 0.0,
-                           solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        timeStepsTaken_ =
+            FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
+                .rollback(rhs, solverDesc_);
 
         const boost::shared_ptr<FdmLinearOpLayout> layout
                                                = solverDesc_.mesher->layout();
@@ -143,6 +146,13 @@ namespace QuantLib {
     }
 
 
+    template <Size N> inline
+    Size FdmNdimSolver<N>::timeStepsTaken() const {
+        calculate();
+        return timeStepsTaken_;
+    }
+
+
     template <Size N> inline
     Real FdmNdimSolver<N>::thetaAt(const std::vector<Real>& x) const {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
@@ -40,6 +40,12 @@ namespace QuantLib {
         const Time maturity;
         const Size timeSteps;
         const Size dampingSteps;
+        /*! if positive, the solvers roll back with adaptive step
+            sizes (see FdmBackwardSolver::adaptiveRollback) starting
+            from timeSteps steps; the default of zero keeps the fixed
+            time grid.
+        */
+        const Real adaptiveTolerance;
     };
 }
 
@@ -9,12 +9,17 @@
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <ql/methods/montecarlo/multilevelmontecarlomodel.hpp>
+#include <ql/methods/montecarlo/multilevelpathgenerator.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/multipathbatch.hpp>
 #include <ql/methods/montecarlo/multipathgenerator.hpp>
 #include <ql/methods/montecarlo/nodedata.hpp>
 #include <ql/methods/montecarlo/parametricexercise.hpp>
 #include <ql/methods/montecarlo/path.hpp>
+#include <ql/methods/montecarlo/pathbatch.hpp>
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/methods/montecarlo/randomizedqmcmodel.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 
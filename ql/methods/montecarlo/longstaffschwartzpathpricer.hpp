@@ -29,6 +29,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
@@ -45,9 +46,156 @@
 #endif
 
 #include <boost/function.hpp>
+#include <string>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        /* Normal equations of the least-squares regression at an
+           exercise date, accumulated one sample at a time. */
+        template <class StateType>
+        class LsmNormalEquations {
+          public:
+            explicit LsmNormalEquations(
+                const std::vector<boost::function1<Real, StateType> >& v)
+            : v_(v), f_(v.size()), a_(v.size(), v.size(), 0.0),
+              b_(v.size(), 0.0), samples_(0) {}
+            void add(const StateType& x, Real y) {
+                const Size n = v_.size();
+                for (Size l=0; l<n; ++l)
+                    f_[l] = v_[l](x);
+                for (Size l=0; l<n; ++l) {
+                    for (Size m=0; m<=l; ++m)
+                        a_[l][m] += f_[l]*f_[m];
+                    b_[l] += f_[l]*y;
+                }
+                ++samples_;
+            }
+            void add(const LsmNormalEquations& other) {
+                a_ += other.a_;
+                b_ += other.b_;
+                samples_ += other.samples_;
+            }
+            Size samples() const { return samples_; }
+            Disposable<Array> coefficients() const {
+                // only the lower triangle was accumulated
+                Matrix a = a_;
+                for (Size l=0; l<a.rows(); ++l)
+                    for (Size m=l+1; m<a.columns(); ++m)
+                        a[l][m] = a[m][l];
+                return SVD(a).solveFor(b_);
+            }
+          private:
+            std::vector<boost::function1<Real, StateType> > v_;
+            Array f_;
+            Matrix a_;
+            Array b_;
+            Size samples_;
+        };
+
+        /* Draws the given number of samples (followed by their
+           antithetic paths, if required) and passes each path to the
+           visitor together with its index and with the index of the
+           worker drawing it.  The samples are split in contiguous
+           blocks among the workers, which run in parallel when the
+           library is compiled with OpenMP support; the visitor must
+           be safe to call concurrently for different workers. */
+        template <class PathGenerator, class Visitor>
+        void visitCalibrationPaths(const PathGenerator& generator,
+                                   Size samples,
+                                   bool antitheticVariate,
+                                   Size workers,
+                                   Visitor& visitor) {
+            QL_REQUIRE(workers > 0, "at least one worker required");
+            const Size pathsPerSample = antitheticVariate ? 2 : 1;
+
+            std::vector<Size> chunks(workers, samples/workers);
+            for (Size i=0; i<samples%workers; ++i)
+                ++chunks[i];
+            std::vector<Size> offsets(workers, 0);
+            for (Size i=1; i<workers; ++i)
+                offsets[i] = offsets[i-1] + chunks[i-1];
+
+            std::vector<PathGenerator> generators(workers, generator);
+            std::vector<std::string> errors(workers);
+
+            // the first sample is drawn serially, as in
+            // MonteCarloModel
+            Size first = 0;
+            if (chunks[0] > 0) {
+                visitor(0, 0, generators[0].next().value);
+                if (antitheticVariate)
+                    visitor(0, 1, generators[0].antithetic().value);
+                first = 1;
+            }
+
+            #pragma omp parallel for
+            for (long i=0; i<(long)workers; ++i) {
+                try {
+                    generators[i].discard(offsets[i]);
+                    for (Size j = (i == 0 ? first : 0); j<chunks[i]; ++j) {
+                        const Size index = (offsets[i]+j)*pathsPerSample;
+                        visitor(i, index, generators[i].next().value);
+                        if (antitheticVariate)
+                            visitor(i, index+1,
+                                    generators[i].antithetic().value);
+                    }
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                } catch (...) {
+                    errors[i] = "unknown error";
+                }
+            }
+
+            for (Size i=0; i<workers; ++i)
+                QL_REQUIRE(errors[i].empty(),
+                           "worker " << i << " failed: " << errors[i]);
+        }
+
+        /* Accumulates the normal equations of the regression at an
+           exercise date over the selected paths, splitting them in
+           contiguous blocks among the workers; the results of the
+           workers are added in their order. */
+        template <class StateType>
+        LsmNormalEquations<StateType> accumulateNormalEquations(
+                const std::vector<boost::function1<Real, StateType> >& v,
+                const std::vector<StateType>& x,
+                const Array& y,
+                const std::vector<bool>& selected,
+                Size workers) {
+            const Size n = y.size();
+            std::vector<LsmNormalEquations<StateType> > equations(
+                                   workers, LsmNormalEquations<StateType>(v));
+            std::vector<std::string> errors(workers);
+
+            #pragma omp parallel for
+            for (long i=0; i<(long)workers; ++i) {
+                try {
+                    const Size begin = n*Size(i)/workers,
+                               end = n*Size(i+1)/workers;
+                    for (Size j=begin; j<end; ++j) {
+                        if (selected[j])
+                            equations[i].add(x[j], y[j]);
+                    }
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                } catch (...) {
+                    errors[i] = "unknown error";
+                }
+            }
+
+            for (Size i=0; i<workers; ++i)
+                QL_REQUIRE(errors[i].empty(),
+                           "worker " << i << " failed: " << errors[i]);
+
+            for (Size i=1; i<workers; ++i)
+                equations.front().add(equations[i]);
+            return equations.front();
+        }
+
+    }
+
     //! Longstaff-Schwarz path pricer for early exercise options
     /*! References:
 
@@ -57,6 +205,19 @@ namespace QuantLib {
 
         \ingroup mcarlo
 
+        The exercise strategy can be calibrated either by passing the
+        calibration paths to the pricer and calling calibrate(), in
+        which case all of them are stored, or by passing a path
+        generator to calibrate(); in the latter case, the paths are
+        not stored.  Each of them is generated once for each group
+        of exercise dates (by default, one at a time) and only its
+        discounted cash flow and its exercise values and states at
+        the dates of the group are kept in memory.  The regressions
+        are then performed by accumulating their normal equations.
+        Both the generation and the regressions can be split among a
+        number of parallel workers.  The post-processing hook is not
+        called in this mode.
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
     */
@@ -72,10 +233,56 @@ namespace QuantLib {
 
         Real operator()(const PathType& path) const;
         virtual void calibrate();
+        //! calibrates the exercise strategy without storing the paths
+        /*! The path generator is copied, so that the passed instance
+            is not modified.  The paths are generated once for each
+            group of datesPerPass exercise dates; larger groups trade
+            memory for generation time.
+        */
+        template <class PathGenerator>
+        void calibrate(const PathGenerator& generator,
+                       Size samples,
+                       bool antitheticVariate,
+                       Size workers = 1,
+                       Size datesPerPass = 1);
 
         Real exerciseProbability() const;
 
       protected:
+        // stores the data needed by the regressions at the exercise
+        // dates between first and last, and initializes the cash
+        // flows if the last date is the one before maturity
+        class CalibrationVisitor {
+          public:
+            CalibrationVisitor(const LongstaffSchwartzPathPricer& pricer,
+                               Size first,
+                               Size last,
+                               Array& prices,
+                               std::vector<Array>& exercise,
+                               std::vector<std::vector<StateType> >& states)
+            : pricer_(pricer), first_(first), last_(last), prices_(prices),
+              exercise_(exercise), states_(states) {}
+            void operator()(Size, Size j, const PathType& path) {
+                const EarlyExercisePathPricer<PathType>& pathPricer =
+                    *pricer_.pathPricer_;
+                // initialize with exercise on last date
+                if (last_ == pricer_.len_-2)
+                    prices_[j] = pathPricer(path, pricer_.len_-1);
+                for (Size i=first_; i<=last_; ++i) {
+                    Real exercise = pathPricer(path, i);
+                    exercise_[i-first_][j] = exercise;
+                    if (exercise > 0.0)
+                        states_[i-first_][j] = pathPricer.state(path, i);
+                }
+            }
+          private:
+            const LongstaffSchwartzPathPricer& pricer_;
+            Size first_, last_;
+            Array& prices_;
+            std::vector<Array>& exercise_;
+            std::vector<std::vector<StateType> >& states_;
+        };
+
         virtual void post_processing(const Size i,
                                      const std::vector<StateType> &state,
                                      const std::vector<Real> &price,
@@ -221,6 +428,75 @@ namespace QuantLib {
         calibrationPhase_ = false;
     }
 
+    template <class PathType>
+    template <class PathGenerator>
+    inline void LongstaffSchwartzPathPricer<PathType>::calibrate(
+                                            const PathGenerator& generator,
+                                            Size samples,
+                                            bool antitheticVariate,
+                                            Size workers,
+                                            Size datesPerPass) {
+        QL_REQUIRE(samples > 0, "no calibration samples given");
+        QL_REQUIRE(datesPerPass > 0, "at least one date per pass required");
+        const Size n = antitheticVariate ? 2*samples : samples;
+        const Size dates = std::min(datesPerPass, len_-2);
+        Array prices(n), y(n);
+        std::vector<Array> exercise(dates, Array(n));
+        std::vector<std::vector<StateType> > states(dates,
+                                                   std::vector<StateType>(n));
+        std::vector<bool> inTheMoney(n);
+
+        for (Size last=len_-2; last>0; last-=dates) {
+            // the paths are generated once for each group of dates
+            const Size first = last > dates ? last-dates+1 : 1;
+            CalibrationVisitor visitor(*this, first, last,
+                                       prices, exercise, states);
+            detail::visitCalibrationPaths(generator, samples,
+                                          antitheticVariate, workers,
+                                          visitor);
+
+            for (Size i=last; i>=first; --i) {
+                const Array& exercise_i = exercise[i-first];
+                const std::vector<StateType>& states_i = states[i-first];
+                for (Size j=0; j<n; ++j) {
+                    inTheMoney[j] = (exercise_i[j] > 0.0);
+                    y[j] = dF_[i]*prices[j];
+                }
+
+                const detail::LsmNormalEquations<StateType> equations =
+                    detail::accumulateNormalEquations(v_, states_i, y,
+                                                      inTheMoney, workers);
+                if (v_.size() <= equations.samples()) {
+                    coeff_[i-1] = equations.coefficients();
+                }
+                else {
+                // if number of itm paths is smaller then the number of
+                // calibration functions then early exercise if exerciseValue > 0
+                    coeff_[i-1] = Array(v_.size(), 0.0);
+                }
+
+                for (Size j=0; j<n; ++j) {
+                    prices[j]*=dF_[i];
+                    if (inTheMoney[j]) {
+                        Real continuationValue = 0.0;
+                        for (Size l=0; l<v_.size(); ++l) {
+                            continuationValue +=
+                                coeff_[i-1][l] * v_[l](states_i[j]);
+                        }
+                        if (continuationValue < exercise_i[j]) {
+                            prices[j] = exercise_i[j];
+                        }
+                    }
+                }
+            }
+            if (first == 1)
+                break;
+        }
+
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::exerciseProbability() const {
         return exerciseProbability_.mean();
@@ -28,6 +28,9 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
 #include <boost/shared_ptr.hpp>
+#include <algorithm>
+#include <vector>
+#include <string>
 
 namespace QuantLib {
 
@@ -45,6 +48,40 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        A second constructor accepts a path pricer for each of a
+        number of workers; in this case, each call to addSamples()
+        splits the samples evenly among the workers, which run in
+        parallel when the library is compiled with OpenMP support.
+        Each worker draws a contiguous block of the random sequence
+        from its own copy of the path generator, moved forward by
+        means of its discard() method; the samples are then added to
+        the accumulator in their original order, so that the results
+        are exactly the same as the ones of a serial simulation.
+        Path pricers drawing random numbers of their own must
+        implement the RandomizedPathPricer interface for this to hold;
+        they are moved forward in the same way.  The control-variate
+        path pricer must be safe to call concurrently.
+
+        The first sample is drawn by the calling thread before the
+        workers are spawned.  Processes, term structures and pricers
+        often complete their initialization lazily when first used
+        (e.g., a lazy object performing its calculations, or a
+        process caching its local volatility); drawing a sample
+        serially ensures that this happens once, in a single thread,
+        and that the structures shared by the workers are only read
+        afterwards.  The other parallel simulations and valuations in
+        the library follow the same rule for the same reason.
+
+        If a non-null batch size is passed, and the path pricers (and
+        the control-variate path pricer, if any) also implement the
+        BatchPathPricer interface, the samples are generated and
+        priced in batches of the given size.  The results are the
+        same as the ones obtained path by path.  Batches are not used
+        with antithetic variates when the path pricers implement the
+        RandomizedPathPricer interface, since they would draw their
+        random numbers for all the paths of a batch before the ones
+        for their antithetics.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -54,7 +91,10 @@ namespace QuantLib {
         typedef RNG rng_traits;
         typedef typename MC<RNG>::path_generator_type path_generator_type;
         typedef typename MC<RNG>::path_pricer_type path_pricer_type;
+        typedef typename MC<RNG>::batch_path_pricer_type
+                                                    batch_path_pricer_type;
         typedef typename path_generator_type::sample_type sample_type;
+        typedef typename path_generator_type::batch_type batch_type;
         typedef typename path_pricer_type::result_type result_type;
         typedef S stats_type;
         // constructor
@@ -67,67 +107,354 @@ namespace QuantLib {
                         = boost::shared_ptr<path_pricer_type>(),
                   result_type cvOptionValue = result_type(),
                   const boost::shared_ptr<path_generator_type>& cvPathGenerator
-                        = boost::shared_ptr<path_generator_type>())
-        : pathGenerator_(pathGenerator), pathPricer_(pathPricer),
+                        = boost::shared_ptr<path_generator_type>(),
+                  Size batchSize = 0)
+        : pathGenerator_(pathGenerator), pathPricers_(1, pathPricer),
           sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
+          cvPathGenerator_(cvPathGenerator), batchSize_(batchSize),
+          drawnSamples_(0) {
             if (!cvPathPricer_)
                 isControlVariate_ = false;
             else
                 isControlVariate_ = true;
+            initializeRandomizedPricers();
+            initializeBatchPricers();
+        }
+        MonteCarloModel(
+            const boost::shared_ptr<path_generator_type>& pathGenerator,
+            const std::vector<boost::shared_ptr<path_pricer_type> >&
+                                                              pathPricers,
+            const stats_type& sampleAccumulator,
+            bool antitheticVariate,
+            const boost::shared_ptr<path_pricer_type>& cvPathPricer
+                  = boost::shared_ptr<path_pricer_type>(),
+            result_type cvOptionValue = result_type(),
+            const boost::shared_ptr<path_generator_type>& cvPathGenerator
+                  = boost::shared_ptr<path_generator_type>(),
+            Size batchSize = 0)
+        : pathGenerator_(pathGenerator), pathPricers_(pathPricers),
+          sampleAccumulator_(sampleAccumulator),
+          isAntitheticVariate_(antitheticVariate),
+          cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
+          cvPathGenerator_(cvPathGenerator), batchSize_(batchSize),
+          drawnSamples_(0) {
+            QL_REQUIRE(!pathPricers_.empty(), "no path pricer given");
+            if (!cvPathPricer_)
+                isControlVariate_ = false;
+            else
+                isControlVariate_ = true;
+            initializeRandomizedPricers();
+            initializeBatchPricers();
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator() const;
+        //! number of workers sharing the sample generation
+        Size workers() const { return pathPricers_.size(); }
+        //! whether the samples are generated and priced in batches
+        bool usesBatches() const { return !batchPricers_.empty(); }
       private:
+        class SampleBuffer {
+          public:
+            void add(const result_type& value, Real weight) {
+                samples_.push_back(std::make_pair(value, weight));
+            }
+            void reserve(Size n) { samples_.reserve(n); }
+            void flush(stats_type& accumulator) const {
+                for (Size i=0; i<samples_.size(); ++i)
+                    accumulator.add(samples_[i].first, samples_[i].second);
+            }
+          private:
+            std::vector<std::pair<result_type, Real> > samples_;
+        };
+        template <class Accumulator>
+        void addSamples(Size samples,
+                        path_generator_type& pathGenerator,
+                        const path_pricer_type& pathPricer,
+                        path_generator_type* cvPathGenerator,
+                        Accumulator& accumulator) const;
+        template <class Accumulator>
+        void addBatchSamples(Size samples,
+                             path_generator_type& pathGenerator,
+                             const batch_path_pricer_type& pathPricer,
+                             path_generator_type* cvPathGenerator,
+                             Accumulator& accumulator) const;
+        template <class Accumulator>
+        void addWorkerSamples(Size worker,
+                              Size samples,
+                              path_generator_type& pathGenerator,
+                              path_generator_type* cvPathGenerator,
+                              Accumulator& accumulator) const;
+        void initializeBatchPricers();
+        void initializeRandomizedPricers();
+        void moveRandomizedPricer(Size worker, Size firstSample,
+                                  Size samples);
         boost::shared_ptr<path_generator_type> pathGenerator_;
-        boost::shared_ptr<path_pricer_type> pathPricer_;
+        std::vector<boost::shared_ptr<path_pricer_type> > pathPricers_;
         stats_type sampleAccumulator_;
         bool isAntitheticVariate_;
         boost::shared_ptr<path_pricer_type> cvPathPricer_;
         result_type cvOptionValue_;
         bool isControlVariate_;
         boost::shared_ptr<path_generator_type> cvPathGenerator_;
+        Size batchSize_;
+        std::vector<boost::shared_ptr<batch_path_pricer_type> >
+                                                           batchPricers_;
+        boost::shared_ptr<batch_path_pricer_type> cvBatchPricer_;
+        Size drawnSamples_;
+        // worker pricers drawing random numbers of their own, and the
+        // sample each of them is positioned at
+        std::vector<boost::shared_ptr<RandomizedPathPricer> >
+                                                      randomizedPricers_;
+        std::vector<Size> pricerPositions_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        const Size workers = pathPricers_.size();
+        if (workers == 1) {
+            addWorkerSamples(0, samples, *pathGenerator_,
+                             cvPathGenerator_.get(), sampleAccumulator_);
+            drawnSamples_ += samples;
+            return;
+        }
+
+        std::vector<Size> chunks(workers, samples/workers);
+        for (Size i=0; i<samples%workers; ++i)
+            ++chunks[i];
+
+        std::vector<path_generator_type> generators(workers,
+                                                    *pathGenerator_);
+        std::vector<path_generator_type> cvGenerators;
+        if (cvPathGenerator_)
+            cvGenerators.resize(workers, *cvPathGenerator_);
+        std::vector<SampleBuffer> buffers(workers);
+        std::vector<Size> offsets(workers, 0);
+        for (Size i=0; i<workers; ++i) {
+            if (i > 0)
+                offsets[i] = offsets[i-1] + chunks[i-1];
+            buffers[i].reserve(chunks[i]);
+        }
+        std::vector<std::string> errors(workers+1);
+
+        // the first sample is drawn serially (see the class docs)
+        moveRandomizedPricer(0, drawnSamples_, chunks[0]);
+        if (chunks[0] > 0) {
+            addWorkerSamples(0, 1, generators[0],
+                             cvPathGenerator_ ? &cvGenerators[0] : 0,
+                             buffers[0]);
+            --chunks[0];
+        }
+
+        // the last task moves the model generators past the samples,
+        // while the workers move their copies to their blocks
+        #pragma omp parallel for schedule(dynamic)
+        for (long i=0; i<=(long)workers; ++i) {
+            try {
+                if (i == (long)workers) {
+                    pathGenerator_->discard(samples);
+                    if (cvPathGenerator_)
+                        cvPathGenerator_->discard(samples);
+                    continue;
+                }
+                if (i > 0) {
+                    generators[i].discard(offsets[i]);
+                    if (cvPathGenerator_)
+                        cvGenerators[i].discard(offsets[i]);
+                    moveRandomizedPricer(i, drawnSamples_+offsets[i],
+                                         chunks[i]);
+                }
+                addWorkerSamples(i, chunks[i], generators[i],
+                                 cvPathGenerator_ ? &cvGenerators[i] : 0,
+                                 buffers[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<workers; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "worker " << i << " failed: " << errors[i]);
+        QL_REQUIRE(errors[workers].empty(),
+                   "path generator failed: " << errors[workers]);
+
+        for (Size i=0; i<workers; ++i)
+            buffers[i].flush(sampleAccumulator_);
+
+        drawnSamples_ += samples;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    template <class Accumulator>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(
+                                   Size samples,
+                                   path_generator_type& pathGenerator,
+                                   const path_pricer_type& pathPricer,
+                                   path_generator_type* cvPathGenerator,
+                                   Accumulator& accumulator) const {
         for(Size j = 1; j <= samples; j++) {
 
-            const sample_type& path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+            const sample_type& path = pathGenerator.next();
+            result_type price = pathPricer(path.value);
 
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
+                if (!cvPathGenerator) {
                     price += cvOptionValue_-(*cvPathPricer_)(path.value);
                 }
                 else {
-                    const sample_type& cvPath = cvPathGenerator_->next();
+                    const sample_type& cvPath = cvPathGenerator->next();
                     price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
                 }
             }
 
             if (isAntitheticVariate_) {
-                const sample_type& atPath = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(atPath.value);
+                const sample_type& atPath = pathGenerator.antithetic();
+                result_type price2 = pathPricer(atPath.value);
                 if (isControlVariate_) {
-                    if (!cvPathGenerator_)
+                    if (!cvPathGenerator)
                         price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
                     else {
-                        const sample_type& cvPath = cvPathGenerator_->antithetic();
+                        const sample_type& cvPath =
+                            cvPathGenerator->antithetic();
                         price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
                     }
                 }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
+                accumulator.add((price+price2)/2.0, path.weight);
+            } else {
+                accumulator.add(price, path.weight);
+            }
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    template <class Accumulator>
+    inline void MonteCarloModel<MC,RNG,S>::addBatchSamples(
+                                   Size samples,
+                                   path_generator_type& pathGenerator,
+                                   const batch_path_pricer_type& pathPricer,
+                                   path_generator_type* cvPathGenerator,
+                                   Accumulator& accumulator) const {
+        std::vector<result_type> prices, prices2, cvPrices;
+        for (Size done = 0; done < samples; ) {
+            Size n = std::min(batchSize_, samples-done);
+
+            const batch_type& paths = pathGenerator.nextBatch(n);
+            pathPricer(paths, prices);
+
+            if (isControlVariate_) {
+                if (!cvPathGenerator)
+                    (*cvBatchPricer_)(paths, cvPrices);
+                else
+                    (*cvBatchPricer_)(cvPathGenerator->nextBatch(n),
+                                      cvPrices);
+                for (Size j=0; j<n; ++j)
+                    prices[j] += cvOptionValue_-cvPrices[j];
+            }
+
+            if (isAntitheticVariate_) {
+                const batch_type& atPaths = pathGenerator.antitheticBatch();
+                pathPricer(atPaths, prices2);
+                if (isControlVariate_) {
+                    if (!cvPathGenerator)
+                        (*cvBatchPricer_)(atPaths, cvPrices);
+                    else
+                        (*cvBatchPricer_)(cvPathGenerator->antitheticBatch(),
+                                          cvPrices);
+                    for (Size j=0; j<n; ++j)
+                        prices2[j] += cvOptionValue_-cvPrices[j];
+                }
+
+                for (Size j=0; j<n; ++j)
+                    accumulator.add((prices[j]+prices2[j])/2.0,
+                                    atPaths.weight(j));
             } else {
-                sampleAccumulator_.add(price, path.weight);
+                for (Size j=0; j<n; ++j)
+                    accumulator.add(prices[j], paths.weight(j));
             }
+
+            done += n;
         }
     }
 
+    template <template <class> class MC, class RNG, class S>
+    template <class Accumulator>
+    inline void MonteCarloModel<MC,RNG,S>::addWorkerSamples(
+                                   Size worker,
+                                   Size samples,
+                                   path_generator_type& pathGenerator,
+                                   path_generator_type* cvPathGenerator,
+                                   Accumulator& accumulator) const {
+        if (usesBatches())
+            addBatchSamples(samples, pathGenerator, *batchPricers_[worker],
+                            cvPathGenerator, accumulator);
+        else
+            addSamples(samples, pathGenerator, *pathPricers_[worker],
+                       cvPathGenerator, accumulator);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::initializeBatchPricers() {
+        if (batchSize_ == 0)
+            return;
+
+        // batches would change the order in which the pricers draw
+        // their own random numbers
+        if (isAntitheticVariate_ && !randomizedPricers_.empty())
+            return;
+
+        if (isControlVariate_) {
+            cvBatchPricer_ =
+                boost::dynamic_pointer_cast<batch_path_pricer_type>(
+                                                             cvPathPricer_);
+            if (!cvBatchPricer_)
+                return;
+        }
+
+        std::vector<boost::shared_ptr<batch_path_pricer_type> >
+            pricers(pathPricers_.size());
+        for (Size i=0; i<pathPricers_.size(); ++i) {
+            pricers[i] = boost::dynamic_pointer_cast<batch_path_pricer_type>(
+                                                            pathPricers_[i]);
+            if (!pricers[i])
+                return;
+        }
+        batchPricers_.swap(pricers);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::initializeRandomizedPricers() {
+        std::vector<boost::shared_ptr<RandomizedPathPricer> >
+            pricers(pathPricers_.size());
+        for (Size i=0; i<pathPricers_.size(); ++i) {
+            pricers[i] = boost::dynamic_pointer_cast<RandomizedPathPricer>(
+                                                            pathPricers_[i]);
+            if (!pricers[i])
+                return;
+        }
+        randomizedPricers_.swap(pricers);
+        pricerPositions_.resize(pathPricers_.size(), 0);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::moveRandomizedPricer(
+                                                     Size worker,
+                                                     Size firstSample,
+                                                     Size samples) {
+        if (randomizedPricers_.empty())
+            return;
+
+        // each sample is priced on a path and, possibly, its antithetic
+        const Size pathsPerSample = isAntitheticVariate_ ? 2 : 1;
+        randomizedPricers_[worker]->discard(
+                    (firstSample-pricerPositions_[worker])*pathsPerSample);
+        pricerPositions_[worker] = firstSample + samples;
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline const typename MonteCarloModel<MC,RNG,S>::stats_type&
     MonteCarloModel<MC,RNG,S>::sampleAccumulator() const {
@@ -0,0 +1,273 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelmontecarlomodel.hpp
+    \brief Multilevel Monte Carlo model
+*/
+
+#ifndef quantlib_multi_level_montecarlo_model_hpp
+#define quantlib_multi_level_montecarlo_model_hpp
+
+#include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/multilevelpathgenerator.hpp>
+#include <ql/math/statistics/statistics.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        // extracts the path priced by single- or multi-variate pricers
+        template <class PathType>
+        struct multi_level_path;
+
+        template <>
+        struct multi_level_path<Path> {
+            static const Path& get(const MultiPath& path) {
+                return path[0];
+            }
+        };
+
+        template <>
+        struct multi_level_path<MultiPath> {
+            static const MultiPath& get(const MultiPath& path) {
+                return path;
+            }
+        };
+
+    }
+
+    //! Multilevel Monte Carlo model for path samples
+    /*! The price is estimated as the telescopic sum
+        \f[
+            E[P_L] = E[P_0] + \sum_{l=1}^L E[P_l - P_{l-1}]
+        \f]
+        where \f$ P_l \f$ is the price of a path simulated on the
+        grid of level \f$ l \f$.  Each term is estimated separately;
+        level 0 uses a plain path generator, while each of the other
+        levels uses a MultiLevelPathGenerator so that the fine and
+        coarse paths in each difference are driven by the same
+        Brownian motion.  Levels are added from the coarsest; the
+        number of samples for each level is chosen by the caller
+        (see MultiLevelMcSimulation).
+
+        If a pricing grid is passed, the paths are sampled on its
+        times before being passed to the path pricers; this is
+        needed for products (such as discretely-monitored ones) whose
+        payoff depends on the path values at given times only, while
+        finer grids are used to reduce the discretization error.  The
+        grids of all levels must then be refinements of the pricing
+        grid.
+
+        \ingroup mcarlo
+    */
+    template <template <class> class MC, class RNG, class S = Statistics>
+    class MultiLevelMonteCarloModel {
+      public:
+        typedef MC<RNG> mc_traits;
+        typedef RNG rng_traits;
+        typedef typename MC<RNG>::path_type path_type;
+        typedef typename MC<RNG>::path_pricer_type path_pricer_type;
+        typedef typename RNG::rsg_type rsg_type;
+        typedef MultiPathGenerator<rsg_type> path_generator_type;
+        typedef MultiLevelPathGenerator<rsg_type>
+            coupled_path_generator_type;
+        typedef S stats_type;
+        typedef Real result_type;
+        // constructor
+        MultiLevelMonteCarloModel(bool antitheticVariate = false,
+                                  const TimeGrid& pricingGrid = TimeGrid());
+        //! adds the coarsest level
+        void addLevel(
+                 const boost::shared_ptr<path_generator_type>& pathGenerator,
+                 const boost::shared_ptr<path_pricer_type>& pathPricer);
+        //! adds a level on top of the current finest one
+        /*! The coarse grid of the generator must be the grid of the
+            current finest level.
+        */
+        void addLevel(
+          const boost::shared_ptr<coupled_path_generator_type>& pathGenerator,
+          const boost::shared_ptr<path_pricer_type>& finePathPricer,
+          const boost::shared_ptr<path_pricer_type>& coarsePathPricer);
+        Size levels() const { return levels_.size(); }
+        //! adds samples to the estimate of the given level
+        void addSamples(Size level, Size samples);
+        //! samples of the correction at the given level
+        const stats_type& levelAccumulator(Size level) const;
+        //! time steps simulated for each sample of the given level
+        Size levelCost(Size level) const;
+        //! sum of the estimates of all levels
+        result_type mean() const;
+        //! statistical error of the sum of the estimates
+        result_type errorEstimate() const;
+      private:
+        struct Level {
+            boost::shared_ptr<path_generator_type> pathGenerator;
+            boost::shared_ptr<coupled_path_generator_type> coupledGenerator;
+            boost::shared_ptr<path_pricer_type> finePricer, coarsePricer;
+            stats_type accumulator;
+            Size cost;
+        };
+        const path_type& pricedPath(const MultiPath& path) const;
+        Real price(Level& level, bool antithetic, Real& weight) const;
+        bool isAntitheticVariate_;
+        TimeGrid pricingGrid_;
+        std::vector<Level> levels_;
+        mutable MultiPath sampledPath_;
+    };
+
+
+    // inline definitions
+
+    template <template <class> class MC, class RNG, class S>
+    inline MultiLevelMonteCarloModel<MC,RNG,S>::MultiLevelMonteCarloModel(
+                                                  bool antitheticVariate,
+                                                  const TimeGrid& pricingGrid)
+    : isAntitheticVariate_(antitheticVariate), pricingGrid_(pricingGrid) {}
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMonteCarloModel<MC,RNG,S>::addLevel(
+                 const boost::shared_ptr<path_generator_type>& pathGenerator,
+                 const boost::shared_ptr<path_pricer_type>& pathPricer) {
+        QL_REQUIRE(levels_.empty(),
+                   "coupled path generator required for finer levels");
+        QL_REQUIRE(pathGenerator, "null path generator");
+        QL_REQUIRE(pathPricer, "null path pricer");
+        Level level;
+        level.pathGenerator = pathGenerator;
+        level.finePricer = pathPricer;
+        // set when the first path is drawn
+        level.cost = 0;
+        levels_.push_back(level);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMonteCarloModel<MC,RNG,S>::addLevel(
+          const boost::shared_ptr<coupled_path_generator_type>& pathGenerator,
+          const boost::shared_ptr<path_pricer_type>& finePathPricer,
+          const boost::shared_ptr<path_pricer_type>& coarsePathPricer) {
+        QL_REQUIRE(!levels_.empty(), "coarsest level not added");
+        QL_REQUIRE(pathGenerator, "null path generator");
+        QL_REQUIRE(finePathPricer && coarsePathPricer, "null path pricer");
+        Level level;
+        level.coupledGenerator = pathGenerator;
+        level.finePricer = finePathPricer;
+        level.coarsePricer = coarsePathPricer;
+        level.cost = (pathGenerator->fineGrid().size()-1) +
+                     (pathGenerator->coarseGrid().size()-1);
+        levels_.push_back(level);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline const typename MultiLevelMonteCarloModel<MC,RNG,S>::path_type&
+    MultiLevelMonteCarloModel<MC,RNG,S>::pricedPath(
+                                               const MultiPath& path) const {
+        if (pricingGrid_.empty())
+            return detail::multi_level_path<path_type>::get(path);
+
+        Size points = pricingGrid_.size();
+        QL_REQUIRE((path.pathSize()-1) % (points-1) == 0,
+                   "path grid is not a refinement of the pricing grid");
+        Size stride = (path.pathSize()-1)/(points-1);
+        if (sampledPath_.assetNumber() != path.assetNumber())
+            sampledPath_ = MultiPath(path.assetNumber(), pricingGrid_);
+        for (Size j=0; j<path.assetNumber(); ++j)
+            for (Size i=0; i<points; ++i)
+                sampledPath_[j][i] = path[j][i*stride];
+        return detail::multi_level_path<path_type>::get(sampledPath_);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Real MultiLevelMonteCarloModel<MC,RNG,S>::price(
+                       Level& level, bool antithetic, Real& weight) const {
+        if (level.pathGenerator) {
+            const typename path_generator_type::sample_type& path =
+                antithetic ? level.pathGenerator->antithetic()
+                           : level.pathGenerator->next();
+            level.cost = path.value.pathSize()-1;
+            weight = path.weight;
+            return (*level.finePricer)(pricedPath(path.value));
+        } else {
+            const typename coupled_path_generator_type::sample_type& path =
+                antithetic ? level.coupledGenerator->antithetic()
+                           : level.coupledGenerator->next();
+            weight = path.weight;
+            Real fine = (*level.finePricer)(pricedPath(path.value));
+            Real coarse = (*level.coarsePricer)(
+                          pricedPath(level.coupledGenerator->coarse().value));
+            return fine - coarse;
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMonteCarloModel<MC,RNG,S>::addSamples(
+                                                 Size level, Size samples) {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available; only "
+                   << levels_.size() << " levels added");
+        Level& l = levels_[level];
+        Real weight, antitheticWeight;
+        for (Size j = 1; j <= samples; j++) {
+            Real value = price(l, false, weight);
+            if (isAntitheticVariate_)
+                value = (value + price(l, true, antitheticWeight))/2.0;
+            l.accumulator.add(value, weight);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline const typename MultiLevelMonteCarloModel<MC,RNG,S>::stats_type&
+    MultiLevelMonteCarloModel<MC,RNG,S>::levelAccumulator(Size level) const {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available; only "
+                   << levels_.size() << " levels added");
+        return levels_[level].accumulator;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Size
+    MultiLevelMonteCarloModel<MC,RNG,S>::levelCost(Size level) const {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available; only "
+                   << levels_.size() << " levels added");
+        return levels_[level].cost;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MultiLevelMonteCarloModel<MC,RNG,S>::result_type
+    MultiLevelMonteCarloModel<MC,RNG,S>::mean() const {
+        result_type sum = 0.0;
+        for (Size l=0; l<levels_.size(); ++l)
+            sum += levels_[l].accumulator.mean();
+        return sum;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MultiLevelMonteCarloModel<MC,RNG,S>::result_type
+    MultiLevelMonteCarloModel<MC,RNG,S>::errorEstimate() const {
+        result_type variance = 0.0;
+        for (Size l=0; l<levels_.size(); ++l) {
+            result_type error = levels_[l].accumulator.errorEstimate();
+            variance += error*error;
+        }
+        return std::sqrt(variance);
+    }
+
+}
+
+#endif
@@ -0,0 +1,200 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelpathgenerator.hpp
+    \brief Generates coupled pairs of paths on a fine and a coarse grid
+*/
+
+#ifndef quantlib_multi_level_path_generator_hpp
+#define quantlib_multi_level_path_generator_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/stochasticprocess.hpp>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! Generates coupled pairs of multipaths on a fine and a coarse grid
+    /*! The fine grid is obtained by dividing each step of the coarse
+        grid into a given number of equal steps.  Each call to next()
+        draws the Gaussian increments for the fine path; the increments
+        used for the coarse path are obtained by summing the
+        corresponding Brownian increments of the fine one, so that the
+        two paths are driven by the same Brownian motion.  This is the
+        coupling required by multilevel Monte Carlo methods.
+
+        The generator must have dimension equal to the number of
+        factors of the process times the number of fine steps.
+
+        \ingroup mcarlo
+
+        \test the coarse paths are checked against the fine ones for a
+              process with exact discretization.
+    */
+    template <class GSG>
+    class MultiLevelPathGenerator {
+      public:
+        typedef Sample<MultiPath> sample_type;
+        MultiLevelPathGenerator(const boost::shared_ptr<StochasticProcess>&,
+                                const TimeGrid& coarseGrid,
+                                Size refinement,
+                                GSG generator);
+        //! generates the next fine path and the coupled coarse path
+        const sample_type& next() const;
+        //! antithetic of the last fine path and of its coarse path
+        const sample_type& antithetic() const;
+        //! coarse path coupled with the last generated fine path
+        const sample_type& coarse() const { return coarse_; }
+        const TimeGrid& fineGrid() const { return next_.value[0].timeGrid(); }
+        const TimeGrid& coarseGrid() const {
+            return coarse_.value[0].timeGrid();
+        }
+        Size refinement() const { return refinement_; }
+        //! divides each step of the given grid into equal steps
+        static TimeGrid refine(const TimeGrid& grid, Size refinement);
+      private:
+        const sample_type& next(bool antithetic) const;
+        boost::shared_ptr<StochasticProcess> process_;
+        Size refinement_;
+        GSG generator_;
+        mutable sample_type next_, coarse_;
+        std::vector<Real> sqrtDt_, coarseSqrtDt_;
+        mutable Array temp_, coarseTemp_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    MultiLevelPathGenerator<GSG>::MultiLevelPathGenerator(
+                   const boost::shared_ptr<StochasticProcess>& process,
+                   const TimeGrid& coarseGrid,
+                   Size refinement,
+                   GSG generator)
+    : process_(process), refinement_(refinement), generator_(generator),
+      next_(MultiPath(process->size(), refine(coarseGrid, refinement)), 1.0),
+      coarse_(MultiPath(process->size(), coarseGrid), 1.0),
+      temp_(process->factors()), coarseTemp_(process->factors()) {
+
+        const TimeGrid& fineGrid = next_.value[0].timeGrid();
+        QL_REQUIRE(generator_.dimension() ==
+                   process->factors()*(fineGrid.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << process->factors() << " * " << fineGrid.size()-1
+                   << ") the number of factors "
+                   << "times the number of fine time steps");
+
+        sqrtDt_.resize(fineGrid.size()-1);
+        for (Size i=0; i<sqrtDt_.size(); ++i)
+            sqrtDt_[i] = std::sqrt(fineGrid.dt(i));
+        coarseSqrtDt_.resize(coarseGrid.size()-1);
+        for (Size i=0; i<coarseSqrtDt_.size(); ++i)
+            coarseSqrtDt_[i] = std::sqrt(coarseGrid.dt(i));
+    }
+
+    template <class GSG>
+    TimeGrid MultiLevelPathGenerator<GSG>::refine(const TimeGrid& grid,
+                                                  Size refinement) {
+        QL_REQUIRE(grid.size() > 1, "no times given");
+        QL_REQUIRE(refinement > 0, "null refinement given");
+        if (refinement == 1)
+            return grid;
+
+        std::vector<Time> times;
+        times.reserve((grid.size()-1)*refinement);
+        for (Size i=1; i<grid.size(); ++i) {
+            Time t = grid[i-1], dt = grid.dt(i-1);
+            for (Size k=1; k<refinement; ++k)
+                times.push_back(t + (dt*k)/refinement);
+            times.push_back(grid[i]);
+        }
+        TimeGrid fineGrid(times.begin(), times.end());
+        QL_ENSURE(fineGrid.size() == (grid.size()-1)*refinement+1,
+                  "time steps too small to be refined by "
+                  << refinement);
+        return fineGrid;
+    }
+
+    template <class GSG>
+    inline const typename MultiLevelPathGenerator<GSG>::sample_type&
+    MultiLevelPathGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    inline const typename MultiLevelPathGenerator<GSG>::sample_type&
+    MultiLevelPathGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const typename MultiLevelPathGenerator<GSG>::sample_type&
+    MultiLevelPathGenerator<GSG>::next(bool antithetic) const {
+
+        typedef typename GSG::sample_type sequence_type;
+        const sequence_type& sequence_ =
+            antithetic ? generator_.lastSequence()
+                       : generator_.nextSequence();
+
+        Size m = process_->size();
+        Size n = process_->factors();
+
+        MultiPath& path = next_.value;
+        MultiPath& coarsePath = coarse_.value;
+
+        Array asset = process_->initialValues();
+        Array coarseAsset = asset;
+        for (Size j=0; j<m; j++)
+            path[j].front() = coarsePath[j].front() = asset[j];
+
+        next_.weight = coarse_.weight = sequence_.weight;
+
+        const TimeGrid& timeGrid = path[0].timeGrid();
+        const TimeGrid& coarseTimeGrid = coarsePath[0].timeGrid();
+        for (Size k = 1; k < coarsePath.pathSize(); k++) {
+            std::fill(coarseTemp_.begin(), coarseTemp_.end(), 0.0);
+            for (Size s = 0; s < refinement_; s++) {
+                Size i = (k-1)*refinement_ + s;
+                Size offset = i*n;
+                for (Size j=0; j<n; j++) {
+                    temp_[j] = antithetic ? -sequence_.value[offset+j]
+                                          : sequence_.value[offset+j];
+                    coarseTemp_[j] += sqrtDt_[i]*temp_[j];
+                }
+                asset = process_->evolve(timeGrid[i], asset,
+                                         timeGrid.dt(i), temp_);
+                for (Size j=0; j<m; j++)
+                    path[j][i+1] = asset[j];
+            }
+
+            // the Brownian increment over the coarse step, normalized
+            for (Size j=0; j<n; j++)
+                coarseTemp_[j] /= coarseSqrtDt_[k-1];
+            coarseAsset = process_->evolve(coarseTimeGrid[k-1], coarseAsset,
+                                           coarseTimeGrid.dt(k-1),
+                                           coarseTemp_);
+            for (Size j=0; j<m; j++)
+                coarsePath[j][k] = coarseAsset[j];
+        }
+        return next_;
+    }
+
+}
+
+#endif
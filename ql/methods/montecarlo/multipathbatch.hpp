@@ -0,0 +1,99 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multipathbatch.hpp
+    \brief batch of correlated multiple asset paths
+*/
+
+#ifndef quantlib_montecarlo_multi_path_batch_hpp
+#define quantlib_montecarlo_multi_path_batch_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! batch of correlated multiple asset paths on the same time grid
+    /*! The values at each point of the time grid are stored in a
+        matrix whose rows correspond to the assets and whose columns
+        correspond to the paths; this is the layout expected by the
+        batch version of StochasticProcess::evolve().
+
+        \ingroup mcarlo
+    */
+    class MultiPathBatch {
+      public:
+        MultiPathBatch() {}
+        MultiPathBatch(Size nAsset, const TimeGrid& timeGrid, Size paths);
+        //! \name inspectors
+        //@{
+        bool empty() const { return values_.empty(); }
+        Size assetNumber() const { return values_.front().rows(); }
+        //! number of paths in the batch
+        Size paths() const { return weights_.size(); }
+        //! number of points in each path
+        Size pathSize() const { return values_.size(); }
+        //! value of asset \f$ a \f$ at point \f$ i \f$ of path \f$ j \f$
+        Real operator()(Size a, Size i, Size j) const {
+            return values_[i][a][j];
+        }
+        Real& operator()(Size a, Size i, Size j) {
+            return values_[i][a][j];
+        }
+        //! values of all assets and paths at the \f$ i \f$-th point
+        const Matrix& values(Size i) const { return values_[i]; }
+        Matrix& values(Size i) { return values_[i]; }
+        //! weight of the \f$ j \f$-th path
+        Real weight(Size j) const { return weights_[j]; }
+        Real& weight(Size j) { return weights_[j]; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //! copy of the \f$ j \f$-th multi-path
+        MultiPath multiPath(Size j) const;
+        //@}
+      private:
+        TimeGrid timeGrid_;
+        std::vector<Matrix> values_;
+        std::vector<Real> weights_;
+    };
+
+
+    // inline definitions
+
+    inline MultiPathBatch::MultiPathBatch(Size nAsset,
+                                          const TimeGrid& timeGrid,
+                                          Size paths)
+    : timeGrid_(timeGrid), values_(timeGrid.size(), Matrix(nAsset, paths)),
+      weights_(paths, 1.0) {
+        QL_REQUIRE(nAsset > 0, "number of asset must be positive");
+        QL_REQUIRE(paths > 0, "number of paths must be positive");
+    }
+
+    inline MultiPath MultiPathBatch::multiPath(Size j) const {
+        QL_REQUIRE(j < paths(),
+                   "path " << j << " out of range [0, " << paths() << ")");
+        MultiPath result(assetNumber(), timeGrid_);
+        for (Size i=0; i<pathSize(); ++i)
+            for (Size a=0; a<assetNumber(); ++a)
+                result[a][i] = values_[i][a][j];
+        return result;
+    }
+
+}
+
+
+#endif
@@ -28,6 +28,7 @@
 #define quantlib_multi_path_generator_hpp
 
 #include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/multipathbatch.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/stochasticprocess.hpp>
 
@@ -42,6 +43,11 @@ namespace QuantLib {
         };
         \endcode
 
+        Paths can also be generated in batches; the paths in a batch
+        are the same that would be returned by the corresponding
+        sequence of calls to next(), but each time step is evolved
+        for all paths at once.
+
         \ingroup mcarlo
 
         \test the generated paths are checked against cached results
@@ -50,18 +56,29 @@ namespace QuantLib {
     class MultiPathGenerator {
       public:
         typedef Sample<MultiPath> sample_type;
+        typedef MultiPathBatch batch_type;
         MultiPathGenerator(const boost::shared_ptr<StochasticProcess>&,
                            const TimeGrid&,
                            GSG generator,
                            bool brownianBridge = false);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        //! generates the next \f$ n \f$ multi-paths
+        const batch_type& nextBatch(Size n) const;
+        //! antithetic multi-paths of the last generated batch
+        const batch_type& antitheticBatch() const;
+        //! advance the generator as if n paths had been drawn
+        void discard(Size n) { generator_.discard(n); }
       private:
         const sample_type& next(bool antithetic) const;
+        void evolveBatch(bool antithetic) const;
         bool brownianBridge_;
         boost::shared_ptr<StochasticProcess> process_;
         GSG generator_;
         mutable sample_type next_;
+        mutable batch_type batch_;
+        mutable std::vector<Matrix> batchIncrements_;
+        mutable Matrix batchTemp_;
     };
 
 
@@ -150,6 +167,71 @@ namespace QuantLib {
         }
     }
 
+    template <class GSG>
+    const typename MultiPathGenerator<GSG>::batch_type&
+    MultiPathGenerator<GSG>::nextBatch(Size n) const {
+
+        QL_REQUIRE(!brownianBridge_, "Brownian bridge not supported");
+
+        Size m = process_->size();
+        Size f = process_->factors();
+        const TimeGrid& timeGrid = next_.value[0].timeGrid();
+        Size steps = timeGrid.size()-1;
+
+        if (batch_.paths() != n) {
+            batch_ = batch_type(m, timeGrid, n);
+            batchIncrements_ = std::vector<Matrix>(steps, Matrix(f, n));
+            batchTemp_ = Matrix(f, n);
+        }
+
+        typedef typename GSG::sample_type sequence_type;
+        for (Size j=0; j<n; ++j) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            for (Size i=0; i<steps; ++i) {
+                Size offset = i*f;
+                for (Size k=0; k<f; ++k)
+                    batchIncrements_[i][k][j] = sequence_.value[offset+k];
+            }
+            batch_.weight(j) = sequence_.weight;
+        }
+
+        evolveBatch(false);
+        return batch_;
+    }
+
+    template <class GSG>
+    const typename MultiPathGenerator<GSG>::batch_type&
+    MultiPathGenerator<GSG>::antitheticBatch() const {
+        QL_REQUIRE(!batch_.empty(), "no batch generated yet");
+        evolveBatch(true);
+        return batch_;
+    }
+
+    template <class GSG>
+    void MultiPathGenerator<GSG>::evolveBatch(bool antithetic) const {
+        Size m = process_->size();
+
+        Array asset = process_->initialValues();
+        Matrix& start = batch_.values(0);
+        for (Size k=0; k<m; k++)
+            std::fill(start.row_begin(k), start.row_end(k), asset[k]);
+
+        const TimeGrid& timeGrid = batch_.timeGrid();
+        for (Size i=1; i<batch_.pathSize(); i++) {
+            Time t = timeGrid[i-1];
+            Time dt = timeGrid.dt(i-1);
+            const Matrix* dw = &batchIncrements_[i-1];
+            if (antithetic) {
+                std::transform(dw->begin(), dw->end(), batchTemp_.begin(),
+                               std::negate<Real>());
+                dw = &batchTemp_;
+            }
+            process_->evolve(t, batch_.values(i-1), dt, *dw,
+                             batch_.values(i));
+        }
+    }
+
+
 }
 
 #endif
@@ -0,0 +1,92 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathbatch.hpp
+    \brief batch of single-factor random walks
+*/
+
+#ifndef quantlib_montecarlo_path_batch_hpp
+#define quantlib_montecarlo_path_batch_hpp
+
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! batch of single-factor random walks on the same time grid
+    /*! The values are stored time-major, i.e., the values of all
+        paths at a given time are contiguous in memory.  This allows
+        processes and pricers to work on all paths at once with loops
+        that the compiler can vectorize.
+
+        \ingroup mcarlo
+
+        \note as for Path, the initial asset values are included.
+    */
+    class PathBatch {
+      public:
+        PathBatch() {}
+        PathBatch(const TimeGrid& timeGrid, Size paths);
+        //! \name inspectors
+        //@{
+        bool empty() const { return values_.empty(); }
+        //! number of paths in the batch
+        Size paths() const { return values_.columns(); }
+        //! number of points in each path
+        Size length() const { return values_.rows(); }
+        //! value of the \f$ j \f$-th path at the \f$ i \f$-th point
+        Real operator()(Size i, Size j) const { return values_[i][j]; }
+        Real& operator()(Size i, Size j) { return values_[i][j]; }
+        //! values of all paths at the \f$ i \f$-th point
+        const Real* values(Size i) const { return values_.row_begin(i); }
+        Real* values(Size i) { return values_.row_begin(i); }
+        //! weight of the \f$ j \f$-th path
+        Real weight(Size j) const { return weights_[j]; }
+        Real& weight(Size j) { return weights_[j]; }
+        //! time at the \f$ i \f$-th point
+        Time time(Size i) const { return timeGrid_[i]; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //! copy of the \f$ j \f$-th path
+        Path path(Size j) const;
+        //@}
+      private:
+        TimeGrid timeGrid_;
+        Matrix values_;
+        std::vector<Real> weights_;
+    };
+
+
+    // inline definitions
+
+    inline PathBatch::PathBatch(const TimeGrid& timeGrid, Size paths)
+    : timeGrid_(timeGrid), values_(timeGrid.size(), paths),
+      weights_(paths, 1.0) {
+        QL_REQUIRE(paths > 0, "number of paths must be positive");
+    }
+
+    inline Path PathBatch::path(Size j) const {
+        QL_REQUIRE(j < paths(),
+                   "path " << j << " out of range [0, " << paths() << ")");
+        return Path(timeGrid_,
+                    Array(values_.column_begin(j), values_.column_end(j)));
+    }
+
+}
+
+
+#endif
@@ -27,7 +27,9 @@
 #define quantlib_montecarlo_path_generator_hpp
 
 #include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/pathbatch.hpp>
 #include <ql/stochasticprocess.hpp>
+#include <functional>
 
 namespace QuantLib {
     class StochasticProcess;
@@ -38,12 +40,18 @@ namespace QuantLib {
 
         \ingroup mcarlo
 
+        Paths can also be generated in batches; the paths in a batch
+        are the same that would be returned by the corresponding
+        sequence of calls to next(), but each time step is evolved
+        for all paths at once.
+
         \test the generated paths are checked against cached results
     */
     template <class GSG>
     class PathGenerator {
       public:
         typedef Sample<Path> sample_type;
+        typedef PathBatch batch_type;
         // constructors
         PathGenerator(const boost::shared_ptr<StochasticProcess>&,
                       Time length,
@@ -58,11 +66,18 @@ namespace QuantLib {
         //@{
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        //! generates the next \f$ n \f$ paths
+        const batch_type& nextBatch(Size n) const;
+        //! antithetic paths of the last generated batch
+        const batch_type& antitheticBatch() const;
         Size size() const { return dimension_; }
+        //! advance the generator as if n paths had been drawn
+        void discard(Size n) { generator_.discard(n); }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
       private:
         const sample_type& next(bool antithetic) const;
+        void evolveBatch(bool antithetic) const;
         bool brownianBridge_;
         GSG generator_;
         Size dimension_;
@@ -71,6 +86,9 @@ namespace QuantLib {
         mutable sample_type next_;
         mutable std::vector<Real> temp_;
         BrownianBridge bb_;
+        mutable batch_type batch_;
+        mutable Matrix batchIncrements_;
+        mutable std::vector<Real> batchTemp_;
     };
 
 
@@ -154,6 +172,64 @@ namespace QuantLib {
         return next_;
     }
 
+    template <class GSG>
+    const typename PathGenerator<GSG>::batch_type&
+    PathGenerator<GSG>::nextBatch(Size n) const {
+
+        if (batch_.paths() != n) {
+            batch_ = batch_type(timeGrid_, n);
+            batchIncrements_ = Matrix(dimension_, n);
+            batchTemp_.resize(n);
+        }
+
+        typedef typename GSG::sample_type sequence_type;
+        for (Size j=0; j<n; ++j) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            if (brownianBridge_) {
+                bb_.transform(sequence_.value.begin(),
+                              sequence_.value.end(),
+                              temp_.begin());
+            } else {
+                std::copy(sequence_.value.begin(),
+                          sequence_.value.end(),
+                          temp_.begin());
+            }
+            for (Size i=0; i<dimension_; ++i)
+                batchIncrements_[i][j] = temp_[i];
+            batch_.weight(j) = sequence_.weight;
+        }
+
+        evolveBatch(false);
+        return batch_;
+    }
+
+    template <class GSG>
+    const typename PathGenerator<GSG>::batch_type&
+    PathGenerator<GSG>::antitheticBatch() const {
+        QL_REQUIRE(!batch_.empty(), "no batch generated yet");
+        evolveBatch(true);
+        return batch_;
+    }
+
+    template <class GSG>
+    void PathGenerator<GSG>::evolveBatch(bool antithetic) const {
+        Size n = batch_.paths();
+        std::fill(batch_.values(0), batch_.values(0)+n, process_->x0());
+
+        for (Size i=1; i<batch_.length(); i++) {
+            Time t = timeGrid_[i-1];
+            Time dt = timeGrid_.dt(i-1);
+            const Real* dw = batchIncrements_.row_begin(i-1);
+            if (antithetic) {
+                std::transform(dw, dw+n, batchTemp_.begin(),
+                               std::negate<Real>());
+                dw = &batchTemp_[0];
+            }
+            process_->evolve(t, batch_.values(i-1), dt, dw,
+                             batch_.values(i), n);
+        }
+    }
+
 }
 
 
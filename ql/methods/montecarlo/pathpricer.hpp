@@ -19,7 +19,7 @@
 */
 
 /*! \file pathpricer.hpp
-    \brief base class for single-path pricers
+    \brief base classes for single-path and batch pricers
 */
 
 #ifndef quantlib_montecarlo_path_pricer_hpp
@@ -28,6 +28,7 @@
 #include <ql/option.hpp>
 #include <ql/types.hpp>
 #include <functional>
+#include <vector>
 
 namespace QuantLib {
 
@@ -43,6 +44,48 @@ namespace QuantLib {
         virtual ValueType operator()(const PathType& path) const=0;
     };
 
+    //! base class for path pricers working on batches of paths
+    /*! Path pricers can inherit from this class besides PathPricer
+        in order to price a whole batch of paths (as returned by the
+        nextBatch() method of the path generators) in a single call.
+        MonteCarloModel uses this interface when available.
+
+        \ingroup mcarlo
+    */
+    template<class BatchType, class ValueType=Real>
+    class BatchPathPricer {
+      public:
+        virtual ~BatchPathPricer() {}
+        /*! writes into values[j] the value of the option on the
+            \f$ j \f$-th path of the batch; values is resized to the
+            number of paths.
+        */
+        virtual void operator()(const BatchType& paths,
+                                std::vector<ValueType>& values) const=0;
+    };
+
+    //! base class for path pricers drawing random numbers of their own
+    /*! Path pricers which draw random numbers besides the ones
+        driving the paths (e.g., for a Brownian-bridge correction)
+        can inherit from this class besides PathPricer.  When the
+        samples are split among parallel workers, MonteCarloModel
+        uses this interface to move the pricer of each worker forward
+        by the number of paths priced before its block, so that the
+        results are the same as the ones of a serial simulation.
+
+        The pricer must draw the same amount of random numbers for
+        each path, in the order of the paths, also when a batch of
+        paths is priced.
+
+        \ingroup mcarlo
+    */
+    class RandomizedPathPricer {
+      public:
+        virtual ~RandomizedPathPricer() {}
+        //! skips the random numbers used for pricing the next n paths
+        virtual void discard(Size n) = 0;
+    };
+
 }
 
 
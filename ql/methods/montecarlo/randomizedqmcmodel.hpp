@@ -0,0 +1,151 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file randomizedqmcmodel.hpp
+    \brief Randomized quasi-Monte Carlo model
+*/
+
+#ifndef quantlib_randomized_qmc_model_hpp
+#define quantlib_randomized_qmc_model_hpp
+
+#include <ql/methods/montecarlo/montecarlomodel.hpp>
+
+namespace QuantLib {
+
+    //! Randomized quasi-Monte Carlo model for path samples
+    /*! The samples are drawn in a number of independent
+        replications, each one using its own randomization of the
+        low-discrepancy sequence (e.g., a ScrambledSobolRsg with a
+        different seed) and running a MonteCarloModel of its own.
+        The result is the average of the means of the replications,
+        and its error is estimated from their dispersion; this gives
+        an error estimate for quasi-Monte Carlo simulations, whose
+        samples are not independent.
+
+        Each call to addSamples() adds the given number of samples
+        to each replication.  The replications run in parallel when
+        the library is compiled with OpenMP support; therefore, each
+        one needs its own path generator and path pricer.  The
+        results don't depend on the number of threads.
+
+        \ingroup mcarlo
+    */
+    template <template <class> class MC, class RNG, class S = Statistics>
+    class RandomizedQmcModel {
+      public:
+        typedef MonteCarloModel<MC,RNG,S> model_type;
+        typedef typename model_type::path_generator_type path_generator_type;
+        typedef typename model_type::path_pricer_type path_pricer_type;
+        typedef typename model_type::result_type result_type;
+        typedef S stats_type;
+        // constructor
+        RandomizedQmcModel(
+            const std::vector<boost::shared_ptr<path_generator_type> >&
+                                                              pathGenerators,
+            const std::vector<boost::shared_ptr<path_pricer_type> >&
+                                                              pathPricers,
+            bool antitheticVariate = false);
+        //! adds samples to each replication
+        void addSamples(Size samples);
+        Size replications() const { return models_.size(); }
+        //! accumulator of the samples of a single replication
+        const stats_type& sampleAccumulator(Size replication) const;
+        //! accumulator of the means of the replications
+        const stats_type& replicationAccumulator() const {
+            return replicationAccumulator_;
+        }
+        result_type mean() const {
+            return replicationAccumulator_.mean();
+        }
+        result_type errorEstimate() const {
+            return replicationAccumulator_.errorEstimate();
+        }
+      private:
+        std::vector<boost::shared_ptr<model_type> > models_;
+        stats_type replicationAccumulator_;
+    };
+
+
+    // inline definitions
+
+    template <template <class> class MC, class RNG, class S>
+    inline RandomizedQmcModel<MC,RNG,S>::RandomizedQmcModel(
+            const std::vector<boost::shared_ptr<path_generator_type> >&
+                                                              pathGenerators,
+            const std::vector<boost::shared_ptr<path_pricer_type> >&
+                                                              pathPricers,
+            bool antitheticVariate) {
+        QL_REQUIRE(pathGenerators.size() > 1,
+                   "at least two replications required");
+        QL_REQUIRE(pathPricers.size() == pathGenerators.size(),
+                   "mismatch between path generators ("
+                   << pathGenerators.size() << ") and path pricers ("
+                   << pathPricers.size() << ")");
+        models_.reserve(pathGenerators.size());
+        for (Size i=0; i<pathGenerators.size(); ++i) {
+            QL_REQUIRE(pathGenerators[i], "null path generator");
+            QL_REQUIRE(pathPricers[i], "null path pricer");
+            models_.push_back(boost::shared_ptr<model_type>(
+                new model_type(pathGenerators[i], pathPricers[i],
+                               stats_type(), antitheticVariate)));
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void RandomizedQmcModel<MC,RNG,S>::addSamples(Size samples) {
+        const Size n = models_.size();
+        std::vector<std::string> errors(n);
+
+        // the first replication draws a sample serially, as in
+        // MonteCarloModel
+        Size first = samples > 0 ? 1 : 0;
+        models_[0]->addSamples(first);
+
+        #pragma omp parallel for
+        for (long i=0; i<(long)n; ++i) {
+            try {
+                models_[i]->addSamples(i == 0 ? samples-first : samples);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "replication " << i << " failed: " << errors[i]);
+
+        replicationAccumulator_.reset();
+        for (Size i=0; i<n; ++i)
+            replicationAccumulator_.add(
+                                     models_[i]->sampleAccumulator().mean());
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline const typename RandomizedQmcModel<MC,RNG,S>::stats_type&
+    RandomizedQmcModel<MC,RNG,S>::sampleAccumulator(Size replication) const {
+        QL_REQUIRE(replication < models_.size(),
+                   "replication " << replication << " not available; only "
+                   << models_.size() << " replications");
+        return models_[replication]->sampleAccumulator();
+    }
+
+}
+
+
+#endif
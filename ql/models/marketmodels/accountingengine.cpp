@@ -20,19 +20,24 @@
 #include <ql/models/marketmodels/accountingengine.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/evolver.hpp>
+#include <ql/models/marketmodels/evolvers/blockevolveradapter.hpp>
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
     AccountingEngine::AccountingEngine(
                          const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
-                         Real initialNumeraireValue)
+                         Real initialNumeraireValue,
+                         Size workers,
+                         Size blockSize)
     : evolver_(evolver), product_(product),
       initialNumeraireValue_(initialNumeraireValue),
-      numberProducts_(product->numberOfProducts()),
+      numberProducts_(product->numberOfProducts()), workers_(workers),
+      blockSize_(blockSize),
       numerairesHeld_(product->numberOfProducts()),
       numberCashFlowsThisStep_(product->numberOfProducts()),
       cashFlowsGenerated_(product->numberOfProducts()) {
@@ -48,23 +53,25 @@ namespace QuantLib {
             discounters_.push_back(MarketModelDiscounter(cashFlowTimes[j],
                                                          rateTimes));
 
+        QL_REQUIRE(workers_ > 0, "at least one worker required");
     }
 
-    Real AccountingEngine::singlePathValues(std::vector<Real>& values) {
+    Real AccountingEngine::singlePathValues(MarketModelEvolver& evolver,
+                                            std::vector<Real>& values) {
         std::fill(numerairesHeld_.begin(), numerairesHeld_.end(), 0.0);
-        Real weight = evolver_->startNewPath();
+        Real weight = evolver.startNewPath();
         product_->reset();
         Real principalInNumerairePortfolio = 1.0;
 
         bool done = false;
         do {
-            Size thisStep = evolver_->currentStep();
-            weight *= evolver_->advanceStep();
-            done = product_->nextTimeStep(evolver_->currentState(),
+            Size thisStep = evolver.currentStep();
+            weight *= evolver.advanceStep();
+            done = product_->nextTimeStep(evolver.currentState(),
                                           numberCashFlowsThisStep_,
                                           cashFlowsGenerated_);
             Size numeraire =
-                evolver_->numeraires()[thisStep];
+                evolver.numeraires()[thisStep];
 
             // for each product...
             for (Size i=0; i<numberProducts_; ++i) {
@@ -79,7 +86,7 @@ namespace QuantLib {
                         discounters_[cashflows[j].timeIndex];
 
                     Real bonds = cashflows[j].amount *
-                        discounter.numeraireBonds(evolver_->currentState(),
+                        discounter.numeraireBonds(evolver.currentState(),
                                                   numeraire);
 
                     // ...and adding the newly bought bonds to the number
@@ -97,10 +104,10 @@ namespace QuantLib {
                 // the principal of the numeraire and updating the number
                 // of bonds in the numeraire portfolio accordingly.
 
-                Size nextNumeraire = evolver_->numeraires()[thisStep+1];
+                Size nextNumeraire = evolver.numeraires()[thisStep+1];
 
                 principalInNumerairePortfolio *=
-                    evolver_->currentState().discountRatio(numeraire,
+                    evolver.currentState().discountRatio(numeraire,
                                                            nextNumeraire);
             }
 
@@ -112,13 +119,88 @@ namespace QuantLib {
         return weight;
     }
 
+    void AccountingEngine::storePathValues(Size numberOfPaths,
+                                           std::vector<Real>& values,
+                                           std::vector<Real>& weights) {
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            blockEvolver(evolver_, numberOfPaths, blockSize_);
+        std::vector<Real> pathValues(numberProducts_);
+        for (Size i=0; i<numberOfPaths; ++i) {
+            weights.push_back(singlePathValues(*evolver, pathValues));
+            values.insert(values.end(), pathValues.begin(), pathValues.end());
+        }
+    }
+
     void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
                                               Size numberOfPaths)
     {
-        std::vector<Real> values(product_->numberOfProducts());
-        for (Size i=0; i<numberOfPaths; ++i) {
-            Real weight = singlePathValues(values);
-            stats.add(values,weight);
+        if (workers_ == 1 || numberOfPaths < workers_) {
+            boost::shared_ptr<MarketModelEvolver> evolver =
+                blockEvolver(evolver_, numberOfPaths, blockSize_);
+            std::vector<Real> values(product_->numberOfProducts());
+            for (Size i=0; i<numberOfPaths; ++i) {
+                Real weight = singlePathValues(*evolver, values);
+                stats.add(values,weight);
+            }
+            return;
+        }
+
+        std::vector<Size> chunks(workers_, numberOfPaths/workers_);
+        for (Size i=0; i<numberOfPaths%workers_; ++i)
+            ++chunks[i];
+
+        std::vector<std::vector<Real> > values(workers_), weights(workers_);
+        std::vector<Size> offsets(workers_, 0);
+        for (Size i=0; i<workers_; ++i) {
+            values[i].reserve(chunks[i]*numberProducts_);
+            weights[i].reserve(chunks[i]);
+            if (i > 0)
+                offsets[i] = offsets[i-1] + chunks[i-1];
+        }
+        std::vector<std::string> errors(workers_);
+
+        // the first path is simulated serially, as in MonteCarloModel
+        storePathValues(1, values[0], weights[0]);
+
+        // the first worker is this engine; the others copy a snapshot
+        // of the evolver and product, since the originals are used by
+        // the first worker while the others start
+        boost::shared_ptr<MarketModelEvolver> evolver = evolver_->clone();
+        Clone<MarketModelMultiProduct> product(product_);
+
+        #pragma omp parallel for
+        for (long i=0; i<(long)workers_; ++i) {
+            try {
+                if (i == 0) {
+                    storePathValues(chunks[0]-1, values[0], weights[0]);
+                    // move the evolver past the paths simulated by
+                    // the others
+                    evolver_->discard(numberOfPaths-chunks[0]);
+                } else {
+                    boost::shared_ptr<MarketModelEvolver> workerEvolver =
+                        evolver->clone();
+                    workerEvolver->discard(offsets[i]-1);
+                    AccountingEngine engine(workerEvolver, product,
+                                            initialNumeraireValue_,
+                                            1, blockSize_);
+                    engine.storePathValues(chunks[i],
+                                           values[i], weights[i]);
+                }
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<workers_; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "worker " << i << " failed: " << errors[i]);
+
+        for (Size i=0; i<workers_; ++i) {
+            std::vector<Real>::const_iterator v = values[i].begin();
+            for (Size j=0; j<weights[i].size(); ++j, v+=numberProducts_)
+                stats.add(v, v+numberProducts_, weights[i][j]);
         }
     }
 
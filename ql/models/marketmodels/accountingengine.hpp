@@ -41,21 +41,44 @@ namespace QuantLib {
     //struct MarketModelMultiProduct::CashFlow;
 
     //! Engine collecting cash flows along a market-model simulation
+    /*! If more than one worker is requested, the paths passed to
+        each call of multiplePathValues() are split in contiguous
+        blocks, one for each worker; the workers run in parallel when
+        the library is compiled with OpenMP support.  The first
+        worker uses the given evolver, while each of the others uses
+        a clone of both evolver and product, with its Brownian
+        generator skipped ahead to the start of its block.  The
+        values of each path are stored and added to the statistics in
+        path order, so that the results are the same as in a serial
+        simulation; the evolver must support cloning.
+
+        If a block size greater than 1 is passed and the evolver
+        supports block evolution, the paths are evolved in blocks of
+        that size through a BlockEvolverAdapter; the results are the
+        same up to rounding.
+    */
     class AccountingEngine {
       public:
         AccountingEngine(const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
-                         Real initialNumeraireValue);
+                         Real initialNumeraireValue,
+                         Size workers = 1,
+                         Size blockSize = 0);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
-        Real singlePathValues(std::vector<Real>& values);
+        Real singlePathValues(MarketModelEvolver& evolver,
+                              std::vector<Real>& values);
+        void storePathValues(Size numberOfPaths,
+                             std::vector<Real>& values,
+                             std::vector<Real>& weights);
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
         Clone<MarketModelMultiProduct> product_;
 
         Real initialNumeraireValue_;
         Size numberProducts_;
+        Size workers_, blockSize_;
 
         // workspace
         std::vector<Real> numerairesHeld_;
@@ -22,6 +22,8 @@
 #define quantlib_brownian_generator_hpp
 
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <ql/math/matrix.hpp>
 #include <boost/shared_ptr.hpp>
 #include <vector>
 
@@ -37,6 +39,57 @@ namespace QuantLib {
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
+
+        //! draws a block of paths
+        /*! On return, variates[i] contains the variates for the
+            i-th step, with one row per factor and one column per
+            path; weights contains the weight of each path, that is,
+            the product of the weights returned by nextPath() and by
+            nextStep() for each step.  The paths are the same that
+            would be returned by as many calls to nextPath(), each
+            followed by a call to nextStep() for each step.
+        */
+        virtual void nextPaths(Size paths,
+                               std::vector<Matrix>& variates,
+                               std::vector<Real>& weights) {
+            Size factors = numberOfFactors(), steps = numberOfSteps();
+            if (variates.size() != steps || (steps > 0 &&
+                                             variates[0].columns() != paths))
+                variates = std::vector<Matrix>(steps, Matrix(factors, paths));
+            weights.resize(paths);
+            std::vector<Real> step(factors);
+            for (Size p=0; p<paths; ++p) {
+                weights[p] = nextPath();
+                for (Size i=0; i<steps; ++i) {
+                    weights[p] *= nextStep(step);
+                    for (Size f=0; f<factors; ++f)
+                        variates[i][f][p] = step[f];
+                }
+            }
+        }
+
+        //! returns a copy of the generator in its current state
+        /*! The copy draws the same variates as the original from
+            that point onwards; together with discard(), this allows
+            a simulation to be split among workers drawing from
+            contiguous blocks of paths.
+        */
+        virtual boost::shared_ptr<BrownianGenerator> clone() const {
+            QL_FAIL("cloning not supported by this Brownian generator");
+        }
+        //! advance the generator as if n paths had been drawn
+        /*! The default implementation draws and discards the
+            variates; derived classes should override it when a
+            faster skip-ahead is available.
+        */
+        virtual void discard(Size n) {
+            std::vector<Real> variates(numberOfFactors());
+            for (Size i=0; i<n; ++i) {
+                nextPath();
+                for (Size j=0; j<numberOfSteps(); ++j)
+                    nextStep(variates);
+            }
+        }
     };
 
     class BrownianGeneratorFactory {
@@ -56,6 +56,16 @@ namespace QuantLib {
 
     Size MTBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    boost::shared_ptr<BrownianGenerator> MTBrownianGenerator::clone() const {
+        return boost::shared_ptr<BrownianGenerator>(
+                                               new MTBrownianGenerator(*this));
+    }
+
+    void MTBrownianGenerator::discard(Size n) {
+        generator_.discard(n);
+        lastStep_ = 0;
+    }
+
 
     MTBrownianGeneratorFactory::MTBrownianGeneratorFactory(unsigned long seed)
     : seed_(seed) {}
@@ -51,6 +51,9 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
+
+        boost::shared_ptr<BrownianGenerator> clone() const;
+        void discard(Size n);
       private:
         Size factors_, steps_;
         Size lastStep_;
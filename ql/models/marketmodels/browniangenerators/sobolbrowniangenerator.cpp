@@ -204,10 +204,20 @@ namespace QuantLib {
         return 1.0;
     }
 
+    void SobolBrownianGenerator::discard(Size n) {
+        generator_.discard(n);
+    }
+
     Size SobolBrownianGenerator::numberOfFactors() const { return factors_; }
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    boost::shared_ptr<BrownianGenerator>
+    SobolBrownianGenerator::clone() const {
+        return boost::shared_ptr<BrownianGenerator>(
+                                            new SobolBrownianGenerator(*this));
+    }
+
 
 
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
@@ -56,10 +56,14 @@ namespace QuantLib {
 
         Real nextPath();
         Real nextStep(std::vector<Real>&);
+        //! advance the generator as if n paths had been drawn
+        void discard(Size n);
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
-        
+
+        boost::shared_ptr<BrownianGenerator> clone() const;
+
         // test interface
         const std::vector<std::vector<Size> >& orderedIndices() const;
         std::vector<std::vector<Real> > transform(
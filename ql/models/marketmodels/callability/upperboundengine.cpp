@@ -29,6 +29,7 @@
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/callability/exercisevalue.hpp>
 #include <algorithm>
+#include <numeric>
 
 namespace QuantLib {
 
@@ -116,10 +117,13 @@ namespace QuantLib {
                    const MarketModelMultiProduct& hedge,
                    const MarketModelExerciseValue& hedgeRebate,
                    const ExerciseStrategy<CurveState>& hedgeStrategy,
-                   Real initialNumeraireValue)
+                   Real initialNumeraireValue,
+                   Size workers)
     : evolver_(evolver), innerEvolvers_(innerEvolvers),
       composite_(MultiProductComposite()),
-      initialNumeraireValue_(initialNumeraireValue) {
+      initialNumeraireValue_(initialNumeraireValue), workers_(workers) {
+
+        QL_REQUIRE(workers_ > 0, "at least one worker required");
 
         composite_.add(underlying);
         composite_.add(ExerciseAdapter(rebate));
@@ -148,6 +152,14 @@ namespace QuantLib {
         isExerciseTime_.resize(evolutionTimes.size());
         isExerciseTime_ = isInSubset(evolutionTimes,
                                      hedgeStrategy.exerciseTimes());
+        // no inner simulation is needed on the last step
+        innerSimulations_ = 0;
+        for (Size k=0; k+1<numberOfSteps_; ++k)
+            if (isExerciseTime_[k])
+                ++innerSimulations_;
+        QL_REQUIRE(innerEvolvers_.size() >= innerSimulations_,
+                   innerSimulations_ << " inner evolvers required, "
+                   << innerEvolvers_.size() << " given");
 
         numberCashFlowsThisStep_.resize(numberOfProducts_);
         cashFlowsGenerated_.resize(numberOfProducts_);
@@ -170,14 +182,133 @@ namespace QuantLib {
     void UpperBoundEngine::multiplePathValues(Statistics& stats,
                                               Size outerPaths,
                                               Size innerPaths) {
+        multiplePathValues(stats, outerPaths, innerPaths, innerPaths, 0.0);
+    }
+
+
+    void UpperBoundEngine::multiplePathValues(Statistics& stats,
+                                              Size outerPaths,
+                                              Size minInnerPaths,
+                                              Size maxInnerPaths,
+                                              Real innerTolerance) {
+        if (workers_ == 1 || outerPaths < workers_) {
+            std::vector<Real> values, weights;
+            storePathValues(outerPaths, minInnerPaths, maxInnerPaths,
+                            innerTolerance, values, weights);
+            for (Size j=0; j<values.size(); ++j)
+                stats.add(values[j], weights[j]);
+            return;
+        }
+
+        std::vector<Size> chunks(workers_, outerPaths/workers_);
+        for (Size i=0; i<outerPaths%workers_; ++i)
+            ++chunks[i];
+
+        std::vector<std::vector<Real> > values(workers_), weights(workers_);
+        std::vector<Size> offsets(workers_, 0);
+        for (Size i=0; i<workers_; ++i) {
+            values[i].reserve(chunks[i]);
+            weights[i].reserve(chunks[i]);
+            if (i > 0)
+                offsets[i] = offsets[i-1] + chunks[i-1];
+        }
+        std::vector<std::string> errors(workers_);
+
+        // the first path is simulated serially, as in MonteCarloModel
+        storePathValues(1, minInnerPaths, maxInnerPaths, innerTolerance,
+                        values[0], weights[0]);
+
+        // the first worker is this engine; the others copy a snapshot
+        // of its evolvers and products, since the originals are used
+        // by the first worker while the others start
+        boost::shared_ptr<UpperBoundEngine> snapshot = workerEngine(0, 0);
+
+        #pragma omp parallel for
+        for (long i=0; i<(long)workers_; ++i) {
+            try {
+                if (i == 0) {
+                    storePathValues(chunks[0]-1, minInnerPaths,
+                                    maxInnerPaths, innerTolerance,
+                                    values[0], weights[0]);
+                    // move the evolvers past the paths simulated by
+                    // the others
+                    discard(outerPaths-chunks[0], maxInnerPaths);
+                } else {
+                    snapshot->workerEngine(offsets[i]-1, maxInnerPaths)
+                        ->storePathValues(chunks[i], minInnerPaths,
+                                          maxInnerPaths, innerTolerance,
+                                          values[i], weights[i]);
+                }
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<workers_; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "worker " << i << " failed: " << errors[i]);
+
+        for (Size i=0; i<workers_; ++i)
+            for (Size j=0; j<values[i].size(); ++j)
+                stats.add(values[i][j], weights[i][j]);
+    }
+
+
+    void UpperBoundEngine::storePathValues(Size outerPaths,
+                                           Size minInnerPaths,
+                                           Size maxInnerPaths,
+                                           Real innerTolerance,
+                                           std::vector<Real>& values,
+                                           std::vector<Real>& weights) {
         for (Size i=0; i<outerPaths; ++i) {
-            std::pair<Real,Real> result = singlePathValue(innerPaths);
-            stats.add(result.first, result.second);
+            std::pair<Real,Real> result =
+                singlePathValue(minInnerPaths, maxInnerPaths, innerTolerance);
+            values.push_back(result.first);
+            weights.push_back(result.second);
         }
     }
 
 
+    boost::shared_ptr<UpperBoundEngine> UpperBoundEngine::workerEngine(
+                                     Size outerPaths,
+                                     Size innerPathsPerOuterPath) const {
+        boost::shared_ptr<UpperBoundEngine> engine(
+                                              new UpperBoundEngine(*this));
+        engine->evolver_ = evolver_->clone();
+        for (Size j=0; j<innerSimulations_; ++j)
+            engine->innerEvolvers_[j] = innerEvolvers_[j]->clone();
+        engine->discard(outerPaths, innerPathsPerOuterPath);
+        return engine;
+    }
+
+
+    void UpperBoundEngine::discard(Size outerPaths,
+                                   Size innerPathsPerOuterPath) {
+        evolver_->discard(outerPaths);
+        for (Size j=0; j<innerSimulations_; ++j)
+            innerEvolvers_[j]->discard(outerPaths*innerPathsPerOuterPath);
+    }
+
+
     std::pair<Real,Real> UpperBoundEngine::singlePathValue(Size innerPaths) {
+        return singlePathValue(innerPaths, innerPaths, 0.0);
+    }
+
+
+    std::pair<Real,Real> UpperBoundEngine::singlePathValue(
+                                                       Size minInnerPaths,
+                                                       Size maxInnerPaths,
+                                                       Real innerTolerance) {
+
+        QL_REQUIRE(minInnerPaths > 0, "at least one inner path required");
+        QL_REQUIRE(minInnerPaths <= maxInnerPaths,
+                   "minimum number of inner paths (" << minInnerPaths
+                   << ") greater than maximum (" << maxInnerPaths << ")");
+        QL_REQUIRE(minInnerPaths > 1 || minInnerPaths == maxInnerPaths,
+                   "at least two inner paths required "
+                   "for an adaptive inner simulation");
 
         DecoratedHedge& callable =
             dynamic_cast<DecoratedHedge&>(composite_.item(4));
@@ -192,6 +323,7 @@ namespace QuantLib {
         callable.disableCallability();
         Real principalInNumerairePortfolio = 1.0;
         Size exercise = 0;
+        std::vector<Size> unusedInnerPaths(innerSimulations_, 0);
 
         for (Size k=0; k<numberOfSteps_; ++k) {
             weight *= evolver_->advanceStep();
@@ -246,7 +378,7 @@ namespace QuantLib {
                     // rather than the beginning of the path.
 
                     boost::shared_ptr<MarketModelEvolver> currentEvolver =
-                        innerEvolvers_[exercise++];
+                        innerEvolvers_[exercise];
                     currentEvolver->setInitialState(evolver_->currentState());
 
                     callable.stopRecording();
@@ -258,7 +390,29 @@ namespace QuantLib {
                                             1.0); // this causes the result
                                                   // to be in numeraire units
                     SequenceStatisticsInc innerStats(callable.numberOfProducts());
-                    engine.multiplePathValues(innerStats, innerPaths);
+                    engine.multiplePathValues(innerStats, minInnerPaths);
+
+                    // add paths until the error on the total hedge
+                    // value, converted to cash, is small enough
+                    Real cashFactor =
+                        initialNumeraireValue_/principalInNumerairePortfolio;
+                    Size samples = innerStats.samples();
+                    while (samples < maxInnerPaths) {
+                        Matrix covariance = innerStats.covariance();
+                        Real variance = std::accumulate(covariance.begin(),
+                                                        covariance.end(),
+                                                        Real(0.0));
+                        Real error =
+                            std::sqrt(std::max(variance, Real(0.0))/samples)
+                            * cashFactor;
+                        if (error < innerTolerance)
+                            break;
+                        engine.multiplePathValues(
+                                innerStats,
+                                std::min(samples, maxInnerPaths-samples));
+                        samples = innerStats.samples();
+                    }
+                    unusedInnerPaths[exercise++] = maxInnerPaths-samples;
 
                     const std::vector<Real>& values = innerStats.mean();
                     unexercisedHedgeValue =
@@ -318,6 +472,10 @@ namespace QuantLib {
         // all done; we just convert the result back to cash
         maximumValue *= initialNumeraireValue_;
 
+        // the next path starts at the next block of inner paths
+        for (Size j=0; j<innerSimulations_; ++j)
+            innerEvolvers_[j]->discard(unusedInnerPaths[j]);
+
         return std::make_pair(maximumValue, weight);
     }
 
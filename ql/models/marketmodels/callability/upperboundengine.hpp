@@ -37,7 +37,24 @@ namespace QuantLib {
     class MarketModelExerciseValue;
 
     //! Market-model %engine for upper-bound estimation
-    /*! \pre product and hedge must have the same rate times
+    /*! The hedge value on each exercise date is estimated by an
+        inner simulation, run by an AccountingEngine on the inner
+        evolver for that date.  If more than one worker is requested,
+        the outer paths are split among the workers, each one using
+        copies of the evolvers and products that start at its own
+        block of outer paths; the results are the same as in a serial
+        simulation.  The evolvers must support cloning in this case.
+
+        The number of inner paths can also be chosen adaptively: the
+        inner simulation starts with the given minimum number of
+        paths, which is then doubled until the error estimate of the
+        hedge value (i.e., of the increment of the martingale used
+        for the upper bound) is below the required tolerance or the
+        maximum number of paths is reached.  Each outer path skips the
+        inner paths it didn't use, so that it always uses a block of
+        the maximum size from the inner Brownian streams.
+
+        \pre product and hedge must have the same rate times
              and exercise times
     */
     class UpperBoundEngine {
@@ -51,12 +68,35 @@ namespace QuantLib {
                    const MarketModelMultiProduct& hedge,
                    const MarketModelExerciseValue& hedgeRebate,
                    const ExerciseStrategy<CurveState>& hedgeStrategy,
-                   Real initialNumeraireValue);
+                   Real initialNumeraireValue,
+                   Size workers = 1);
         void multiplePathValues(Statistics& stats,
                                 Size outerPaths,
                                 Size innerPaths);
+        /*! \param innerTolerance absolute tolerance on the error
+                   estimate of the hedge value, in the same units as
+                   the results
+        */
+        void multiplePathValues(Statistics& stats,
+                                Size outerPaths,
+                                Size minInnerPaths,
+                                Size maxInnerPaths,
+                                Real innerTolerance);
         std::pair<Real,Real> singlePathValue(Size innerPaths);
+        std::pair<Real,Real> singlePathValue(Size minInnerPaths,
+                                             Size maxInnerPaths,
+                                             Real innerTolerance);
       private:
+        void storePathValues(Size outerPaths,
+                             Size minInnerPaths,
+                             Size maxInnerPaths,
+                             Real innerTolerance,
+                             std::vector<Real>& values,
+                             std::vector<Real>& weights);
+        boost::shared_ptr<UpperBoundEngine> workerEngine(
+                                           Size outerPaths,
+                                           Size innerPathsPerOuterPath) const;
+        void discard(Size outerPaths, Size innerPathsPerOuterPath);
         Real collectCashFlows(Size currentStep,
                               Real principalInNumerairePortfolio,
                               Size beginProduct,
@@ -67,11 +107,13 @@ namespace QuantLib {
         MultiProductComposite composite_;
 
         Real initialNumeraireValue_;
+        Size workers_;
         Size underlyingSize_, rebateSize_, hedgeSize_, hedgeRebateSize_;
         Size underlyingOffset_, rebateOffset_, hedgeOffset_, hedgeRebateOffset_;
         Size numberOfProducts_;
         Size numberOfSteps_;
         std::valarray<bool> isExerciseTime_;
+        Size innerSimulations_;
 
         // workspace
         std::vector<Size> numberCashFlowsThisStep_;
@@ -23,6 +23,7 @@
 
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -181,4 +182,117 @@ namespace QuantLib {
         }
     }
 
+    void LMMDriftCalculator::compute(const Matrix& fwds,
+                                     Matrix& drifts) const {
+        QL_REQUIRE(fwds.rows()==numberOfRates_,
+                   "number of forward rows (" << fwds.rows()
+                   << ") different from number of rates ("
+                   << numberOfRates_ << ")");
+        QL_REQUIRE(drifts.rows()==numberOfRates_ &&
+                   drifts.columns()==fwds.columns(),
+                   "drifts size (" << drifts.rows() << "x"
+                   << drifts.columns() << ") different from forwards size ("
+                   << fwds.rows() << "x" << fwds.columns() << ")");
+
+        if (isFullFactor_)
+            computePlain(fwds, drifts);
+        else
+            computeReduced(fwds, drifts);
+    }
+
+    void LMMDriftCalculator::computeForwardFactors(const Matrix& fwds) const {
+        Size paths = fwds.columns();
+        if (tmpBlock_.rows() != numberOfRates_ || tmpBlock_.columns() != paths)
+            tmpBlock_ = Matrix(numberOfRates_, paths, 0.0);
+
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = fwds.row_begin(i);
+            Real* t = tmpBlock_.row_begin(i);
+            Real displacement = displacements_[i];
+            Real oneOverTau = oneOverTaus_[i];
+            for (Size p=0; p<paths; ++p)
+                t[p] = (f[p]+displacement) / (oneOverTau+f[p]);
+        }
+    }
+
+    void LMMDriftCalculator::computePlain(const Matrix& fwds,
+                                          Matrix& drifts) const {
+
+        // Same as the single-path version; the inner product over
+        // rates is accumulated in the same order for each path.
+
+        computeForwardFactors(fwds);
+
+        Size paths = fwds.columns();
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            Real* d = drifts.row_begin(i);
+            std::fill(d, d+paths, 0.0);
+            for (Size j=downs_[i]; j<ups_[i]; ++j) {
+                const Real* t = tmpBlock_.row_begin(j);
+                Real c = C_[i][j];
+                for (Size p=0; p<paths; ++p)
+                    d[p] += t[p]*c;
+            }
+            if (numeraire_>i+1) {
+                for (Size p=0; p<paths; ++p)
+                    d[p] = -d[p];
+            }
+        }
+    }
+
+    void LMMDriftCalculator::computeReduced(const Matrix& fwds,
+                                            Matrix& drifts) const {
+
+        // Same as the single-path version; since e_[r][i] only
+        // depends on e_[r][i+1] (backward step) or e_[r][i-1]
+        // (forward step), a single row per factor is kept and
+        // updated in place.
+
+        computeForwardFactors(fwds);
+
+        Size paths = fwds.columns();
+        if (eBlock_.rows() != numberOfFactors_ || eBlock_.columns() != paths)
+            eBlock_ = Matrix(numberOfFactors_, paths);
+
+        // 1st step: the drift corresponding to the numeraire is zero.
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        // 2nd step: move backward from N-2 (included) back to alive
+        // (included), starting from e = 0 at N-1.
+        std::fill(eBlock_.begin(), eBlock_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Real* d = drifts.row_begin(i);
+            std::fill(d, d+paths, 0.0);
+            const Real* t = tmpBlock_.row_begin(i+1);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Real* e = eBlock_.row_begin(r);
+                Real a1 = pseudo_[i+1][r], a0 = pseudo_[i][r];
+                for (Size p=0; p<paths; ++p) {
+                    e[p] = e[p] + t[p] * a1;
+                    d[p] -= e[p]*a0;
+                }
+            }
+        }
+
+        // 3rd step: move forward from N (included) up to n (excluded),
+        // starting again from e = 0 at N-1.
+        std::fill(eBlock_.begin(), eBlock_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            Real* d = drifts.row_begin(i);
+            std::fill(d, d+paths, 0.0);
+            const Real* t = tmpBlock_.row_begin(i);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Real* e = eBlock_.row_begin(r);
+                Real a = pseudo_[i][r];
+                for (Size p=0; p<paths; ++p) {
+                    e[p] = e[p] + t[p] * a;
+                    d[p] += e[p]*a;
+                }
+            }
+        }
+    }
+
 }
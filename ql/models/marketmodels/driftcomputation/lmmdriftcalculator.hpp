@@ -64,7 +64,25 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! \name Block computation
+            The following methods compute the drifts for a block of
+            paths at once; forwards and drifts are stored with one
+            row per rate and one column per path, so that the inner
+            loops run across paths and can be vectorized by the
+            compiler.  For each path, the operations are performed in
+            the same order as in the single-path methods.
+        */
+        //@{
+        void compute(const Matrix& fwds,
+                     Matrix& drifts) const;
+        void computePlain(const Matrix& fwds,
+                          Matrix& drifts) const;
+        void computeReduced(const Matrix& fwds,
+                            Matrix& drifts) const;
+        //@}
+
       private:
+        void computeForwardFactors(const Matrix& fwds) const;
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
         Size numeraire_, alive_;
@@ -74,6 +92,7 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix tmpBlock_, eBlock_;
         std::vector<Size> downs_, ups_;
     };
 
@@ -22,11 +22,14 @@
 #define quantlib_market_model_evolver_hpp
 
 #include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <boost/shared_ptr.hpp>
 #include <vector>
 
 namespace QuantLib {
 
     class CurveState;
+    class Matrix;
 
     //! Market-model evolver
     /*! Abstract base class. The evolver does the actual gritty work of
@@ -42,6 +45,58 @@ namespace QuantLib {
         virtual Size currentStep() const = 0;
         virtual const CurveState& currentState() const = 0;
         virtual void setInitialState(const CurveState&) = 0;
+
+        //! returns a copy of the evolver in its current state
+        /*! The copy owns a copy of the Brownian generator, so that it
+            can be used concurrently with the original; from that
+            point onwards, the two evolvers generate the same paths.
+        */
+        virtual boost::shared_ptr<MarketModelEvolver> clone() const {
+            QL_FAIL("cloning not supported by this evolver");
+        }
+        //! advance the evolver as if n paths had been generated
+        /*! The default implementation evolves and discards the
+            paths; derived classes should override it by skipping
+            ahead their Brownian generator.
+        */
+        virtual void discard(Size n) {
+            for (Size i=0; i<n; ++i) {
+                startNewPath();
+                while (currentStep() < numeraires().size())
+                    advanceStep();
+            }
+        }
+
+        /*! \name Block interface
+            Evolvers can also evolve a block of paths at once; in
+            this case, the forwards are stored with one row per rate
+            and one column per path, so that the calculations can be
+            vectorized across paths.  The paths are the same, up to
+            rounding, that would be generated by as many calls to
+            startNewPath() and advanceStep().  BlockEvolverAdapter
+            returns them one at a time through the single-path
+            interface.
+        */
+        //@{
+        //! whether the evolver implements the block interface
+        virtual bool supportsBlocks() const {
+            return false;
+        }
+        virtual void startNewPaths(Size) {
+            QL_FAIL("block evolution not supported by this evolver");
+        }
+        virtual void advanceSteps() {
+            QL_FAIL("block evolution not supported by this evolver");
+        }
+        //! forwards of the current block, one column per path
+        virtual const Matrix& currentForwards() const {
+            QL_FAIL("block evolution not supported by this evolver");
+        }
+        //! weights of the paths in the current block
+        virtual const std::vector<Real>& pathWeights() const {
+            QL_FAIL("block evolution not supported by this evolver");
+        }
+        //@}
     };
 
 }
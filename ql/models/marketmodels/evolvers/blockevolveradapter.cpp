@@ -0,0 +1,98 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/blockevolveradapter.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    BlockEvolverAdapter::BlockEvolverAdapter(
+                       const boost::shared_ptr<MarketModelEvolver>& evolver,
+                       Size paths,
+                       Size blockSize)
+    : evolver_(evolver), remainingPaths_(paths), blockSize_(blockSize),
+      initialStep_(0), currentStep_(0), currentPath_(0), nextPath_(0),
+      pathForwards_(evolver->currentState().numberOfRates()),
+      curveState_(evolver->currentState().rateTimes()) {
+        QL_REQUIRE(evolver_->supportsBlocks(),
+                   "block evolution not supported by the given evolver");
+        QL_REQUIRE(blockSize_ > 0, "null block size");
+    }
+
+    const std::vector<Size>& BlockEvolverAdapter::numeraires() const {
+        return evolver_->numeraires();
+    }
+
+    void BlockEvolverAdapter::evolveBlock() {
+        QL_REQUIRE(remainingPaths_ > 0, "no more paths available");
+        Size paths = std::min(blockSize_, remainingPaths_);
+        evolver_->startNewPaths(paths);
+        initialStep_ = evolver_->currentStep();
+        Size steps = evolver_->numeraires().size() - initialStep_;
+        forwards_.resize(steps);
+        for (Size i=0; i<steps; ++i) {
+            evolver_->advanceSteps();
+            forwards_[i] = evolver_->currentForwards();
+        }
+        weights_ = evolver_->pathWeights();
+        remainingPaths_ -= paths;
+        nextPath_ = 0;
+    }
+
+    Real BlockEvolverAdapter::startNewPath() {
+        if (nextPath_ == weights_.size())
+            evolveBlock();
+        currentPath_ = nextPath_++;
+        currentStep_ = initialStep_;
+        return weights_[currentPath_];
+    }
+
+    Real BlockEvolverAdapter::advanceStep() {
+        const Matrix& forwards = forwards_[currentStep_-initialStep_];
+        for (Size i=0; i<pathForwards_.size(); ++i)
+            pathForwards_[i] = forwards[i][currentPath_];
+        curveState_.setOnForwardRates(pathForwards_);
+        ++currentStep_;
+        return 1.0;
+    }
+
+    Size BlockEvolverAdapter::currentStep() const {
+        return currentStep_;
+    }
+
+    const CurveState& BlockEvolverAdapter::currentState() const {
+        return curveState_;
+    }
+
+    void BlockEvolverAdapter::setInitialState(const CurveState&) {
+        QL_FAIL("setting the initial state is not supported; "
+                "set it on the underlying evolver instead");
+    }
+
+
+    boost::shared_ptr<MarketModelEvolver> blockEvolver(
+                       const boost::shared_ptr<MarketModelEvolver>& evolver,
+                       Size paths,
+                       Size blockSize) {
+        if (blockSize > 1 && paths > 1 && evolver->supportsBlocks())
+            return boost::shared_ptr<MarketModelEvolver>(
+                           new BlockEvolverAdapter(evolver, paths, blockSize));
+        else
+            return evolver;
+    }
+
+}
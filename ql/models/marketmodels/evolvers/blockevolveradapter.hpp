@@ -0,0 +1,82 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blockevolveradapter.hpp
+    \brief single-path access to paths evolved in blocks
+*/
+
+#ifndef quantlib_block_evolver_adapter_hpp
+#define quantlib_block_evolver_adapter_hpp
+
+#include <ql/models/marketmodels/evolver.hpp>
+#include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! single-path interface to an evolver working on blocks of paths
+    /*! The adapter evolves the next given number of paths of the
+        underlying evolver in blocks of the given size, and returns
+        them one at a time through the single-path interface.  When
+        all of them were returned, the underlying evolver is
+        positioned after them.
+
+        Each block is evolved up to the last step when its first
+        path is started; therefore, startNewPath() returns the weight
+        of the whole path and advanceStep() returns 1.0.
+
+        \pre the underlying evolver must support block evolution
+    */
+    class BlockEvolverAdapter : public MarketModelEvolver {
+      public:
+        BlockEvolverAdapter(
+                       const boost::shared_ptr<MarketModelEvolver>& evolver,
+                       Size paths,
+                       Size blockSize);
+        //! \name MarketModelEvolver interface
+        //@{
+        const std::vector<Size>& numeraires() const;
+        Real startNewPath();
+        Real advanceStep();
+        Size currentStep() const;
+        const CurveState& currentState() const;
+        void setInitialState(const CurveState&);
+        //@}
+      private:
+        void evolveBlock();
+        boost::shared_ptr<MarketModelEvolver> evolver_;
+        Size remainingPaths_, blockSize_;
+        std::vector<Matrix> forwards_;
+        std::vector<Real> weights_;
+        Size initialStep_, currentStep_, currentPath_, nextPath_;
+        std::vector<Rate> pathForwards_;
+        LMMCurveState curveState_;
+    };
+
+    /*! returns an evolver generating the next paths of the given
+        one, in blocks of the given size if the latter supports block
+        evolution and the size is greater than 1; otherwise, returns
+        the evolver itself.
+    */
+    boost::shared_ptr<MarketModelEvolver> blockEvolver(
+                       const boost::shared_ptr<MarketModelEvolver>& evolver,
+                       Size paths,
+                       Size blockSize);
+
+}
+
+#endif
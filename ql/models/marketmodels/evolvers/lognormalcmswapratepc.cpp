@@ -156,6 +156,18 @@ namespace QuantLib {
         return currentStep_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalCmSwapRatePc::clone() const {
+        boost::shared_ptr<LogNormalCmSwapRatePc> evolver(
+                                             new LogNormalCmSwapRatePc(*this));
+        evolver->generator_ = generator_->clone();
+        return evolver;
+    }
+
+    void LogNormalCmSwapRatePc::discard(Size n) {
+        generator_->discard(n);
+    }
+
     const CurveState& LogNormalCmSwapRatePc::currentState() const {
         return curveState_;
     }
@@ -153,6 +153,18 @@ namespace QuantLib {
         return currentStep_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalCotSwapRatePc::clone() const {
+        boost::shared_ptr<LogNormalCotSwapRatePc> evolver(
+                                            new LogNormalCotSwapRatePc(*this));
+        evolver->generator_ = generator_->clone();
+        return evolver;
+    }
+
+    void LogNormalCotSwapRatePc::discard(Size n) {
+        generator_->discard(n);
+    }
+
     const CurveState& LogNormalCotSwapRatePc::currentState() const {
         return curveState_;
     }
@@ -150,6 +150,18 @@ namespace QuantLib {
         return currentStep_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateBalland::clone() const {
+        boost::shared_ptr<LogNormalFwdRateBalland> evolver(
+                                           new LogNormalFwdRateBalland(*this));
+        evolver->generator_ = generator_->clone();
+        return evolver;
+    }
+
+    void LogNormalFwdRateBalland::discard(Size n) {
+        generator_->discard(n);
+    }
+
     const CurveState& LogNormalFwdRateBalland::currentState() const {
         return curveState_;
     }
@@ -23,6 +23,7 @@
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/browniangenerator.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -139,8 +140,94 @@ namespace QuantLib {
         return currentStep_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateEuler::clone() const {
+        boost::shared_ptr<LogNormalFwdRateEuler> evolver(
+                                             new LogNormalFwdRateEuler(*this));
+        evolver->generator_ = generator_->clone();
+        return evolver;
+    }
+
+    void LogNormalFwdRateEuler::discard(Size n) {
+        generator_->discard(n);
+    }
+
     const CurveState& LogNormalFwdRateEuler::currentState() const {
         return curveState_;
     }
 
+    void LogNormalFwdRateEuler::startNewPaths(Size paths) {
+        QL_REQUIRE(paths > 0, "at least one path required");
+        currentStep_ = initialStep_;
+        generator_->nextPaths(paths, blockBrownians_, blockWeights_);
+        if (blockForwards_.columns() != paths) {
+            blockForwards_ = Matrix(numberOfRates_, paths);
+            blockLogForwards_ = Matrix(numberOfRates_, paths);
+            blockDrifts1_ = Matrix(numberOfRates_, paths);
+            blockDiffusion_.resize(paths);
+        }
+        // rates that are already dead keep their initial value
+        for (Size i=0; i<numberOfRates_; ++i) {
+            std::fill(blockLogForwards_.row_begin(i),
+                      blockLogForwards_.row_end(i),
+                      initialLogForwards_[i]);
+            std::fill(blockForwards_.row_begin(i),
+                      blockForwards_.row_end(i),
+                      std::exp(initialLogForwards_[i]) - displacements_[i]);
+        }
+    }
+
+    void LogNormalFwdRateEuler::advanceSteps() {
+        Size paths = blockForwards_.columns();
+        QL_REQUIRE(paths > 0, "no block of paths started");
+
+        // we're going from T1 to T2
+
+        // a) compute drifts D1 at T1;
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].compute(blockForwards_, blockDrifts1_);
+        } else {
+            for (Size i=0; i<numberOfRates_; ++i)
+                std::fill(blockDrifts1_.row_begin(i),
+                          blockDrifts1_.row_end(i), initialDrifts_[i]);
+        }
+
+        // b) evolve forwards up to T2 using D1;
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        const Matrix& brownians = blockBrownians_[currentStep_-initialStep_];
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+        std::vector<Real>& w = blockDiffusion_;
+
+        Size alive = alive_[currentStep_];
+        for (Size i=alive; i<numberOfRates_; i++) {
+            // diffusion term, accumulated as in std::inner_product
+            std::fill(w.begin(), w.end(), 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real* z = brownians.row_begin(r);
+                Real a = A[i][r];
+                for (Size p=0; p<paths; ++p)
+                    w[p] += a*z[p];
+            }
+            Real* logForwards = blockLogForwards_.row_begin(i);
+            Real* forwards = blockForwards_.row_begin(i);
+            const Real* drifts1 = blockDrifts1_.row_begin(i);
+            Real fixed = fixedDrift[i], displacement = displacements_[i];
+            for (Size p=0; p<paths; ++p) {
+                logForwards[p] += drifts1[p] + fixed;
+                logForwards[p] += w[p];
+                forwards[p] = std::exp(logForwards[p]) - displacement;
+            }
+        }
+
+        ++currentStep_;
+    }
+
+    const Matrix& LogNormalFwdRateEuler::currentForwards() const {
+        return blockForwards_;
+    }
+
+    const std::vector<Real>& LogNormalFwdRateEuler::pathWeights() const {
+        return blockWeights_;
+    }
+
 }
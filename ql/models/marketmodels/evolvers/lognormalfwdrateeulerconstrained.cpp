@@ -230,6 +230,18 @@ namespace QuantLib {
         return currentStep_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateEulerConstrained::clone() const {
+        boost::shared_ptr<LogNormalFwdRateEulerConstrained> evolver(
+                                  new LogNormalFwdRateEulerConstrained(*this));
+        evolver->generator_ = generator_->clone();
+        return evolver;
+    }
+
+    void LogNormalFwdRateEulerConstrained::discard(Size n) {
+        generator_->discard(n);
+    }
+
     const CurveState& LogNormalFwdRateEulerConstrained::currentState() const {
         return curveState_;
     }
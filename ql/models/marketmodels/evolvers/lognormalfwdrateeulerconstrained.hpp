@@ -58,6 +58,8 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        boost::shared_ptr<MarketModelEvolver> clone() const;
+        void discard(Size n);
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
@@ -152,6 +152,18 @@ namespace QuantLib {
         return currentStep_;
     }
 
+    boost::shared_ptr<MarketModelEvolver>
+    LogNormalFwdRateiBalland::clone() const {
+        boost::shared_ptr<LogNormalFwdRateiBalland> evolver(
+                                          new LogNormalFwdRateiBalland(*this));
+        evolver->generator_ = generator_->clone();
+        return evolver;
+    }
+
+    void LogNormalFwdRateiBalland::discard(Size n) {
+        generator_->discard(n);
+    }
+
     const CurveState& LogNormalFwdRateiBalland::currentState() const {
         return curveState_;
     }
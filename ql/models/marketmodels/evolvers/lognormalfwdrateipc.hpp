@@ -23,6 +23,7 @@
 
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
@@ -46,6 +47,16 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        boost::shared_ptr<MarketModelEvolver> clone() const;
+        void discard(Size n);
+        //@}
+        //! \name Block interface
+        //@{
+        bool supportsBlocks() const { return true; }
+        void startNewPaths(Size paths);
+        void advanceSteps();
+        const Matrix& currentForwards() const;
+        const std::vector<Real>& pathWeights() const;
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
@@ -66,6 +77,10 @@ namespace QuantLib {
         std::vector<Time> rateTaus_;
         std::vector<Size> alive_;
         //std::vector<Matrix> C_;
+        // block working variables
+        Matrix blockForwards_, blockLogForwards_, blockDrifts1_, blockG_;
+        std::vector<Matrix> blockBrownians_;
+        std::vector<Real> blockWeights_, blockDiffusion_;
         // helper classes
         std::vector<LMMDriftCalculator> calculators_;
     };
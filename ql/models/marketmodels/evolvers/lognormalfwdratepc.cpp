@@ -23,6 +23,7 @@
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/browniangenerator.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -148,8 +149,110 @@ namespace QuantLib {
         return currentStep_;
     }
 
+    boost::shared_ptr<MarketModelEvolver> LogNormalFwdRatePc::clone() const {
+        boost::shared_ptr<LogNormalFwdRatePc> evolver(
+                                                new LogNormalFwdRatePc(*this));
+        evolver->generator_ = generator_->clone();
+        return evolver;
+    }
+
+    void LogNormalFwdRatePc::discard(Size n) {
+        generator_->discard(n);
+    }
+
     const CurveState& LogNormalFwdRatePc::currentState() const {
         return curveState_;
     }
 
+    void LogNormalFwdRatePc::startNewPaths(Size paths) {
+        QL_REQUIRE(paths > 0, "at least one path required");
+        currentStep_ = initialStep_;
+        generator_->nextPaths(paths, blockBrownians_, blockWeights_);
+        if (blockForwards_.columns() != paths) {
+            blockForwards_ = Matrix(numberOfRates_, paths);
+            blockLogForwards_ = Matrix(numberOfRates_, paths);
+            blockDrifts1_ = Matrix(numberOfRates_, paths);
+            blockDrifts2_ = Matrix(numberOfRates_, paths);
+            blockDiffusion_.resize(paths);
+        }
+        // rates that are already dead keep their initial value
+        for (Size i=0; i<numberOfRates_; ++i) {
+            std::fill(blockLogForwards_.row_begin(i),
+                      blockLogForwards_.row_end(i),
+                      initialLogForwards_[i]);
+            std::fill(blockForwards_.row_begin(i),
+                      blockForwards_.row_end(i),
+                      std::exp(initialLogForwards_[i]) - displacements_[i]);
+        }
+    }
+
+    void LogNormalFwdRatePc::advanceSteps() {
+        Size paths = blockForwards_.columns();
+        QL_REQUIRE(paths > 0, "no block of paths started");
+
+        // we're going from T1 to T2
+
+        // a) compute drifts D1 at T1;
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].compute(blockForwards_, blockDrifts1_);
+        } else {
+            for (Size i=0; i<numberOfRates_; ++i)
+                std::fill(blockDrifts1_.row_begin(i),
+                          blockDrifts1_.row_end(i), initialDrifts_[i]);
+        }
+
+        // b) evolve forwards up to T2 using D1;
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        const Matrix& brownians = blockBrownians_[currentStep_-initialStep_];
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+        std::vector<Real>& w = blockDiffusion_;
+
+        Size i, alive = alive_[currentStep_];
+        for (i=alive; i<numberOfRates_; ++i) {
+            // diffusion term, accumulated as in std::inner_product
+            std::fill(w.begin(), w.end(), 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real* z = brownians.row_begin(r);
+                Real a = A[i][r];
+                for (Size p=0; p<paths; ++p)
+                    w[p] += a*z[p];
+            }
+            Real* logForwards = blockLogForwards_.row_begin(i);
+            Real* forwards = blockForwards_.row_begin(i);
+            const Real* drifts1 = blockDrifts1_.row_begin(i);
+            Real fixed = fixedDrift[i], displacement = displacements_[i];
+            for (Size p=0; p<paths; ++p) {
+                logForwards[p] += drifts1[p] + fixed;
+                logForwards[p] += w[p];
+                forwards[p] = std::exp(logForwards[p]) - displacement;
+            }
+        }
+
+        // c) recompute drifts D2 using the predicted forwards;
+        calculators_[currentStep_].compute(blockForwards_, blockDrifts2_);
+
+        // d) correct forwards using both drifts
+        for (i=alive; i<numberOfRates_; ++i) {
+            Real* logForwards = blockLogForwards_.row_begin(i);
+            Real* forwards = blockForwards_.row_begin(i);
+            const Real* drifts1 = blockDrifts1_.row_begin(i);
+            const Real* drifts2 = blockDrifts2_.row_begin(i);
+            Real displacement = displacements_[i];
+            for (Size p=0; p<paths; ++p) {
+                logForwards[p] += (drifts2[p]-drifts1[p])/2.0;
+                forwards[p] = std::exp(logForwards[p]) - displacement;
+            }
+        }
+
+        ++currentStep_;
+    }
+
+    const Matrix& LogNormalFwdRatePc::currentForwards() const {
+        return blockForwards_;
+    }
+
+    const std::vector<Real>& LogNormalFwdRatePc::pathWeights() const {
+        return blockWeights_;
+    }
+
 }
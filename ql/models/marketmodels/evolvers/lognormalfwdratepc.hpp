@@ -46,6 +46,16 @@ namespace QuantLib {
         Size currentStep() const;
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
+        boost::shared_ptr<MarketModelEvolver> clone() const;
+        void discard(Size n);
+        //@}
+        //! \name Block interface
+        //@{
+        bool supportsBlocks() const { return true; }
+        void startNewPaths(Size paths);
+        void advanceSteps();
+        const Matrix& currentForwards() const;
+        const std::vector<Real>& pathWeights() const;
         //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
@@ -64,6 +74,10 @@ namespace QuantLib {
         std::vector<Real> drifts1_, drifts2_, initialDrifts_;
         std::vector<Real> brownians_, correlatedBrownians_;
         std::vector<Size> alive_;
+        // block working variables
+        Matrix blockForwards_, blockLogForwards_, blockDrifts1_, blockDrifts2_;
+        std::vector<Matrix> blockBrownians_;
+        std::vector<Real> blockWeights_, blockDiffusion_;
         // helper classes
         std::vector<LMMDriftCalculator> calculators_;
     };
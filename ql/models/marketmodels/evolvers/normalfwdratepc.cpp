@@ -139,6 +139,17 @@ namespace QuantLib {
         return currentStep_;
     }
 
+    boost::shared_ptr<MarketModelEvolver> NormalFwdRatePc::clone() const {
+        boost::shared_ptr<NormalFwdRatePc> evolver(
+                                                   new NormalFwdRatePc(*this));
+        evolver->generator_ = generator_->clone();
+        return evolver;
+    }
+
+    void NormalFwdRatePc::discard(Size n) {
+        generator_->discard(n);
+    }
+
     const CurveState& NormalFwdRatePc::currentState() const {
         return curveState_;
     }
@@ -20,20 +20,25 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/pathwiseaccountingengine.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
+#include <ql/models/marketmodels/evolvers/blockevolveradapter.hpp>
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/marketmodel.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
     PathwiseAccountingEngine::PathwiseAccountingEngine(const boost::shared_ptr<LogNormalFwdRateEuler>& evolver, // method relies heavily on LMM Euler
         const Clone<MarketModelPathwiseMultiProduct>& product,
         const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
-        Real initialNumeraireValue)
+        Real initialNumeraireValue,
+        Size workers,
+        Size blockSize)
         : evolver_(evolver), product_(product),pseudoRootStructure_(pseudoRootStructure),
         initialNumeraireValue_(initialNumeraireValue),
         numberProducts_(product->numberOfProducts()),
+        workers_(workers), blockSize_(blockSize),
         doDeflation_(!product->alreadyDeflated()),
         numerairesHeld_(product->numberOfProducts()),
         numberCashFlowsThisStep_(product->numberOfProducts()),
@@ -115,9 +120,12 @@ namespace QuantLib {
         }
 
         partials_ = Matrix(pseudoRootStructure_->numberOfFactors(),numberRates_);
+
+        QL_REQUIRE(workers_ > 0, "at least one worker required");
     }
 
-    Real PathwiseAccountingEngine::singlePathValues(std::vector<Real>& values)
+    Real PathwiseAccountingEngine::singlePathValues(MarketModelEvolver& evolver,
+                                                    std::vector<Real>& values)
     {
 
         const std::vector<Real> initialForwards_(pseudoRootStructure_->initialRates());
@@ -143,32 +151,32 @@ namespace QuantLib {
 
 
 
-        Real weight = evolver_->startNewPath();
+        Real weight = evolver.startNewPath();
         product_->reset();
 
         Size thisStep;
 
         bool done = false;
         do {
-            thisStep = evolver_->currentStep();
+            thisStep = evolver.currentStep();
             Size storeStep = thisStep+1;
-            weight *= evolver_->advanceStep();
+            weight *= evolver.advanceStep();
 
-            done = product_->nextTimeStep(evolver_->currentState(),
+            done = product_->nextTimeStep(evolver.currentState(),
                 numberCashFlowsThisStep_,
                 cashFlowsGenerated_);
 
             lastForwards_ = currentForwards_;
-            currentForwards_ =  evolver_->currentState().forwardRates();
+            currentForwards_ =  evolver.currentState().forwardRates();
 
             for (unsigned long i=0; i < numberRates_; ++i)
             {
-                Real x=  evolver_->currentState().discountRatio(i+1,i);
+                Real x=  evolver.currentState().discountRatio(i+1,i);
                 StepsDiscountsSquared_[storeStep][i] = x*x;
 
                 LIBORRatios_[storeStep][i] = currentForwards_[i]/lastForwards_[i];
                 LIBORRates_[storeStep][i] = currentForwards_[i];
-                Discounts_[storeStep][i+1] = evolver_->currentState().discountRatio(i+1,0);
+                Discounts_[storeStep][i+1] = evolver.currentState().discountRatio(i+1,0);
             }
 
             // for each product...
@@ -309,14 +317,101 @@ namespace QuantLib {
         return 1.0; // we have put the weight in already, this results in lower variance since weight changes along the path
     }
 
+    void PathwiseAccountingEngine::storePathValues(Size numberOfPaths,
+        std::vector<Real>& values,
+        std::vector<Real>& weights)
+    {
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            blockEvolver(evolver_, numberOfPaths, blockSize_);
+        std::vector<Real> pathValues(numberProducts_*(numberRates_+1));
+        for (Size i=0; i<numberOfPaths; ++i)
+        {
+            weights.push_back(singlePathValues(*evolver, pathValues));
+            values.insert(values.end(), pathValues.begin(), pathValues.end());
+        }
+    }
+
     void PathwiseAccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
         Size numberOfPaths)
     {
-        std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
-        for (Size i=0; i<numberOfPaths; ++i)
+        if (workers_ == 1 || numberOfPaths < workers_)
+        {
+            boost::shared_ptr<MarketModelEvolver> evolver =
+                blockEvolver(evolver_, numberOfPaths, blockSize_);
+            std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
+            for (Size i=0; i<numberOfPaths; ++i)
+            {
+                Real weight = singlePathValues(*evolver, values);
+                stats.add(values,weight);
+            }
+            return;
+        }
+
+        Size dimension = numberProducts_*(numberRates_+1);
+        std::vector<Size> chunks(workers_, numberOfPaths/workers_);
+        for (Size i=0; i<numberOfPaths%workers_; ++i)
+            ++chunks[i];
+
+        std::vector<std::vector<Real> > values(workers_), weights(workers_);
+        std::vector<Size> offsets(workers_, 0);
+        for (Size i=0; i<workers_; ++i)
+        {
+            values[i].reserve(chunks[i]*dimension);
+            weights[i].reserve(chunks[i]);
+            if (i > 0)
+                offsets[i] = offsets[i-1] + chunks[i-1];
+        }
+        std::vector<std::string> errors(workers_);
+
+        // the first path is simulated serially, as in MonteCarloModel
+        storePathValues(1, values[0], weights[0]);
+
+        // the first worker is this engine; the others copy a snapshot
+        // of the evolver and product, since the originals are used by
+        // the first worker while the others start
+        boost::shared_ptr<MarketModelEvolver> evolver = evolver_->clone();
+        Clone<MarketModelPathwiseMultiProduct> product(product_);
+
+        #pragma omp parallel for
+        for (long i=0; i<(long)workers_; ++i)
+        {
+            try {
+                if (i == 0)
+                {
+                    storePathValues(chunks[0]-1, values[0], weights[0]);
+                    // move the evolver past the paths simulated by
+                    // the others
+                    evolver_->discard(numberOfPaths-chunks[0]);
+                }
+                else
+                {
+                    boost::shared_ptr<LogNormalFwdRateEuler> workerEvolver =
+                        boost::dynamic_pointer_cast<LogNormalFwdRateEuler>(
+                                                            evolver->clone());
+                    workerEvolver->discard(offsets[i]-1);
+                    PathwiseAccountingEngine engine(workerEvolver, product,
+                                                    pseudoRootStructure_,
+                                                    initialNumeraireValue_,
+                                                    1, blockSize_);
+                    engine.storePathValues(chunks[i],
+                                           values[i], weights[i]);
+                }
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<workers_; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "worker " << i << " failed: " << errors[i]);
+
+        for (Size i=0; i<workers_; ++i)
         {
-            Real weight = singlePathValues(values);
-            stats.add(values,weight);
+            std::vector<Real>::const_iterator v = values[i].begin();
+            for (Size j=0; j<weights[i].size(); ++j, v+=dimension)
+                stats.add(v, v+dimension, weights[i][j]);
         }
     }
 
@@ -33,6 +33,7 @@
 
 namespace QuantLib {
 
+    class MarketModelEvolver;
     class LogNormalFwdRateEuler;
     class MarketModel;
 
@@ -41,18 +42,25 @@ namespace QuantLib {
     // using Giles--Glasserman smoking adjoints method
     // note only works with displaced LMM, and requires knowledge of pseudo-roots and displacements 
     // This is tested in MarketModelTest::testPathwiseGreeks
+    // Paths can be split among parallel workers and evolved in blocks as in AccountingEngine
     class PathwiseAccountingEngine 
     {
       public:
         PathwiseAccountingEngine(const boost::shared_ptr<LogNormalFwdRateEuler>& evolver, // method relies heavily on LMM Euler
                          const Clone<MarketModelPathwiseMultiProduct>& product,
                          const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
-                         Real initialNumeraireValue);
+                         Real initialNumeraireValue,
+                         Size workers = 1,
+                         Size blockSize = 0);
 
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
-          Real singlePathValues(std::vector<Real>& values);
+          Real singlePathValues(MarketModelEvolver& evolver,
+                                std::vector<Real>& values);
+          void storePathValues(Size numberOfPaths,
+                               std::vector<Real>& values,
+                               std::vector<Real>& weights);
 
         boost::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
@@ -63,6 +71,7 @@ namespace QuantLib {
         Size numberRates_;
         Size numberCashFlowTimes_;
         Size numberSteps_;
+        Size workers_, blockSize_;
 
         std::vector<Real> currentForwards_, lastForwards_;
 
@@ -22,7 +22,9 @@
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/constrainedevolver.hpp>
+#include <ql/models/marketmodels/evolvers/blockevolveradapter.hpp>
 #include <algorithm>
+#include <string>
 
 namespace QuantLib {
 
@@ -35,14 +37,17 @@ namespace QuantLib {
             const std::vector<Size>& startIndexOfConstraint,
             const std::vector<Size>& endIndexOfConstraint,
             const Clone<MarketModelMultiProduct>& product,
-            Real initialNumeraireValue)
+            Real initialNumeraireValue,
+            Size workers,
+            Size blockSize)
     : originalEvolver_(evolver), constrainedEvolvers_(constrainedEvolvers),
       diffWeights_(diffWeights),
       startIndexOfConstraint_(startIndexOfConstraint),
       endIndexOfConstraint_(endIndexOfConstraint),
       product_(product),
       initialNumeraireValue_(initialNumeraireValue),
-      numberProducts_(product->numberOfProducts()),
+      numberProducts_(product->numberOfProducts()), workers_(workers),
+      blockSize_(blockSize),
       numerairesHeld_(product->numberOfProducts()),
       numberCashFlowsThisStep_(product->numberOfProducts()),
       cashFlowsGenerated_(product->numberOfProducts()) {
@@ -62,12 +67,21 @@ namespace QuantLib {
             product_->evolution().evolutionTimes();
         constraints_.resize(evolutionTimes.size());
         constraintsActive_.resize(evolutionTimes.size());
+
+        QL_REQUIRE(workers_ > 0, "at least one worker required");
+    }
+
+    void ProxyGreekEngine::singlePathValues(
+              std::vector<Real>& values,
+              std::vector<std::vector<std::vector<Real> > >& modifiedValues) {
+        singlePathValues(*originalEvolver_, values, modifiedValues);
     }
 
     void ProxyGreekEngine::singlePathValues(
+              MarketModelEvolver& originalEvolver,
               std::vector<Real>& values,
               std::vector<std::vector<std::vector<Real> > >& modifiedValues) {
-        singleEvolverValues(*originalEvolver_, values, true);
+        singleEvolverValues(originalEvolver, values, true);
         for (Size i=0; i<constrainedEvolvers_.size(); ++i) {
             for (Size j=0; j<constrainedEvolvers_[i].size(); ++j) {
                 constrainedEvolvers_[i][j]->setThisConstraint(
@@ -84,6 +98,67 @@ namespace QuantLib {
                   Size numberOfPaths) {
         Size N = product_->numberOfProducts();
 
+        if (workers_ > 1 && numberOfPaths >= workers_) {
+            std::vector<Size> chunks(workers_, numberOfPaths/workers_);
+            for (Size i=0; i<numberOfPaths%workers_; ++i)
+                ++chunks[i];
+
+            std::vector<Size> offsets(workers_, 0);
+            for (Size i=1; i<workers_; ++i)
+                offsets[i] = offsets[i-1] + chunks[i-1];
+            std::vector<std::vector<Real> > buffers(workers_);
+            std::vector<std::string> errors(workers_);
+
+            // the first path is simulated serially, as in
+            // MonteCarloModel
+            storePathValues(1, buffers[0]);
+
+            // the first worker is this engine; the others copy a
+            // snapshot of its evolvers and product, since the
+            // originals are used by the first worker while the
+            // others start
+            boost::shared_ptr<ProxyGreekEngine> snapshot = workerEngine(0);
+
+            #pragma omp parallel for
+            for (long i=0; i<(long)workers_; ++i) {
+                try {
+                    if (i == 0) {
+                        storePathValues(chunks[0]-1, buffers[0]);
+                        // move the evolvers past the paths simulated
+                        // by the others
+                        discard(numberOfPaths-chunks[0]);
+                    } else {
+                        snapshot->workerEngine(offsets[i]-1)
+                            ->storePathValues(chunks[i], buffers[i]);
+                    }
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                } catch (...) {
+                    errors[i] = "unknown error";
+                }
+            }
+
+            for (Size i=0; i<workers_; ++i)
+                QL_REQUIRE(errors[i].empty(),
+                           "worker " << i << " failed: " << errors[i]);
+
+            for (Size i=0; i<workers_; ++i) {
+                std::vector<Real>::const_iterator v = buffers[i].begin();
+                while (v != buffers[i].end()) {
+                    stats.add(v, v+N);
+                    v += N;
+                    for (Size j=0; j<diffWeights_.size(); ++j) {
+                        for (Size k=0; k<diffWeights_[j].size(); ++k) {
+                            modifiedStats[j][k].add(v, v+N);
+                            v += N;
+                        }
+                    }
+                }
+            }
+
+            return;
+        }
+
         std::vector<Real> values(N);
         std::vector<std::vector<std::vector<Real> > > modifiedValues;
         modifiedValues.resize(constrainedEvolvers_.size());
@@ -95,8 +170,10 @@ namespace QuantLib {
 
         std::vector<Real> results(N);
 
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            blockEvolver(originalEvolver_, numberOfPaths, blockSize_);
         for (Size i=0; i<numberOfPaths; ++i) {
-            singlePathValues(values, modifiedValues);
+            singlePathValues(*evolver, values, modifiedValues);
             stats.add(values);
 
             for (Size j=0; j<diffWeights_.size(); ++j) {
@@ -113,6 +190,76 @@ namespace QuantLib {
         }
     }
 
+    void ProxyGreekEngine::storePathValues(Size numberOfPaths,
+                                           std::vector<Real>& buffer) {
+        Size N = product_->numberOfProducts();
+
+        std::vector<Real> values(N);
+        std::vector<std::vector<std::vector<Real> > > modifiedValues;
+        modifiedValues.resize(constrainedEvolvers_.size());
+        for (Size i=0; i<modifiedValues.size(); ++i) {
+            modifiedValues[i].resize(constrainedEvolvers_[i].size());
+            for (Size j=0; j<modifiedValues[i].size(); ++j)
+                modifiedValues[i][j].resize(N);
+        }
+
+        std::vector<Real> results(N);
+
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            blockEvolver(originalEvolver_, numberOfPaths, blockSize_);
+        for (Size i=0; i<numberOfPaths; ++i) {
+            singlePathValues(*evolver, values, modifiedValues);
+            buffer.insert(buffer.end(), values.begin(), values.end());
+
+            for (Size j=0; j<diffWeights_.size(); ++j) {
+                for (Size k=0; k<diffWeights_[j].size(); ++k) {
+                    const std::vector<Real>& weights = diffWeights_[j][k];
+                    for (Size l=0; l<N; ++l) {
+                        results[l] = weights[0]*values[l];
+                        for (Size n=1; n<weights.size(); ++n)
+                            results[l] += weights[n]*modifiedValues[j][n-1][l];
+                    }
+                    buffer.insert(buffer.end(),
+                                  results.begin(), results.end());
+                }
+            }
+        }
+    }
+
+    boost::shared_ptr<ProxyGreekEngine>
+    ProxyGreekEngine::workerEngine(Size offset) const {
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            originalEvolver_->clone();
+        evolver->discard(offset);
+
+        std::vector<std::vector<boost::shared_ptr<ConstrainedEvolver> > >
+            constrainedEvolvers(constrainedEvolvers_.size());
+        for (Size i=0; i<constrainedEvolvers_.size(); ++i) {
+            for (Size j=0; j<constrainedEvolvers_[i].size(); ++j) {
+                boost::shared_ptr<ConstrainedEvolver> constrained =
+                    boost::dynamic_pointer_cast<ConstrainedEvolver>(
+                                       constrainedEvolvers_[i][j]->clone());
+                QL_REQUIRE(constrained, "constrained evolver expected");
+                constrained->discard(offset);
+                constrainedEvolvers[i].push_back(constrained);
+            }
+        }
+
+        return boost::shared_ptr<ProxyGreekEngine>(
+            new ProxyGreekEngine(evolver, constrainedEvolvers, diffWeights_,
+                                 startIndexOfConstraint_,
+                                 endIndexOfConstraint_,
+                                 product_, initialNumeraireValue_,
+                                 1, blockSize_));
+    }
+
+    void ProxyGreekEngine::discard(Size numberOfPaths) {
+        originalEvolver_->discard(numberOfPaths);
+        for (Size i=0; i<constrainedEvolvers_.size(); ++i)
+            for (Size j=0; j<constrainedEvolvers_[i].size(); ++j)
+                constrainedEvolvers_[i][j]->discard(numberOfPaths);
+    }
+
     void ProxyGreekEngine::singleEvolverValues(MarketModelEvolver& evolver,
                                                std::vector<Real>& values,
                                                bool storeRates) {
@@ -34,6 +34,14 @@ namespace QuantLib {
     class ConstrainedEvolver;
     class MarketModelDiscounter;
 
+    //! Engine computing Greeks by means of constrained evolvers
+    /*! Paths can be split among parallel workers as in
+        AccountingEngine; in this case, each worker uses clones of
+        the original and of the constrained evolvers.  The original
+        evolver can also evolve paths in blocks as in
+        AccountingEngine, while the constrained evolvers, which
+        depend on it, evolve one path at a time.
+    */
     class ProxyGreekEngine {
       public:
         ProxyGreekEngine(
@@ -45,7 +53,9 @@ namespace QuantLib {
             const std::vector<Size>& startIndexOfConstraint,
             const std::vector<Size>& endIndexOfConstraint,
             const Clone<MarketModelMultiProduct>& product,
-            Real initialNumeraireValue);
+            Real initialNumeraireValue,
+            Size workers = 1,
+            Size blockSize = 0);
         void multiplePathValues(
                   SequenceStatisticsInc& stats,
                   std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
@@ -54,9 +64,17 @@ namespace QuantLib {
                 std::vector<Real>& values,
                 std::vector<std::vector<std::vector<Real> > >& modifiedValues);
       private:
+        void singlePathValues(
+                MarketModelEvolver& originalEvolver,
+                std::vector<Real>& values,
+                std::vector<std::vector<std::vector<Real> > >& modifiedValues);
         void singleEvolverValues(MarketModelEvolver& evolver,
                                  std::vector<Real>& values,
                                  bool storeRates = false);
+        void storePathValues(Size numberOfPaths,
+                             std::vector<Real>& values);
+        boost::shared_ptr<ProxyGreekEngine> workerEngine(Size offset) const;
+        void discard(Size numberOfPaths);
         boost::shared_ptr<MarketModelEvolver> originalEvolver_;
         std::vector<std::vector<boost::shared_ptr<ConstrainedEvolver> > >
             constrainedEvolvers_;
@@ -67,6 +85,7 @@ namespace QuantLib {
 
         Real initialNumeraireValue_;
         Size numberProducts_;
+        Size workers_, blockSize_;
 
         // workspace
         std::vector<Rate> constraints_;
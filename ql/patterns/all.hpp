@@ -5,6 +5,7 @@
 #include <ql/patterns/curiouslyrecurring.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/patterns/observable.hpp>
+#include <ql/patterns/pricingcontext.hpp>
 #include <ql/patterns/singleton.hpp>
 #include <ql/patterns/visitor.hpp>
 
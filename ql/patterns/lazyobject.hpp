@@ -26,6 +26,13 @@
 
 #include <ql/patterns/observable.hpp>
 
+#if defined(QL_ENABLE_CALCULATION_PROFILING)
+#include <ql/utilities/calculationprofiler.hpp>
+#else
+#define QL_PROFILE_NOTIFICATION(object, invalidating)
+#define QL_PROFILE_CALCULATION(object)
+#endif
+
 namespace QuantLib {
 
     //! Framework for calculation on demand and result caching.
@@ -38,6 +45,7 @@ namespace QuantLib {
         //! \name Observer interface
         //@{
         void update();
+        bool forwardsNotifications() const;
         //@}
         /*! \name Calculations
             These methods do not modify the structure of the object
@@ -67,6 +75,19 @@ namespace QuantLib {
             method, thus re-enabling recalculations.
         */
         void unfreeze();
+        /*! As <i><b>unfreeze</b></i>, but observers are only
+            notified if the object discarded a notification while
+            frozen; if it didn't, its cached results are still valid
+            and so are the ones of its observers.
+        */
+        void unfreezeQuietly();
+        //! returns whether the object is frozen
+        bool isFrozen() const;
+        /*! This method performs any pending calculation; unlike
+            <i><b>recalculate</b></i>, it doesn't redo cached
+            results and doesn't notify observers.
+        */
+        void ensureCalculated() const;
         /*! This method causes the object to forward all
             notifications, even when not calculated.  The default
             behavior is to forward the first notification received,
@@ -116,6 +137,7 @@ namespace QuantLib {
     : calculated_(false), frozen_(false), alwaysForward_(false) {}
 
     inline void LazyObject::update() {
+        QL_PROFILE_NOTIFICATION(this, calculated_);
         // forwards notifications only the first time
         if (calculated_ || alwaysForward_) {
             // set to false early
@@ -131,6 +153,10 @@ namespace QuantLib {
         }
     }
  
+    inline bool LazyObject::forwardsNotifications() const {
+        return (calculated_ || alwaysForward_) && !frozen_;
+    }
+
     inline void LazyObject::recalculate() {
         bool wasFrozen = frozen_;
         calculated_ = frozen_ = false;
@@ -158,6 +184,24 @@ namespace QuantLib {
         }
     }
 
+    inline void LazyObject::unfreezeQuietly() {
+        // a notification received while frozen resets calculated_;
+        // a frozen object can't be recalculated in the meantime
+        if (frozen_) {
+            frozen_ = false;
+            if (!calculated_)
+                notifyObservers();
+        }
+    }
+
+    inline bool LazyObject::isFrozen() const {
+        return frozen_;
+    }
+
+    inline void LazyObject::ensureCalculated() const {
+        calculate();
+    }
+
     inline void LazyObject::alwaysForwardNotifications() {
         alwaysForward_ = true;
     }
@@ -166,6 +210,7 @@ namespace QuantLib {
         if (!calculated_ && !frozen_) {
             calculated_ = true;   // prevent infinite recursion in
                                   // case of bootstrapping
+            QL_PROFILE_CALCULATION(this);
             try {
                 performCalculations();
             } catch (...) {
@@ -25,6 +25,35 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 namespace QuantLib {
 
+    namespace {
+
+        // a copy of the observers of an observable, whose updates
+        // might register or unregister observers and invalidate the
+        // iterators of the set; small sets are copied on the stack
+        class ObserverList {
+          public:
+            template <class Set>
+            explicit ObserverList(const Set& observers)
+            : size_(observers.size()), begin_(buffer_) {
+                if (size_ > bufferSize) {
+                    heap_.assign(observers.begin(), observers.end());
+                    begin_ = &heap_[0];
+                } else {
+                    std::copy(observers.begin(), observers.end(), buffer_);
+                }
+            }
+            Size size() const { return size_; }
+            Observer* operator[](Size i) const { return begin_[i]; }
+          private:
+            static const Size bufferSize = 16;
+            Observer* buffer_[bufferSize];
+            std::vector<Observer*> heap_;
+            Size size_;
+            Observer** begin_;
+        };
+
+    }
+
     void ObservableSettings::enableUpdates() {
         updatesEnabled_  = true;
         updatesDeferred_ = false;
@@ -37,6 +66,7 @@ namespace QuantLib {
             for (iterator i=deferredObservers_.begin();
                 i!=deferredObservers_.end(); ++i) {
                 try {
+                    ++notificationsSent_;
                     (*i)->update();
                 } catch (std::exception& e) {
                     successful = false;
@@ -54,18 +84,149 @@ namespace QuantLib {
     }
 
 
+    void ObservableSettings::beginNotificationBatch() {
+        ++batchDepth_;
+    }
+
+    void ObservableSettings::endNotificationBatch() {
+        QL_REQUIRE(batchDepth_ > 0, "no notification batch open");
+        // batches opened while notifying the observers of the
+        // outermost one are merged into it
+        if (batchDepth_ > 1 || propagating_) {
+            --batchDepth_;
+            return;
+        }
+
+        propagating_ = true;
+
+        // the observers of the changed observables are the first
+        // ones to be notified...
+        std::vector<Observable*> changed;
+        changed.swap(changedObservables_);
+        changedSet_.clear();
+        for (Size i=0; i<changed.size(); ++i) {
+            const Observable::set_type& observers = changed[i]->observers_;
+            for (Observable::iterator j=observers.begin();
+                 j!=observers.end(); ++j)
+                requestBatchUpdate(*j);
+        }
+
+        // ...and the ones depending on them might be notified in
+        // turn; they are sorted so that each observer comes after
+        // the observables it depends on
+        std::vector<Observer*> order;
+        for (Size i=0; i<changed.size(); ++i) {
+            const Observable::set_type& observers = changed[i]->observers_;
+            for (Observable::iterator j=observers.begin();
+                 j!=observers.end(); ++j)
+                scheduleBatchUpdates(*j, order);
+        }
+
+        bool successful = true;
+        std::string errMsg;
+        for (Size i=order.size(); i>0; --i) {
+            Observer* o = order[i-1];
+            // observers might be removed by the updates of the
+            // previous ones, and only pending ones are notified
+            if (scheduledObservers_.count(o) == 0 ||
+                pendingObservers_.erase(o) == 0)
+                continue;
+            notifiedObservers_.insert(o);
+            try {
+                ++notificationsSent_;
+                o->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+
+        scheduledObservers_.clear();
+        pendingObservers_.clear();
+        notifiedObservers_.clear();
+        propagating_ = false;
+        batchDepth_ = 0;
+
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+    void ObservableSettings::registerBatchNotification(Observable* o) {
+        if (propagating_) {
+            // requestBatchUpdate might notify them right away
+            ObserverList observers(o->observers_);
+            for (Size i=0; i<observers.size(); ++i) {
+                if (o->observers_.count(observers[i]) != 0)
+                    requestBatchUpdate(observers[i]);
+            }
+        } else {
+            if (changedSet_.insert(o).second)
+                changedObservables_.push_back(o);
+            else
+                notificationsSaved_ += o->observers_.size();
+        }
+    }
+
+    void ObservableSettings::requestBatchUpdate(Observer* o) {
+        if (notifiedObservers_.count(o) != 0 ||
+            !pendingObservers_.insert(o).second) {
+            ++notificationsSaved_;
+        } else if (propagating_ && scheduledObservers_.count(o) == 0 &&
+                   !scheduledObservers_.empty()) {
+            // the observer registered after the batch was sorted;
+            // it is notified right away
+            pendingObservers_.erase(o);
+            notifiedObservers_.insert(o);
+            ++notificationsSent_;
+            o->update();
+        }
+    }
+
+    void ObservableSettings::scheduleBatchUpdates(
+                                             Observer* o,
+                                             std::vector<Observer*>& order) {
+        if (!scheduledObservers_.insert(o).second)
+            return;
+        // observers that won't forward the notification stop the sort
+        // of their dependents; if they do after all, the latter are
+        // notified right away
+        Observable* observable = o->forwardsNotifications() ?
+                                 dynamic_cast<Observable*>(o) : 0;
+        if (observable) {
+            const Observable::set_type& observers = observable->observers_;
+            for (Observable::iterator i=observers.begin();
+                 i!=observers.end(); ++i)
+                scheduleBatchUpdates(*i, order);
+        }
+        // reverse post-order gives the notification order
+        order.push_back(o);
+    }
+
+
     void Observable::notifyObservers() {
         if (!settings_.updatesEnabled()) {
             // if updates are only deferred, flag this for later notification
             // these are held centrally by the settings singleton
             settings_.registerDeferredObservers(observers_);
         }
+        else if (settings_.batchingUpdates()) {
+            // the observers are notified when the batch is closed
+            settings_.registerBatchNotification(this);
+        }
         else if (observers_.size()) {
             bool successful = true;
             std::string errMsg;
-            for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+            ObserverList observers(observers_);
+            for (Size i=0; i<observers.size(); ++i) {
+                // observers unregistered by the updates of the
+                // previous ones (e.g., destroyed) are skipped
+                if (observers_.count(observers[i]) == 0)
+                    continue;
                 try {
-                    (*i)->update();
+                    ++settings_.notificationsSent_;
+                    observers[i]->update();
                 } catch (std::exception& e) {
                     // quite a dilemma. If we don't catch the exception,
                     // other observers will not receive the notification
@@ -89,93 +250,161 @@ namespace QuantLib {
 
 #else
 
-#include <boost/signals2/signal_type.hpp>
+#include <boost/thread/thread.hpp>
 
 namespace QuantLib {
 
-    namespace detail {
+    ObservableSettings::ObservableSettings()
+    : hasDeferredObservers_(false), updatesType_(UpdatesEnabled),
+      batchDepth_(0), epoch_(0) {
+        for (Size i=0; i<LockStripes; ++i) {
+            running_[i].count[0] = 0;
+            running_[i].count[1] = 0;
+        }
+    }
 
-        class Signal {
-          public:
-            typedef boost::signals2::signal_type<
-                void(),
-                boost::signals2::keywords::mutex_type<boost::recursive_mutex> >
-                ::type signal_type;
+    void ObservableSettings::enableUpdates() {
+        // the proxies of observers destroyed while the deferred
+        // notifications are sent are kept alive by the epoch
+        Epoch epoch(*this);
+        set_type deferredObservers;
+        {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            updatesType_ = UpdatesEnabled;
+            deferredObservers.swap(deferredObservers_);
+            hasDeferredObservers_ = false;
+        }
 
-            void connect(const signal_type::slot_type& slot) {
-                sig_.connect(slot);
-            }
+        // if there are outstanding deferred updates, do the notification
+        if (deferredObservers.size()) {
+            bool successful = true;
+            std::string errMsg;
 
-            template <class T>
-            void disconnect(const T& slot) {
-                sig_.disconnect(slot);
+            for (iterator i=deferredObservers.begin();
+                i!=deferredObservers.end(); ++i) {
+                try {
+                    (*i)->update();
+                } catch (std::exception& e) {
+                    successful = false;
+                    errMsg = e.what();
+                } catch (...) {
+                    successful = false;
+                }
             }
 
-            void operator()() const {
-                sig_.operator()();
-            }
-          private:
-            signal_type sig_;
-        };
+            QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+        }
+    }
 
+    Size ObservableSettings::retiredObservers() const {
+        boost::lock_guard<boost::mutex> lock(retiredMutex_);
+        return retired_[0].size() + retired_[1].size() + retired_[2].size();
     }
 
-    void Observable::registerObserver(
-        const boost::shared_ptr<Observer::Proxy>& observerProxy) {
-        {
-            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-            observers_.insert(observerProxy);
+    ObservableSettings::Epoch::Epoch(ObservableSettings& settings)
+    : settings_(settings),
+      stripe_(boost::hash<boost::thread::id>()(boost::this_thread::get_id())
+              % LockStripes) {
+        // the epoch might be advanced between reading it and
+        // registering the notification; in that case, we try again
+        for (;;) {
+            Size epoch = settings_.epoch_.load();
+            parity_ = epoch % 2;
+            ++settings_.running_[stripe_].count[parity_];
+            if (settings_.epoch_.load() == epoch)
+                break;
+            --settings_.running_[stripe_].count[parity_];
         }
+    }
 
-        detail::Signal::signal_type::slot_type slot(&Observer::Proxy::update,
-                                    observerProxy.get());
-        sig_->connect(slot.track(observerProxy));
+    ObservableSettings::Epoch::~Epoch() {
+        --settings_.running_[stripe_].count[parity_];
     }
 
-    void Observable::unregisterObserver(
-        const boost::shared_ptr<Observer::Proxy>& observerProxy) {
+    void ObservableSettings::retire(Observer::Proxy* proxy) {
+        std::vector<Observer::Proxy*> expired;
         {
-            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-            observers_.erase(observerProxy);
+            boost::lock_guard<boost::mutex> lock(retiredMutex_);
+            retired_[epoch_.load() % 3].push_back(proxy);
+
+            // the epoch can advance when the notifications started in
+            // the previous one are over; the proxies retired then
+            // can't be seen by the running ones, that started later.
+            // Two steps delete the proxy just retired if no
+            // notification is running.
+            bool quiescent = true;
+            for (Size step=0; step<2 && quiescent; ++step) {
+                Size epoch = epoch_.load(), parity = (epoch+1) % 2;
+                for (Size i=0; i<LockStripes && quiescent; ++i)
+                    quiescent = (running_[i].count[parity] == 0);
+                if (quiescent) {
+                    epoch_.store(epoch+1);
+                    std::vector<Observer::Proxy*>& previous =
+                        retired_[(epoch+2) % 3];
+                    expired.insert(expired.end(),
+                                   previous.begin(), previous.end());
+                    previous.clear();
+                }
+            }
         }
+        for (Size i=0; i<expired.size(); ++i)
+            delete expired[i];
+    }
+
 
-        if (settings_.updatesDeferred()) {
+    void Observable::notifyObservers() {
+        if (!settings_.updatesEnabled()) {
             boost::lock_guard<boost::mutex> sLock(settings_.mutex_);
-            if (settings_.updatesDeferred()) {
-                settings_.unregisterDeferredObserver(observerProxy);
+            if (!settings_.updatesEnabled()) {
+                if (settings_.updatesDeferred()) {
+                    boost::lock_guard<boost::mutex> lock(
+                                             settings_.observableLock(this));
+                    // if updates are only deferred, flag this for later
+                    // notification; these are held centrally by the
+                    // settings singleton
+                    settings_.registerDeferredObservers(observers_);
+                }
+                return;
             }
         }
 
-        sig_->disconnect(boost::bind(&Observer::Proxy::update,
-                             observerProxy.get()));
-    }
+        ObservableSettings::Epoch epoch(settings_);
 
-    void Observable::notifyObservers() {
-        if (settings_.updatesEnabled()) {
-            return sig_->operator()();
+        // the observers are copied so that no lock is held while
+        // they're notified; the epoch keeps their proxies alive
+        const Size bufferSize = 16;
+        Observer::Proxy* buffer[bufferSize];
+        std::vector<Observer::Proxy*> proxies;
+        Observer::Proxy** begin = buffer;
+        Size n;
+        {
+            boost::lock_guard<boost::mutex> lock(
+                                             settings_.observableLock(this));
+            n = observers_.size();
+            if (n > bufferSize) {
+                proxies.assign(observers_.begin(), observers_.end());
+                begin = &proxies[0];
+            } else {
+                std::copy(observers_.begin(), observers_.end(), buffer);
+            }
         }
 
-        boost::lock_guard<boost::mutex> sLock(settings_.mutex_);
-        if (settings_.updatesEnabled()) {
-            return sig_->operator()();
-        }
-        else if (settings_.updatesDeferred()) {
-            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-            // if updates are only deferred, flag this for later notification
-            // these are held centrally by the settings singleton
-            settings_.registerDeferredObservers(observers_);
+        bool successful = true;
+        std::string errMsg;
+        for (Size i=0; i<n; ++i) {
+            try {
+                begin[i]->update();
+            } catch (std::exception& e) {
+                // see the single-threaded implementation
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
         }
-    }
-
-    Observable::Observable()
-    : sig_(new detail::Signal()),
-      settings_(ObservableSettings::instance()) { }
-
-    Observable::Observable(const Observable&)
-    : sig_(new detail::Signal()),
-      settings_(ObservableSettings::instance()) {
-        // the observer set is not copied; no observer asked to
-        // register with this object
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
     }
 
 }
@@ -32,9 +32,12 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
 #include <ql/patterns/singleton.hpp>
+#include <ql/utilities/compactset.hpp>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/unordered_set.hpp>
+#include <algorithm>
+#include <vector>
 
 
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
@@ -52,6 +55,16 @@ namespace QuantLib {
     class Observable;
 
     //! global repository for run-time library settings
+    /*! Notifications can also be collected in batches (see
+        NotificationBatch.)  While a batch is open, observables only
+        record that they changed; when the outermost batch is closed,
+        the observers depending on them are notified in dependency
+        order, i.e., each observer is notified after the observables
+        it depends on, and at most once.  As during a regular
+        notification, observers are only notified if one of their
+        observables notifies them; therefore, lazy objects still stop
+        the notifications that they wouldn't forward.
+    */
     class ObservableSettings : public Singleton<ObservableSettings> {
         friend class Singleton<ObservableSettings>;
         friend class Observable;
@@ -64,24 +77,71 @@ namespace QuantLib {
 
         bool updatesEnabled()  {return updatesEnabled_;}
         bool updatesDeferred() {return updatesDeferred_;}
+
+        /*! \name Notification batches
+            Batches can be nested; notifications are sent when the
+            outermost one is closed.
+        */
+        //@{
+        void beginNotificationBatch();
+        void endNotificationBatch();
+        bool batchingUpdates() const { return batchDepth_ > 0; }
+        //! whether batches notify the observers in dependency order
+        bool orderedNotificationBatches() const { return true; }
+        //@}
+
+        /*! \name Notification counters */
+        //@{
+        //! notifications delivered to observers
+        Size notificationsSent() const { return notificationsSent_; }
+        /*! notifications requested during a batch and not delivered,
+            since the observer had already received or was going to
+            receive one from the batch
+        */
+        Size notificationsSaved() const { return notificationsSaved_; }
+        void resetNotificationCounters() {
+            notificationsSent_ = notificationsSaved_ = 0;
+        }
+        //@}
       private:
         ObservableSettings()
         : updatesEnabled_(true),
-          updatesDeferred_(false) {}
+          updatesDeferred_(false),
+          batchDepth_(0), propagating_(false),
+          notificationsSent_(0), notificationsSaved_(0) {}
 
         void registerDeferredObservers(
-            const boost::unordered_set<Observer*>& observers);
+            const CompactSet<Observer*>& observers);
         void unregisterDeferredObserver(Observer*);
 
+        void registerBatchNotification(Observable*);
+        void unregisterBatchObservable(Observable*);
+        void unregisterBatchObserver(Observer*);
+        void requestBatchUpdate(Observer*);
+        void scheduleBatchUpdates(Observer*, std::vector<Observer*>&);
+
         typedef boost::unordered_set<Observer*> set_type;
         typedef set_type::iterator iterator;
         set_type deferredObservers_;
 
         bool updatesEnabled_,  updatesDeferred_;
+
+        // batch state
+        Size batchDepth_;
+        bool propagating_;
+        std::vector<Observable*> changedObservables_;
+        boost::unordered_set<Observable*> changedSet_;
+        set_type scheduledObservers_, pendingObservers_, notifiedObservers_;
+
+        Size notificationsSent_, notificationsSaved_;
     };
 
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! The observers are kept in a CompactSet, so that observables
+        with a few of them don't allocate any memory for the purpose.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
       public:
@@ -89,27 +149,34 @@ namespace QuantLib {
         Observable() : settings_(ObservableSettings::instance()) {}
         Observable(const Observable&);
         Observable& operator=(const Observable&);
-        virtual ~Observable() {}
+        virtual ~Observable();
         /*! This method should be called at the end of non-const methods
             or when the programmer desires to notify any changes.
         */
         void notifyObservers();
       private:
-        typedef boost::unordered_set<Observer*>::iterator iterator;
+        friend class ObservableSettings;
+        typedef CompactSet<Observer*> set_type;
+        typedef set_type::iterator iterator;
         std::pair<iterator, bool> registerObserver(Observer*);
         Size unregisterObserver(Observer*);
-        boost::unordered_set<Observer*> observers_;
+        set_type observers_;
         ObservableSettings& settings_;
     };
 
     //! Object that gets notified when a given observable changes
-    /*! \ingroup patterns */
+    /*! As for Observable, the observables are kept in a CompactSet.
+
+        \ingroup patterns
+    */
     class Observer {
       public:
 #if BOOST_VERSION < 104700
-        typedef std::set<boost::shared_ptr<Observable> > set_type;
+        typedef CompactSet<boost::shared_ptr<Observable>, 3,
+                           std::set<boost::shared_ptr<Observable> > >
+                                                                   set_type;
 #else
-        typedef boost::unordered_set<boost::shared_ptr<Observable> > set_type;
+        typedef CompactSet<boost::shared_ptr<Observable>, 3> set_type;
 #endif
         typedef set_type::iterator iterator;
 
@@ -143,15 +210,64 @@ namespace QuantLib {
           should be implemented in derived classes whenever applicable */
         virtual void deepUpdate();
 
+        /*! Whether a call to update() might cause further
+            notifications to be sent to other observers; the default
+            is true.  It is used to sort the observers to be notified
+            at the end of a notification batch, and should return
+            false only if the instance surely won't notify.
+        */
+        virtual bool forwardsNotifications() const;
+
       private:
         set_type observables_;
     };
 
+    //! Notification batch
+    /*! Notifications sent by observables during the lifetime of an
+        instance of this class are collected and sent at the end of
+        it, as described for ObservableSettings; the batch can also
+        be closed explicitly by calling commit(), which reports any
+        exception thrown by the observers.
+
+        \code
+        {
+            NotificationBatch batch;
+            for (Size i=0; i<quotes.size(); ++i)
+                quotes[i]->setValue(values[i]);
+            batch.commit();
+        }
+        \endcode
+    */
+    class NotificationBatch {
+      public:
+        NotificationBatch() : open_(true) {
+            ObservableSettings::instance().beginNotificationBatch();
+        }
+        ~NotificationBatch() {
+            if (open_) {
+                try {
+                    ObservableSettings::instance().endNotificationBatch();
+                } catch (...) {
+                    // nothing we can do in a destructor
+                }
+            }
+        }
+        void commit() {
+            QL_REQUIRE(open_, "notification batch already committed");
+            open_ = false;
+            ObservableSettings::instance().endNotificationBatch();
+        }
+      private:
+        NotificationBatch(const NotificationBatch&);
+        NotificationBatch& operator=(const NotificationBatch&);
+        bool open_;
+    };
+
 
     // inline definitions
 
     inline void ObservableSettings::registerDeferredObservers(
-        const boost::unordered_set<Observer*>& observers) {
+        const CompactSet<Observer*>& observers) {
         if (updatesDeferred()) {
             deferredObservers_.insert(observers.begin(), observers.end());
         }
@@ -161,12 +277,29 @@ namespace QuantLib {
         deferredObservers_.erase(o);
     }
 
+    inline void ObservableSettings::unregisterBatchObservable(Observable* o) {
+        if (changedSet_.erase(o) != 0)
+            changedObservables_.erase(std::find(changedObservables_.begin(),
+                                                changedObservables_.end(),
+                                                o));
+    }
+
+    inline void ObservableSettings::unregisterBatchObserver(Observer* o) {
+        scheduledObservers_.erase(o);
+        pendingObservers_.erase(o);
+    }
+
     inline Observable::Observable(const Observable&)
     : settings_(ObservableSettings::instance()) {
         // the observer set is not copied; no observer asked to
         // register with this object
     }
 
+    inline Observable::~Observable() {
+        if (settings_.batchingUpdates())
+            settings_.unregisterBatchObservable(this);
+    }
+
     /*! \warning notification is sent before the copy constructor has
                  a chance of actually change the data
                  members. Therefore, observers whose update() method
@@ -183,7 +316,7 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<boost::unordered_set<Observer*>::iterator, bool>
+    inline std::pair<Observable::iterator, bool>
     Observable::registerObserver(Observer* o) {
         return observers_.insert(o);
     }
@@ -192,6 +325,9 @@ namespace QuantLib {
         if (settings_.updatesDeferred())
             settings_.unregisterDeferredObserver(o);
 
+        if (settings_.batchingUpdates())
+            settings_.unregisterBatchObserver(o);
+
         return observers_.erase(o);
     }
 
@@ -252,6 +388,10 @@ namespace QuantLib {
         update();
     }
 
+    inline bool Observer::forwardsNotifications() const {
+        return true;
+    }
+
 }
 
 #else
@@ -260,9 +400,7 @@ namespace QuantLib {
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/recursive_mutex.hpp>
-#include <boost/smart_ptr/owner_less.hpp>
 #include <boost/enable_shared_from_this.hpp>
-#include <set>
 
 namespace QuantLib {
 
@@ -270,16 +408,21 @@ namespace QuantLib {
     class ObservableSettings;
 
     //! Object that gets notified when a given observable changes
-    /*! \ingroup patterns */
+    /*! Each observer is represented towards its observables by a
+        proxy, which outlives it until no notification can still be
+        using it; see ObservableSettings.
+
+        \ingroup patterns
+    */
     class Observer : public boost::enable_shared_from_this<Observer> {
         friend class Observable;
         friend class ObservableSettings;
       public:
-        typedef boost::unordered_set<boost::shared_ptr<Observable> > set_type;
+        typedef CompactSet<boost::shared_ptr<Observable>, 3> set_type;
         typedef set_type::iterator iterator;
 
         // constructors, assignment, destructor
-        Observer() {}
+        Observer() : proxy_(0) {}
         Observer(const Observer&);
         Observer& operator=(const Observer&);
         virtual ~Observer();
@@ -306,16 +449,25 @@ namespace QuantLib {
           should be implemented in derived classes whenever applicable */
         virtual void deepUpdate();
 
+        /*! Whether a call to update() might cause further
+            notifications to be sent to other observers; the default
+            is true.
+        */
+        virtual bool forwardsNotifications() const;
+
       private:
 
         class Proxy {
           public:
-            explicit Proxy(Observer* const observer)
+            Proxy(Observer* const observer, ObservableSettings& settings)
              : active_  (true),
-               observer_(observer) {
+               observer_(observer),
+               settings_(settings) {
             }
 
             void update() const {
+                if (!active_)
+                    return;
                 boost::lock_guard<boost::recursive_mutex> lock(mutex_);
                 if (active_) {
                     const boost::weak_ptr<Observer> o
@@ -331,34 +483,34 @@ namespace QuantLib {
                 }
             }
 
+            //! waits for running updates to complete
             void deactivate() {
                 boost::lock_guard<boost::recursive_mutex> lock(mutex_);
                 active_ = false;
             }
 
+            ObservableSettings& settings() const { return settings_; }
+
         private:
-            bool active_;
+            boost::atomic<bool> active_;
             mutable boost::recursive_mutex mutex_;
             Observer* const observer_;
+            ObservableSettings& settings_;
         };
 
-        boost::shared_ptr<Proxy> proxy_;
-        mutable boost::recursive_mutex mutex_;
+        // created at the first registration; when the observer is
+        // destroyed, it is handed over to the settings for deletion
+        Proxy* proxy_;
 
         set_type observables_;
     };
 
-	namespace detail {
-		class Signal;
-	}
-
     //! Object that notifies its changes to a set of observers
     /*! \ingroup patterns */
     class Observable {
         friend class Observer;
       public:
-        typedef boost::unordered_set<boost::shared_ptr<Observer::Proxy> >
-            set_type;
+        typedef CompactSet<Observer::Proxy*> set_type;
         typedef set_type::iterator iterator;
 
         // constructors, assignment, destructor
@@ -371,20 +523,34 @@ namespace QuantLib {
         */
         void notifyObservers();
       private:
-        void registerObserver(const boost::shared_ptr<Observer::Proxy>&);
-        void unregisterObserver(const boost::shared_ptr<Observer::Proxy>&);
-
-        boost::shared_ptr<detail::Signal> sig_;
+        void registerObserver(Observer::Proxy*);
+        void unregisterObserver(Observer::Proxy*);
 
         set_type observers_;
-        mutable boost::recursive_mutex mutex_;
 
         ObservableSettings& settings_;
     };
 
     //! global repository for run-time library settings
+    /*! In this implementation of the observer pattern, the sets of
+        observers and observables are guarded by striped locks,
+        i.e., by one of a fixed number of mutexes chosen according
+        to the address of their owner; this avoids both a global
+        lock and the memory cost of a mutex for each instance.
+
+        Notifications don't hold any lock while the observers are
+        updated, and don't use reference counting; instead, they run
+        within an epoch.  When an observer is destroyed, its proxy is
+        removed from its observables and retired; it is deleted only
+        when all notifications that might have seen it (i.e., those
+        running in the epoch in which it was retired or in the
+        previous one) have completed.  The counters of running
+        notifications are also striped, by thread, so that
+        concurrent notifications don't contend for them.
+    */
     class ObservableSettings : public Singleton<ObservableSettings> {
         friend class Singleton<ObservableSettings>;
+        friend class Observer;
         friend class Observable;
 
     public:
@@ -396,23 +562,134 @@ namespace QuantLib {
 
         bool updatesEnabled()  {return (updatesType_ & UpdatesEnabled) != 0; }
         bool updatesDeferred() {return (updatesType_ & UpdatesDeferred) != 0; }
+
+        /*! \name Notification batches
+            In this implementation, a batch defers the notifications
+            as disableUpdates(true) does; the observers are notified
+            when the outermost batch is closed, but not in dependency
+            order, so that some of them might be notified again by
+            the observables they depend on.  Code relying on the
+            ordering should check orderedNotificationBatches().
+        */
+        //@{
+        void beginNotificationBatch() {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            if (batchDepth_++ == 0)
+                updatesType_ = UpdatesDeferred;
+        }
+        void endNotificationBatch() {
+            {
+                boost::lock_guard<boost::mutex> lock(mutex_);
+                QL_REQUIRE(batchDepth_ > 0, "no notification batch open");
+                if (--batchDepth_ > 0)
+                    return;
+            }
+            enableUpdates();
+        }
+        bool batchingUpdates() const { return batchDepth_ > 0; }
+        bool orderedNotificationBatches() const { return false; }
+        //@}
+
+        /*! \name Notification counters
+            Notifications are not counted in this implementation,
+            since a shared counter would be contended by every
+            notification; these methods throw.
+        */
+        //@{
+        Size notificationsSent() const {
+            QL_FAIL("notifications are not counted by the thread-safe "
+                    "observer pattern");
+        }
+        Size notificationsSaved() const {
+            QL_FAIL("notifications are not counted by the thread-safe "
+                    "observer pattern");
+        }
+        void resetNotificationCounters() {
+            QL_FAIL("notifications are not counted by the thread-safe "
+                    "observer pattern");
+        }
+        //@}
+
+        //! number of proxies retired and not yet deleted
+        Size retiredObservers() const;
       private:
-        ObservableSettings() : updatesType_(UpdatesEnabled) {}
+        ObservableSettings();
 
-        typedef std::set<boost::weak_ptr<Observer::Proxy>,
-                         boost::owner_less<boost::weak_ptr<Observer::Proxy> > >
-            set_type;
+        typedef boost::unordered_set<Observer::Proxy*> set_type;
         typedef set_type::iterator iterator;
 
         void registerDeferredObservers(const Observable::set_type& observers);
-        void unregisterDeferredObserver(
-            const boost::shared_ptr<Observer::Proxy>& proxy);
+        void unregisterDeferredObserver(Observer::Proxy* proxy);
 
         set_type deferredObservers_;
+        boost::atomic<bool> hasDeferredObservers_;
         mutable boost::mutex mutex_;
 
         enum UpdateType { UpdatesEnabled = 1, UpdatesDeferred = 2} ;
         boost::atomic<int> updatesType_;
+        boost::atomic<Size> batchDepth_;
+
+        // striped locks
+        enum { LockStripes = 64 };
+        struct StripedMutex {
+            boost::mutex mutex;
+            char padding[64];
+        };
+        boost::mutex& observerLock(const Observer*);
+        boost::mutex& observableLock(const Observable*);
+        StripedMutex observerLocks_[LockStripes];
+        StripedMutex observableLocks_[LockStripes];
+
+        // epochs
+        class Epoch {
+          public:
+            explicit Epoch(ObservableSettings&);
+            ~Epoch();
+          private:
+            Epoch(const Epoch&);
+            Epoch& operator=(const Epoch&);
+            ObservableSettings& settings_;
+            Size stripe_, parity_;
+        };
+        struct RunningNotifications {
+            boost::atomic<Size> count[2];
+            char padding[64];
+        };
+        void retire(Observer::Proxy*);
+        RunningNotifications running_[LockStripes];
+        boost::atomic<Size> epoch_;
+        mutable boost::mutex retiredMutex_;
+        // proxies retired in each of the last three epochs
+        std::vector<Observer::Proxy*> retired_[3];
+    };
+
+    //! Notification batch
+    /*! See the single-threaded implementation; in this one, the
+        notifications are deferred but not sorted.
+    */
+    class NotificationBatch {
+      public:
+        NotificationBatch() : open_(true) {
+            ObservableSettings::instance().beginNotificationBatch();
+        }
+        ~NotificationBatch() {
+            if (open_) {
+                try {
+                    ObservableSettings::instance().endNotificationBatch();
+                } catch (...) {
+                    // nothing we can do in a destructor
+                }
+            }
+        }
+        void commit() {
+            QL_REQUIRE(open_, "notification batch already committed");
+            open_ = false;
+            ObservableSettings::instance().endNotificationBatch();
+        }
+      private:
+        NotificationBatch(const NotificationBatch&);
+        NotificationBatch& operator=(const NotificationBatch&);
+        bool open_;
     };
 
 
@@ -421,45 +698,41 @@ namespace QuantLib {
     inline void ObservableSettings::registerDeferredObservers(
         const Observable::set_type& observers) {
         deferredObservers_.insert(observers.begin(), observers.end());
+        hasDeferredObservers_ = !deferredObservers_.empty();
     }
 
     inline void ObservableSettings::unregisterDeferredObserver(
-        const boost::shared_ptr<Observer::Proxy>& o) {
-        deferredObservers_.erase(o);
+                                                   Observer::Proxy* proxy) {
+        // the flag is set while the observable lock is held, so it's
+        // visible here if the proxy was added by an observable from
+        // which it was removed before calling this method
+        if (hasDeferredObservers_) {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            deferredObservers_.erase(proxy);
+        }
     }
 
-    inline void ObservableSettings::enableUpdates() {
-        boost::lock_guard<boost::mutex> lock(mutex_);
-
-        // if there are outstanding deferred updates, do the notification
-        updatesType_ = UpdatesEnabled;
+    inline boost::mutex& ObservableSettings::observerLock(const Observer* o) {
+        return observerLocks_[boost::hash<const void*>()(o) % LockStripes]
+            .mutex;
+    }
 
-        if (deferredObservers_.size()) {
-            bool successful = true;
-            std::string errMsg;
+    inline boost::mutex& ObservableSettings::observableLock(
+                                                       const Observable* o) {
+        return observableLocks_[boost::hash<const void*>()(o) % LockStripes]
+            .mutex;
+    }
 
-            for (iterator i=deferredObservers_.begin();
-                i!=deferredObservers_.end(); ++i) {
-                try {
-                    const boost::shared_ptr<Observer::Proxy> proxy = i->lock();
-                    if (proxy)
-                        proxy->update();
-                } catch (std::exception& e) {
-                    successful = false;
-                    errMsg = e.what();
-                } catch (...) {
-                    successful = false;
-                }
-            }
 
-            deferredObservers_.clear();
+    inline Observable::Observable()
+    : settings_(ObservableSettings::instance()) {}
 
-            QL_ENSURE(successful,
-                  "could not notify one or more observers: " << errMsg);
-        }
+    inline Observable::Observable(const Observable&)
+    : settings_(ObservableSettings::instance()) {
+        // the observer set is not copied; no observer asked to
+        // register with this object
     }
 
-
     /*! \warning notification is sent before the copy constructor has
              a chance of actually change the data
              members. Therefore, observers whose update() method
@@ -476,96 +749,123 @@ namespace QuantLib {
         return *this;
     }
 
-    inline Observer::Observer(const Observer& o) {
-        proxy_.reset(new Proxy(this));
+    inline void Observable::registerObserver(Observer::Proxy* proxy) {
+        boost::lock_guard<boost::mutex> lock(settings_.observableLock(this));
+        observers_.insert(proxy);
+    }
 
+    inline void Observable::unregisterObserver(Observer::Proxy* proxy) {
         {
-             boost::lock_guard<boost::recursive_mutex> lock(o.mutex_);
-             observables_ = o.observables_;
+            boost::lock_guard<boost::mutex> lock(
+                                            settings_.observableLock(this));
+            observers_.erase(proxy);
         }
-
-        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->registerObserver(proxy_);
+        settings_.unregisterDeferredObserver(proxy);
     }
 
-    inline Observer& Observer::operator=(const Observer& o) {
-        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-        if (!proxy_) {
-            proxy_.reset(new Proxy(this));
-        }
-
-        iterator i;
-        for (i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->unregisterObserver(proxy_);
 
+    inline Observer::Observer(const Observer& o) : proxy_(0) {
+        if (o.proxy_ == 0)
+            return;
+        ObservableSettings& settings = o.proxy_->settings();
         {
-            boost::lock_guard<boost::recursive_mutex> lock(o.mutex_);
+            boost::lock_guard<boost::mutex> lock(settings.observerLock(&o));
             observables_ = o.observables_;
         }
-        for (i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->registerObserver(proxy_);
-
-        return *this;
+        if (!observables_.empty()) {
+            proxy_ = new Proxy(this, settings);
+            for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+                (*i)->registerObserver(proxy_);
+        }
     }
 
-    inline Observer::~Observer() {
-        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-        if (proxy_)
-            proxy_->deactivate();
-
-        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
-            (*i)->unregisterObserver(proxy_);
+    inline Observer& Observer::operator=(const Observer& o) {
+        if (&o == this)
+            return *this;
+        set_type observables;
+        if (o.proxy_ != 0) {
+            boost::lock_guard<boost::mutex> lock(
+                                      o.proxy_->settings().observerLock(&o));
+            observables = o.observables_;
+        }
+        unregisterWithAll();
+        for (iterator i=observables.begin(); i!=observables.end(); ++i)
+            registerWith(*i);
+        return *this;
     }
 
     inline std::pair<Observer::iterator, bool>
     Observer::registerWith(const boost::shared_ptr<Observable>& h) {
-        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-        if (!proxy_) {
-            proxy_.reset(new Proxy(this));
-        }
-
-        if (h) {
+        if (!h)
+            return std::make_pair(observables_.end(), false);
+
+        boost::lock_guard<boost::mutex> lock(h->settings_.observerLock(this));
+        if (proxy_ == 0)
+            proxy_ = new Proxy(this, h->settings_);
+        std::pair<iterator, bool> result = observables_.insert(h);
+        if (result.second)
             h->registerObserver(proxy_);
-            return observables_.insert(h);
-        }
-        return std::make_pair(observables_.end(), false);
+        return result;
     }
 
     inline void
     Observer::registerWithObservables(const boost::shared_ptr<Observer>& o) {
-        if (o) {
-            boost::lock_guard<boost::recursive_mutex> lock(o->mutex_);
-
-            for (iterator i = o->observables_.begin();
-                 i != o->observables_.end(); ++i)
+        if (o && o->proxy_ != 0) {
+            set_type observables;
+            {
+                boost::lock_guard<boost::mutex> lock(
+                                   o->proxy_->settings().observerLock(o.get()));
+                observables = o->observables_;
+            }
+            for (iterator i=observables.begin(); i!=observables.end(); ++i)
                 registerWith(*i);
         }
     }
 
     inline
     Size Observer::unregisterWith(const boost::shared_ptr<Observable>& h) {
-        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        if (!h || proxy_ == 0)
+            return 0;
 
-        if (h)  {
-            QL_REQUIRE(proxy_, "unregister called without a proxy");
+        boost::lock_guard<boost::mutex> lock(
+                                        proxy_->settings().observerLock(this));
+        Size erased = observables_.erase(h);
+        if (erased != 0)
             h->unregisterObserver(proxy_);
-        }
-
-        return observables_.erase(h);
+        return erased;
     }
 
     inline void Observer::unregisterWithAll() {
-        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        if (proxy_ == 0)
+            return;
 
-        for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
+        // the observables are released after the lock, since their
+        // destruction might need it
+        set_type observables;
+        {
+            boost::lock_guard<boost::mutex> lock(
+                                        proxy_->settings().observerLock(this));
+            observables.swap(observables_);
+        }
+        for (iterator i=observables.begin(); i!=observables.end(); ++i)
             (*i)->unregisterObserver(proxy_);
+    }
 
-        observables_.clear();
+    inline Observer::~Observer() {
+        if (proxy_ != 0) {
+            proxy_->deactivate();
+            unregisterWithAll();
+            proxy_->settings().retire(proxy_);
+        }
     }
 
     inline void Observer::deepUpdate() {
         update();
     }
+
+    inline bool Observer::forwardsNotifications() const {
+        return true;
+    }
 }
 #endif
 #endif
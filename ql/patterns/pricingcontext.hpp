@@ -0,0 +1,172 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pricingcontext.hpp
+    \brief per-thread instances of the singletons
+*/
+
+#ifndef quantlib_pricing_context_hpp
+#define quantlib_pricing_context_hpp
+
+#include <ql/types.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <vector>
+
+/* thread-local storage for the current context; __thread is preferred
+   when available, since unlike thread_local it never adds an
+   initialization check to the accesses from other translation units */
+#if defined(BOOST_MSVC)
+    #define QL_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+    #define QL_THREAD_LOCAL __thread
+#else
+    #define QL_THREAD_LOCAL thread_local
+#endif
+
+namespace QuantLib {
+
+    //! set of instances of the singletons
+    /*! A pricing context holds its own instances of the classes
+        derived from Singleton, such as Settings, IndexManager,
+        ExchangeRateManager and ObservableSettings; they are created
+        with their default state when first used in the context, and
+        destroyed with it.
+
+        Each thread has a current context, which is switched by means
+        of an instance of PricingContextSwitch; when a context is
+        current, Singleton::instance() returns the instances that it
+        holds.  Threads that never switched use the global instances,
+        i.e., the ones that are returned when no context is used.
+        This allows different threads to price under different
+        evaluation dates or fixings without locking; the lookup of
+        the current context is an inlined read of a thread-local
+        pointer, and doesn't use any lock, nor the sessionId()
+        function required by QL_ENABLE_SESSIONS.
+
+        Objects should be built and used within the same context,
+        and must not outlive it: for instance, term structures
+        register as observers with the evaluation date of the context
+        that was current when they were built, and observables keep a
+        reference to its ObservableSettings instance.
+
+        \warning a context can be current for several threads at the
+                 same time only if its singletons are already created
+                 and are not modified by any of the threads.
+
+        \ingroup patterns
+    */
+    class PricingContext : private boost::noncopyable {
+        template <class T> friend class Singleton;
+        friend class PricingContextSwitch;
+      public:
+        PricingContext() {}
+        //! destroys the singletons in reverse order of creation
+        ~PricingContext();
+        /*! returns the context which is current for the calling
+            thread, or a null pointer if the global instances are
+            being used.
+        */
+        static PricingContext* current();
+      private:
+        typedef boost::shared_ptr<void> (*factory)();
+        // returns the instance with the given key, creating it with
+        // the given factory if needed
+        void* instance(const void* key, factory create);
+        static void setCurrent(PricingContext*);
+        static QL_THREAD_LOCAL PricingContext* current_;
+        std::vector<std::pair<const void*, boost::shared_ptr<void> > >
+                                                                  instances_;
+    };
+
+
+    //! scoped switch of the current pricing context
+    /*! The given context becomes current for the calling thread
+        during the lifetime of the instance; the previous one is
+        restored by the destructor.  A null pointer switches to the
+        global instances.
+
+        \code
+        boost::shared_ptr<PricingContext> scenario(new PricingContext);
+        {
+            PricingContextSwitch inScenario(scenario);
+            Settings::instance().evaluationDate() = scenarioDate;
+            // build and price the instruments
+        }
+        \endcode
+
+        \test the independence of different contexts is checked.
+    */
+    class PricingContextSwitch : private boost::noncopyable {
+      public:
+        explicit PricingContextSwitch(
+                            const boost::shared_ptr<PricingContext>& context);
+        /*! switches to a context owned elsewhere, e.g., the one
+            that is current for the thread spawning a worker; the
+            context must outlive the switch.
+        */
+        explicit PricingContextSwitch(PricingContext* context);
+        ~PricingContextSwitch();
+      private:
+        boost::shared_ptr<PricingContext> context_;
+        PricingContext* previous_;
+    };
+
+
+    // inline definitions
+
+    inline PricingContext* PricingContext::current() {
+        return current_;
+    }
+
+    inline void PricingContext::setCurrent(PricingContext* context) {
+        current_ = context;
+    }
+
+    inline void* PricingContext::instance(const void* key,
+                                          factory create) {
+        for (Size i=0; i<instances_.size(); ++i) {
+            if (instances_[i].first == key)
+                return instances_[i].second.get();
+        }
+        // the constructor might use other singletons, which would be
+        // added to the context before this one
+        boost::shared_ptr<void> instance = create();
+        instances_.push_back(std::make_pair(key, instance));
+        return instance.get();
+    }
+
+    inline PricingContextSwitch::PricingContextSwitch(
+                             const boost::shared_ptr<PricingContext>& context)
+    : context_(context), previous_(PricingContext::current()) {
+        PricingContext::setCurrent(context_.get());
+    }
+
+    inline PricingContextSwitch::PricingContextSwitch(
+                                                     PricingContext* context)
+    : previous_(PricingContext::current()) {
+        PricingContext::setCurrent(context);
+    }
+
+    inline PricingContextSwitch::~PricingContextSwitch() {
+        PricingContext::setCurrent(previous_);
+    }
+
+}
+
+
+#endif
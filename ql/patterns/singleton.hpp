@@ -56,6 +56,7 @@
 #endif
 
 #include <ql/types.hpp>
+#include <ql/patterns/pricingcontext.hpp>
 #include <boost/shared_ptr.hpp>
 #if defined(QL_PATCH_MSVC)
     #pragma managed(push, off)
@@ -105,6 +106,9 @@ namespace QuantLib {
         as a single implemementation point should synchronization
         features be added.
 
+        Different instances are returned in different pricing
+        contexts; see PricingContext.
+
         \ingroup patterns
     */
     template <class T>
@@ -120,15 +124,27 @@ namespace QuantLib {
         static boost::mutex mutex_;
     #endif
 
+      private:
+        // identifies the instance held by a pricing context
+        static char contextKey_;
+        static boost::shared_ptr<void> create() {
+            return boost::shared_ptr<T>(new T);
+        }
+
       public:
         //! access to the unique instance
+        /*! if a pricing context is current for the calling thread,
+            the instance held by the context is returned.
+        */
         static T& instance();
       protected:
         Singleton() {}
     };
 
     // static member definitions
-    
+
+    template <class T> char Singleton<T>::contextKey_ = 0;
+
     #if (QL_MANAGED == 1) && !defined(QL_SINGLETON_THREAD_SAFE_INIT)
       template <class T>
       std::map<Integer, boost::shared_ptr<T> > Singleton<T>::instances_;
@@ -144,6 +160,11 @@ namespace QuantLib {
     template <class T>
     T& Singleton<T>::instance() {
 
+        PricingContext* context = PricingContext::current();
+        if (context)
+            return *static_cast<T*>(
+                         context->instance(&contextKey_, &Singleton<T>::create));
+
         #if (QL_MANAGED == 0) && !defined(QL_SINGLETON_THREAD_SAFE_INIT)
         static std::map<Integer, boost::shared_ptr<T> > instances_;
         #endif
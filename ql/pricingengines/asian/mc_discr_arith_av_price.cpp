@@ -51,4 +51,48 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+    void ArithmeticAPOPathPricer::operator()(
+                                          const PathBatch& paths,
+                                          std::vector<Real>& values) const {
+        Size n = paths.length();
+        QL_REQUIRE(n>1, "the paths cannot be empty");
+
+        Size m = paths.paths();
+        values.assign(m, runningSum_);
+
+        Size first, fixings;
+        if (paths.timeGrid().mandatoryTimes()[0]==0.0) {
+            // include initial fixing
+            first = 0;
+            fixings = pastFixings_ + n;
+        } else {
+            first = 1;
+            fixings = pastFixings_ + n - 1;
+        }
+
+        // the sums are accumulated in the same order as in the
+        // single-path version, one time at a time
+        for (Size i=first; i<n; ++i) {
+            const Real* x = paths.values(i);
+            for (Size j=0; j<m; ++j)
+                values[j] += x[j];
+        }
+
+        Real strike = payoff_.strike();
+        switch (payoff_.optionType()) {
+          case Option::Call:
+            for (Size j=0; j<m; ++j)
+                values[j] = discount_ *
+                    std::max<Real>(values[j]/fixings-strike,0.0);
+            break;
+          case Option::Put:
+            for (Size j=0; j<m; ++j)
+                values[j] = discount_ *
+                    std::max<Real>(strike-values[j]/fixings,0.0);
+            break;
+          default:
+            QL_FAIL("unknown/illegal option type");
+        }
+    }
+
 }
@@ -64,9 +64,11 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1);
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
+        Size batchSize() const { return this->cacheFriendlyBatchSize(); }
         boost::shared_ptr<path_pricer_type> controlPathPricer() const;
         boost::shared_ptr<PricingEngine> controlPricingEngine() const {
             return boost::shared_ptr<PricingEngine>(
@@ -76,7 +78,8 @@ namespace QuantLib {
     };
 
 
-    class ArithmeticAPOPathPricer : public PathPricer<Path> {
+    class ArithmeticAPOPathPricer : public PathPricer<Path>,
+                                    public BatchPathPricer<PathBatch> {
       public:
         ArithmeticAPOPathPricer(Option::Type type,
                                 Real strike,
@@ -84,6 +87,8 @@ namespace QuantLib {
                                 Real runningSum = 0.0,
                                 Size pastFixings = 0);
         Real operator()(const Path& path) const;
+        void operator()(const PathBatch& paths,
+                        std::vector<Real>& values) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
@@ -104,7 +109,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size workers)
     : MCDiscreteAveragingAsianEngine<RNG,S>(process,
                                             brownianBridge,
                                             antitheticVariate,
@@ -112,7 +118,8 @@ namespace QuantLib {
                                             requiredSamples,
                                             requiredTolerance,
                                             maxSamples,
-                                            seed) {}
+                                            seed,
+                                            workers) {}
 
     template <class RNG, class S>
     inline
@@ -182,6 +189,7 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withWorkers(Size workers);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -191,6 +199,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size workers_;
     };
 
     template <class RNG, class S>
@@ -199,7 +208,8 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false), controlVariate_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0),
+      workers_(1) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
@@ -258,6 +268,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -268,7 +285,8 @@ namespace QuantLib {
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
-                                                seed_));
+                                                seed_,
+                                                workers_));
     }
 
 
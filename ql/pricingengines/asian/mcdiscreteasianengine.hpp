@@ -70,7 +70,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1);
         void calculate() const {
             try {
                 McSimulation<SingleVariate,RNG,S>::calculate(
@@ -131,8 +132,10 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
-    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, controlVariate),
+             BigNatural seed,
+             Size workers)
+    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, controlVariate,
+                                        workers),
       process_(process), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance),
       brownianBridge_(brownianBridge), seed_(seed) {
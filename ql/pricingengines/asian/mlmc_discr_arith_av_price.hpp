@@ -0,0 +1,262 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmc_discr_arith_av_price.hpp
+    \brief Multilevel Monte Carlo engine for discrete arithmetic average
+           price Asian
+*/
+
+#ifndef quantlib_mlmc_discrete_arithmetic_average_price_asian_engine_hpp
+#define quantlib_mlmc_discrete_arithmetic_average_price_asian_engine_hpp
+
+#include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
+#include <ql/pricingengines/multilevelmcsimulation.hpp>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo engine for discrete arithmetic average price Asian
+    /*! The coarsest level simulates the underlying on the fixing
+        dates only; the following levels refine the discretization of
+        the process between fixings, while the payoff is always
+        computed on the fixing dates.  This reduces the
+        discretization bias of processes whose evolution is not
+        exact, e.g., with a local volatility; a weak order of 1 is
+        assumed.
+
+        \ingroup asianengines
+
+        \test the returned value is compared with analytic results for
+              a process evolved exactly, and with the one of the
+              Monte Carlo engine for an Euler-discretized process,
+              whose corrections are checked for decaying variance.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCDiscreteArithmeticAPEngine
+        : public DiscreteAveragingAsianOption::engine,
+          public MultiLevelMcSimulation<SingleVariate,RNG,S> {
+      public:
+        typedef
+        typename MultiLevelMcSimulation<SingleVariate,RNG,S>::path_pricer_type
+            path_pricer_type;
+        typedef typename MultiLevelMcSimulation<SingleVariate,RNG,S>::stats_type
+            stats_type;
+        // constructor
+        MLMCDiscreteArithmeticAPEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             bool antitheticVariate,
+             Real requiredTolerance,
+             Size maxLevels,
+             Size calibrationSamples,
+             Size refinement,
+             BigNatural seed);
+        void calculate() const {
+            MultiLevelMcSimulation<SingleVariate,RNG,S>::calculate(
+                                                          requiredTolerance_,
+                                                          maxLevels_,
+                                                          calibrationSamples_);
+            results_.value = this->mcModel_->mean();
+            results_.errorEstimate = this->mcModel_->errorEstimate();
+        }
+      protected:
+        // MultiLevelMcSimulation implementation
+        boost::shared_ptr<StochasticProcess> process() const {
+            return process_;
+        }
+        TimeGrid timeGrid() const;
+        TimeGrid pricingGrid() const {
+            return timeGrid();
+        }
+        boost::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const;
+        // data members
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Real requiredTolerance_;
+        Size maxLevels_, calibrationSamples_;
+    };
+
+
+    //! Multilevel Monte Carlo arithmetic average-price Asian engine factory
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MakeMLMCDiscreteArithmeticAPEngine {
+      public:
+        MakeMLMCDiscreteArithmeticAPEngine(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process);
+        // named parameters
+        MakeMLMCDiscreteArithmeticAPEngine& withAntitheticVariate(
+                                                              bool b = true);
+        MakeMLMCDiscreteArithmeticAPEngine& withAbsoluteTolerance(
+                                                            Real tolerance);
+        MakeMLMCDiscreteArithmeticAPEngine& withMaxLevels(Size levels);
+        MakeMLMCDiscreteArithmeticAPEngine& withCalibrationSamples(
+                                                               Size samples);
+        MakeMLMCDiscreteArithmeticAPEngine& withRefinement(Size refinement);
+        MakeMLMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
+        // conversion to pricing engine
+        operator boost::shared_ptr<PricingEngine>() const;
+      private:
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        bool antithetic_;
+        Real tolerance_;
+        Size maxLevels_, calibrationSamples_, refinement_;
+        BigNatural seed_;
+    };
+
+
+    // inline definitions
+
+    template <class RNG, class S>
+    inline
+    MLMCDiscreteArithmeticAPEngine<RNG,S>::MLMCDiscreteArithmeticAPEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             bool antitheticVariate,
+             Real requiredTolerance,
+             Size maxLevels,
+             Size calibrationSamples,
+             Size refinement,
+             BigNatural seed)
+    : MultiLevelMcSimulation<SingleVariate,RNG,S>(antitheticVariate,
+                                                  refinement, 1.0, seed),
+      process_(process), requiredTolerance_(requiredTolerance),
+      maxLevels_(maxLevels), calibrationSamples_(calibrationSamples) {
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline
+    TimeGrid MLMCDiscreteArithmeticAPEngine<RNG,S>::timeGrid() const {
+
+        Date referenceDate = process_->riskFreeRate()->referenceDate();
+        DayCounter voldc = process_->blackVolatility()->dayCounter();
+        std::vector<Time> fixingTimes;
+        for (Size i=0; i<arguments_.fixingDates.size(); i++) {
+            if (arguments_.fixingDates[i]>=referenceDate) {
+                Time t = voldc.yearFraction(referenceDate,
+                    arguments_.fixingDates[i]);
+                fixingTimes.push_back(t);
+            }
+        }
+
+        if (fixingTimes.empty() ||
+            (fixingTimes.size() == 1 && fixingTimes.front() == 0.0))
+            throw detail::PastFixingsOnly();
+
+        return TimeGrid(fixingTimes.begin(), fixingTimes.end());
+    }
+
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<
+        typename MLMCDiscreteArithmeticAPEngine<RNG,S>::path_pricer_type>
+    MLMCDiscreteArithmeticAPEngine<RNG,S>::pathPricer(const TimeGrid&) const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        boost::shared_ptr<EuropeanExercise> exercise =
+            boost::dynamic_pointer_cast<EuropeanExercise>(
+                this->arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        return boost::shared_ptr<typename
+            MLMCDiscreteArithmeticAPEngine<RNG,S>::path_pricer_type>(
+                new ArithmeticAPOPathPricer(
+                    payoff->optionType(),
+                    payoff->strike(),
+                    this->process_->riskFreeRate()->discount(
+                                                        exercise->lastDate()),
+                    this->arguments_.runningAccumulator,
+                    this->arguments_.pastFixings));
+    }
+
+
+    template <class RNG, class S>
+    inline
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::
+    MakeMLMCDiscreteArithmeticAPEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
+    : process_(process), antithetic_(false), tolerance_(Null<Real>()),
+      maxLevels_(10), calibrationSamples_(1000), refinement_(2), seed_(0) {}
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withAntitheticVariate(bool b) {
+        antithetic_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withAbsoluteTolerance(
+                                                             Real tolerance) {
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withMaxLevels(Size levels) {
+        maxLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withCalibrationSamples(
+                                                               Size samples) {
+        calibrationSamples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withRefinement(
+                                                           Size refinement) {
+        refinement_ = refinement;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::
+    operator boost::shared_ptr<PricingEngine>() const {
+        QL_REQUIRE(tolerance_ != Null<Real>(), "tolerance not given");
+        return boost::shared_ptr<PricingEngine>(new
+            MLMCDiscreteArithmeticAPEngine<RNG,S>(process_,
+                                                  antithetic_,
+                                                  tolerance_,
+                                                  maxLevels_,
+                                                  calibrationSamples_,
+                                                  refinement_,
+                                                  seed_));
+    }
+
+}
+
+
+#endif
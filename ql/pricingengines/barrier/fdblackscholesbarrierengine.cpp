@@ -40,10 +40,12 @@ namespace QuantLib {
             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
             Size tGrid, Size xGrid, Size dampingSteps, 
             const FdmSchemeDesc& schemeDesc,
-            bool localVol, Real illegalLocalVolOverwrite)
+            bool localVol, Real illegalLocalVolOverwrite,
+            const boost::shared_ptr<FdmMesherCache>& mesherCache)
     : process_(process), tGrid_(tGrid), xGrid_(xGrid),
       dampingSteps_(dampingSteps), schemeDesc_(schemeDesc),
-      localVol_(localVol), illegalLocalVolOverwrite_(illegalLocalVolOverwrite){
+      localVol_(localVol), illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      mesherCache_(mesherCache) {
 
         registerWith(process_);
     }
@@ -66,15 +68,18 @@ namespace QuantLib {
             xMax = std::log(arguments_.barrier);
         }
 
-        const boost::shared_ptr<Fdm1dMesher> equityMesher(
-            new FdmBlackScholesMesher(
+        FdmMesherCache noCache(0);
+        FdmMesherCache& meshers = (mesherCache_) ? *mesherCache_ : noCache;
+
+        const boost::shared_ptr<Fdm1dMesher> equityMesher =
+            meshers.blackScholesMesher(
                 xGrid_, process_, maturity, payoff->strike(),
                 xMin, xMax, 0.0001, 1.5,
                 std::make_pair(Null<Real>(), Null<Real>()),
-                arguments_.cashFlow));
+                arguments_.cashFlow);
         
-        const boost::shared_ptr<FdmMesher> mesher (
-            boost::make_shared<FdmMesherComposite>(equityMesher));
+        const boost::shared_ptr<FdmMesher> mesher =
+            meshers.composite(equityMesher);
 
         // 2. Calculator
         boost::shared_ptr<FdmInnerValueCalculator> calculator(
@@ -120,7 +125,7 @@ namespace QuantLib {
 
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
-                                     maturity, tGrid_, dampingSteps_ };
+                                     maturity, tGrid_, dampingSteps_, 0.0 };
 
         boost::shared_ptr<FdmBlackScholesSolver> solver(
             boost::make_shared<FdmBlackScholesSolver>(
@@ -152,7 +157,8 @@ namespace QuantLib {
                 boost::make_shared<FdBlackScholesVanillaEngine>(
                         process_, tGrid_, xGrid_,
                         0, // dampingSteps
-                        schemeDesc_, localVol_, illegalLocalVolOverwrite_));
+                        schemeDesc_, localVol_, illegalLocalVolOverwrite_,
+                        mesherCache_));
 
             // Calculate the rebate value
             boost::shared_ptr<DividendBarrierOption> rebateOption(
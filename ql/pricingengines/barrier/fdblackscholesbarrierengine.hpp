@@ -28,6 +28,7 @@
 
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercache.hpp>
 #include <ql/instruments/dividendbarrieroption.hpp>
 
 namespace QuantLib {
@@ -40,6 +41,10 @@ namespace QuantLib {
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
+
+        If a mesher cache is given, the meshers are taken from it
+        whenever possible, also for the vanilla part of knock-in
+        options; see FdmMesherCache.
     */
     class FdBlackScholesBarrierEngine : public DividendBarrierOption::engine {
       public:
@@ -49,7 +54,9 @@ namespace QuantLib {
                 Size tGrid = 100, Size xGrid = 100, Size dampingSteps = 0,
                 const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
                 bool localVol = false, 
-                Real illegalLocalVolOverwrite = -Null<Real>());
+                Real illegalLocalVolOverwrite = -Null<Real>(),
+                const boost::shared_ptr<FdmMesherCache>& mesherCache
+                    = boost::shared_ptr<FdmMesherCache>());
 
         void calculate() const;
 
@@ -59,6 +66,7 @@ namespace QuantLib {
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+        const boost::shared_ptr<FdmMesherCache> mesherCache_;
     };
 
 
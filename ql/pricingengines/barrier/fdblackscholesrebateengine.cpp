@@ -107,7 +107,7 @@ namespace QuantLib {
 
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
-                                     maturity, tGrid_, dampingSteps_ };
+                                     maturity, tGrid_, dampingSteps_, 0.0 };
 
         const boost::shared_ptr<FdmBlackScholesSolver> solver(
                 new FdmBlackScholesSolver(
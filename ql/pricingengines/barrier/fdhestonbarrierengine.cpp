@@ -38,14 +38,16 @@ namespace QuantLib {
             const boost::shared_ptr<HestonModel>& model,
             Size tGrid, Size xGrid, Size vGrid, Size dampingSteps,
             const FdmSchemeDesc& schemeDesc,
-            const boost::shared_ptr<LocalVolTermStructure>& leverageFct)
+            const boost::shared_ptr<LocalVolTermStructure>& leverageFct,
+            const boost::shared_ptr<FdmMesherCache>& mesherCache)
     : GenericModelEngine<HestonModel,
                         DividendBarrierOption::arguments,
                         DividendBarrierOption::results>(model),
       tGrid_(tGrid), xGrid_(xGrid), 
       vGrid_(vGrid), dampingSteps_(dampingSteps),
       schemeDesc_(schemeDesc),
-      leverageFct_(leverageFct) {
+      leverageFct_(leverageFct),
+      mesherCache_(mesherCache) {
     }
 
     void FdHestonBarrierEngine::calculate() const {
@@ -54,11 +56,14 @@ namespace QuantLib {
         const boost::shared_ptr<HestonProcess>& process = model_->process();
         const Time maturity = process->time(arguments_.exercise->lastDate());
 
+        FdmMesherCache noCache(0);
+        FdmMesherCache& meshers = (mesherCache_) ? *mesherCache_ : noCache;
+
         // 1.1 The variance mesher
         const Size tGridMin = 5;
-        const boost::shared_ptr<FdmHestonVarianceMesher> varianceMesher(
-			boost::make_shared<FdmHestonVarianceMesher>(vGrid_, process, maturity,
-                                        std::max(tGridMin, tGrid_/50)));
+        const boost::shared_ptr<FdmHestonVarianceMesher> varianceMesher =
+            meshers.hestonVarianceMesher(vGrid_, process, maturity,
+                                         std::max(tGridMin, tGrid_/50));
 
         // 1.2 The equity mesher
         const boost::shared_ptr<StrikedTypePayoff> payoff =
@@ -75,8 +80,8 @@ namespace QuantLib {
             xMax = std::log(arguments_.barrier);
         }
 
-        const boost::shared_ptr<Fdm1dMesher> equityMesher(
-            new FdmBlackScholesMesher(
+        const boost::shared_ptr<Fdm1dMesher> equityMesher =
+            meshers.blackScholesMesher(
                 xGrid_,
                 FdmBlackScholesMesher::processHelper(
                     process->s0(), process->dividendYield(),
@@ -84,10 +89,10 @@ namespace QuantLib {
                 maturity, payoff->strike(),
                 xMin, xMax, 0.0001, 1.5,
                 std::make_pair(Null<Real>(), Null<Real>()),
-                arguments_.cashFlow));
+                arguments_.cashFlow);
 
-        const boost::shared_ptr<FdmMesher> mesher (
-			boost::make_shared<FdmMesherComposite>(equityMesher, varianceMesher));
+        const boost::shared_ptr<FdmMesher> mesher =
+            meshers.composite(equityMesher, varianceMesher);
 
         // 2. Calculator
         boost::shared_ptr<FdmInnerValueCalculator> calculator(
@@ -133,7 +138,7 @@ namespace QuantLib {
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
                                      calculator, maturity,
-                                     tGrid_, dampingSteps_ };
+                                     tGrid_, dampingSteps_, 0.0 };
 
         boost::shared_ptr<FdmHestonSolver> solver(boost::make_shared<FdmHestonSolver>(
                     Handle<HestonProcess>(process), solverDesc, schemeDesc_,
@@ -160,7 +165,10 @@ namespace QuantLib {
             vanillaOption->setPricingEngine(boost::shared_ptr<PricingEngine>(
 				boost::make_shared<FdHestonVanillaEngine>(*model_, tGrid_, xGrid_,
                                               vGrid_, dampingSteps_,
-                                              schemeDesc_)));
+                                              schemeDesc_,
+                                              boost::shared_ptr<
+                                                  LocalVolTermStructure>(),
+                                              mesherCache_)));
             // Calculate the rebate value
             boost::shared_ptr<DividendBarrierOption> rebateOption(
 				boost::make_shared<DividendBarrierOption>(arguments_.barrierType,
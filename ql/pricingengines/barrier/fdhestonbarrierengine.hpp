@@ -30,6 +30,7 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercache.hpp>
 #include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
 #include <ql/instruments/dividendbarrieroption.hpp>
 
@@ -44,6 +45,10 @@ namespace QuantLib {
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
+
+        If a mesher cache is given, the meshers are taken from it
+        whenever possible, also for the vanilla part of knock-in
+        options; see FdmMesherCache.
     */
     class FdHestonBarrierEngine
         : public GenericModelEngine<HestonModel,
@@ -57,7 +62,9 @@ namespace QuantLib {
             Size vGrid = 50, Size dampingSteps = 0,
             const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
             const boost::shared_ptr<LocalVolTermStructure>& leverageFct
-                = boost::shared_ptr<LocalVolTermStructure>());
+                = boost::shared_ptr<LocalVolTermStructure>(),
+            const boost::shared_ptr<FdmMesherCache>& mesherCache
+                = boost::shared_ptr<FdmMesherCache>());
 
         void calculate() const;
 
@@ -65,6 +72,7 @@ namespace QuantLib {
         const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         const boost::shared_ptr<LocalVolTermStructure> leverageFct_;
+        const boost::shared_ptr<FdmMesherCache> mesherCache_;
     };
 
 
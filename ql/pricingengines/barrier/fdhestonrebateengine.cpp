@@ -122,7 +122,7 @@ namespace QuantLib {
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
                                      calculator, maturity,
-                                     tGrid_, dampingSteps_ };
+                                     tGrid_, dampingSteps_, 0.0 };
 
         boost::shared_ptr<FdmHestonSolver> solver(new FdmHestonSolver(
                     Handle<HestonProcess>(process), solverDesc, schemeDesc_,
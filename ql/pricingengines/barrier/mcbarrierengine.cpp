@@ -157,6 +157,95 @@ namespace QuantLib {
     }
 
 
+    void BarrierPathPricer::operator()(const PathBatch& paths,
+                                       std::vector<Real>& values) const {
+        static Size null = Null<Size>();
+        Size n = paths.length();
+        QL_REQUIRE(n>1, "the paths cannot be empty");
+
+        Size m = paths.paths();
+        const TimeGrid& timeGrid = paths.timeGrid();
+
+        // same variates as the single-path version, stored time-major
+        Matrix u(n-1, m);
+        for (Size j=0; j<m; j++) {
+            const std::vector<Real>& uj = sequenceGen_.nextSequence().value;
+            for (Size i=0; i<n-1; i++)
+                u[i][j] = uj[i];
+        }
+
+        std::vector<Size> knockNode(m, null);
+        Real x, y;
+        Volatility vol;
+
+        for (Size i=0; i<n-1; i++) {
+            const Real* asset_price = paths.values(i);
+            const Real* new_asset_price = paths.values(i+1);
+            Time dt = timeGrid.dt(i);
+            switch (barrierType_) {
+              case Barrier::DownIn:
+              case Barrier::DownOut:
+                for (Size j=0; j<m; j++) {
+                    // terminal or initial vol?
+                    vol = diffProcess_->diffusion(timeGrid[i],
+                                                  asset_price[j]);
+                    x = std::log(new_asset_price[j] / asset_price[j]);
+                    y = 0.5*(x - std::sqrt(x*x - 2*vol*vol*dt
+                                                 *std::log(u[i][j])));
+                    y = asset_price[j] * std::exp(y);
+                    if (y <= barrier_ && knockNode[j] == null)
+                        knockNode[j] = i+1;
+                }
+                break;
+              case Barrier::UpIn:
+              case Barrier::UpOut:
+                for (Size j=0; j<m; j++) {
+                    // terminal or initial vol?
+                    vol = diffProcess_->diffusion(timeGrid[i],
+                                                  asset_price[j]);
+                    x = std::log(new_asset_price[j] / asset_price[j]);
+                    y = 0.5*(x + std::sqrt(x*x - 2*vol*vol*dt
+                                                 *std::log((1-u[i][j]))));
+                    y = asset_price[j] * std::exp(y);
+                    if (y >= barrier_ && knockNode[j] == null)
+                        knockNode[j] = i+1;
+                }
+                break;
+              default:
+                QL_FAIL("unknown barrier type");
+            }
+        }
+
+        const Real* finalPrice = paths.values(n-1);
+        values.resize(m);
+        for (Size j=0; j<m; j++) {
+            switch (barrierType_) {
+              case Barrier::UpIn:
+              case Barrier::DownIn:
+                if (knockNode[j] != null)
+                    values[j] = payoff_(finalPrice[j]) * discounts_.back();
+                else
+                    values[j] = rebate_*discounts_.back();
+                break;
+              case Barrier::UpOut:
+              case Barrier::DownOut:
+                if (knockNode[j] == null)
+                    values[j] = payoff_(finalPrice[j]) * discounts_.back();
+                else
+                    values[j] = rebate_*discounts_[knockNode[j]];
+                break;
+              default:
+                QL_FAIL("unknown barrier type");
+            }
+        }
+    }
+
+
+    void BarrierPathPricer::discard(Size n) {
+        sequenceGen_.discard(n);
+    }
+
+
     BiasedBarrierPathPricer::BiasedBarrierPathPricer(
                                  Barrier::Type barrierType,
                                  Real barrier,
@@ -248,4 +337,61 @@ namespace QuantLib {
         }
     }
 
+
+    void BiasedBarrierPathPricer::operator()(
+                                          const PathBatch& paths,
+                                          std::vector<Real>& values) const {
+        static Size null = Null<Size>();
+        Size n = paths.length();
+        QL_REQUIRE(n>1, "the paths cannot be empty");
+
+        Size m = paths.paths();
+        std::vector<Size> knockNode(m, null);
+
+        for (Size i=1; i<n; i++) {
+            const Real* asset_price = paths.values(i);
+            switch (barrierType_) {
+              case Barrier::DownIn:
+              case Barrier::DownOut:
+                for (Size j=0; j<m; j++) {
+                    if (asset_price[j] <= barrier_ && knockNode[j] == null)
+                        knockNode[j] = i;
+                }
+                break;
+              case Barrier::UpIn:
+              case Barrier::UpOut:
+                for (Size j=0; j<m; j++) {
+                    if (asset_price[j] >= barrier_ && knockNode[j] == null)
+                        knockNode[j] = i;
+                }
+                break;
+              default:
+                QL_FAIL("unknown barrier type");
+            }
+        }
+
+        const Real* finalPrice = paths.values(n-1);
+        values.resize(m);
+        for (Size j=0; j<m; j++) {
+            switch (barrierType_) {
+              case Barrier::UpIn:
+              case Barrier::DownIn:
+                if (knockNode[j] != null)
+                    values[j] = payoff_(finalPrice[j]) * discounts_.back();
+                else
+                    values[j] = rebate_*discounts_.back();
+                break;
+              case Barrier::UpOut:
+              case Barrier::DownOut:
+                if (knockNode[j] == null)
+                    values[j] = payoff_(finalPrice[j]) * discounts_.back();
+                else
+                    values[j] = rebate_*discounts_[knockNode[j]];
+                break;
+              default:
+                QL_FAIL("unknown barrier type");
+            }
+        }
+    }
+
 }
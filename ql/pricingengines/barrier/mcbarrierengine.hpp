@@ -74,7 +74,8 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1);
         void calculate() const {
             Real spot = process_->x0();
             QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
@@ -99,6 +100,7 @@ namespace QuantLib {
                                                  grid, gen, brownianBridge_));
         }
         boost::shared_ptr<path_pricer_type> pathPricer() const;
+        Size batchSize() const { return this->cacheFriendlyBatchSize(); }
         // data members
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
@@ -126,6 +128,7 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withWorkers(Size workers);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -134,10 +137,13 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size workers_;
     };
 
 
-    class BarrierPathPricer : public PathPricer<Path> {
+    class BarrierPathPricer : public PathPricer<Path>,
+                              public BatchPathPricer<PathBatch>,
+                              public RandomizedPathPricer {
       public:
         BarrierPathPricer(
                     Barrier::Type barrierType,
@@ -149,6 +155,16 @@ namespace QuantLib {
                     const boost::shared_ptr<StochasticProcess1D>& diffProcess,
                     const PseudoRandom::ursg_type& sequenceGen);
         Real operator()(const Path& path) const;
+        /*! \note the uniform variates for the Brownian-bridge
+                  correction are drawn for the paths of the batch in
+                  order.  When antithetic paths are used, this pairs
+                  them with different variates than the single-path
+                  version, in which each path is followed by its
+                  antithetic.
+        */
+        void operator()(const PathBatch& paths,
+                        std::vector<Real>& values) const;
+        void discard(Size n);
       private:
         Barrier::Type barrierType_;
         Real barrier_;
@@ -160,7 +176,8 @@ namespace QuantLib {
     };
 
 
-    class BiasedBarrierPathPricer : public PathPricer<Path> {
+    class BiasedBarrierPathPricer : public PathPricer<Path>,
+                                    public BatchPathPricer<PathBatch> {
       public:
         BiasedBarrierPathPricer(Barrier::Type barrierType,
                                 Real barrier,
@@ -169,6 +186,8 @@ namespace QuantLib {
                                 Real strike,
                                 const std::vector<DiscountFactor>& discounts);
         Real operator()(const Path& path) const;
+        void operator()(const PathBatch& paths,
+                        std::vector<Real>& values) const;
       private:
         Barrier::Type barrierType_;
         Real barrier_;
@@ -192,8 +211,9 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed)
-    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, false),
+             BigNatural seed,
+             Size workers)
+    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, false, workers),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -278,7 +298,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       biased_(false), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), workers_(1) {}
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
@@ -350,6 +370,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -367,7 +394,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   workers_));
     }
 
 }
@@ -0,0 +1,282 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmcbarrierengine.hpp
+    \brief Multilevel Monte Carlo barrier option engine
+*/
+
+#ifndef quantlib_mlmc_barrier_engine_hpp
+#define quantlib_mlmc_barrier_engine_hpp
+
+#include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/multilevelmcsimulation.hpp>
+
+namespace QuantLib {
+
+    //! Pricing engine for barrier options using multilevel Monte Carlo
+    /*! The barrier is monitored at the points of the grid of each
+        level, as in MCBarrierEngine without Brownian-bridge
+        correction; the levels refine the monitoring of the barrier
+        until the estimated bias with respect to continuous monitoring
+        is below the required tolerance.  Since the bias decays as
+        the square root of the time step, a weak order of 0.5 is
+        used.
+
+        \ingroup barrierengines
+
+        \test the returned value is compared with the analytic value
+              of the continuously-monitored option.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCBarrierEngine : public BarrierOption::engine,
+                              public MultiLevelMcSimulation<SingleVariate,
+                                                            RNG,S> {
+      public:
+        typedef
+        typename MultiLevelMcSimulation<SingleVariate,RNG,S>::path_pricer_type
+            path_pricer_type;
+        typedef typename MultiLevelMcSimulation<SingleVariate,RNG,S>::stats_type
+            stats_type;
+        // constructor
+        MLMCBarrierEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Size timeSteps,
+             Size timeStepsPerYear,
+             bool antitheticVariate,
+             Real requiredTolerance,
+             Size maxLevels,
+             Size calibrationSamples,
+             Size refinement,
+             BigNatural seed);
+        void calculate() const {
+            Real spot = process_->x0();
+            QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
+            QL_REQUIRE(!triggered(spot), "barrier touched");
+            MultiLevelMcSimulation<SingleVariate,RNG,S>::calculate(
+                                                          requiredTolerance_,
+                                                          maxLevels_,
+                                                          calibrationSamples_);
+            results_.value = this->mcModel_->mean();
+            results_.errorEstimate = this->mcModel_->errorEstimate();
+        }
+      protected:
+        // MultiLevelMcSimulation implementation
+        boost::shared_ptr<StochasticProcess> process() const {
+            return process_;
+        }
+        TimeGrid timeGrid() const;
+        boost::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const;
+        // data members
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size timeSteps_, timeStepsPerYear_;
+        Real requiredTolerance_;
+        Size maxLevels_, calibrationSamples_;
+    };
+
+
+    //! Multilevel Monte Carlo barrier-option engine factory
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MakeMLMCBarrierEngine {
+      public:
+        MakeMLMCBarrierEngine(
+                    const boost::shared_ptr<GeneralizedBlackScholesProcess>&);
+        // named parameters
+        MakeMLMCBarrierEngine& withSteps(Size steps);
+        MakeMLMCBarrierEngine& withStepsPerYear(Size steps);
+        MakeMLMCBarrierEngine& withAntitheticVariate(bool b = true);
+        MakeMLMCBarrierEngine& withAbsoluteTolerance(Real tolerance);
+        MakeMLMCBarrierEngine& withMaxLevels(Size levels);
+        MakeMLMCBarrierEngine& withCalibrationSamples(Size samples);
+        MakeMLMCBarrierEngine& withRefinement(Size refinement);
+        MakeMLMCBarrierEngine& withSeed(BigNatural seed);
+        // conversion to pricing engine
+        operator boost::shared_ptr<PricingEngine>() const;
+      private:
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        bool antithetic_;
+        Size steps_, stepsPerYear_;
+        Real tolerance_;
+        Size maxLevels_, calibrationSamples_, refinement_;
+        BigNatural seed_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S>
+    inline MLMCBarrierEngine<RNG,S>::MLMCBarrierEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Size timeSteps,
+             Size timeStepsPerYear,
+             bool antitheticVariate,
+             Real requiredTolerance,
+             Size maxLevels,
+             Size calibrationSamples,
+             Size refinement,
+             BigNatural seed)
+    : MultiLevelMcSimulation<SingleVariate,RNG,S>(antitheticVariate,
+                                                  refinement, 0.5, seed),
+      process_(process), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear),
+      requiredTolerance_(requiredTolerance), maxLevels_(maxLevels),
+      calibrationSamples_(calibrationSamples) {
+        QL_REQUIRE(timeSteps != Null<Size>() ||
+                   timeStepsPerYear != Null<Size>(),
+                   "no time steps provided");
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid MLMCBarrierEngine<RNG,S>::timeGrid() const {
+
+        Time residualTime = process_->time(arguments_.exercise->lastDate());
+        if (timeSteps_ != Null<Size>()) {
+            return TimeGrid(residualTime, timeSteps_);
+        } else if (timeStepsPerYear_ != Null<Size>()) {
+            Size steps = static_cast<Size>(timeStepsPerYear_*residualTime);
+            return TimeGrid(residualTime, std::max<Size>(steps, 1));
+        } else {
+            QL_FAIL("time steps not specified");
+        }
+    }
+
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<typename MLMCBarrierEngine<RNG,S>::path_pricer_type>
+    MLMCBarrierEngine<RNG,S>::pathPricer(const TimeGrid& grid) const {
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        std::vector<DiscountFactor> discounts(grid.size());
+        for (Size i=0; i<grid.size(); i++)
+            discounts[i] = process_->riskFreeRate()->discount(grid[i]);
+
+        return boost::shared_ptr<
+                    typename MLMCBarrierEngine<RNG,S>::path_pricer_type>(
+            new BiasedBarrierPathPricer(
+                   arguments_.barrierType,
+                   arguments_.barrier,
+                   arguments_.rebate,
+                   payoff->optionType(),
+                   payoff->strike(),
+                   discounts));
+    }
+
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>::MakeMLMCBarrierEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
+    : process_(process), antithetic_(false),
+      steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
+      tolerance_(Null<Real>()), maxLevels_(10), calibrationSamples_(1000),
+      refinement_(2), seed_(0) {}
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withSteps(Size steps) {
+        steps_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withStepsPerYear(Size steps) {
+        stepsPerYear_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withAntitheticVariate(bool b) {
+        antithetic_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withAbsoluteTolerance(Real tolerance) {
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withMaxLevels(Size levels) {
+        maxLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withCalibrationSamples(Size samples) {
+        calibrationSamples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withRefinement(Size refinement) {
+        refinement_ = refinement;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline
+    MakeMLMCBarrierEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
+                                                                      const {
+        QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
+                   "number of steps not given");
+        QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
+                   "number of steps overspecified");
+        QL_REQUIRE(tolerance_ != Null<Real>(), "tolerance not given");
+        return boost::shared_ptr<PricingEngine>(new
+            MLMCBarrierEngine<RNG,S>(process_,
+                                     steps_,
+                                     stepsPerYear_,
+                                     antithetic_,
+                                     tolerance_,
+                                     maxLevels_,
+                                     calibrationSamples_,
+                                     refinement_,
+                                     seed_));
+    }
+
+}
+
+
+#endif
@@ -89,7 +89,8 @@ namespace QuantLib {
         // 6. Solver
         const FdmSolverDesc solverDesc = { mesher, boundaries,
                                            conditions, calculator,
-                                           maturity, tGrid_, dampingSteps_ };
+                                           maturity, tGrid_, dampingSteps_,
+                                           0.0 };
 
         boost::shared_ptr<Fdm2dBlackScholesSolver> solver(
                 new Fdm2dBlackScholesSolver(
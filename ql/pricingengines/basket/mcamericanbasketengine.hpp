@@ -57,7 +57,10 @@ namespace QuantLib {
                                Real requiredTolerance,
                                Size maxSamples,
                                BigNatural seed,
-                               Size nCalibrationSamples = Null<Size>());
+                               Size nCalibrationSamples = Null<Size>(),
+                               bool streamingCalibration = false,
+                               Size calibrationWorkers = 1,
+                               Size calibrationDatesPerPass = 1);
       protected:
         boost::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> >
             lsmPathPricer() const;
@@ -80,6 +83,9 @@ namespace QuantLib {
         MakeMCAmericanBasketEngine& withMaxSamples(Size samples);
         MakeMCAmericanBasketEngine& withSeed(BigNatural seed);
         MakeMCAmericanBasketEngine& withCalibrationSamples(Size samples);
+        MakeMCAmericanBasketEngine& withStreamingCalibration(bool b = true);
+        MakeMCAmericanBasketEngine& withCalibrationWorkers(Size workers);
+        MakeMCAmericanBasketEngine& withCalibrationDatesPerPass(Size dates);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -88,6 +94,8 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_, calibrationSamples_;
         Real tolerance_;
         BigNatural seed_;
+        bool streamingCalibration_;
+        Size calibrationWorkers_, calibrationDatesPerPass_;
     };
 
 
@@ -126,7 +134,10 @@ namespace QuantLib {
                    Real requiredTolerance,
                    Size maxSamples,
                    BigNatural seed,
-                   Size nCalibrationSamples)
+                   Size nCalibrationSamples,
+                   bool streamingCalibration,
+                   Size calibrationWorkers,
+                   Size calibrationDatesPerPass)
         : MCLongstaffSchwartzEngine<BasketOption::engine,
                                     MultiVariate,RNG>(processes,
                                                       timeSteps,
@@ -138,7 +149,13 @@ namespace QuantLib {
                                                       requiredTolerance,
                                                       maxSamples,
                                                       seed,
-                                                      nCalibrationSamples) {}
+                                                      nCalibrationSamples,
+                                                      boost::none,
+                                                      boost::none,
+                                                      Null<Size>(),
+                                                      streamingCalibration,
+                                                      calibrationWorkers,
+                                                      calibrationDatesPerPass) {}
 
     template <class RNG>
     inline boost::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> >
@@ -181,7 +198,9 @@ namespace QuantLib {
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
       calibrationSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0),
+      streamingCalibration_(false), calibrationWorkers_(1),
+      calibrationDatesPerPass_(1) {}
 
     template <class RNG>
     inline MakeMCAmericanBasketEngine<RNG>&
@@ -253,6 +272,27 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withStreamingCalibration(bool b) {
+        streamingCalibration_ = b;
+        return *this;
+    }
+
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withCalibrationWorkers(Size workers) {
+        calibrationWorkers_ = workers;
+        return *this;
+    }
+
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withCalibrationDatesPerPass(Size dates) {
+        calibrationDatesPerPass_ = dates;
+        return *this;
+    }
+
     template <class RNG>
     inline
     MakeMCAmericanBasketEngine<RNG>::operator
@@ -271,7 +311,10 @@ namespace QuantLib {
                                         tolerance_,
                                         maxSamples_,
                                         seed_,
-                                        calibrationSamples_));
+                                        calibrationSamples_,
+                                        streamingCalibration_,
+                                        calibrationWorkers_,
+                                        calibrationDatesPerPass_));
     }
 
 }
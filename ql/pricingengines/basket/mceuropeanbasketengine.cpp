@@ -44,5 +44,25 @@ namespace QuantLib {
         return (*payoff_)(finalPrice) * discount_;
     }
 
+    void EuropeanMultiPathPricer::operator()(
+                                          const MultiPathBatch& multiPaths,
+                                          std::vector<Real>& values) const {
+        Size n = multiPaths.pathSize();
+        QL_REQUIRE(n>0, "the paths cannot be empty");
+
+        Size numAssets = multiPaths.assetNumber();
+        QL_REQUIRE(numAssets>0, "there must be some paths");
+
+        const Matrix& finalPrices = multiPaths.values(n-1);
+        Size m = multiPaths.paths();
+        values.resize(m);
+        Array finalPrice(numAssets);
+        for (Size k = 0; k < m; k++) {
+            std::copy(finalPrices.column_begin(k), finalPrices.column_end(k),
+                      finalPrice.begin());
+            values[k] = (*payoff_)(finalPrice) * discount_;
+        }
+    }
+
 }
 
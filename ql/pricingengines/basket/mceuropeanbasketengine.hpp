@@ -58,7 +58,8 @@ namespace QuantLib {
                                Size requiredSamples,
                                Real requiredTolerance,
                                Size maxSamples,
-                               BigNatural seed);
+                               BigNatural seed,
+                               Size workers = 1);
         void calculate() const {
             McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
                                                         requiredSamples_,
@@ -89,6 +90,9 @@ namespace QuantLib {
                                                  grid, gen, brownianBridge_));
         }
         boost::shared_ptr<path_pricer_type> pathPricer() const;
+        Size batchSize() const {
+            return this->cacheFriendlyBatchSize(processes_->size());
+        }
         // data members
         boost::shared_ptr<StochasticProcessArray> processes_;
         Size timeSteps_, timeStepsPerYear_;
@@ -115,6 +119,7 @@ namespace QuantLib {
         MakeMCEuropeanBasketEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanBasketEngine& withMaxSamples(Size samples);
         MakeMCEuropeanBasketEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanBasketEngine& withWorkers(Size workers);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -123,14 +128,18 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size workers_;
     };
 
 
-    class EuropeanMultiPathPricer : public PathPricer<MultiPath> {
+    class EuropeanMultiPathPricer : public PathPricer<MultiPath>,
+                                    public BatchPathPricer<MultiPathBatch> {
       public:
         EuropeanMultiPathPricer(const boost::shared_ptr<BasketPayoff>& payoff,
                                 DiscountFactor discount);
         Real operator()(const MultiPath& multiPath) const;
+        void operator()(const MultiPathBatch& multiPaths,
+                        std::vector<Real>& values) const;
       private:
         boost::shared_ptr<BasketPayoff> payoff_;
         DiscountFactor discount_;
@@ -149,8 +158,9 @@ namespace QuantLib {
                    Size requiredSamples,
                    Real requiredTolerance,
                    Size maxSamples,
-                   BigNatural seed)
-    : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false),
+                   BigNatural seed,
+                   Size workers)
+    : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false, workers),
       processes_(processes), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -214,7 +224,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), workers_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanBasketEngine<RNG,S>&
@@ -279,6 +289,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanBasketEngine<RNG,S>&
+    MakeMCEuropeanBasketEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanBasketEngine<RNG,S>::operator
@@ -295,7 +312,8 @@ namespace QuantLib {
                                           antithetic_,
                                           samples_, tolerance_,
                                           maxSamples_,
-                                          seed_));
+                                          seed_,
+                                          workers_));
     }
 
 }
@@ -69,7 +69,14 @@ namespace QuantLib {
           calibration and pricing; note however that this has no effect
           for low discrepancy RNGs usually, it is therefore recommended
           to use pseudo random generators for the calibration phase always
-          (and possibly quasi monte carlo in the subsequent pricing). */
+          (and possibly quasi monte carlo in the subsequent pricing).
+
+          If streamingCalibration is true, the calibration paths are
+          not stored; only the data needed by the regressions are
+          (see LongstaffSchwartzPathPricer).  In this case, they can be
+          split among a number of parallel calibration workers, and
+          each path is regenerated once for each group of
+          calibrationDatesPerPass exercise dates. */
         MCLongstaffSchwartzEngine(
             const boost::shared_ptr<StochasticProcess>& process,
             Size timeSteps,
@@ -84,7 +91,10 @@ namespace QuantLib {
             Size nCalibrationSamples = Null<Size>(),
             boost::optional<bool> brownianBridgeCalibration = boost::none,
             boost::optional<bool> antitheticVariateCalibration = boost::none,
-            BigNatural seedCalibration = Null<Size>());
+            BigNatural seedCalibration = Null<Size>(),
+            bool streamingCalibration = false,
+            Size calibrationWorkers = 1,
+            Size calibrationDatesPerPass = 1);
 
         void calculate() const;
 
@@ -108,6 +118,9 @@ namespace QuantLib {
         const bool brownianBridgeCalibration_;
         const bool antitheticVariateCalibration_;
         const BigNatural seedCalibration_;
+        const bool streamingCalibration_;
+        const Size calibrationWorkers_;
+        const Size calibrationDatesPerPass_;
 
         mutable boost::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
             pathPricer_;
@@ -132,7 +145,10 @@ namespace QuantLib {
             Size nCalibrationSamples,
             boost::optional<bool> brownianBridgeCalibration,
             boost::optional<bool> antitheticVariateCalibration,
-            BigNatural seedCalibration)
+            BigNatural seedCalibration,
+            bool streamingCalibration,
+            Size calibrationWorkers,
+            Size calibrationDatesPerPass)
     : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate),
       process_            (process),
       timeSteps_          (timeSteps),
@@ -149,7 +165,10 @@ namespace QuantLib {
       antitheticVariateCalibration_(antitheticVariateCalibration ?
                                     *antitheticVariateCalibration : antitheticVariate),
       seedCalibration_(seedCalibration != Null<Real>() ?
-                         seedCalibration : (seed == 0 ? 0 : seed+1768237423L))
+                         seedCalibration : (seed == 0 ? 0 : seed+1768237423L)),
+      streamingCalibration_(streamingCalibration),
+      calibrationWorkers_(calibrationWorkers),
+      calibrationDatesPerPass_(calibrationDatesPerPass)
     {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
@@ -163,6 +182,13 @@ namespace QuantLib {
         QL_REQUIRE(timeStepsPerYear != 0,
                    "timeStepsPerYear must be positive, " << timeStepsPerYear <<
                    " not allowed");
+        QL_REQUIRE(calibrationWorkers > 0,
+                   "at least one calibration worker required");
+        QL_REQUIRE(calibrationWorkers == 1 || streamingCalibration,
+                   "multiple calibration workers require "
+                   "streaming calibration");
+        QL_REQUIRE(calibrationDatesPerPass > 0,
+                   "at least one calibration date per pass required");
         this->registerWith(process_);
     }
 
@@ -192,14 +218,22 @@ namespace QuantLib {
             pathGeneratorCalibration =
                 boost::make_shared<path_generator_type_calibration>(
                     process_, grid, generator, brownianBridgeCalibration_);
-        mcModelCalibration_ =
-            boost::shared_ptr<MonteCarloModel<MC, RNG_Calibration, S> >(
-                new MonteCarloModel<MC, RNG_Calibration, S>(
-                    pathGeneratorCalibration, pathPricer_, stats_type(),
-                    this->antitheticVariateCalibration_));
+        if (streamingCalibration_) {
+            pathPricer_->calibrate(*pathGeneratorCalibration,
+                                   nCalibrationSamples_,
+                                   antitheticVariateCalibration_,
+                                   calibrationWorkers_,
+                                   calibrationDatesPerPass_);
+        } else {
+            mcModelCalibration_ =
+                boost::shared_ptr<MonteCarloModel<MC, RNG_Calibration, S> >(
+                    new MonteCarloModel<MC, RNG_Calibration, S>(
+                        pathGeneratorCalibration, pathPricer_, stats_type(),
+                        this->antitheticVariateCalibration_));
 
-        mcModelCalibration_->addSamples(nCalibrationSamples_);
-        pathPricer_->calibrate();
+            mcModelCalibration_->addSamples(nCalibrationSamples_);
+            pathPricer_->calibrate();
+        }
         // pricing
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
                                           requiredSamples_,
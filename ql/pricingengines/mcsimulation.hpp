@@ -37,6 +37,16 @@ namespace QuantLib {
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        Engines can split the simulation among a number of workers
+        (running in parallel when the library is compiled with OpenMP
+        support) by passing their number to the constructor; the
+        workers draw contiguous blocks of the same random sequence,
+        so that the results don't depend on their number.
+
+        Engines whose path pricers also implement the BatchPathPricer
+        interface can have paths generated and priced in blocks by
+        overriding batchSize().
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,9 +77,12 @@ namespace QuantLib {
                        Size maxSamples) const;
       protected:
         McSimulation(bool antitheticVariate,
-                     bool controlVariate)
+                     bool controlVariate,
+                     Size workers = 1)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), workers_(workers) {
+            QL_REQUIRE(workers > 0, "at least one worker required");
+        }
         virtual boost::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual boost::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
@@ -87,6 +100,21 @@ namespace QuantLib {
         virtual result_type controlVariateValue() const {
             return Null<result_type>();
         }
+        /*! number of paths generated and priced together when the
+            path pricers support batches; the default of 0 prices
+            the paths one by one.
+        */
+        virtual Size batchSize() const {
+            return 0;
+        }
+        /*! a batch size such that the values of a batch of paths
+            for the given number of assets fit in a typical level-2
+            cache; engines can return it from batchSize().
+        */
+        Size cacheFriendlyBatchSize(Size assets = 1) const {
+            Size points = timeGrid().size()*assets;
+            return std::min<Size>(1024, std::max<Size>(1, 16384/points));
+        }
         template <class Sequence>
         static Real maxError(const Sequence& sequence) {
             return *std::max_element(sequence.begin(), sequence.end());
@@ -97,6 +125,10 @@ namespace QuantLib {
         
         mutable boost::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size workers_;
+      private:
+        std::vector<boost::shared_ptr<path_pricer_type> >
+        workerPathPricers() const;
     };
 
 
@@ -181,18 +213,44 @@ namespace QuantLib {
             boost::shared_ptr<path_generator_type> controlPG = 
                 this->controlPathGenerator();
 
-            this->mcModel_ =
-                boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
-                    new MonteCarloModel<MC,RNG,S>(
+            if (workers_ == 1) {
+                this->mcModel_ =
+                    boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                        new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), stats_type(),
                            this->antitheticVariate_, controlPP,
-                           controlVariateValue, controlPG));
+                           controlVariateValue, controlPG, batchSize()));
+            } else {
+                this->mcModel_ =
+                    boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                        new MonteCarloModel<MC,RNG,S>(
+                           pathGenerator(), workerPathPricers(),
+                           stats_type(), this->antitheticVariate_,
+                           controlPP, controlVariateValue, controlPG,
+                           batchSize()));
+            }
         } else {
-            this->mcModel_ =
-                boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
-                    new MonteCarloModel<MC,RNG,S>(
+            if (workers_ == 1) {
+                this->mcModel_ =
+                    boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                        new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), S(),
-                           this->antitheticVariate_));
+                           this->antitheticVariate_,
+                           boost::shared_ptr<path_pricer_type>(),
+                           result_type(),
+                           boost::shared_ptr<path_generator_type>(),
+                           batchSize()));
+            } else {
+                this->mcModel_ =
+                    boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                        new MonteCarloModel<MC,RNG,S>(
+                           pathGenerator(), workerPathPricers(), S(),
+                           this->antitheticVariate_,
+                           boost::shared_ptr<path_pricer_type>(),
+                           result_type(),
+                           boost::shared_ptr<path_generator_type>(),
+                           batchSize()));
+            }
         }
 
         if (requiredTolerance != Null<Real>()) {
@@ -206,6 +264,18 @@ namespace QuantLib {
 
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline std::vector<boost::shared_ptr<
+                         typename McSimulation<MC,RNG,S>::path_pricer_type> >
+    McSimulation<MC,RNG,S>::workerPathPricers() const {
+        // a separate pricer for each worker, since some of them
+        // keep an internal state
+        std::vector<boost::shared_ptr<path_pricer_type> > pricers(workers_);
+        for (Size i=0; i<workers_; ++i)
+            pricers[i] = this->pathPricer();
+        return pricers;
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::errorEstimate() const {
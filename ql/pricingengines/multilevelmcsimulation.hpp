@@ -0,0 +1,255 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelmcsimulation.hpp
+    \brief framework for multilevel Monte Carlo engines
+*/
+
+#ifndef quantlib_multi_level_montecarlo_engine_hpp
+#define quantlib_multi_level_montecarlo_engine_hpp
+
+#include <ql/methods/montecarlo/multilevelmontecarlomodel.hpp>
+#include <ql/mathconstants.hpp>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! base class for multilevel Monte Carlo engines
+    /*! This class plays the same role as McSimulation for engines
+        using the multilevel Monte Carlo method described in
+        <i>
+        M.B. Giles, Multilevel Monte Carlo path simulation,
+        Operations Research 56(3), pp. 607-617, 2008
+        </i>
+        Level 0 uses the grid returned by timeGrid(); each of the
+        following levels divides the steps of the previous one into
+        refinement() equal steps.
+
+        Levels and samples are added until the estimated
+        root-mean-square error of the result is below the required
+        tolerance.  Half of the mean-square error is allotted to the
+        statistical error, and the samples are distributed among the
+        levels so as to minimize the total cost; the other half is
+        allotted to the discretization bias, which is estimated from
+        the corrections of the two finest levels assuming that it
+        decays as \f$ \Delta t^{\alpha} \f$ where \f$ \alpha \f$ is
+        the weak order passed to the constructor.
+
+        Each level uses its own random-sequence generator.  Path
+        pricers are created for the grid of each level, unless
+        pricingGrid() returns a non-empty grid; in this case, paths
+        are sampled on its times and priced by a single pricer.
+
+        \ingroup mcarlo
+    */
+    template <template <class> class MC, class RNG, class S = Statistics>
+    class MultiLevelMcSimulation {
+      public:
+        typedef MultiLevelMonteCarloModel<MC,RNG,S> model_type;
+        typedef typename model_type::path_pricer_type path_pricer_type;
+        typedef typename model_type::path_generator_type path_generator_type;
+        typedef typename model_type::coupled_path_generator_type
+            coupled_path_generator_type;
+        typedef typename model_type::stats_type stats_type;
+        typedef typename model_type::result_type result_type;
+
+        virtual ~MultiLevelMcSimulation() {}
+        //! add levels and samples until the required tolerance is reached
+        result_type value(Real tolerance,
+                          Size maxLevels,
+                          Size calibrationSamples = 1000) const;
+        //! statistical error estimated using the samples simulated so far
+        result_type errorEstimate() const;
+        //! number of levels used so far
+        Size levels() const;
+        //! access to the sample accumulator of each level
+        const stats_type& levelAccumulator(Size level) const;
+        //! basic calculate method provided to inherited pricing engines
+        void calculate(Real requiredTolerance,
+                       Size maxLevels,
+                       Size calibrationSamples) const;
+      protected:
+        MultiLevelMcSimulation(bool antitheticVariate,
+                               Size refinement,
+                               Real weakOrder,
+                               BigNatural seed)
+        : antitheticVariate_(antitheticVariate), refinement_(refinement),
+          weakOrder_(weakOrder), seed_(seed) {
+            QL_REQUIRE(refinement > 1,
+                       "refinement factor must be greater than 1, "
+                       << refinement << " not allowed");
+            QL_REQUIRE(weakOrder > 0.0,
+                       "weak order must be positive, "
+                       << weakOrder << " not allowed");
+        }
+        virtual boost::shared_ptr<StochasticProcess> process() const = 0;
+        //! grid of the coarsest level
+        virtual TimeGrid timeGrid() const = 0;
+        virtual boost::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const = 0;
+        //! grid of the times used by the payoff, if any
+        virtual TimeGrid pricingGrid() const {
+            return TimeGrid();
+        }
+        Size refinement() const { return refinement_; }
+
+        mutable boost::shared_ptr<model_type> mcModel_;
+        bool antitheticVariate_;
+        Size refinement_;
+        Real weakOrder_;
+        BigNatural seed_;
+      private:
+        void addLevel(Size calibrationSamples) const;
+        mutable TimeGrid finestGrid_;
+        mutable boost::shared_ptr<path_pricer_type> finestPricer_;
+    };
+
+
+    // inline definitions
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMcSimulation<MC,RNG,S>::addLevel(
+                                           Size calibrationSamples) const {
+        Size level = mcModel_->levels();
+        BigNatural seed = seed_ == 0 ? 0 : seed_ + level;
+        boost::shared_ptr<StochasticProcess> process = this->process();
+        TimeGrid pricingGrid = this->pricingGrid();
+
+        if (level == 0) {
+            finestGrid_ = timeGrid();
+            typename RNG::rsg_type generator =
+                RNG::make_sequence_generator(
+                    process->factors()*(finestGrid_.size()-1), seed);
+            finestPricer_ = pathPricer(pricingGrid.empty() ? finestGrid_
+                                                           : pricingGrid);
+            mcModel_->addLevel(
+                boost::shared_ptr<path_generator_type>(
+                     new path_generator_type(process, finestGrid_,
+                                             generator, false)),
+                finestPricer_);
+        } else {
+            TimeGrid fineGrid =
+                coupled_path_generator_type::refine(finestGrid_,
+                                                    refinement_);
+            typename RNG::rsg_type generator =
+                RNG::make_sequence_generator(
+                    process->factors()*(fineGrid.size()-1), seed);
+            boost::shared_ptr<path_pricer_type> finePricer =
+                pricingGrid.empty() ? pathPricer(fineGrid) : finestPricer_;
+            mcModel_->addLevel(
+                boost::shared_ptr<coupled_path_generator_type>(
+                     new coupled_path_generator_type(process, finestGrid_,
+                                                     refinement_,
+                                                     generator)),
+                finePricer, finestPricer_);
+            finestGrid_ = fineGrid;
+            finestPricer_ = finePricer;
+        }
+
+        mcModel_->addSamples(level, calibrationSamples);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MultiLevelMcSimulation<MC,RNG,S>::result_type
+    MultiLevelMcSimulation<MC,RNG,S>::value(Real tolerance,
+                                            Size maxLevels,
+                                            Size calibrationSamples) const {
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+        QL_REQUIRE(tolerance > 0.0, "positive tolerance required");
+        QL_REQUIRE(maxLevels >= 2, "at least two levels required");
+        QL_REQUIRE(calibrationSamples > 1,
+                   "at least two calibration samples required");
+
+        // start with three levels, as in Giles' paper
+        while (mcModel_->levels() < std::min<Size>(3, maxLevels))
+            addLevel(calibrationSamples);
+
+        Real ma = std::pow(Real(refinement_), weakOrder_);
+        for (;;) {
+            // optimal number of samples for the current levels,
+            // keeping the variance of the result below tolerance^2/2
+            Size levels = mcModel_->levels();
+            Real sum = 0.0;
+            for (Size l=0; l<levels; ++l)
+                sum += std::sqrt(mcModel_->levelAccumulator(l).variance()
+                                 * mcModel_->levelCost(l));
+            for (Size l=0; l<levels; ++l) {
+                Real variance = mcModel_->levelAccumulator(l).variance();
+                Real cost = mcModel_->levelCost(l);
+                Size optimal = static_cast<Size>(std::ceil(
+                   2.0*std::sqrt(variance/cost)*sum/(tolerance*tolerance)));
+                Size samples = mcModel_->levelAccumulator(l).samples();
+                if (optimal > samples)
+                    mcModel_->addSamples(l, optimal-samples);
+            }
+
+            // bias estimate from the corrections of the finest levels
+            Real fine =
+                std::fabs(mcModel_->levelAccumulator(levels-1).mean());
+            Real coarse =
+                std::fabs(mcModel_->levelAccumulator(levels-2).mean());
+            Real bias = std::max(fine, coarse/ma)/(ma-1.0);
+            if (bias <= tolerance/M_SQRT2)
+                break;
+
+            QL_REQUIRE(levels < maxLevels,
+                       "max number of levels (" << maxLevels
+                       << ") reached, while estimated bias (" << bias
+                       << ") is still above tolerance (" << tolerance
+                       << "/sqrt(2))");
+            addLevel(calibrationSamples);
+        }
+
+        return mcModel_->mean();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMcSimulation<MC,RNG,S>::calculate(
+                                             Real requiredTolerance,
+                                             Size maxLevels,
+                                             Size calibrationSamples) const {
+        QL_REQUIRE(requiredTolerance != Null<Real>(),
+                   "tolerance not set");
+
+        mcModel_ = boost::shared_ptr<model_type>(
+                       new model_type(antitheticVariate_, pricingGrid()));
+        value(requiredTolerance, maxLevels, calibrationSamples);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MultiLevelMcSimulation<MC,RNG,S>::result_type
+    MultiLevelMcSimulation<MC,RNG,S>::errorEstimate() const {
+        return mcModel_->errorEstimate();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Size MultiLevelMcSimulation<MC,RNG,S>::levels() const {
+        return mcModel_->levels();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline const typename MultiLevelMcSimulation<MC,RNG,S>::stats_type&
+    MultiLevelMcSimulation<MC,RNG,S>::levelAccumulator(Size level) const {
+        return mcModel_->levelAccumulator(level);
+    }
+
+}
+
+
+#endif
@@ -117,7 +117,7 @@ namespace QuantLib {
         // 6. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
                                      calculator, maturity,
-                                     tGrid_, dampingSteps_ };
+                                     tGrid_, dampingSteps_, 0.0 };
 
         const boost::scoped_ptr<FdmG2Solver> solver(
             new FdmG2Solver(model_, solverDesc, schemeDesc_));
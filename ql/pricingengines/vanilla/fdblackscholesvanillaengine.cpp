@@ -25,7 +25,6 @@
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
-#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 
@@ -35,12 +34,14 @@ namespace QuantLib {
             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
             Size tGrid, Size xGrid, Size dampingSteps, 
             const FdmSchemeDesc& schemeDesc,
-            bool localVol, Real illegalLocalVolOverwrite)
+            bool localVol, Real illegalLocalVolOverwrite,
+            const boost::shared_ptr<FdmMesherCache>& mesherCache)
     : process_(process),
       tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps),
       schemeDesc_(schemeDesc), 
       localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      mesherCache_(mesherCache) {
 
         registerWith(process_);
     }
@@ -52,15 +53,20 @@ namespace QuantLib {
             boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
 
         const Time maturity = process_->time(arguments_.exercise->lastDate());
-        const boost::shared_ptr<Fdm1dMesher> equityMesher(
-            new FdmBlackScholesMesher(
+
+        // without a cache, the meshers are built every time
+        FdmMesherCache noCache(0);
+        FdmMesherCache& meshers = (mesherCache_) ? *mesherCache_ : noCache;
+
+        const boost::shared_ptr<Fdm1dMesher> equityMesher =
+            meshers.blackScholesMesher(
                     xGrid_, process_, maturity, payoff->strike(), 
                     Null<Real>(), Null<Real>(), 0.0001, 1.5, 
                     std::pair<Real, Real>(payoff->strike(), 0.1),
-                    arguments_.cashFlow));
+                    arguments_.cashFlow);
         
-        const boost::shared_ptr<FdmMesher> mesher (
-            new FdmMesherComposite(equityMesher));
+        const boost::shared_ptr<FdmMesher> mesher =
+            meshers.composite(equityMesher);
         
         // 2. Calculator
         const boost::shared_ptr<FdmInnerValueCalculator> calculator(
@@ -79,7 +85,7 @@ namespace QuantLib {
 
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
-                                     maturity, tGrid_, dampingSteps_ };
+                                     maturity, tGrid_, dampingSteps_, 0.0 };
 
         const boost::shared_ptr<FdmBlackScholesSolver> solver(
                 new FdmBlackScholesSolver(
@@ -29,12 +29,16 @@
 #include <ql/pricingengine.hpp>
 #include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercache.hpp>
 
 namespace QuantLib {
 
     //! Finite-Differences Black Scholes vanilla option engine
 
-    /*! \ingroup vanillaengines
+    /*! If a mesher cache is given, the mesher is taken from it
+        whenever possible; see FdmMesherCache.
+
+        \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
@@ -50,7 +54,9 @@ namespace QuantLib {
                 Size tGrid = 100, Size xGrid = 100, Size dampingSteps = 0,
                 const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
                 bool localVol = false,
-                Real illegalLocalVolOverwrite = -Null<Real>());
+                Real illegalLocalVolOverwrite = -Null<Real>(),
+                const boost::shared_ptr<FdmMesherCache>& mesherCache
+                    = boost::shared_ptr<FdmMesherCache>());
 
         void calculate() const;
 
@@ -60,6 +66,7 @@ namespace QuantLib {
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+        const boost::shared_ptr<FdmMesherCache> mesherCache_;
     };
 }
 
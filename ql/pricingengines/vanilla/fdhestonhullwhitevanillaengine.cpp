@@ -150,7 +150,7 @@ namespace QuantLib {
         // 6. Solver
         const FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
                                            calculator, maturity,
-                                           tGrid_, dampingSteps_ };
+                                           tGrid_, dampingSteps_, 0.0 };
 
         const boost::shared_ptr<FdmHestonHullWhiteSolver> solver(
             new FdmHestonHullWhiteSolver(Handle<HestonProcess>(hestonProcess),
@@ -38,14 +38,16 @@ namespace QuantLib {
             const boost::shared_ptr<HestonModel>& model,
             Size tGrid, Size xGrid, Size vGrid, Size dampingSteps,
             const FdmSchemeDesc& schemeDesc,
-            const boost::shared_ptr<LocalVolTermStructure>& leverageFct)
+            const boost::shared_ptr<LocalVolTermStructure>& leverageFct,
+            const boost::shared_ptr<FdmMesherCache>& mesherCache)
     : GenericModelEngine<HestonModel,
                         DividendVanillaOption::arguments,
                         DividendVanillaOption::results>(model),
       tGrid_(tGrid), xGrid_(xGrid), 
       vGrid_(vGrid), dampingSteps_(dampingSteps),
       schemeDesc_(schemeDesc),
-      leverageFct_(leverageFct) {
+      leverageFct_(leverageFct),
+      mesherCache_(mesherCache) {
     }
 
 
@@ -54,11 +56,14 @@ namespace QuantLib {
         const boost::shared_ptr<HestonProcess> process = model_->process();
         const Time maturity = process->time(arguments_.exercise->lastDate());
 
+        FdmMesherCache noCache(0);
+        FdmMesherCache& meshers = (mesherCache_) ? *mesherCache_ : noCache;
+
         // 1.1 The variance mesher
         const Size tGridMin = 5;
-        const boost::shared_ptr<FdmHestonVarianceMesher> varianceMesher(
-            new FdmHestonVarianceMesher(vGrid_, process,
-                                        maturity,std::max(tGridMin,tGrid_/50)));
+        const boost::shared_ptr<FdmHestonVarianceMesher> varianceMesher =
+            meshers.hestonVarianceMesher(vGrid_, process,
+                                         maturity,std::max(tGridMin,tGrid_/50));
 
         // 1.2 The equity mesher
         const boost::shared_ptr<StrikedTypePayoff> payoff =
@@ -66,8 +71,7 @@ namespace QuantLib {
 
         boost::shared_ptr<Fdm1dMesher> equityMesher;
         if (strikes_.empty()) {
-            equityMesher = boost::shared_ptr<Fdm1dMesher>(
-                new FdmBlackScholesMesher(
+            equityMesher = meshers.blackScholesMesher(
                     xGrid_, 
                     FdmBlackScholesMesher::processHelper(
                       process->s0(), process->dividendYield(), 
@@ -75,7 +79,7 @@ namespace QuantLib {
                       maturity, payoff->strike(),
                       Null<Real>(), Null<Real>(), 0.0001, 2.0,
                       std::pair<Real, Real>(payoff->strike(), 0.1),
-                      arguments_.cashFlow));
+                      arguments_.cashFlow);
         }
         else {
             QL_REQUIRE(arguments_.cashFlow.empty(),"multiple strikes engine "
@@ -90,8 +94,12 @@ namespace QuantLib {
                     std::pair<Real, Real>(payoff->strike(), 0.075)));            
         }
         
-        const boost::shared_ptr<FdmMesher> mesher(
-            new FdmMesherComposite(equityMesher, varianceMesher));
+        // the multiple strikes meshers aren't cached, nor are their
+        // composites, which would never be found again
+        const boost::shared_ptr<FdmMesher> mesher = (strikes_.empty())
+            ? meshers.composite(equityMesher, varianceMesher)
+            : boost::shared_ptr<FdmMesher>(
+                  new FdmMesherComposite(equityMesher, varianceMesher));
 
         // 2. Calculator
         const boost::shared_ptr<FdmInnerValueCalculator> calculator(
@@ -111,7 +119,7 @@ namespace QuantLib {
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
                                      calculator, maturity,
-                                     tGrid_, dampingSteps_ };
+                                     tGrid_, dampingSteps_, 0.0 };
 
        return solverDesc;
     }
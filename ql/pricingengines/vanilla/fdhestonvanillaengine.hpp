@@ -31,6 +31,7 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercache.hpp>
 #include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
 
 namespace QuantLib {
@@ -42,6 +43,9 @@ namespace QuantLib {
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
+
+        If a mesher cache is given, the meshers are taken from it
+        whenever possible; see FdmMesherCache.
     */
     class FdHestonVanillaEngine
         : public GenericModelEngine<HestonModel,
@@ -55,7 +59,9 @@ namespace QuantLib {
             Size vGrid = 50, Size dampingSteps = 0,
             const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Hundsdorfer(),
             const boost::shared_ptr<LocalVolTermStructure>& leverageFct
-                = boost::shared_ptr<LocalVolTermStructure>());
+                = boost::shared_ptr<LocalVolTermStructure>(),
+            const boost::shared_ptr<FdmMesherCache>& mesherCache
+                = boost::shared_ptr<FdmMesherCache>());
 
         void calculate() const;
         
@@ -70,6 +76,7 @@ namespace QuantLib {
         const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         const boost::shared_ptr<LocalVolTermStructure> leverageFct_;
+        const boost::shared_ptr<FdmMesherCache> mesherCache_;
         
         std::vector<Real> strikes_;
         mutable std::vector<std::pair<DividendVanillaOption::arguments,
@@ -99,7 +99,7 @@ namespace QuantLib {
         
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
-                                     calculator, maturity, tGrid_, 0 };
+                                     calculator, maturity, tGrid_, 0, 0.0 };
         boost::shared_ptr<FdmSimple2dBSSolver> solver(
                 new FdmSimple2dBSSolver(
                                Handle<GeneralizedBlackScholesProcess>(process_),
@@ -65,7 +65,10 @@ namespace QuantLib {
              LsmBasisSystem::PolynomType polynomType,
              Size nCalibrationSamples = Null<Size>(),
              boost::optional<bool> antitheticVariateCalibration = boost::none,
-             BigNatural seedCalibration = Null<Size>());
+             BigNatural seedCalibration = Null<Size>(),
+             bool streamingCalibration = false,
+             Size calibrationWorkers = 1,
+             Size calibrationDatesPerPass = 1);
 
         void calculate() const;
         
@@ -123,6 +126,9 @@ namespace QuantLib {
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
         MakeMCAmericanEngine& withAntitheticVariateCalibration(bool b = true);
         MakeMCAmericanEngine& withSeedCalibration(BigNatural seed);
+        MakeMCAmericanEngine& withStreamingCalibration(bool b = true);
+        MakeMCAmericanEngine& withCalibrationWorkers(Size workers);
+        MakeMCAmericanEngine& withCalibrationDatesPerPass(Size dates);
 
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -137,6 +143,8 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType_;
         boost::optional<bool> antitheticCalibration_;
         BigNatural seedCalibration_;
+        bool streamingCalibration_;
+        Size calibrationWorkers_, calibrationDatesPerPass_;
     };
 
     template <class RNG, class S, class RNG_Calibration>
@@ -147,13 +155,15 @@ namespace QuantLib {
         Size maxSamples, BigNatural seed, Size polynomOrder,
         LsmBasisSystem::PolynomType polynomType, Size nCalibrationSamples,
         boost::optional<bool> antitheticVariateCalibration,
-        BigNatural seedCalibration)
+        BigNatural seedCalibration, bool streamingCalibration,
+        Size calibrationWorkers, Size calibrationDatesPerPass)
         : MCLongstaffSchwartzEngine<VanillaOption::engine, SingleVariate, RNG,
                                     S, RNG_Calibration>(
               process, timeSteps, timeStepsPerYear, false, antitheticVariate,
               controlVariate, requiredSamples, requiredTolerance, maxSamples,
               seed, nCalibrationSamples, false, antitheticVariateCalibration,
-              seedCalibration),
+              seedCalibration, streamingCalibration, calibrationWorkers,
+              calibrationDatesPerPass),
           polynomOrder_(polynomOrder), polynomType_(polynomType) {}
 
     template <class RNG, class S, class RNG_Calibration>
@@ -259,7 +269,9 @@ namespace QuantLib {
           samples_(Null<Size>()), maxSamples_(Null<Size>()),
           calibrationSamples_(2048), tolerance_(Null<Real>()), seed_(0),
           polynomOrder_(2), polynomType_(LsmBasisSystem::Monomial),
-          antitheticCalibration_(boost::none), seedCalibration_(Null<Size>()) {}
+          antitheticCalibration_(boost::none), seedCalibration_(Null<Size>()),
+          streamingCalibration_(false), calibrationWorkers_(1),
+          calibrationDatesPerPass_(1) {}
 
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
@@ -367,6 +379,30 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withStreamingCalibration(
+        bool b) {
+        streamingCalibration_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withCalibrationWorkers(
+        Size workers) {
+        calibrationWorkers_ = workers;
+        return *this;
+    }
+
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withCalibrationDatesPerPass(
+        Size dates) {
+        calibrationDatesPerPass_ = dates;
+        return *this;
+    }
+
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration>::
     operator boost::shared_ptr<PricingEngine>() const {
@@ -387,7 +423,10 @@ namespace QuantLib {
                                      polynomType_,
                                      calibrationSamples_,
                                      antitheticCalibration_,
-                                     seedCalibration_));
+                                     seedCalibration_,
+                                     streamingCalibration_,
+                                     calibrationWorkers_,
+                                     calibrationDatesPerPass_));
     }
 
 }
@@ -60,9 +60,11 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1);
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
+        Size batchSize() const { return this->cacheFriendlyBatchSize(); }
     };
 
     //! Monte Carlo European engine factory
@@ -80,6 +82,7 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withWorkers(Size workers);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -89,14 +92,18 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size workers_;
     };
 
-    class EuropeanPathPricer : public PathPricer<Path> {
+    class EuropeanPathPricer : public PathPricer<Path>,
+                               public BatchPathPricer<PathBatch> {
       public:
         EuropeanPathPricer(Option::Type type,
                            Real strike,
                            DiscountFactor discount);
         Real operator()(const Path& path) const;
+        void operator()(const PathBatch& paths,
+                        std::vector<Real>& values) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
@@ -116,7 +123,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size workers)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +134,8 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed,
+                                           workers) {}
 
 
     template <class RNG, class S>
@@ -159,7 +168,8 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0),
+      workers_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -224,6 +234,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -240,7 +257,8 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_));
+                                    seed_,
+                                    workers_));
     }
 
 
@@ -258,6 +276,28 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+    inline void EuropeanPathPricer::operator()(
+                                          const PathBatch& paths,
+                                          std::vector<Real>& values) const {
+        QL_REQUIRE(paths.length() > 0, "the paths cannot be empty");
+        Size n = paths.paths();
+        values.resize(n);
+        const Real* x = paths.values(paths.length()-1);
+        Real strike = payoff_.strike();
+        switch (payoff_.optionType()) {
+          case Option::Call:
+            for (Size j=0; j<n; ++j)
+                values[j] = std::max<Real>(x[j]-strike,0.0) * discount_;
+            break;
+          case Option::Put:
+            for (Size j=0; j<n; ++j)
+                values[j] = std::max<Real>(strike-x[j],0.0) * discount_;
+            break;
+          default:
+            QL_FAIL("unknown/illegal option type");
+        }
+    }
+
 }
 
 
@@ -0,0 +1,268 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmceuropeanhestonengine.hpp
+    \brief Multilevel Monte Carlo Heston-model engine for European options
+*/
+
+#ifndef quantlib_mlmc_european_heston_engine_hpp
+#define quantlib_mlmc_european_heston_engine_hpp
+
+#include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/pricingengines/multilevelmcsimulation.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo Heston-model engine for European options
+    /*! The levels refine the discretization of the process until the
+        estimated discretization bias is below the required
+        tolerance; a weak order of 1 is assumed.
+
+        \ingroup vanillaengines
+
+        \test the returned value is compared with the analytic value.
+    */
+    template <class RNG = PseudoRandom,
+              class S = Statistics, class P = HestonProcess>
+    class MLMCEuropeanHestonEngine
+        : public VanillaOption::engine,
+          public MultiLevelMcSimulation<MultiVariate,RNG,S> {
+      public:
+        typedef
+        typename MultiLevelMcSimulation<MultiVariate,RNG,S>::path_pricer_type
+            path_pricer_type;
+        typedef typename MultiLevelMcSimulation<MultiVariate,RNG,S>::stats_type
+            stats_type;
+        MLMCEuropeanHestonEngine(const boost::shared_ptr<P>&,
+                                 Size timeSteps,
+                                 Size timeStepsPerYear,
+                                 bool antitheticVariate,
+                                 Real requiredTolerance,
+                                 Size maxLevels,
+                                 Size calibrationSamples,
+                                 Size refinement,
+                                 BigNatural seed);
+        void calculate() const {
+            MultiLevelMcSimulation<MultiVariate,RNG,S>::calculate(
+                                                          requiredTolerance_,
+                                                          maxLevels_,
+                                                          calibrationSamples_);
+            results_.value = this->mcModel_->mean();
+            results_.errorEstimate = this->mcModel_->errorEstimate();
+        }
+      protected:
+        // MultiLevelMcSimulation implementation
+        boost::shared_ptr<StochasticProcess> process() const {
+            return process_;
+        }
+        TimeGrid timeGrid() const;
+        boost::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const;
+        // data members
+        boost::shared_ptr<P> process_;
+        Size timeSteps_, timeStepsPerYear_;
+        Real requiredTolerance_;
+        Size maxLevels_, calibrationSamples_;
+    };
+
+    //! Multilevel Monte Carlo Heston European engine factory
+    template <class RNG = PseudoRandom,
+              class S = Statistics, class P = HestonProcess>
+    class MakeMLMCEuropeanHestonEngine {
+      public:
+        MakeMLMCEuropeanHestonEngine(const boost::shared_ptr<P>&);
+        // named parameters
+        MakeMLMCEuropeanHestonEngine& withSteps(Size steps);
+        MakeMLMCEuropeanHestonEngine& withStepsPerYear(Size steps);
+        MakeMLMCEuropeanHestonEngine& withAntitheticVariate(bool b = true);
+        MakeMLMCEuropeanHestonEngine& withAbsoluteTolerance(Real tolerance);
+        MakeMLMCEuropeanHestonEngine& withMaxLevels(Size levels);
+        MakeMLMCEuropeanHestonEngine& withCalibrationSamples(Size samples);
+        MakeMLMCEuropeanHestonEngine& withRefinement(Size refinement);
+        MakeMLMCEuropeanHestonEngine& withSeed(BigNatural seed);
+        // conversion to pricing engine
+        operator boost::shared_ptr<PricingEngine>() const;
+      private:
+        boost::shared_ptr<P> process_;
+        bool antithetic_;
+        Size steps_, stepsPerYear_;
+        Real tolerance_;
+        Size maxLevels_, calibrationSamples_, refinement_;
+        BigNatural seed_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S, class P>
+    inline MLMCEuropeanHestonEngine<RNG,S,P>::MLMCEuropeanHestonEngine(
+                const boost::shared_ptr<P>& process,
+                Size timeSteps, Size timeStepsPerYear, bool antitheticVariate,
+                Real requiredTolerance, Size maxLevels,
+                Size calibrationSamples, Size refinement, BigNatural seed)
+    : MultiLevelMcSimulation<MultiVariate,RNG,S>(antitheticVariate,
+                                                 refinement, 1.0, seed),
+      process_(process), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear),
+      requiredTolerance_(requiredTolerance), maxLevels_(maxLevels),
+      calibrationSamples_(calibrationSamples) {
+        QL_REQUIRE(timeSteps != Null<Size>() ||
+                   timeStepsPerYear != Null<Size>(),
+                   "no time steps provided");
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S, class P>
+    inline TimeGrid MLMCEuropeanHestonEngine<RNG,S,P>::timeGrid() const {
+        Date lastExerciseDate = this->arguments_.exercise->lastDate();
+        Time t = process_->time(lastExerciseDate);
+        if (timeSteps_ != Null<Size>()) {
+            return TimeGrid(t, timeSteps_);
+        } else if (timeStepsPerYear_ != Null<Size>()) {
+            Size steps = static_cast<Size>(timeStepsPerYear_*t);
+            return TimeGrid(t, std::max<Size>(steps, 1));
+        } else {
+            QL_FAIL("time steps not specified");
+        }
+    }
+
+    template <class RNG, class S, class P>
+    inline boost::shared_ptr<
+        typename MLMCEuropeanHestonEngine<RNG,S,P>::path_pricer_type>
+    MLMCEuropeanHestonEngine<RNG,S,P>::pathPricer(const TimeGrid& grid) const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff(
+                  boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                    this->arguments_.payoff));
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        return boost::shared_ptr<
+            typename MLMCEuropeanHestonEngine<RNG,S,P>::path_pricer_type>(
+                   new EuropeanHestonPathPricer(
+                               payoff->optionType(),
+                               payoff->strike(),
+                               process_->riskFreeRate()->discount(
+                                                               grid.back())));
+    }
+
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>::MakeMLMCEuropeanHestonEngine(
+                              const boost::shared_ptr<P>& process)
+    : process_(process), antithetic_(false),
+      steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
+      tolerance_(Null<Real>()), maxLevels_(10), calibrationSamples_(1000),
+      refinement_(2), seed_(0) {}
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withSteps(Size steps) {
+        QL_REQUIRE(stepsPerYear_ == Null<Size>(),
+                   "number of steps per year already set");
+        steps_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withStepsPerYear(Size steps) {
+        QL_REQUIRE(steps_ == Null<Size>(),
+                   "number of steps already set");
+        stepsPerYear_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withAntitheticVariate(bool b) {
+        antithetic_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withAbsoluteTolerance(
+                                                             Real tolerance) {
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withMaxLevels(Size levels) {
+        maxLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withCalibrationSamples(
+                                                               Size samples) {
+        calibrationSamples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withRefinement(Size refinement) {
+        refinement_ = refinement;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::
+    operator boost::shared_ptr<PricingEngine>() const {
+        QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
+                   "number of steps not given");
+        QL_REQUIRE(tolerance_ != Null<Real>(), "tolerance not given");
+        return boost::shared_ptr<PricingEngine>(
+               new MLMCEuropeanHestonEngine<RNG,S,P>(process_,
+                                                     steps_,
+                                                     stepsPerYear_,
+                                                     antithetic_,
+                                                     tolerance_,
+                                                     maxLevels_,
+                                                     calibrationSamples_,
+                                                     refinement_,
+                                                     seed_));
+    }
+
+}
+
+
+#endif
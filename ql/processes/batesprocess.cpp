@@ -59,6 +59,12 @@ namespace QuantLib {
         return retVal;
     }
 
+    void BatesProcess::evolve(Time t0, const Matrix& x0,
+                              Time dt, const Matrix& dw, Matrix& x) const {
+        // the jumps are added path by path
+        StochasticProcess::evolve(t0, x0, dt, dw, x);
+    }
+
     Size BatesProcess::factors() const {
         return 4;
     }
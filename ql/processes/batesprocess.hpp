@@ -61,6 +61,8 @@ namespace QuantLib {
         Disposable<Array> drift(Time t, const Array& x) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        void evolve(Time t0, const Matrix& x0,
+                    Time dt, const Matrix& dw, Matrix& x) const;
 
         Real lambda() const;
         Real nu()     const;
@@ -29,6 +29,7 @@
 #include <ql/time/daycounters/actual365fixed.hpp>
 
 #include <boost/make_shared.hpp>
+#include <typeinfo>
 
 namespace QuantLib {
 
@@ -146,6 +147,46 @@ namespace QuantLib {
                                  stdDeviation(t0, x0, dt) * dw);
     }
 
+    namespace {
+
+        /* the batch step below hard-codes the exact step and apply();
+           derived classes other than the ones declared along with the
+           base class might override them. */
+        bool hasDefaultDynamics(const GeneralizedBlackScholesProcess& p) {
+            const std::type_info& type = typeid(p);
+            return type == typeid(GeneralizedBlackScholesProcess)
+                || type == typeid(BlackScholesProcess)
+                || type == typeid(BlackScholesMertonProcess)
+                || type == typeid(BlackProcess)
+                || type == typeid(GarmanKohlagenProcess);
+        }
+
+    }
+
+    void GeneralizedBlackScholesProcess::evolve(Time t0, const Real* x0,
+                                                Time dt, const Real* dw,
+                                                Real* x, Size n) const {
+        localVolatility(); // trigger update
+        if (n == 0)
+            return;
+        if (isStrikeIndependent_ && !forceDiscretization_
+            && hasDefaultDynamics(*this)) {
+            // exact value for curves; the same for all paths
+            Real var = variance(t0, x0[0], dt);
+            Real drift = (riskFreeRate_->forwardRate(t0, t0 + dt, Continuous,
+                                                     NoFrequency, true) -
+                          dividendYield_->forwardRate(t0, t0 + dt, Continuous,
+                                                      NoFrequency, true)) *
+                             dt -
+                         0.5 * var;
+            Real stdDev = std::sqrt(var);
+            for (Size j=0; j<n; ++j)
+                x[j] = x0[j] * std::exp(stdDev * dw[j] + drift);
+        } else {
+            StochasticProcess1D::evolve(t0, x0, dt, dw, x, n);
+        }
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
@@ -85,6 +85,14 @@ namespace QuantLib {
         Real stdDeviation(Time t0, Real x0, Time dt) const;
         Real variance(Time t0, Real x0, Time dt) const;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        /*! when the exact evolution is used, the variance and the
+            drift are calculated once for the whole batch.  This is
+            only done for the classes declared in this file; for other
+            derived classes, each path is evolved by the single-path
+            evolve() method.
+        */
+        void evolve(Time t0, const Real* x0, Time dt,
+                    const Real* dw, Real* x, Size n) const;
         //@}
         Time time(const Date&) const;
         //! \name Observer interface
@@ -567,6 +567,142 @@ namespace QuantLib {
         return retVal;
     }
 
+    void HestonProcess::evolve(Time t0, const Matrix& x0,
+                               Time dt, const Matrix& dw,
+                               Matrix& x) const {
+        switch (discretization_) {
+          case PartialTruncation:
+          case FullTruncation:
+          case Reflection:
+          case QuadraticExponential:
+          case QuadraticExponentialMartingale:
+            break;
+          default:
+            // the exact schemes need a root finding per path anyway
+            StochasticProcess::evolve(t0, x0, dt, dw, x);
+            return;
+        }
+
+        QL_REQUIRE(x0.rows() == 2 && x.rows() == 2,
+                   "state matrices must have 2 rows");
+        QL_REQUIRE(dw.rows() == 2, "increment matrix must have 2 rows");
+        QL_REQUIRE(dw.columns() == x0.columns() &&
+                   x.columns() == x0.columns(),
+                   "mismatch between number of paths");
+
+        const Size n = x0.columns();
+        const Real* s0 = x0.row_begin(0);
+        const Real* v0 = x0.row_begin(1);
+        const Real* dw0 = dw.row_begin(0);
+        const Real* dw1 = dw.row_begin(1);
+        Real* s = x.row_begin(0);
+        Real* v = x.row_begin(1);
+
+        const Real sdt = std::sqrt(dt);
+        const Real sqrhov = std::sqrt(1.0 - rho_*rho_);
+        // the same for all paths
+        const Real rq = riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+                      - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+
+        switch (discretization_) {
+          case PartialTruncation:
+            for (Size j=0; j<n; ++j) {
+                const Real vj = v0[j];
+                const Real vol = (vj > 0.0) ? std::sqrt(vj) : 0.0;
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rq - 0.5 * vol * vol;
+                const Real nu = kappa_*(theta_ - vj);
+
+                s[j] = s0[j] * std::exp(mu*dt+vol*dw0[j]*sdt);
+                v[j] = vj + nu*dt + vol2*sdt*(rho_*dw0[j] + sqrhov*dw1[j]);
+            }
+            break;
+          case FullTruncation:
+            for (Size j=0; j<n; ++j) {
+                const Real vj = v0[j];
+                const Real vol = (vj > 0.0) ? std::sqrt(vj) : 0.0;
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rq - 0.5 * vol * vol;
+                const Real nu = kappa_*(theta_ - vol*vol);
+
+                s[j] = s0[j] * std::exp(mu*dt+vol*dw0[j]*sdt);
+                v[j] = vj + nu*dt + vol2*sdt*(rho_*dw0[j] + sqrhov*dw1[j]);
+            }
+            break;
+          case Reflection:
+            for (Size j=0; j<n; ++j) {
+                const Real vol = std::sqrt(std::fabs(v0[j]));
+                const Real vol2 = sigma_ * vol;
+                const Real mu = rq - 0.5 * vol*vol;
+                const Real nu = kappa_*(theta_ - vol*vol);
+
+                s[j] = s0[j]*std::exp(mu*dt+vol*dw0[j]*sdt);
+                v[j] = vol*vol
+                       +nu*dt + vol2*sdt*(rho_*dw0[j] + sqrhov*dw1[j]);
+            }
+            break;
+          case QuadraticExponential:
+          case QuadraticExponentialMartingale:
+          {
+            const Real ex = std::exp(-kappa_*dt);
+
+            const Real g1 =  0.5;
+            const Real g2 =  0.5;
+            const Real k1 =  g1*dt*(kappa_*rho_/sigma_-0.5)-rho_/sigma_;
+            const Real k2 =  g2*dt*(kappa_*rho_/sigma_-0.5)+rho_/sigma_;
+            const Real k3 =  g1*dt*(1-rho_*rho_);
+            const Real k4 =  g2*dt*(1-rho_*rho_);
+            const Real A  =  k2+0.5*k4;
+            const CumulativeNormalDistribution N;
+
+            for (Size j=0; j<n; ++j) {
+                const Real vj = v0[j];
+                const Real m  =  theta_+(vj-theta_)*ex;
+                const Real s2 =  vj*sigma_*sigma_*ex/kappa_*(1-ex)
+                              + theta_*sigma_*sigma_/(2*kappa_)*(1-ex)*(1-ex);
+                const Real psi = s2/(m*m);
+
+                Real k0 = -rho_*kappa_*theta_*dt/sigma_;
+                Real vt;
+
+                if (psi < 1.5) {
+                    const Real b2 = 2/psi-1+std::sqrt(2/psi*(2/psi-1));
+                    const Real b  = std::sqrt(b2);
+                    const Real a  = m/(1+b2);
+
+                    if (discretization_ == QuadraticExponentialMartingale) {
+                        // martingale correction
+                        QL_REQUIRE(A < 1/(2*a), "illegal value");
+                        k0 = -A*b2*a/(1-2*A*a)+0.5*std::log(1-2*A*a)
+                             -(k1+0.5*k3)*vj;
+                    }
+                    vt = a*(b+dw1[j])*(b+dw1[j]);
+                }
+                else {
+                    const Real p = (psi-1)/(psi+1);
+                    const Real beta = (1-p)/m;
+
+                    const Real u = N(dw1[j]);
+
+                    if (discretization_ == QuadraticExponentialMartingale) {
+                        // martingale correction
+                        QL_REQUIRE(A < beta, "illegal value");
+                        k0 = -std::log(p+beta*(1-p)/(beta-A))-(k1+0.5*k3)*vj;
+                    }
+                    vt = ((u <= p) ? 0.0 : std::log((1-p)/(1-u))/beta);
+                }
+
+                s[j] = s0[j]*std::exp(rq*dt + k0 + k1*vj + k2*vt
+                                      +std::sqrt(k3*vj+k4*vt)*dw0[j]);
+                v[j] = vt;
+            }
+          }
+          break;
+          default:
+            QL_FAIL("unknown discretization schema");
+        }
+    }
+
     const Handle<Quote>& HestonProcess::s0() const {
         return s0_;
     }
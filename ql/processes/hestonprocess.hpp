@@ -71,6 +71,12 @@ namespace QuantLib {
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        /*! the truncation, reflection and quadratic-exponential
+            schemes evolve the whole batch at once; the other schemes
+            use the default path-by-path implementation.
+        */
+        void evolve(Time t0, const Matrix& x0,
+                    Time dt, const Matrix& dw, Matrix& x) const;
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
@@ -107,6 +107,21 @@ namespace QuantLib {
         return tmp;
     }
 
+    void StochasticProcessArray::evolve(Time t0, const Matrix& x0,
+                                        Time dt, const Matrix& dw,
+                                        Matrix& x) const {
+        QL_REQUIRE(x0.rows() == size() && x.rows() == size(),
+                   "state matrices must have " << size() << " rows");
+        QL_REQUIRE(dw.columns() == x0.columns() &&
+                   x.columns() == x0.columns(),
+                   "mismatch between number of paths");
+        const Matrix dz = sqrtCorrelation_ * dw;
+
+        for (Size i=0; i<size(); ++i)
+            processes_[i]->evolve(t0, x0.row_begin(i), dt, dz.row_begin(i),
+                                  x.row_begin(i), x0.columns());
+    }
+
     Disposable<Array> StochasticProcessArray::apply(const Array& x0,
                                                     const Array& dx) const {
         Array tmp(size());
@@ -59,6 +59,25 @@ namespace QuantLib {
         return apply(expectation(t0,x0,dt), stdDeviation(t0,x0,dt)*dw);
     }
 
+    void StochasticProcess::evolve(Time t0, const Matrix& x0,
+                                   Time dt, const Matrix& dw,
+                                   Matrix& x) const {
+        QL_REQUIRE(x0.rows() == size() && x.rows() == size(),
+                   "state matrices must have " << size() << " rows");
+        QL_REQUIRE(dw.rows() == factors(),
+                   "increment matrix must have " << factors() << " rows");
+        QL_REQUIRE(dw.columns() == x0.columns() &&
+                   x.columns() == x0.columns(),
+                   "mismatch between number of paths");
+        Array xj(x0.rows()), dwj(dw.rows());
+        for (Size j=0; j<x0.columns(); ++j) {
+            std::copy(x0.column_begin(j), x0.column_end(j), xj.begin());
+            std::copy(dw.column_begin(j), dw.column_end(j), dwj.begin());
+            const Array y = evolve(t0, xj, dt, dwj);
+            std::copy(y.begin(), y.end(), x.column_begin(j));
+        }
+    }
+
     Disposable<Array> StochasticProcess::apply(const Array& x0,
                                                const Array& dx) const {
         return x0 + dx;
@@ -98,6 +117,12 @@ namespace QuantLib {
         return apply(expectation(t0,x0,dt), stdDeviation(t0,x0,dt)*dw);
     }
 
+    void StochasticProcess1D::evolve(Time t0, const Real* x0, Time dt,
+                                     const Real* dw, Real* x, Size n) const {
+        for (Size j=0; j<n; ++j)
+            x[j] = evolve(t0, x0[j], dt, dw[j]);
+    }
+
     Real StochasticProcess1D::apply(Real x0, Real dx) const {
         return x0 + dx;
     }
@@ -123,6 +123,21 @@ namespace QuantLib {
                                          const Array& x0,
                                          Time dt,
                                          const Array& dw) const;
+        /*! evolves a batch of paths over the same time interval.
+            Each column of \f$ x_0 \f$, \f$ \Delta \mathrm{w} \f$
+            and \f$ x \f$ holds the state or the increments of a
+            single path; \f$ x \f$ must be sized beforehand and can
+            be the same matrix as \f$ x_0 \f$.  By default, each
+            column is passed to the single-path evolve() method;
+            derived classes can override this to hoist the
+            path-independent parts of the calculation out of the
+            loop over paths.
+        */
+        virtual void evolve(Time t0,
+                            const Matrix& x0,
+                            Time dt,
+                            const Matrix& dw,
+                            Matrix& x) const;
         /*! applies a change to the asset value. By default, it
             returns \f$ \mathrm{x} + \Delta \mathrm{x} \f$.
         */
@@ -216,6 +231,15 @@ namespace QuantLib {
             standard deviation.
         */
         virtual Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        /*! evolves the \f$ n \f$ values starting at \f$ x_0 \f$
+            over the same time interval, using the corresponding
+            increments starting at \f$ \Delta w \f$, and writes the
+            results starting at \f$ x \f$ (which can coincide with
+            \f$ x_0 \f$).  By default, it calls the single-value
+            evolve() method on each of them.
+        */
+        virtual void evolve(Time t0, const Real* x0, Time dt,
+                            const Real* dw, Real* x, Size n) const;
         /*! applies a change to the asset value. By default, it
             returns \f$ x + \Delta x \f$.
         */
@@ -239,6 +263,8 @@ namespace QuantLib {
                                       Time dt) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        void evolve(Time t0, const Matrix& x0,
+                    Time dt, const Matrix& dw, Matrix& x) const;
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
     };
 
@@ -310,6 +336,18 @@ namespace QuantLib {
         return a;
     }
 
+    inline void StochasticProcess1D::evolve(Time t0, const Matrix& x0,
+                                            Time dt, const Matrix& dw,
+                                            Matrix& x) const {
+        QL_REQUIRE(x0.rows() == 1 && dw.rows() == 1 && x.rows() == 1,
+                   "1-D matrices required");
+        QL_REQUIRE(dw.columns() == x0.columns() &&
+                   x.columns() == x0.columns(),
+                   "mismatch between number of paths");
+        evolve(t0, x0.row_begin(0), dt, dw.row_begin(0), x.row_begin(0),
+               x0.columns());
+    }
+
     inline Disposable<Array> StochasticProcess1D::apply(
                                                       const Array& x0,
                                                       const Array& dx) const {
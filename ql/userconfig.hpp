@@ -47,6 +47,18 @@
 //#   define QL_ENABLE_TRACING
 #endif
 
+/* Define this if the calculations of lazy objects should be profiled
+   (whether they actually are will depend on run-time settings.) */
+#ifndef QL_ENABLE_CALCULATION_PROFILING
+//#   define QL_ENABLE_CALCULATION_PROFILING
+#endif
+
+/* Define this if matrix products should be delegated to a CBLAS
+   library, which must then be linked to the executables. */
+#ifndef QL_USE_BLAS
+//#   define QL_USE_BLAS
+#endif
+
 /* Define this if negative rates should be allowed. */
 #ifndef QL_NEGATIVE_RATES
 #   define QL_NEGATIVE_RATES
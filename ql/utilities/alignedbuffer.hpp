@@ -0,0 +1,130 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file alignedbuffer.hpp
+    \brief heap buffer with aligned storage
+*/
+
+#ifndef quantlib_aligned_buffer_hpp
+#define quantlib_aligned_buffer_hpp
+
+#include <ql/types.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/has_trivial_constructor.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <algorithm>
+#include <new>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <stdlib.h>
+#define QL_HAS_POSIX_MEMALIGN
+#endif
+
+namespace QuantLib {
+
+    namespace detail {
+
+        /* Where the platform doesn't provide aligned allocation, the
+           block is over-allocated and the distance between its start
+           and the aligned address is stored in the byte before the
+           latter, so that the block can be recovered from it. */
+        inline void* alignedAllocate(std::size_t bytes,
+                                     std::size_t alignment) {
+            #if defined(_MSC_VER)
+            void* p = _aligned_malloc(bytes, alignment);
+            if (!p)
+                throw std::bad_alloc();
+            return p;
+            #elif defined(QL_HAS_POSIX_MEMALIGN)
+            void* p = 0;
+            if (posix_memalign(&p, alignment, bytes) != 0)
+                throw std::bad_alloc();
+            return p;
+            #else
+            char* raw = static_cast<char*>(
+                                  ::operator new(bytes + alignment));
+            std::size_t address = reinterpret_cast<std::size_t>(raw);
+            std::size_t offset = alignment - address % alignment;
+            raw[offset-1] = static_cast<unsigned char>(offset-1);
+            return raw + offset;
+            #endif
+        }
+
+        inline void alignedFree(void* p) {
+            #if defined(_MSC_VER)
+            _aligned_free(p);
+            #elif defined(QL_HAS_POSIX_MEMALIGN)
+            free(p);
+            #else
+            if (p) {
+                char* aligned = static_cast<char*>(p);
+                std::size_t offset =
+                    static_cast<unsigned char>(aligned[-1]) + 1;
+                ::operator delete(aligned - offset);
+            }
+            #endif
+        }
+
+    }
+
+    //! heap buffer whose first element is aligned to the given boundary
+    /*! The buffer owns its elements, as a \c boost::scoped_array
+        would, and has the same size; the default alignment of 64
+        bytes is the size of a cache line and of an AVX-512 register,
+        so that vectorised loops over the elements can start with
+        aligned loads.
+
+        The buffer doesn't store the number of its elements, which
+        is kept by its owner; therefore, the elements must be of a
+        type with trivial constructor and destructor.  They are left
+        uninitialized, as in a plain <tt>new Real[n]</tt> expression.
+    */
+    template <class T, Size Alignment = 64>
+    class AlignedBuffer : private boost::noncopyable {
+        BOOST_STATIC_ASSERT(boost::has_trivial_constructor<T>::value);
+        BOOST_STATIC_ASSERT(boost::has_trivial_destructor<T>::value);
+        // the fallback allocation stores the offset in a byte
+        BOOST_STATIC_ASSERT(Alignment > 0 && Alignment <= 256 &&
+                            (Alignment & (Alignment-1)) == 0);
+      public:
+        typedef T element_type;
+        //! creates a buffer with the given number of elements
+        explicit AlignedBuffer(Size n = 0)
+        : data_(n == 0 ? 0 : static_cast<T*>(
+                          detail::alignedAllocate(n*sizeof(T), Alignment))) {
+        }
+        ~AlignedBuffer() { detail::alignedFree(data_); }
+        //! replaces the buffer with a new one of the given size
+        void reset(Size n = 0) {
+            AlignedBuffer tmp(n);
+            swap(tmp);
+        }
+        void swap(AlignedBuffer& other) {  // never throws
+            std::swap(data_, other.data_);
+        }
+        T* get() const { return data_; }
+        T& operator[](Size i) const { return data_[i]; }
+      private:
+        T* data_;
+    };
+
+}
+
+
+#endif
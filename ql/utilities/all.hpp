@@ -1,7 +1,10 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/utilities/alignedbuffer.hpp>
+#include <ql/utilities/calculationprofiler.hpp>
 #include <ql/utilities/clone.hpp>
+#include <ql/utilities/compactset.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/utilities/dataparsers.hpp>
 #include <ql/utilities/disposable.hpp>
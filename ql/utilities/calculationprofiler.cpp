@@ -0,0 +1,211 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/calculationprofiler.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105600
+#include <boost/core/demangle.hpp>
+#endif
+#include <algorithm>
+#include <ostream>
+#include <typeinfo>
+
+namespace QuantLib {
+
+    namespace {
+
+        boost::posix_time::ptime now() {
+            return boost::posix_time::microsec_clock::universal_time();
+        }
+
+        std::string typeName(const LazyObject* object) {
+            const char* name = typeid(*object).name();
+            #if BOOST_VERSION >= 105600
+            return boost::core::demangle(name);
+            #else
+            return name;
+            #endif
+        }
+
+        bool byOwnTime(const CalculationProfiler::Record& r1,
+                       const CalculationProfiler::Record& r2) {
+            return r1.ownTime > r2.ownTime;
+        }
+
+        std::string csvString(const std::string& s) {
+            // type names can contain commas, as in templates
+            std::string result = "\"";
+            for (Size i=0; i<s.size(); ++i) {
+                if (s[i] == '"')
+                    result += '"';
+                result += s[i];
+            }
+            return result + "\"";
+        }
+
+        std::string jsonString(const std::string& s) {
+            std::string result = "\"";
+            for (Size i=0; i<s.size(); ++i) {
+                if (s[i] == '"' || s[i] == '\\')
+                    result += '\\';
+                result += s[i];
+            }
+            return result + "\"";
+        }
+
+    }
+
+    CalculationProfiler::Record::Record()
+    : object(0), instances(0), calculations(0), notifications(0),
+      invalidations(0), time(0.0), ownTime(0.0) {}
+
+    CalculationProfiler::CalculationProfiler() : enabled_(false) {}
+
+    void CalculationProfiler::enable() {
+        #if defined(QL_ENABLE_CALCULATION_PROFILING)
+        enabled_ = true;
+        #else
+        QL_FAIL("calculation profiling not available");
+        #endif
+    }
+
+    void CalculationProfiler::reset() {
+        records_.clear();
+        running_.clear();
+    }
+
+    CalculationProfiler::Record&
+    CalculationProfiler::recordFor(const LazyObject* object) {
+        std::map<const LazyObject*, Record>::iterator i =
+            records_.find(object);
+        if (i == records_.end()) {
+            Record r;
+            r.object = object;
+            r.type = typeName(object);
+            r.instances = 1;
+            i = records_.insert(std::make_pair(object, r)).first;
+        }
+        return i->second;
+    }
+
+    void CalculationProfiler::addNotification(const LazyObject* object,
+                                              bool invalidating) {
+        Record& r = recordFor(object);
+        ++r.notifications;
+        if (invalidating)
+            ++r.invalidations;
+    }
+
+    void CalculationProfiler::calculationStarted() {
+        running_.push_back(std::make_pair(now(), 0.0));
+    }
+
+    void CalculationProfiler::calculationFinished(const LazyObject* object) {
+        // the records might have been reset in the meantime
+        if (running_.empty())
+            return;
+        Real elapsed =
+            (now() - running_.back().first).total_microseconds() * 1.0e-6;
+        Real nested = running_.back().second;
+        running_.pop_back();
+        if (!running_.empty())
+            running_.back().second += elapsed;
+
+        Record& r = recordFor(object);
+        ++r.calculations;
+        r.time += elapsed;
+        r.ownTime += elapsed - nested;
+    }
+
+    CalculationProfiler::Record
+    CalculationProfiler::record(const LazyObject* object) const {
+        std::map<const LazyObject*, Record>::const_iterator i =
+            records_.find(object);
+        return i != records_.end() ? i->second : Record();
+    }
+
+    std::vector<CalculationProfiler::Record>
+    CalculationProfiler::records(Grouping grouping) const {
+        std::vector<Record> result;
+        std::map<const LazyObject*, Record>::const_iterator i;
+        if (grouping == ByInstance) {
+            for (i = records_.begin(); i != records_.end(); ++i)
+                result.push_back(i->second);
+        } else {
+            std::map<std::string, Record> types;
+            for (i = records_.begin(); i != records_.end(); ++i) {
+                const Record& r = i->second;
+                Record& total = types[r.type];
+                total.type = r.type;
+                total.instances += r.instances;
+                total.calculations += r.calculations;
+                total.notifications += r.notifications;
+                total.invalidations += r.invalidations;
+                total.time += r.time;
+                total.ownTime += r.ownTime;
+            }
+            std::map<std::string, Record>::const_iterator j;
+            for (j = types.begin(); j != types.end(); ++j)
+                result.push_back(j->second);
+        }
+        std::stable_sort(result.begin(), result.end(), byOwnTime);
+        return result;
+    }
+
+    void CalculationProfiler::writeCsv(std::ostream& out,
+                                       Grouping grouping) const {
+        std::vector<Record> rs = records(grouping);
+        if (grouping == ByInstance)
+            out << "instance,";
+        out << "type,instances,calculations,notifications,"
+            << "invalidations,time,own_time\n";
+        for (Size i=0; i<rs.size(); ++i) {
+            const Record& r = rs[i];
+            if (grouping == ByInstance)
+                out << r.object << ",";
+            out << csvString(r.type) << ","
+                << r.instances << ","
+                << r.calculations << ","
+                << r.notifications << ","
+                << r.invalidations << ","
+                << r.time << ","
+                << r.ownTime << "\n";
+        }
+    }
+
+    void CalculationProfiler::writeJson(std::ostream& out,
+                                        Grouping grouping) const {
+        std::vector<Record> rs = records(grouping);
+        out << "[";
+        for (Size i=0; i<rs.size(); ++i) {
+            const Record& r = rs[i];
+            out << (i == 0 ? "\n" : ",\n") << "  { ";
+            if (grouping == ByInstance)
+                out << "\"instance\": \"" << r.object << "\", ";
+            out << "\"type\": " << jsonString(r.type) << ", "
+                << "\"instances\": " << r.instances << ", "
+                << "\"calculations\": " << r.calculations << ", "
+                << "\"notifications\": " << r.notifications << ", "
+                << "\"invalidations\": " << r.invalidations << ", "
+                << "\"time\": " << r.time << ", "
+                << "\"ownTime\": " << r.ownTime << " }";
+        }
+        out << "\n]\n";
+    }
+
+}
@@ -0,0 +1,185 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file calculationprofiler.hpp
+    \brief profiling of lazy-object calculations
+*/
+
+#ifndef quantlib_calculation_profiler_hpp
+#define quantlib_calculation_profiler_hpp
+
+#include <ql/patterns/singleton.hpp>
+#include <ql/errors.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    class LazyObject;
+
+    //! profiler of lazy-object calculations
+    /*! When the library is compiled with
+        QL_ENABLE_CALCULATION_PROFILING defined and the profiler is
+        enabled, each LazyObject instance (including instruments,
+        whose calculations include the ones of their engines) records:
+        - the number of calls to its performCalculations() method;
+        - the wall-clock time spent in them, both in total and net of
+          the calculations of other lazy objects nested inside them
+          (e.g., those of a bootstrapped curve in an instrument);
+        - the number of notifications it received, and how many of
+          them invalidated its results.
+
+        A notification fan-in larger than the number of
+        calculations, or many calculations for an object whose inputs
+        didn't change, points at redundant work.  The records can be
+        read per instance or aggregated per type, and written in CSV
+        or JSON format.  When the macro is not defined, the hooks in
+        LazyObject compile to nothing.
+
+        Instances are identified by their address; an object created
+        at the address of a destroyed one is added to its record
+        unless reset() is called in between.  As the profiler is a
+        singleton, each pricing context has its own.
+
+        \warning the profiler is not thread-safe; it should not be
+                 enabled while objects are calculated concurrently in
+                 the same pricing context.
+
+        \test records are checked for a curve and its observers.
+    */
+    class CalculationProfiler : public Singleton<CalculationProfiler> {
+        friend class Singleton<CalculationProfiler>;
+      public:
+        //! profiling information
+        struct Record {
+            Record();
+            //! the instance; null for records aggregated per type
+            const void* object;
+            std::string type;
+            Size instances;
+            Size calculations;
+            Size notifications;
+            //! notifications received while calculated
+            Size invalidations;
+            //! time in seconds spent calculating
+            Real time;
+            //! time in seconds net of nested calculations
+            Real ownTime;
+        };
+        enum Grouping { ByInstance, ByType };
+        //! \name Settings
+        //@{
+        void enable();
+        void disable() { enabled_ = false; }
+        bool enabled() const { return enabled_; }
+        //! discards all records
+        void reset();
+        //@}
+        //! \name Inspectors
+        //@{
+        //! record for a given instance (empty if not available)
+        Record record(const LazyObject* object) const;
+        //! records sorted by decreasing own time
+        std::vector<Record> records(Grouping grouping = ByInstance) const;
+        //@}
+        //! \name Output
+        //@{
+        void writeCsv(std::ostream&, Grouping grouping = ByInstance) const;
+        void writeJson(std::ostream&, Grouping grouping = ByInstance) const;
+        //@}
+        //! \name Hooks
+        //@{
+        void notified(const LazyObject* object, bool invalidating) {
+            if (enabled_)
+                addNotification(object, invalidating);
+        }
+        void calculationStarted();
+        void calculationFinished(const LazyObject* object);
+        //@}
+      private:
+        CalculationProfiler();
+        Record& recordFor(const LazyObject* object);
+        void addNotification(const LazyObject* object, bool invalidating);
+        bool enabled_;
+        std::map<const LazyObject*, Record> records_;
+        // start times of the calculations in progress, and the time
+        // spent in the ones nested inside each of them
+        std::vector<std::pair<boost::posix_time::ptime, Real> > running_;
+    };
+
+    namespace detail {
+
+        class CalculationTimer {
+          public:
+            explicit CalculationTimer(const LazyObject* object)
+            : object_(object),
+              profiler_(CalculationProfiler::instance()),
+              active_(profiler_.enabled()) {
+                if (active_)
+                    profiler_.calculationStarted();
+            }
+            ~CalculationTimer() {
+                if (active_) {
+                    try {
+                        profiler_.calculationFinished(object_);
+                    } catch (...) {}
+                }
+            }
+          private:
+            const LazyObject* object_;
+            CalculationProfiler& profiler_;
+            bool active_;
+        };
+
+    }
+
+}
+
+/*! \def QL_PROFILE_NOTIFICATION
+    \brief records a notification to a lazy object
+
+    Used by LazyObject::update(); it compiles to nothing unless
+    QL_ENABLE_CALCULATION_PROFILING is defined.
+*/
+
+/*! \def QL_PROFILE_CALCULATION
+    \brief times the calculations of a lazy object
+
+    Used by LazyObject::calculate(); it compiles to nothing unless
+    QL_ENABLE_CALCULATION_PROFILING is defined.  The calculations are
+    timed until the end of the enclosing scope.
+*/
+
+#if defined(QL_ENABLE_CALCULATION_PROFILING)
+
+#define QL_PROFILE_NOTIFICATION(object, invalidating) \
+QuantLib::CalculationProfiler::instance().notified(object, invalidating)
+
+#define QL_PROFILE_CALCULATION(object) \
+QuantLib::detail::CalculationTimer ql_calculation_timer(object)
+
+#else
+
+#define QL_PROFILE_NOTIFICATION(object, invalidating)
+#define QL_PROFILE_CALCULATION(object)
+
+#endif
+
+#endif
@@ -0,0 +1,340 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compactset.hpp
+    \brief set storing a few elements inline
+*/
+
+#ifndef quantlib_compact_set_hpp
+#define quantlib_compact_set_hpp
+
+#include <ql/types.hpp>
+#include <boost/unordered_set.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <new>
+
+namespace QuantLib {
+
+    //! set storing a few elements inline
+    /*! Up to \f$ N \f$ elements are stored in an array inside the
+        object and looked up by linear search, which requires no
+        heap allocation; larger sets are moved into an instance of
+        the \c LargeSet class, and moved back when they shrink to
+        half that size.
+
+        The array and the large set share the same storage, so that
+        a large compact set costs only one word more than the
+        corresponding \c LargeSet.  \f$ N \f$ is best chosen so that
+        the array is no larger than a \c LargeSet instance; the
+        compact form is then never larger than an empty large set
+        plus that word.  With 64-bit pointers, the default hash set
+        takes as much space as six pointers or three shared pointers.
+
+        This is the storage used by the observer pattern, where most
+        instances are registered with a handful of observables and
+        most observables have few observers, but a few (e.g., the
+        evaluation date or a widely used index) might have a great
+        many of them.
+
+        As for other sets, iterators are constant; they are
+        invalidated by insertions and removals.  The copy of the
+        elements is assumed not to throw.
+
+        \test the set is checked against a std::set through its
+              transitions between storages.
+    */
+    template <class T, Size N = 4, class LargeSet = boost::unordered_set<T> >
+    class CompactSet {
+      public:
+        typedef T value_type;
+        typedef T key_type;
+        typedef Size size_type;
+        class const_iterator {
+            friend class CompactSet;
+          public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const T* pointer;
+            typedef const T& reference;
+            const_iterator() : item_(0) {}
+            reference operator*() const {
+                return item_ != 0 ? *item_ : *large_;
+            }
+            pointer operator->() const { return &(**this); }
+            const_iterator& operator++() {
+                if (item_ != 0)
+                    ++item_;
+                else
+                    ++large_;
+                return *this;
+            }
+            const_iterator operator++(int) {
+                const_iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+            bool operator==(const const_iterator& i) const {
+                return item_ == i.item_ && (item_ != 0 || large_ == i.large_);
+            }
+            bool operator!=(const const_iterator& i) const {
+                return !(*this == i);
+            }
+          private:
+            explicit const_iterator(const T* item) : item_(item) {}
+            explicit const_iterator(typename LargeSet::const_iterator i)
+            : item_(0), large_(i) {}
+            const T* item_;
+            typename LargeSet::const_iterator large_;
+        };
+        typedef const_iterator iterator;
+
+        CompactSet() : size_(0) {}
+        CompactSet(const CompactSet&);
+        CompactSet& operator=(const CompactSet&);
+        ~CompactSet() { destroy(); }
+
+        //! \name Inspectors
+        //@{
+        Size size() const { return isCompact() ? size_ : large().size(); }
+        bool empty() const { return size() == 0; }
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator find(const T&) const;
+        Size count(const T& x) const { return find(x) != end() ? 1 : 0; }
+        //! whether the elements are stored inline
+        bool isCompact() const { return size_ != largeStorage; }
+        //@}
+
+        //! \name Modifiers
+        //@{
+        std::pair<iterator, bool> insert(const T&);
+        template <class I>
+        void insert(I begin, I end) {
+            for (; begin != end; ++begin)
+                insert(*begin);
+        }
+        Size erase(const T&);
+        void clear();
+        void swap(CompactSet&);
+        //@}
+      private:
+        // value of size_ when the elements are in the large set
+        static const Size largeStorage = Size(-1);
+        static const Size itemBytes = N*sizeof(T);
+        static const Size bytes = itemBytes > sizeof(LargeSet) ?
+                                  itemBytes : sizeof(LargeSet);
+        static const Size alignment =
+            boost::alignment_of<T>::value > boost::alignment_of<LargeSet>::value
+            ? boost::alignment_of<T>::value
+            : boost::alignment_of<LargeSet>::value;
+        T* items() { return reinterpret_cast<T*>(&storage_); }
+        const T* items() const {
+            return reinterpret_cast<const T*>(&storage_);
+        }
+        LargeSet& large() { return *reinterpret_cast<LargeSet*>(&storage_); }
+        const LargeSet& large() const {
+            return *reinterpret_cast<const LargeSet*>(&storage_);
+        }
+        const T* findInline(const T&) const;
+        // the storage is left empty and uninitialized
+        void destroy();
+        // the storage must be empty; the contents of s are taken
+        void makeCompact(const LargeSet& s);
+        void makeLarge(LargeSet& s);
+        typename boost::aligned_storage<bytes, alignment>::type storage_;
+        Size size_;
+    };
+
+
+    // inline definitions
+
+    template <class T, Size N, class S>
+    inline CompactSet<T,N,S>::CompactSet(const CompactSet& s) : size_(0) {
+        if (s.isCompact()) {
+            std::uninitialized_copy(s.items(), s.items()+s.size_, items());
+            size_ = s.size_;
+        } else {
+            new (&storage_) S(s.large());
+            size_ = largeStorage;
+        }
+    }
+
+    template <class T, Size N, class S>
+    inline CompactSet<T,N,S>& CompactSet<T,N,S>::operator=(
+                                                        const CompactSet& s) {
+        if (&s != this) {
+            CompactSet tmp(s);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    template <class T, Size N, class S>
+    inline void CompactSet<T,N,S>::destroy() {
+        if (isCompact()) {
+            for (Size i=0; i<size_; ++i)
+                items()[i].~T();
+        } else {
+            large().~S();
+        }
+        size_ = 0;
+    }
+
+    template <class T, Size N, class S>
+    inline void CompactSet<T,N,S>::makeCompact(const S& s) {
+        std::uninitialized_copy(s.begin(), s.end(), items());
+        size_ = s.size();
+    }
+
+    template <class T, Size N, class S>
+    inline void CompactSet<T,N,S>::makeLarge(S& s) {
+        // the default constructor doesn't allocate
+        new (&storage_) S;
+        size_ = largeStorage;
+        large().swap(s);
+    }
+
+    template <class T, Size N, class S>
+    inline typename CompactSet<T,N,S>::const_iterator
+    CompactSet<T,N,S>::begin() const {
+        if (isCompact())
+            return const_iterator(items());
+        else
+            return const_iterator(typename S::const_iterator(large().begin()));
+    }
+
+    template <class T, Size N, class S>
+    inline typename CompactSet<T,N,S>::const_iterator
+    CompactSet<T,N,S>::end() const {
+        if (isCompact())
+            return const_iterator(items()+size_);
+        else
+            return const_iterator(typename S::const_iterator(large().end()));
+    }
+
+    template <class T, Size N, class S>
+    inline const T* CompactSet<T,N,S>::findInline(const T& x) const {
+        for (Size i=0; i<size_; ++i) {
+            if (items()[i] == x)
+                return items()+i;
+        }
+        return 0;
+    }
+
+    template <class T, Size N, class S>
+    inline typename CompactSet<T,N,S>::const_iterator
+    CompactSet<T,N,S>::find(const T& x) const {
+        if (!isCompact())
+            return const_iterator(typename S::const_iterator(large().find(x)));
+        const T* item = findInline(x);
+        return item != 0 ? const_iterator(item) : end();
+    }
+
+    template <class T, Size N, class S>
+    inline std::pair<typename CompactSet<T,N,S>::iterator, bool>
+    CompactSet<T,N,S>::insert(const T& x) {
+        if (isCompact()) {
+            if (const T* item = findInline(x))
+                return std::make_pair(const_iterator(item), false);
+            if (size_ < N) {
+                new (items()+size_) T(x);
+                return std::make_pair(const_iterator(items()+size_++), true);
+            }
+            // no more room; the elements are moved to a large set
+            // built in the same storage
+            S tmp(items(), items()+size_);
+            tmp.insert(x);
+            destroy();
+            makeLarge(tmp);
+            return std::make_pair(
+                 const_iterator(typename S::const_iterator(large().find(x))),
+                 true);
+        } else {
+            std::pair<typename S::iterator, bool> result = large().insert(x);
+            return std::make_pair(
+                 const_iterator(typename S::const_iterator(result.first)),
+                 result.second);
+        }
+    }
+
+    template <class T, Size N, class S>
+    inline Size CompactSet<T,N,S>::erase(const T& x) {
+        if (isCompact()) {
+            const T* item = findInline(x);
+            if (item == 0)
+                return 0;
+            Size i = item - items();
+            items()[i] = items()[size_-1];
+            items()[--size_].~T();
+            return 1;
+        } else {
+            Size erased = large().erase(x);
+            if (large().size() <= N/2) {
+                // the elements are moved back inline; the threshold
+                // is lower than N so that a set oscillating around
+                // it doesn't reallocate at each change
+                S tmp;
+                tmp.swap(large());
+                destroy();
+                makeCompact(tmp);
+            }
+            return erased;
+        }
+    }
+
+    template <class T, Size N, class S>
+    inline void CompactSet<T,N,S>::clear() {
+        destroy();
+    }
+
+    template <class T, Size N, class S>
+    inline void CompactSet<T,N,S>::swap(CompactSet& s) {
+        if (!isCompact() && !s.isCompact()) {
+            large().swap(s.large());
+        } else if (isCompact() && s.isCompact()) {
+            CompactSet& shorter = size_ < s.size_ ? *this : s;
+            CompactSet& longer = size_ < s.size_ ? s : *this;
+            Size common = shorter.size_;
+            std::swap_ranges(items(), items()+common, s.items());
+            std::uninitialized_copy(longer.items()+common,
+                                    longer.items()+longer.size_,
+                                    shorter.items()+common);
+            for (Size i=common; i<longer.size_; ++i)
+                longer.items()[i].~T();
+            std::swap(size_, s.size_);
+        } else if (isCompact()) {
+            s.swap(*this);
+        } else {
+            S tmp;
+            tmp.swap(large());
+            destroy();
+            std::uninitialized_copy(s.items(), s.items()+s.size_, items());
+            size_ = s.size_;
+            s.destroy();
+            s.makeLarge(tmp);
+        }
+    }
+
+}
+
+
+#endif
@@ -26,6 +26,14 @@
 
 #include <ql/qldefines.hpp>
 
+/* Defined when the compiler supports rvalue references; classes
+   returned as Disposable can then provide move constructors and
+   assignment operators as well. */
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && \
+    !defined(BOOST_NO_RVALUE_REFERENCES)
+#define QL_HAS_RVALUE_REFERENCES
+#endif
+
 namespace QuantLib {
 
     //! generic disposable object with move semantics
@@ -59,6 +67,12 @@ namespace QuantLib {
             return temp;
         }
         \endcode
+
+        Functions can also be overloaded on
+        <tt>DisposableRvalue\<T\>::type</tt> so that they reuse the
+        storage of a temporary argument instead of allocating their
+        result; see for instance the arithmetic operators of Array and
+        Matrix.
     */
     template <class T>
     class Disposable : public T {
@@ -68,6 +82,25 @@ namespace QuantLib {
         Disposable<T>& operator=(const Disposable<T>& t);
     };
 
+    //! argument type for overloads reusing disposable temporaries
+    /*! When rvalue references are supported, this is an rvalue
+        reference, so that such overloads are only selected for actual
+        temporaries; a named Disposable is passed as a T and keeps its
+        contents.  Otherwise, it is a const reference and the overloads
+        also take the storage of named Disposable arguments, which are
+        left empty; in that case, such arguments should be converted to
+        T before being used in an expression, and the same Disposable
+        must not be passed twice to the same function.
+    */
+    template <class T>
+    struct DisposableRvalue {
+        #if defined(QL_HAS_RVALUE_REFERENCES)
+        typedef const Disposable<T>&& type;
+        #else
+        typedef const Disposable<T>& type;
+        #endif
+    };
+
 
     // inline definitions
 
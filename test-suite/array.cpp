@@ -236,12 +236,75 @@ void ArrayTest::testArrayResize() {
     BOOST_CHECK(iter == a.begin());
 }
 
+void ArrayTest::testDisposableArguments() {
+    BOOST_TEST_MESSAGE("Testing array operators on disposable arguments...");
+
+    const Size n = 10;
+    Array a(n, 1.0, 0.5), b(n, 2.0, -0.25);
+
+    const Array sum = a + b, product = a*b;
+
+    // results must be the same as for non-disposable arguments
+    Array c = (a*b) + (a+b);
+    Array copy = a;
+    Array d = Disposable<Array>(copy) - b;
+    Array e = 2.0*(a+b) / (a*b);
+    Array f = -(a+b);
+    for (Size i=0; i<n; ++i) {
+        if (c[i] != product[i]+sum[i])
+            BOOST_FAIL("sum of disposable arrays failed at index " << i
+                       << "\n    calculated: " << c[i]
+                       << "\n    expected:   " << product[i]+sum[i]);
+        if (d[i] != a[i]-b[i])
+            BOOST_FAIL("difference with disposable array failed at index "
+                       << i
+                       << "\n    calculated: " << d[i]
+                       << "\n    expected:   " << a[i]-b[i]);
+        if (e[i] != (2.0*sum[i])/product[i])
+            BOOST_FAIL("ratio of disposable arrays failed at index " << i
+                       << "\n    calculated: " << e[i]
+                       << "\n    expected:   " << (2.0*sum[i])/product[i]);
+        if (f[i] != -sum[i])
+            BOOST_FAIL("negation of disposable array failed at index " << i
+                       << "\n    calculated: " << f[i]
+                       << "\n    expected:   " << -sum[i]);
+    }
+
+    // the storage of disposable arguments must be reused
+    Disposable<Array> t = a*b;
+    const Real* storage = t.begin();
+    #if defined(QL_HAS_RVALUE_REFERENCES)
+    // ...but only if they are temporaries
+    Array h = t + t;
+    if (t.size() != n || t.begin() != storage)
+        BOOST_FAIL("named disposable argument was modified");
+    for (Size i=0; i<n; ++i) {
+        if (h[i] != product[i]+product[i])
+            BOOST_FAIL("sum of named disposable arrays failed at index " << i
+                       << "\n    calculated: " << h[i]
+                       << "\n    expected:   " << product[i]+product[i]);
+    }
+    Array g = std::move(t) + a;
+    #else
+    Array g = t + a;
+    #endif
+    if (g.begin() != storage)
+        BOOST_FAIL("storage of disposable argument not reused");
+    for (Size i=0; i<n; ++i) {
+        if (g[i] != product[i]+a[i])
+            BOOST_FAIL("sum with disposable array failed at index " << i
+                       << "\n    calculated: " << g[i]
+                       << "\n    expected:   " << product[i]+a[i]);
+    }
+}
+
 
 test_suite* ArrayTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("array tests");
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testArrayFunctions));
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testArrayResize));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testDisposableArguments));
     return suite;
 }
 
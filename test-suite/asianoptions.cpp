@@ -30,11 +30,14 @@
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_strike.hpp>
+#include <ql/pricingengines/asian/mlmc_discr_arith_av_price.hpp>
 #include <ql/pricingengines/asian/fdblackscholesasianengine.hpp>
 #include <ql/experimental/exoticoptions/continuousarithmeticasianlevyengine.hpp>
 #include <ql/experimental/exoticoptions/continuousarithmeticasianvecerengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <boost/make_shared.hpp>
 #include <map>
@@ -1442,6 +1445,301 @@ void AsianOptionTest::testVecerEngine() {
 }
 
 
+void AsianOptionTest::testMCWithWorkers() {
+
+    BOOST_TEST_MESSAGE(
+           "Testing multi-worker Monte Carlo discrete arithmetic Asians...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        flatBlackScholesProcess(today, 90.0, 0.06, 0.025, 0.13, Actual360());
+
+    std::vector<Date> fixingDates;
+    for (Size i=1; i<=12; ++i)
+        fixingDates.push_back(today + Integer(i*30));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(Option::Put, 87.0));
+    boost::shared_ptr<Exercise> exercise(
+                                new EuropeanExercise(fixingDates.back()));
+
+    DiscreteAveragingAsianOption option(Average::Arithmetic, 0.0, 0,
+                                        fixingDates, payoff, exercise);
+
+    const Size samples = 10001;
+    const BigNatural seed = 42;
+
+    for (Size k=0; k<4; ++k) {
+        bool antithetic = (k % 2 == 1);
+        bool controlVariate = (k >= 2);
+
+        option.setPricingEngine(
+            MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+            .withSamples(samples)
+            .withSeed(seed)
+            .withAntitheticVariate(antithetic)
+            .withControlVariate(controlVariate));
+        Real serial = option.NPV();
+
+        for (Size workers=1; workers<=4; workers+=3) {
+            option.setPricingEngine(
+                MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+                .withSamples(samples)
+                .withSeed(seed)
+                .withAntitheticVariate(antithetic)
+                .withControlVariate(controlVariate)
+                .withWorkers(workers));
+            Real parallel = option.NPV();
+
+            if (parallel != serial)
+                BOOST_ERROR("multi-worker pseudo-random result differs "
+                            "from serial one"
+                            << "\n    workers:         " << workers
+                            << "\n    antithetic:      " << antithetic
+                            << "\n    control variate: " << controlVariate
+                            << std::setprecision(16)
+                            << "\n    serial:          " << serial
+                            << "\n    multi-worker:    " << parallel);
+        }
+
+        option.setPricingEngine(
+            MakeMCDiscreteArithmeticAPEngine<LowDiscrepancy>(stochProcess)
+            .withSamples(samples)
+            .withAntitheticVariate(antithetic)
+            .withControlVariate(controlVariate));
+        serial = option.NPV();
+
+        option.setPricingEngine(
+            MakeMCDiscreteArithmeticAPEngine<LowDiscrepancy>(stochProcess)
+            .withSamples(samples)
+            .withAntitheticVariate(antithetic)
+            .withControlVariate(controlVariate)
+            .withWorkers(4));
+        Real parallel = option.NPV();
+
+        if (parallel != serial)
+            BOOST_ERROR("multi-worker low-discrepancy result differs "
+                        "from serial one"
+                        << "\n    antithetic:      " << antithetic
+                        << "\n    control variate: " << controlVariate
+                        << std::setprecision(16)
+                        << "\n    serial:          " << serial
+                        << "\n    multi-worker:    " << parallel);
+    }
+}
+
+
+void AsianOptionTest::testMCBatchPricing() {
+
+    BOOST_TEST_MESSAGE(
+           "Testing batch pricing of Monte Carlo discrete arithmetic Asians...");
+
+    SavedSettings backup;
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        flatBlackScholesProcess(Settings::instance().evaluationDate(),
+                                90.0, 0.06, 0.025, 0.13, Actual360());
+
+    typedef MonteCarloModel<SingleVariate,PseudoRandom> model_type;
+
+    boost::shared_ptr<model_type::path_pricer_type> pricer(
+                new ArithmeticAPOPathPricer(Option::Put, 87.0, 0.97, 0.0, 0));
+
+    for (Size k=0; k<4; ++k) {
+        bool antithetic = (k % 2 == 1);
+        bool initialFixing = (k >= 2);
+
+        std::vector<Time> fixingTimes;
+        if (initialFixing)
+            fixingTimes.push_back(0.0);
+        for (Size i=1; i<=12; ++i)
+            fixingTimes.push_back(i/12.0);
+        TimeGrid grid(fixingTimes.begin(), fixingTimes.end());
+
+        model_type::path_generator_type generator(
+                stochProcess, grid,
+                PseudoRandom::make_sequence_generator(grid.size()-1, 42),
+                false);
+        std::pair<Real, Real> means =
+            singleAndBatchMeans<model_type>(generator, pricer, pricer,
+                                            antithetic);
+        if (means.second != means.first)
+            BOOST_ERROR("batch result differs from path-by-path one"
+                        << "\n    antithetic:     " << antithetic
+                        << "\n    initial fixing: " << initialFixing
+                        << std::setprecision(16)
+                        << "\n    path by path:   " << means.first
+                        << "\n    batch:          " << means.second);
+    }
+}
+
+void AsianOptionTest::testMLMCDiscreteArithmeticAveragePrice() {
+
+    BOOST_TEST_MESSAGE(
+           "Testing multilevel Monte Carlo discrete arithmetic "
+           "average-price Asians...");
+
+    // data from "Asian Option", Levy, 1997
+    // in "Exotic Options: The State of the Art",
+    // edited by Clewlow, Strickland
+    DiscreteAverageData cases[] = {
+        { Option::Put, 90.0, 87.0, 0.06, 0.025, 0.0, 11.0/12.0, 12,
+          0.13, false, 1.6980019214 },
+        { Option::Put, 90.0, 87.0, 0.06, 0.025, 1.0/12.0, 11.0/12.0, 12,
+          0.13, false, 2.1105094397 }
+    };
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.03));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.06));
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    Real tolerance = 0.02;
+
+    for (Size l=0; l<LENGTH(cases); l++) {
+
+        boost::shared_ptr<StrikedTypePayoff> payoff(new
+            PlainVanillaPayoff(cases[l].type, cases[l].strike));
+
+        Time dt = cases[l].length/(cases[l].fixings-1);
+        std::vector<Date> fixingDates(cases[l].fixings);
+        for (Size i=0; i<cases[l].fixings; i++) {
+            Time t = i*dt + cases[l].first;
+            fixingDates[i] = today + Integer(t*360+0.5);
+        }
+        boost::shared_ptr<Exercise> exercise(new
+            EuropeanExercise(fixingDates[cases[l].fixings-1]));
+
+        spot ->setValue(cases[l].underlying);
+        qRate->setValue(cases[l].dividendYield);
+        rRate->setValue(cases[l].riskFreeRate);
+        vol  ->setValue(cases[l].volatility);
+
+        boost::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+            BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+        DiscreteAveragingAsianOption option(Average::Arithmetic, 0.0, 0,
+                                            fixingDates, payoff, exercise);
+        option.setPricingEngine(
+            MakeMLMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+            .withAbsoluteTolerance(tolerance)
+            .withSeed(42));
+
+        // the evolution of the process is exact, so the finer levels
+        // only add corrections with null variance.
+        Real calculated = option.NPV();
+        Real expected = cases[l].result;
+        if (std::fabs(calculated-expected) > 3.0*tolerance) {
+            REPORT_FAILURE("value", Average::Arithmetic, 0.0, 0,
+                           fixingDates, payoff, exercise,
+                           spot->value(), qRate->value(), rRate->value(),
+                           today, vol->value(), expected, calculated,
+                           3.0*tolerance);
+        }
+    }
+
+    // with a time-dependent volatility and an Euler discretization
+    // forced on the process, the finer levels correct a bias and the
+    // variance of their corrections must decay with the step size.
+    std::vector<Date> volDates;
+    std::vector<Volatility> vols;
+    for (Size i=1; i<=6; ++i) {
+        volDates.push_back(today + Integer(60*i));
+        vols.push_back(0.10 + 0.06*i);
+    }
+    boost::shared_ptr<BlackVarianceCurve> varianceCurve(
+                      new BlackVarianceCurve(today, volDates, vols, dc));
+    varianceCurve->setInterpolation<Cubic>();
+    Handle<BlackVolTermStructure> volCurve(varianceCurve);
+
+    spot ->setValue(cases[0].underlying);
+    qRate->setValue(cases[0].dividendYield);
+    rRate->setValue(cases[0].riskFreeRate);
+
+    boost::shared_ptr<BlackScholesMertonProcess> exactProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  volCurve));
+    boost::shared_ptr<BlackScholesMertonProcess> eulerProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  volCurve,
+                                  boost::shared_ptr<StochasticProcess1D::
+                                      discretization>(new EulerDiscretization),
+                                  true));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(new
+        PlainVanillaPayoff(cases[0].type, cases[0].strike));
+    Time dt = cases[0].length/(cases[0].fixings-1);
+    std::vector<Date> fixingDates(cases[0].fixings);
+    for (Size i=0; i<cases[0].fixings; i++) {
+        Time t = i*dt + cases[0].first;
+        fixingDates[i] = today + Integer(t*360+0.5);
+    }
+    boost::shared_ptr<Exercise> exercise(new
+        EuropeanExercise(fixingDates[cases[0].fixings-1]));
+    DiscreteAveragingAsianOption option(Average::Arithmetic, 0.0, 0,
+                                        fixingDates, payoff, exercise);
+
+    Real referenceTolerance = 0.01;
+    option.setPricingEngine(
+        MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(exactProcess)
+        .withAbsoluteTolerance(referenceTolerance)
+        .withSeed(42));
+    Real expected = option.NPV();
+
+    boost::shared_ptr<PricingEngine> engine =
+        MakeMLMCDiscreteArithmeticAPEngine<PseudoRandom>(eulerProcess)
+        .withAbsoluteTolerance(tolerance)
+        .withSeed(42);
+    option.setPricingEngine(engine);
+    Real calculated = option.NPV();
+
+    Real valueTolerance =
+        3.0*std::sqrt(tolerance*tolerance
+                      + referenceTolerance*referenceTolerance);
+    if (std::fabs(calculated-expected) > valueTolerance) {
+        REPORT_FAILURE("value", Average::Arithmetic, 0.0, 0,
+                       fixingDates, payoff, exercise,
+                       spot->value(), qRate->value(), rRate->value(),
+                       today, vols.back(), expected, calculated,
+                       valueTolerance);
+    }
+
+    boost::shared_ptr<MLMCDiscreteArithmeticAPEngine<PseudoRandom> >
+        mlmcEngine = boost::dynamic_pointer_cast<
+            MLMCDiscreteArithmeticAPEngine<PseudoRandom> >(engine);
+    Size levels = mlmcEngine->levels();
+    if (!(mlmcEngine->levelAccumulator(1).variance() > 0.0))
+        BOOST_ERROR("null variance of the first correction; "
+                    "the finer levels are not refining the process");
+    for (Size l=1; l<levels; ++l) {
+        Real previous = mlmcEngine->levelAccumulator(l-1).variance();
+        Real current = mlmcEngine->levelAccumulator(l).variance();
+        if (!(current < previous))
+            BOOST_ERROR("variance not decaying at level " << l << ":"
+                        << std::scientific
+                        << "\n    level " << l-1 << ": " << previous
+                        << "\n    level " << l << ": " << current);
+    }
+}
+
 test_suite* AsianOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Asian option tests");
 
@@ -1465,6 +1763,12 @@ test_suite* AsianOptionTest::suite() {
         &AsianOptionTest::testPastFixings));
     suite->add(QUANTLIB_TEST_CASE(
         &AsianOptionTest::testAllFixingsInThePast));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AsianOptionTest::testMCWithWorkers));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AsianOptionTest::testMCBatchPricing));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AsianOptionTest::testMLMCDiscreteArithmeticAveragePrice));
 
     return suite;
 }
@@ -39,6 +39,9 @@ class AsianOptionTest {
     static void testAnalyticDiscreteGeometricAveragePriceGreeks();
     static void testPastFixings();
     static void testAllFixingsInThePast();
+    static void testMCWithWorkers();
+    static void testMCBatchPricing();
+    static void testMLMCDiscreteArithmeticAveragePrice();
     static void testLevyEngine();
     static void testVecerEngine();
     static boost::unit_test_framework::test_suite* suite();
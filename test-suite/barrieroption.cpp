@@ -35,6 +35,7 @@
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/barrier/mlmcbarrierengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/experimental/barrieroption/perturbativebarrieroptionengine.hpp>
 #include <ql/experimental/barrieroption/vannavolgabarrierengine.hpp>
@@ -1183,6 +1184,213 @@ void BarrierOptionTest::testDividendBarrierOption() {
     }
 }
 
+void BarrierOptionTest::testMCBatchPricing() {
+
+    BOOST_TEST_MESSAGE("Testing batch pricing of Monte Carlo barrier "
+                       "options...");
+
+    SavedSettings backup;
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        flatBlackScholesProcess(Settings::instance().evaluationDate(),
+                                100.0, 0.02, 0.05, 0.25, Actual360());
+
+    typedef MonteCarloModel<SingleVariate,PseudoRandom> model_type;
+    typedef model_type::path_pricer_type pricer_type;
+
+    const Size timeSteps = 20;
+    TimeGrid grid(1.0, timeSteps);
+    std::vector<DiscountFactor> discounts(timeSteps+1);
+    for (Size i=0; i<=timeSteps; ++i)
+        discounts[i] = std::exp(-0.05*grid[i]);
+
+    struct test_case {
+        Barrier::Type type;
+        Real barrier;
+    };
+    test_case cases[] = {
+        { Barrier::DownIn,  90.0 },
+        { Barrier::UpIn,   110.0 },
+        { Barrier::DownOut, 90.0 },
+        { Barrier::UpOut,  110.0 }
+    };
+
+    model_type::path_generator_type generator(
+                  stochProcess, grid,
+                  PseudoRandom::make_sequence_generator(timeSteps, 42),
+                  false);
+
+    for (Size i=0; i<LENGTH(cases); ++i) {
+        // the biased pricer is also checked with antithetic paths;
+        // the corrected one draws its own variates, which are paired
+        // differently with antithetic paths in batches.
+        for (Size k=0; k<3; ++k) {
+            bool biased = (k < 2);
+            bool antithetic = (k == 1);
+
+            // the corrected pricers keep the state of their generator,
+            // so each model needs its own
+            boost::shared_ptr<pricer_type> pricers[2];
+            for (Size j=0; j<2; ++j) {
+                if (biased)
+                    pricers[j] = boost::shared_ptr<pricer_type>(
+                        new BiasedBarrierPathPricer(cases[i].type,
+                                                    cases[i].barrier, 3.0,
+                                                    Option::Call, 100.0,
+                                                    discounts));
+                else
+                    pricers[j] = boost::shared_ptr<pricer_type>(
+                        new BarrierPathPricer(
+                               cases[i].type, cases[i].barrier, 3.0,
+                               Option::Call, 100.0, discounts, stochProcess,
+                               PseudoRandom::ursg_type(
+                                   timeSteps, PseudoRandom::urng_type(5))));
+            }
+
+            std::pair<Real, Real> means =
+                singleAndBatchMeans<model_type>(generator, pricers[0],
+                                                pricers[1], antithetic);
+            if (means.second != means.first)
+                BOOST_ERROR("batch result differs from path-by-path one"
+                            << "\n    barrier type: "
+                            << barrierTypeToString(cases[i].type)
+                            << "\n    biased:       " << biased
+                            << "\n    antithetic:   " << antithetic
+                            << std::setprecision(16)
+                            << "\n    path by path: " << means.first
+                            << "\n    batch:        " << means.second);
+        }
+    }
+}
+
+void BarrierOptionTest::testMCWithWorkers() {
+
+    BOOST_TEST_MESSAGE("Testing multi-worker Monte Carlo barrier options...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS =
+        flatVol(today, 0.25, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(Option::Call, 100.0));
+    boost::shared_ptr<Exercise> exercise(
+                                new EuropeanExercise(today + 360));
+
+    struct test_case {
+        Barrier::Type type;
+        Real barrier;
+    };
+    test_case cases[] = {
+        { Barrier::DownOut, 90.0 },
+        { Barrier::UpIn,   110.0 }
+    };
+
+    for (Size i=0; i<LENGTH(cases); ++i) {
+        BarrierOption option(cases[i].type, cases[i].barrier, 3.0,
+                             payoff, exercise);
+
+        // the unbiased pricers draw variates of their own, which
+        // must be moved forward for each worker as the paths are;
+        // a tolerance causes samples to be added more than once.
+        for (Size k=0; k<8; ++k) {
+            bool biased = (k % 2 == 1);
+            bool byTolerance = (k % 4 >= 2);
+            bool antithetic = (k >= 4);
+
+            std::vector<Real> values;
+            for (Size workers=1; workers<=4; workers+=3) {
+                MakeMCBarrierEngine<PseudoRandom> engine(stochProcess);
+                engine.withSteps(20)
+                      .withBias(biased)
+                      .withAntitheticVariate(antithetic)
+                      .withSeed(42)
+                      .withWorkers(workers);
+                if (byTolerance)
+                    engine.withAbsoluteTolerance(0.05);
+                else
+                    engine.withSamples(10001);
+                option.setPricingEngine(engine);
+                values.push_back(option.NPV());
+            }
+
+            if (values[1] != values[0])
+                BOOST_ERROR("multi-worker result differs from serial one"
+                            << "\n    barrier type: "
+                            << barrierTypeToString(cases[i].type)
+                            << "\n    biased:       " << biased
+                            << "\n    tolerance:    " << byTolerance
+                            << "\n    antithetic:   " << antithetic
+                            << std::setprecision(16)
+                            << "\n    serial:       " << values[0]
+                            << "\n    multi-worker: " << values[1]);
+        }
+    }
+}
+
+void BarrierOptionTest::testMLMCValues() {
+
+    BOOST_TEST_MESSAGE("Testing multilevel Monte Carlo barrier options "
+                       "against analytic values...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.04, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.08, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS =
+        flatVol(today, 0.25, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    Date exDate = today + 180;
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exDate));
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Call, 100.0));
+
+    BarrierOption option(Barrier::UpOut, 115.0, 3.0, payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                               new AnalyticBarrierEngine(stochProcess)));
+    Real expected = option.NPV();
+
+    Real tolerance = 0.05;
+    option.setPricingEngine(
+        MakeMLMCBarrierEngine<PseudoRandom>(stochProcess)
+        .withSteps(8)
+        .withAbsoluteTolerance(tolerance)
+        .withMaxLevels(12)
+        .withSeed(42));
+    Real calculated = option.NPV();
+
+    // the tolerance bounds the root-mean-square error, which
+    // includes the bias due to the discrete monitoring
+    if (std::fabs(calculated - expected) > 3.0*tolerance)
+        BOOST_ERROR("failed to reproduce analytic barrier value"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    tolerance:  " << tolerance);
+}
+
 test_suite* BarrierOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Barrier option tests");
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testHaugValues));
@@ -1192,6 +1400,9 @@ test_suite* BarrierOptionTest::suite() {
         &BarrierOptionTest::testLocalVolAndHestonComparison));
     suite->add(QUANTLIB_TEST_CASE(
         &BarrierOptionTest::testDividendBarrierOption));
+    suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testMCBatchPricing));
+    suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testMCWithWorkers));
+    suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testMLMCValues));
     return suite;
 }
 
@@ -35,6 +35,9 @@ class BarrierOptionTest {
     static void testVannaVolgaSimpleBarrierValues();
     static void testVannaVolgaDoubleBarrierValues();
     static void testDividendBarrierOption();
+    static void testMCBatchPricing();
+    static void testMCWithWorkers();
+    static void testMLMCValues();
 
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
@@ -32,6 +32,7 @@
 #include <ql/math/randomnumbers/stochasticcollocationinvcdf.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/functional.hpp>
+#include <ql/math/array.hpp>
 
 #if defined(__GNUC__) && !defined(__clang__) && BOOST_VERSION > 106300
 #pragma GCC diagnostic push
@@ -717,6 +718,64 @@ void DistributionTest::testInvCDFviaStochasticCollocation() {
     }
 }
 
+namespace {
+
+    template <class IC>
+    void checkRangeTransform(const IC& ic, const std::string& name) {
+
+        // values in the central region and in both tails, in a
+        // number which is not a multiple of the internal block size
+        const Size n = 1003;
+        Array x(n);
+        for (Size i=0; i<n; ++i)
+            x[i] = (i+0.5)/n;
+        x[10] = 1.0e-10;
+        x[n-10] = 1.0-1.0e-10;
+
+        std::vector<Real> y(n);
+        ic(x.begin(), x.end(), y.begin());
+
+        // in place
+        Array z = x;
+        ic(z.begin(), z.end(), z.begin());
+
+        for (Size i=0; i<n; ++i) {
+            Real expected = ic(x[i]);
+            if (y[i] != expected || z[i] != expected)
+                BOOST_FAIL("failed to reproduce single-value "
+                           << name << " on ranges:"
+                           << std::setprecision(16)
+                           << "\n    x:        " << x[i]
+                           << "\n    expected: " << expected
+                           << "\n    range:    " << y[i]
+                           << "\n    in place: " << z[i]);
+        }
+    }
+
+}
+
+void DistributionTest::testInverseCumulativeNormalRanges() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing inverse cumulative normal distributions on ranges...");
+
+    checkRangeTransform(InverseCumulativeNormal(),
+                        "inverse cumulative normal");
+    checkRangeTransform(InverseCumulativeNormal(average, sigma),
+                        "inverse cumulative normal");
+    checkRangeTransform(MoroInverseCumulativeNormal(),
+                        "Moro inverse cumulative normal");
+    checkRangeTransform(MoroInverseCumulativeNormal(average, sigma),
+                        "Moro inverse cumulative normal");
+
+    Array x(3, 0.5);
+    x[1] = 0.0;
+    std::vector<Real> y(3);
+    BOOST_CHECK_THROW(MoroInverseCumulativeNormal()(x.begin(), x.end(),
+                                                    y.begin()),
+                      Error);
+}
+
 test_suite* DistributionTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Distribution tests");
 
@@ -730,6 +789,8 @@ test_suite* DistributionTest::suite(SpeedLevel speed) {
                           &DistributionTest::testBivariateCumulativeStudent));
     suite->add(QUANTLIB_TEST_CASE(
                    &DistributionTest::testInvCDFviaStochasticCollocation));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &DistributionTest::testInverseCumulativeNormalRanges));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
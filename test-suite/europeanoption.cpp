@@ -27,6 +27,8 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
+#include <ql/methods/montecarlo/randomizedqmcmodel.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/binomialengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
@@ -1688,6 +1690,114 @@ void EuropeanOptionTest::testPDESchemes() {
 }
 
 
+void EuropeanOptionTest::testMcBatchPricing() {
+
+    BOOST_TEST_MESSAGE("Testing batch pricing of Monte Carlo European "
+                       "options...");
+
+    SavedSettings backup;
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        flatBlackScholesProcess(Settings::instance().evaluationDate(),
+                                100.0, 0.02, 0.05, 0.20, Actual360());
+
+    typedef MonteCarloModel<SingleVariate,PseudoRandom> model_type;
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    const Size timeSteps = 10;
+
+    for (Size i=0; i<LENGTH(types); ++i) {
+        boost::shared_ptr<model_type::path_pricer_type> pricer(
+                              new EuropeanPathPricer(types[i], 105.0, 0.95));
+        for (Size k=0; k<4; ++k) {
+            bool antithetic = (k % 2 == 1);
+            bool brownianBridge = (k >= 2);
+
+            model_type::path_generator_type generator(
+                    stochProcess, 1.0, timeSteps,
+                    PseudoRandom::make_sequence_generator(timeSteps, 42),
+                    brownianBridge);
+            std::pair<Real, Real> means =
+                singleAndBatchMeans<model_type>(generator, pricer, pricer,
+                                                antithetic);
+            if (means.second != means.first)
+                BOOST_ERROR("batch result differs from path-by-path one"
+                            << "\n    option type:     " << types[i]
+                            << "\n    antithetic:      " << antithetic
+                            << "\n    Brownian bridge: " << brownianBridge
+                            << std::setprecision(16)
+                            << "\n    path by path:    " << means.first
+                            << "\n    batch:           " << means.second);
+        }
+    }
+}
+
+void EuropeanOptionTest::testRandomizedQmc() {
+
+    BOOST_TEST_MESSAGE("Testing randomized quasi-Monte Carlo pricing "
+                       "of European options...");
+
+    SavedSettings backup;
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        flatBlackScholesProcess(Settings::instance().evaluationDate(),
+                                100.0, 0.02, 0.05, 0.20, Actual360());
+
+    typedef RandomizedQmcModel<SingleVariate,ScrambledLowDiscrepancy>
+                                                              qmc_model_type;
+    typedef MonteCarloModel<SingleVariate,PseudoRandom> mc_model_type;
+
+    Real strike = 105.0, discount = 0.95;
+    Size replications = 16, samples = 1023;
+    Real expected = blackFormula(Option::Call, strike,
+                                 100.0*std::exp(0.03), 0.20, discount);
+
+    std::vector<boost::shared_ptr<qmc_model_type::path_generator_type> >
+        generators;
+    std::vector<boost::shared_ptr<qmc_model_type::path_pricer_type> >
+        pricers;
+    for (Size i=0; i<replications; ++i) {
+        generators.push_back(
+            boost::shared_ptr<qmc_model_type::path_generator_type>(
+                new qmc_model_type::path_generator_type(
+                    stochProcess, 1.0, 1,
+                    ScrambledLowDiscrepancy::make_sequence_generator(1, i+1),
+                    false)));
+        pricers.push_back(
+            boost::shared_ptr<qmc_model_type::path_pricer_type>(
+                new EuropeanPathPricer(Option::Call, strike, discount)));
+    }
+    qmc_model_type qmcModel(generators, pricers);
+    qmcModel.addSamples(samples);
+
+    Real value = qmcModel.mean();
+    Real error = qmcModel.errorEstimate();
+    if (qmcModel.replicationAccumulator().samples() != replications ||
+        std::fabs(value-expected) > 3.0*error)
+        BOOST_ERROR("randomized QMC value out of confidence interval:"
+                    << "\n    replications:   "
+                    << qmcModel.replicationAccumulator().samples()
+                    << "\n    value:          " << value
+                    << "\n    error estimate: " << error
+                    << "\n    expected:       " << expected);
+
+    // the same number of pseudo-random samples gives a wider interval
+    mc_model_type mcModel(
+        boost::shared_ptr<mc_model_type::path_generator_type>(
+            new mc_model_type::path_generator_type(
+                stochProcess, 1.0, 1,
+                PseudoRandom::make_sequence_generator(1, 42), false)),
+        boost::shared_ptr<mc_model_type::path_pricer_type>(
+            new EuropeanPathPricer(Option::Call, strike, discount)),
+        Statistics(), false);
+    mcModel.addSamples(replications*samples);
+    Real mcError = mcModel.sampleAccumulator().errorEstimate();
+    if (error > mcError/10.0)
+        BOOST_ERROR("randomized QMC error estimate too large:"
+                    << "\n    randomized QMC: " << error
+                    << "\n    pseudo-random:  " << mcError);
+}
+
 test_suite* EuropeanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("European option tests");
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testValues));
@@ -1719,6 +1829,8 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
                        &EuropeanOptionTest::testAnalyticEngineDiscountCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPDESchemes));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcBatchPricing));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testRandomizedQmc));
 
     return suite;
 }
@@ -49,6 +49,8 @@ class EuropeanOptionTest {
     static void testLocalVolatility();
     static void testAnalyticEngineDiscountCurve();
     static void testPDESchemes();
+    static void testMcBatchPricing();
+    static void testRandomizedQmc();
 
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
@@ -31,6 +31,7 @@
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercache.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
 #include <ql/pricingengines/barrier/analyticbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
@@ -794,6 +795,114 @@ void FdHestonTest::testMethodOfLines() {
     }
 }
 
+void FdHestonTest::testMesherCache() {
+    BOOST_TEST_MESSAGE("Testing the reuse of cached Heston meshers...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(21, February, 2018);
+
+    Settings::instance().evaluationDate() = today;
+
+    const boost::shared_ptr<SimpleQuote> spot(
+        boost::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+
+    const boost::shared_ptr<HestonModel> model(
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                rTS, qTS, Handle<Quote>(spot),
+                0.04, 1.5, 0.04, 0.5, -0.7)));
+
+    const boost::shared_ptr<FdmMesherCache> cache(
+        boost::make_shared<FdmMesherCache>());
+
+    const boost::shared_ptr<PricingEngine> cachedEngine(
+        boost::make_shared<FdHestonVanillaEngine>(
+            model, 50, 51, 21, 0, FdmSchemeDesc::Hundsdorfer(),
+            boost::shared_ptr<LocalVolTermStructure>(), cache));
+    const boost::shared_ptr<PricingEngine> engine(
+        boost::make_shared<FdHestonVanillaEngine>(model, 50, 51, 21, 0));
+
+    const boost::shared_ptr<Exercise> exercise(
+        boost::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    const Real strikes[] = { 80.0, 100.0, 120.0 };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    for (Size i=0; i < LENGTH(strikes); ++i) {
+        for (Size j=0; j < LENGTH(types); ++j) {
+            VanillaOption option(
+                boost::make_shared<PlainVanillaPayoff>(types[j], strikes[i]),
+                exercise);
+
+            option.setPricingEngine(cachedEngine);
+            const Real calculated = option.NPV();
+            option.setPricingEngine(engine);
+            const Real expected = option.NPV();
+
+            if (calculated != expected)
+                BOOST_ERROR("cached meshers changed the option value"
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    type:       " << types[j]
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    // a variance mesher shared by all the strikes, and an equity
+    // mesher and its composite for each of them; the puts use the
+    // meshers built for the calls
+    if (cache->size() != 7 || cache->misses() != 7 || cache->hits() != 11)
+        BOOST_ERROR("unexpected use of the mesher cache"
+                    << "\n    size:   " << cache->size()
+                    << " (expected 7)"
+                    << "\n    misses: " << cache->misses()
+                    << " (expected 7)"
+                    << "\n    hits:   " << cache->hits()
+                    << " (expected 11)");
+
+    // a new spot requires new equity meshers, but not a new
+    // variance mesher; stale meshers must not be returned
+    spot->setValue(105.0);
+
+    BarrierOption barrierOption(
+        Barrier::DownIn, 90.0, 0.0,
+        boost::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        exercise);
+
+    barrierOption.setPricingEngine(
+        boost::make_shared<FdHestonBarrierEngine>(
+            model, 50, 51, 21, 0, FdmSchemeDesc::Hundsdorfer(),
+            boost::shared_ptr<LocalVolTermStructure>(), cache));
+    const Real calculated = barrierOption.NPV();
+
+    barrierOption.setPricingEngine(
+        boost::make_shared<FdHestonBarrierEngine>(model, 50, 51, 21, 0));
+    const Real expected = barrierOption.NPV();
+
+    if (calculated != expected)
+        BOOST_ERROR("cached meshers changed the barrier option value"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+
+    // the barrier and the vanilla knock-in engines share the
+    // variance mesher
+    if (cache->misses() != 11 || cache->hits() != 13)
+        BOOST_ERROR("unexpected use of the mesher cache"
+                    << "\n    misses: " << cache->misses()
+                    << " (expected 11)"
+                    << "\n    hits:   " << cache->hits()
+                    << " (expected 13)");
+
+    cache->clear();
+    if (cache->size() != 0)
+        BOOST_ERROR("meshers left in the cache after clearing it"
+                    << "\n    size: " << cache->size());
+}
+
 
 test_suite* FdHestonTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Finite Difference Heston tests");
@@ -808,6 +917,7 @@ test_suite* FdHestonTest::suite(SpeedLevel speed) {
         &FdHestonTest::testFdmHestonIntradayPricing));
     suite->add(QUANTLIB_TEST_CASE(
         &FdHestonTest::testMethodOfLines));
+    suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testMesherCache));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -39,6 +39,7 @@ public:
     static void testFdmHestonBlackScholes();
     static void testFdmHestonIntradayPricing();
     static void testMethodOfLines();
+    static void testMesherCache();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
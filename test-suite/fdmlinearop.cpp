@@ -45,6 +45,7 @@
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/meshers/uniformgridmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
@@ -62,6 +63,7 @@
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdm1dimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm3dimsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmamericanstepcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
@@ -70,6 +72,7 @@
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -999,7 +1002,7 @@ void FdmLinearOpTest::testFdmHestonExpress() {
 
     const FdmBoundaryConditionSet bcSet;
     const FdmSolverDesc solverDesc = { mesher, bcSet,
-                                       condition, calculator, 1.0, 50, 0 };
+                                       condition, calculator, 1.0, 50, 0, 0.0 };
     FdmHestonSolver solver(hestonProcess, solverDesc);
 
     const Real s = s0->value();
@@ -1110,7 +1113,7 @@ namespace {
 
         FdmSolverDesc desc = { mesher, boundaries,
                                conditions, calculator,
-                               maturity, tGrid, dampingSteps };
+                               maturity, tGrid, dampingSteps, 0.0 };
 
         return desc;
     }
@@ -1749,6 +1752,515 @@ void FdmLinearOpTest::testLowVolatilityHighDiscreteDividendBlackScholesMesher()
     }
 }
 
+void FdmLinearOpTest::testOutputParameterVariants() {
+
+    BOOST_TEST_MESSAGE("Testing output-parameter variants "
+                       "of linear operators...");
+
+    SavedSettings backup;
+
+    Size dims[] = {50, 20};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> index(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>( 3.8, std::log(220.0)));
+    boundaries.push_back(std::pair<Real, Real>( 0.000, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(index, boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+
+    FdmHestonOp op(mesher, hestonProcess);
+    op.setTime(0.5, 0.6);
+
+    Array r(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        r[iter.index()] = std::max(0.0,
+                          std::exp(mesher->location(iter, 0)) - 100.0)
+                          + mesher->location(iter, 1);
+    }
+
+    const Real s = 0.05;
+    std::vector<std::string> names;
+    std::vector<Array> expected, calculated;
+    Array out;
+
+    names.push_back("apply");
+    expected.push_back(op.apply(r));
+    op.apply(r, out);
+    calculated.push_back(out);
+
+    names.push_back("apply_mixed");
+    expected.push_back(op.apply_mixed(r));
+    op.apply_mixed(r, out);
+    calculated.push_back(out);
+
+    for (Size direction=0; direction<2; ++direction) {
+        names.push_back("apply_direction");
+        expected.push_back(op.apply_direction(direction, r));
+        op.apply_direction(direction, r, out);
+        calculated.push_back(out);
+
+        names.push_back("solve_splitting");
+        expected.push_back(op.solve_splitting(direction, r, s));
+        op.solve_splitting(direction, r, s, out);
+        calculated.push_back(out);
+    }
+
+    // tridiagonal solution in place of the right-hand side
+    const TripleBandLinearOp dxx(SecondDerivativeOp(0, mesher));
+    names.push_back("in-place solve_splitting");
+    expected.push_back(dxx.solve_splitting(r, 1.0, -s));
+    Array work, inPlace = r;
+    dxx.solve_splitting(inPlace, 1.0, -s, inPlace, work);
+    calculated.push_back(inPlace);
+
+    for (Size i=0; i<names.size(); ++i) {
+        BOOST_REQUIRE(calculated[i].size() == expected[i].size());
+        for (Size j=0; j<expected[i].size(); ++j) {
+            if (calculated[i][j] != expected[i][j])
+                BOOST_FAIL("output-parameter variant of " << names[i]
+                           << " differs at index " << j
+                           << "\n    calculated: " << calculated[i][j]
+                           << "\n    expected:   " << expected[i][j]);
+        }
+    }
+}
+
+void FdmLinearOpTest::testCsrMatrix() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing compressed-row sparse matrices...");
+
+    SavedSettings backup;
+
+    // assembly from unordered entries with duplicates
+    const Size rowIdx[] = { 2, 0, 3, 0, 2, 1, 3, 2 };
+    const Size colIdx[] = { 1, 3, 0, 0, 1, 2, 3, 0 };
+    const Real vals[]   = { 1.5, 2.0, -1.0, 4.0, 0.25, 3.0, 5.0, -2.0 };
+
+    const CsrMatrix c(4, 4,
+                      std::vector<Size>(rowIdx, rowIdx+LENGTH(rowIdx)),
+                      std::vector<Size>(colIdx, colIdx+LENGTH(colIdx)),
+                      std::vector<Real>(vals, vals+LENGTH(vals)));
+
+    Matrix expectedMatrix(4, 4, 0.0);
+    for (Size k=0; k < LENGTH(vals); ++k)
+        expectedMatrix[rowIdx[k]][colIdx[k]] += vals[k];
+
+    if (c.nonZeros() != 7)
+        BOOST_FAIL("unexpected number of stored elements"
+                   << "\n    calculated: " << c.nonZeros()
+                   << "\n    expected:   " << 7);
+    for (Size i=0; i < 4; ++i)
+        for (Size j=0; j < 4; ++j)
+            if (c(i, j) != expectedMatrix[i][j])
+                BOOST_FAIL("failed to assemble element ("
+                           << i << "," << j << ")"
+                           << "\n    calculated: " << c(i, j)
+                           << "\n    expected:   " << expectedMatrix[i][j]);
+
+    // products with Heston and Heston-Hull-White operators
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+    const Time maturity = Actual365Fixed().yearFraction(
+                                           today, Date(28, March, 2012));
+
+    const boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+
+    Size dims2[] = {101, 51, 1};
+    const std::vector<Size> dim2(dims2, dims2+LENGTH(dims2));
+    Size dims3[] = {51, 31, 31};
+    const std::vector<Size> dim3(dims3, dims3+LENGTH(dims3));
+
+    const boost::shared_ptr<FdmMesher> mesher2d =
+        createSolverDesc(dim2, jointProcess).mesher;
+    const boost::shared_ptr<FdmMesher> mesher3d =
+        createSolverDesc(dim3, jointProcess).mesher;
+
+    const boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    const boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    std::vector<boost::shared_ptr<FdmLinearOpComposite> > ops;
+    ops.push_back(boost::shared_ptr<FdmLinearOpComposite>(
+        new FdmHestonOp(mesher2d, jointProcess->hestonProcess())));
+    ops.push_back(boost::shared_ptr<FdmLinearOpComposite>(
+        new FdmHestonHullWhiteOp(mesher3d, jointProcess->hestonProcess(),
+                                 hwProcess, jointProcess->eta())));
+
+    MersenneTwisterUniformRng rng(1234);
+    for (Size l=0; l < ops.size(); ++l) {
+        ops[l]->setTime(0.5, 0.6);
+        const SparseMatrix a = ops[l]->toMatrix();
+        const CsrMatrix csr(a);
+
+        if (csr.nonZeros() != a.nnz())
+            BOOST_FAIL("unexpected number of stored elements"
+                       << "\n    calculated: " << csr.nonZeros()
+                       << "\n    expected:   " << a.nnz());
+
+        Array x(a.size2());
+        for (Size i=0; i < x.size(); ++i)
+            x[i] = rng.next().value;
+
+        // a few repeated products, which are timed by the benchmark
+        const Array expected = prod(a, x);
+        Array calculated;
+        for (Size k=0; k < 100; ++k)
+            csr.apply(x, calculated);
+        const Array roundTrip = prod(csr.toSparseMatrix(), x);
+
+        for (Size i=0; i < x.size(); ++i) {
+            if (calculated[i] != expected[i] || roundTrip[i] != expected[i])
+                BOOST_FAIL("failed to reproduce sparse matrix product"
+                           << "\n    operator:   " << l
+                           << "\n    row:        " << i
+                           << "\n    calculated: " << calculated[i]
+                           << "\n    round trip: " << roundTrip[i]
+                           << "\n    expected:   " << expected[i]);
+        }
+    }
+
+    // Krylov solvers on CSR matrices
+    const Size n=41, m=21;
+    const SparseMatrix b = createTestMatrix(n, m, 1.0);
+    Array rhs(n*m);
+    for (Size i=0; i < rhs.size(); ++i)
+        rhs[i] = rng.next().value;
+
+    const Real tol = 1e-10;
+    const boost::function<Disposable<Array>(const Array&)> matmult(
+        boost::bind(&axpy, b, _1));
+
+    const Array x1 = BiCGstab(matmult, n*m, tol).solve(rhs).x;
+    const boost::shared_ptr<CsrMatrix> csr(new CsrMatrix(b));
+    const Array x2 = BiCGstab(csr, n*m, tol).solve(rhs).x;
+    const Array x3 = GMRES(csr, 100, tol).solve(rhs).x;
+
+    const Real error2 = Norm2(x2-x1)/Norm2(x1);
+    const Real error3 = Norm2(x3-x1)/Norm2(x1);
+    if (error2 > 1e3*tol || error3 > 1e3*tol)
+        BOOST_FAIL("failed to solve linear system with CSR matrix"
+                   << "\n    BiCGstab error: " << error2
+                   << "\n    GMRES error:    " << error3);
+#endif
+}
+
+void FdmLinearOpTest::testTripleBandDirections() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing triple-band operators "
+                       "along each direction of a 3D grid...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+    const Time maturity = Actual365Fixed().yearFraction(
+                                           today, Date(28, March, 2012));
+
+    Size dims[] = {31, 23, 17};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+    const boost::shared_ptr<FdmMesher> mesher =
+        createSolverDesc(dim, createHestonHullWhite(maturity)).mesher;
+    const Size n = mesher->layout()->size();
+
+    MersenneTwisterUniformRng rng(1234);
+    Array r(n), u(n);
+    for (Size i=0; i < n; ++i) {
+        r[i] = rng.next().value - 0.5;
+        u[i] = 0.1 + rng.next().value;
+    }
+
+    const Real a = -0.05, b = 1.0;
+    for (Size direction=0; direction < dim.size(); ++direction) {
+        const TripleBandLinearOp op =
+            SecondDerivativeOp(direction, mesher).mult(u)
+            .add(FirstDerivativeOp(direction, mesher));
+
+        const Array expected = prod(op.toMatrix(), r);
+        const Array calculated = op.apply(r);
+        for (Size i=0; i < n; ++i) {
+            if (std::fabs(calculated[i] - expected[i])
+                    > 1e-14*(1.0 + std::fabs(expected[i])))
+                BOOST_FAIL("failed to apply triple-band operator"
+                           << "\n    direction:  " << direction
+                           << "\n    index:      " << i
+                           << "\n    calculated: " << calculated[i]
+                           << "\n    expected:   " << expected[i]);
+        }
+
+        const Array x = op.solve_splitting(r, a, b);
+        const Array residual = a*op.apply(x) + b*x - r;
+        const Real error = Norm2(residual)/Norm2(r);
+        if (error > 1e-10)
+            BOOST_FAIL("failed to solve triple-band system"
+                       << "\n    direction: " << direction
+                       << "\n    residual:  " << error);
+
+        Array work, inPlace = r;
+        op.solve_splitting(inPlace, a, b, inPlace, work);
+        for (Size i=0; i < n; ++i) {
+            if (inPlace[i] != x[i])
+                BOOST_FAIL("in-place solution differs"
+                           << "\n    direction:  " << direction
+                           << "\n    index:      " << i
+                           << "\n    calculated: " << inPlace[i]
+                           << "\n    expected:   " << x[i]);
+        }
+    }
+#endif
+}
+
+namespace {
+
+    // the steps of the ADI schemes written with array expressions
+    enum AdiScheme { Douglas, CraigSneyd, ModifiedCraigSneyd, Hundsdorfer };
+
+    Disposable<Array> adiReferenceStep(AdiScheme scheme,
+                                       FdmLinearOpComposite& map,
+                                       const Array& a, Time t, Time dt,
+                                       Real theta, Real mu) {
+        map.setTime(std::max(0.0, t-dt), t);
+
+        Array y = a + dt*map.apply(a);
+        const Array y0 = y;
+        for (Size i=0; i < map.size(); ++i) {
+            Array rhs = y - theta*dt*map.apply_direction(i, a);
+            y = map.solve_splitting(i, rhs, -theta*dt);
+        }
+        if (scheme == Douglas)
+            return y;
+
+        Array yt;
+        if (scheme == CraigSneyd)
+            yt = y0 + mu*dt*map.apply_mixed(y-a);
+        else if (scheme == ModifiedCraigSneyd)
+            yt =  y0 + mu*dt*map.apply_mixed(y-a)
+                + (0.5-mu)*dt*map.apply(y-a);
+        else
+            yt = y0 + mu*dt*map.apply(y-a);
+
+        const Array& v = (scheme == Hundsdorfer) ? y : a;
+        for (Size i=0; i < map.size(); ++i) {
+            Array rhs = yt - theta*dt*map.apply_direction(i, v);
+            yt = map.solve_splitting(i, rhs, -theta*dt);
+        }
+        return yt;
+    }
+
+    template <class Scheme>
+    void checkAdiScheme(Scheme& scheme, AdiScheme type,
+                        FdmLinearOpComposite& map,
+                        const Array& initial, Time maturity, Time dt,
+                        Real theta, Real mu) {
+        const std::string names[] = { "Douglas", "Craig-Sneyd",
+                                      "modified Craig-Sneyd", "Hundsdorfer" };
+        scheme.setStep(dt);
+
+        Array calculated = initial, expected = initial;
+        Time t = maturity;
+        for (Size i=0; i < 5; ++i, t-=dt) {
+            scheme.step(calculated, t);
+            expected = adiReferenceStep(type, map, expected, t, dt, theta, mu);
+
+            for (Size j=0; j < expected.size(); ++j) {
+                if (calculated[j] != expected[j])
+                    BOOST_FAIL("failed to reproduce " << names[type]
+                               << " step"
+                               << "\n    step:       " << i
+                               << "\n    index:      " << j
+                               << "\n    calculated: " << calculated[j]
+                               << "\n    expected:   " << expected[j]);
+            }
+        }
+    }
+}
+
+void FdmLinearOpTest::testAdiSchemesWithWorkArrays() {
+    BOOST_TEST_MESSAGE("Testing ADI schemes with reused work arrays...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+    const Time maturity = Actual365Fixed().yearFraction(
+                                           today, Date(28, March, 2012));
+
+    Size dims[] = {21, 11, 9};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+    const boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    const FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    const boost::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    const boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    const boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+    const boost::shared_ptr<FdmLinearOpComposite> op(
+        new FdmHestonHullWhiteOp(mesher, jointProcess->hestonProcess(),
+                                 hwProcess, jointProcess->eta()));
+
+    Array initial(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        initial[iter.index()] =
+            desc.calculator->avgInnerValue(iter, maturity);
+    }
+
+    const Real theta = 0.5+std::sqrt(3.0)/6.0, mu = 1.0/3.0;
+    const Time dt = maturity/50;
+    DouglasScheme douglas(theta, op);
+    checkAdiScheme(douglas, Douglas, *op, initial, maturity, dt, theta, mu);
+    CraigSneydScheme craigSneyd(theta, mu, op);
+    checkAdiScheme(craigSneyd, CraigSneyd,
+                   *op, initial, maturity, dt, theta, mu);
+    ModifiedCraigSneydScheme modifiedCraigSneyd(theta, mu, op);
+    checkAdiScheme(modifiedCraigSneyd, ModifiedCraigSneyd,
+                   *op, initial, maturity, dt, theta, mu);
+    HundsdorferScheme hundsdorfer(theta, mu, op);
+    checkAdiScheme(hundsdorfer, Hundsdorfer,
+                   *op, initial, maturity, dt, theta, mu);
+}
+
+void FdmLinearOpTest::testAdaptiveTimeStepping() {
+    BOOST_TEST_MESSAGE("Testing adaptive time stepping "
+                       "in the backward solver...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(28, March, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<BlackScholesMertonProcess> process(new
+        BlackScholesMertonProcess(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.3, dc))));
+
+    const Time maturity = 1.0;
+    const Real strike = 100.0;
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Put, strike));
+
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(boost::shared_ptr<Fdm1dMesher>(
+            new FdmBlackScholesMesher(
+                200, process, maturity, strike,
+                Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                std::pair<Real, Real>(strike, 0.1)))));
+    const boost::shared_ptr<FdmLinearOpComposite> op(
+        new FdmBlackScholesOp(mesher, process, strike));
+    const boost::shared_ptr<FdmInnerValueCalculator> calculator(
+        new FdmLogInnerValue(payoff, mesher, 0));
+
+    // American exercise, with two stopping times which
+    // the adaptive steps must not cross
+    std::vector<Time> stoppingTimes;
+    stoppingTimes.push_back(0.25);
+    stoppingTimes.push_back(0.7);
+    const boost::shared_ptr<FdmStepConditionComposite> conditions(
+        new FdmStepConditionComposite(
+            std::list<std::vector<Time> >(1, stoppingTimes),
+            FdmStepConditionComposite::Conditions(1,
+                boost::shared_ptr<StepCondition<Array> >(
+                    new FdmAmericanStepCondition(mesher, calculator)))));
+
+    Array initial(mesher->layout()->size()), x(initial.size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        initial[iter.index()] = calculator->avgInnerValue(iter, maturity);
+        x[iter.index()] = mesher->location(iter, 0);
+    }
+
+    const Real xSpot = std::log(spot->value());
+    const FdmSchemeDesc schemes[] = { FdmSchemeDesc::Douglas(),
+                                      FdmSchemeDesc::Hundsdorfer(),
+                                      FdmSchemeDesc::ImplicitEuler() };
+    const Size fixedSteps[] = { 2000, 2000, 20000 };
+    const Real tolerance = 1e-5;
+
+    for (Size i=0; i < LENGTH(schemes); ++i) {
+        FdmBackwardSolver solver(op, FdmBoundaryConditionSet(),
+                                 conditions, schemes[i]);
+
+        Array expected = initial;
+        solver.rollback(expected, maturity, 0.0, fixedSteps[i], 2);
+        const Real expectedNPV = MonotonicCubicNaturalSpline(
+            x.begin(), x.end(), expected.begin())(xSpot);
+
+        Array calculated = initial;
+        const Size steps = solver.adaptiveRollback(
+            calculated, maturity, 0.0, 50, 2, tolerance);
+        const Real calculatedNPV = MonotonicCubicNaturalSpline(
+            x.begin(), x.end(), calculated.begin())(xSpot);
+
+        const Real tol = 5e-3;
+        if (std::fabs(calculatedNPV - expectedNPV) > tol
+            || steps >= fixedSteps[i]/10) {
+            BOOST_FAIL("failed to reproduce the fixed-step rollback"
+                       << "\n   scheme:     " << schemes[i].type
+                       << std::fixed << std::setprecision(6)
+                       << "\n   calculated: " << calculatedNPV
+                       << "\n   expected:   " << expectedNPV
+                       << "\n   tolerance:  " << tol
+                       << "\n   steps:      " << steps
+                       << "\n   fixed steps:" << fixedSteps[i]);
+        }
+    }
+
+    // the solvers roll back adaptively when the solver
+    // description sets a tolerance
+    FdmBackwardSolver fixedSolver(op, FdmBoundaryConditionSet(),
+                                  conditions, FdmSchemeDesc::Douglas());
+    Array fixed = initial;
+    fixedSolver.rollback(fixed, maturity, 0.0, fixedSteps[0], 2);
+    const Real expectedNPV = MonotonicCubicNaturalSpline(
+        x.begin(), x.end(), fixed.begin())(xSpot);
+
+    const FdmSolverDesc solverDesc = { mesher, FdmBoundaryConditionSet(),
+                                       conditions, calculator, maturity,
+                                       50, 2, tolerance };
+    Fdm1DimSolver solver(solverDesc, FdmSchemeDesc::Douglas(), op);
+    const Real calculatedNPV = solver.interpolateAt(xSpot);
+    const Size steps = solver.timeStepsTaken();
+
+    const Real tol = 5e-3;
+    if (std::fabs(calculatedNPV - expectedNPV) > tol
+        || steps == 0 || steps >= fixedSteps[0]/10) {
+        BOOST_FAIL("failed to reproduce the fixed-step rollback "
+                   "through the solver"
+                   << std::fixed << std::setprecision(6)
+                   << "\n   calculated: " << calculatedNPV
+                   << "\n   expected:   " << expectedNPV
+                   << "\n   tolerance:  " << tol
+                   << "\n   steps:      " << steps
+                   << "\n   fixed steps:" << fixedSteps[0]);
+    }
+}
+
 test_suite* FdmLinearOpTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("linear operator tests");
 
@@ -1783,6 +2295,15 @@ test_suite* FdmLinearOpTest::suite() {
         &FdmLinearOpTest::testHighInterestRateBlackScholesMesher));
     suite->add(QUANTLIB_TEST_CASE(
         &FdmLinearOpTest::testLowVolatilityHighDiscreteDividendBlackScholesMesher));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testOutputParameterVariants));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCsrMatrix));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandDirections));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAdiSchemesWithWorkArrays));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAdaptiveTimeStepping));
 
     return suite;
 }
@@ -48,6 +48,11 @@ public:
     static void testFdmMesherIntegral();
     static void testHighInterestRateBlackScholesMesher();
     static void testLowVolatilityHighDiscreteDividendBlackScholesMesher();
+    static void testOutputParameterVariants();
+    static void testCsrMatrix();
+    static void testTripleBandDirections();
+    static void testAdiSchemesWithWorkArrays();
+    static void testAdaptiveTimeStepping();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -40,6 +40,7 @@
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/pricingengines/vanilla/mlmceuropeanhestonengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
@@ -714,6 +715,72 @@ namespace {
     };
 }
 
+void HestonModelTest::testMLMCVsAnalytic() {
+    BOOST_TEST_MESSAGE(
+        "Testing multilevel Monte Carlo Heston engine against analytic "
+        "values...");
+
+    SavedSettings backup;
+
+    Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    DayCounter dayCounter = ActualActual();
+    Date exerciseDate(28, March, 2005);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+        boost::make_shared<PlainVanillaPayoff>(Option::Put, 1.05));
+    boost::shared_ptr<Exercise> exercise(
+        boost::make_shared<EuropeanExercise>(exerciseDate));
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.7, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.4, dayCounter));
+
+    Handle<Quote> s0(boost::make_shared<SimpleQuote>(1.05));
+
+    VanillaOption option(payoff, exercise);
+
+    // the bias of the truncation schemes is sizable on coarse grids
+    const HestonProcess::Discretization schemes[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation
+    };
+    const std::string names[] = {
+        "PartialTruncation",
+        "FullTruncation"
+    };
+
+    const Real tolerance = 2.0e-3;
+
+    for (Size i=0; i < LENGTH(schemes); ++i) {
+        boost::shared_ptr<HestonProcess> process(
+            boost::make_shared<HestonProcess>(
+                   riskFreeTS, dividendTS, s0, 0.3, 1.16, 0.2, 0.8, 0.8,
+                   schemes[i]));
+
+        option.setPricingEngine(boost::make_shared<AnalyticHestonEngine>(
+                             boost::make_shared<HestonModel>(process), 96));
+        const Real expected = option.NPV();
+
+        option.setPricingEngine(
+            MakeMLMCEuropeanHestonEngine<PseudoRandom>(process)
+            .withSteps(2)
+            .withAbsoluteTolerance(tolerance)
+            .withSeed(1234));
+        const Real calculated = option.NPV();
+
+        // the tolerance bounds the root-mean-square error, which
+        // includes the discretization bias
+        if (std::fabs(calculated - expected) > 3.0*tolerance) {
+            BOOST_ERROR("Failed to reproduce analytic price"
+                        << "\n    discretization: " << names[i]
+                        << "\n    calculated:     " << calculated
+                        << "\n    expected:       " << expected
+                        << "\n    tolerance:      " << tolerance);
+        }
+    }
+}
+
 void HestonModelTest::testKahlJaeckelCase() {
     BOOST_TEST_MESSAGE(
           "Testing MC and FD Heston engines for the Kahl-Jaeckel example...");
@@ -2682,6 +2749,7 @@ test_suite* HestonModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFdVanillaVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultipleStrikesEngine));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMcVsCached));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMLMCVsAnalytic));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testAnalyticPiecewiseTimeDependent));
     suite->add(QUANTLIB_TEST_CASE(
@@ -34,6 +34,7 @@ class HestonModelTest {
     static void testAnalyticVsCached();
     static void testKahlJaeckelCase();
     static void testMcVsCached();
+    static void testMLMCVsAnalytic();
     static void testFdBarrierVsCached();    
     static void testFdVanillaVsCached();    
     static void testDifferentIntegrals();
@@ -83,6 +83,8 @@
 #include <ql/experimental/finitedifferences/localvolrndcalculator.hpp>
 #include <ql/experimental/finitedifferences/squarerootprocessrndcalculator.hpp>
 #include <ql/experimental/finitedifferences/fdhestondoublebarrierengine.hpp>
+#include <ql/experimental/finitedifferences/fdhestonfwdchainengine.hpp>
+#include <ql/experimental/finitedifferences/fdblackscholesfwdchainengine.hpp>
 #include <ql/experimental/exoticoptions/analyticpdfhestonengine.hpp>
 #include <ql/experimental/processes/hestonslvprocess.hpp>
 #include <ql/experimental/barrieroption/doublebarrieroption.hpp>
@@ -2484,6 +2486,193 @@ void HestonSLVModelTest::testMoustacheGraph() {
 }
 
 
+void HestonSLVModelTest::testBlackScholesFwdChainEngine() {
+    BOOST_TEST_MESSAGE("Testing forward-equation engine "
+                       "for Black-Scholes option chains...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate(5, July, 2014);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Handle<Quote> spot(boost::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(todaysDate, 0.035, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(todaysDate, 0.01, dc));
+
+    const Period periods[] = { Period(3, Months), Period(6, Months),
+                               Period(1, Years), Period(2, Years) };
+    const Real strikes[] = { 60, 80, 90, 100, 110, 120, 150 };
+
+    std::vector<Date> maturities;
+    for (Size i=0; i < LENGTH(periods); ++i)
+        maturities.push_back(todaysDate + periods[i]);
+
+    // constant volatility: values and Greeks against the analytic ones
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        boost::make_shared<BlackScholesMertonProcess>(
+            spot, qTS, rTS,
+            Handle<BlackVolTermStructure>(flatVol(todaysDate, 0.25, dc))));
+
+    const boost::shared_ptr<FdBlackScholesFwdChainEngine> chainEngine(
+        boost::make_shared<FdBlackScholesFwdChainEngine>(
+            process, maturities, 400, 401, 2,
+            FdmSchemeDesc::Douglas(), false));
+    const boost::shared_ptr<PricingEngine> analyticEngine(
+        boost::make_shared<AnalyticEuropeanEngine>(process));
+
+    for (Size i=0; i < maturities.size(); ++i) {
+        const boost::shared_ptr<Exercise> exercise(
+            boost::make_shared<EuropeanExercise>(maturities[i]));
+
+        for (Size j=0; j < LENGTH(strikes); ++j) {
+            const Option::Type type =
+                (strikes[j] < 100.0) ? Option::Put : Option::Call;
+            VanillaOption option(
+                boost::make_shared<PlainVanillaPayoff>(type, strikes[j]),
+                exercise);
+
+            option.setPricingEngine(analyticEngine);
+            const Real expectedNPV = option.NPV();
+            const Real expectedDelta = option.delta();
+            const Real expectedGamma = option.gamma();
+            const Real expectedStrikeSensitivity =
+                option.strikeSensitivity();
+
+            option.setPricingEngine(chainEngine);
+
+            if (std::fabs(option.NPV() - expectedNPV) > 5e-3
+                || std::fabs(option.delta() - expectedDelta) > 5e-4
+                || std::fabs(option.gamma() - expectedGamma) > 5e-5
+                || std::fabs(option.strikeSensitivity()
+                             - expectedStrikeSensitivity) > 5e-4)
+                BOOST_FAIL("failed to reproduce Black-Scholes option"
+                           << "\n   maturity:     " << maturities[i]
+                           << "\n   strike:       " << strikes[j]
+                           << std::fixed << std::setprecision(6)
+                           << "\n   npv:          " << option.NPV()
+                           << "\n   expected:     " << expectedNPV
+                           << "\n   delta:        " << option.delta()
+                           << "\n   expected:     " << expectedDelta
+                           << "\n   gamma:        " << option.gamma()
+                           << "\n   expected:     " << expectedGamma
+                           << "\n   strike sens.: "
+                           << option.strikeSensitivity()
+                           << "\n   expected:     "
+                           << expectedStrikeSensitivity);
+        }
+    }
+
+    // all prices came from the densities of a single forward solve
+    BOOST_CHECK_EQUAL(chainEngine->maturities().size(), maturities.size());
+
+    // local volatility: values against the analytic ones
+    // with the implied volatility surface, which ends before two years
+    const std::vector<Date> lvMaturities(
+        maturities.begin(), maturities.end()-1);
+    const Handle<BlackVolTermStructure> smileTS(
+        createSmoothImpliedVol(dc, TARGET()).get<2>());
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> lvProcess(
+        boost::make_shared<BlackScholesMertonProcess>(
+            spot, qTS, rTS, smileTS));
+
+    const boost::shared_ptr<PricingEngine> lvChainEngine(
+        boost::make_shared<FdBlackScholesFwdChainEngine>(
+            lvProcess, lvMaturities, 200, 201, 2,
+            FdmSchemeDesc::Douglas(), true, 0.2));
+    const boost::shared_ptr<PricingEngine> smileEngine(
+        boost::make_shared<AnalyticEuropeanEngine>(lvProcess));
+
+    for (Size i=0; i < lvMaturities.size(); ++i) {
+        const boost::shared_ptr<Exercise> exercise(
+            boost::make_shared<EuropeanExercise>(lvMaturities[i]));
+
+        for (Size j=0; j < LENGTH(strikes); ++j) {
+            const Option::Type type =
+                (strikes[j] < 100.0) ? Option::Put : Option::Call;
+            VanillaOption option(
+                boost::make_shared<PlainVanillaPayoff>(type, strikes[j]),
+                exercise);
+
+            option.setPricingEngine(smileEngine);
+            const Real expected = option.NPV();
+            option.setPricingEngine(lvChainEngine);
+            const Real calculated = option.NPV();
+
+            const Real tol = 0.05;
+            if (std::fabs(calculated - expected) > tol)
+                BOOST_FAIL("failed to reproduce local volatility price"
+                           << "\n   maturity:   " << lvMaturities[i]
+                           << "\n   strike:     " << strikes[j]
+                           << std::fixed << std::setprecision(6)
+                           << "\n   calculated: " << calculated
+                           << "\n   expected:   " << expected
+                           << "\n   tolerance:  " << tol);
+        }
+    }
+}
+
+void HestonSLVModelTest::testHestonFwdChainEngine() {
+    BOOST_TEST_MESSAGE("Testing forward-equation engine "
+                       "for Heston option chains...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate(28, Dec, 2014);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Handle<Quote> spot(boost::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(todaysDate, 0.02, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(todaysDate, 0.01, dc));
+
+    const boost::shared_ptr<HestonModel> model(
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                rTS, qTS, spot, 0.04, 1.0, 0.06, 0.3, -0.75)));
+
+    const Period periods[] = { Period(3, Months), Period(1, Years),
+                               Period(2, Years) };
+    const Real strikes[] = { 60, 80, 90, 100, 110, 120, 150 };
+
+    std::vector<Date> maturities;
+    for (Size i=0; i < LENGTH(periods); ++i)
+        maturities.push_back(todaysDate + periods[i]);
+
+    const boost::shared_ptr<PricingEngine> chainEngine(
+        boost::make_shared<FdHestonFwdChainEngine>(model, maturities));
+    const boost::shared_ptr<PricingEngine> analyticEngine(
+        boost::make_shared<AnalyticHestonEngine>(model));
+
+    for (Size i=0; i < maturities.size(); ++i) {
+        const boost::shared_ptr<Exercise> exercise(
+            boost::make_shared<EuropeanExercise>(maturities[i]));
+
+        for (Size j=0; j < LENGTH(strikes); ++j) {
+            const Option::Type type =
+                (strikes[j] < 100.0) ? Option::Put : Option::Call;
+            VanillaOption option(
+                boost::make_shared<PlainVanillaPayoff>(type, strikes[j]),
+                exercise);
+
+            option.setPricingEngine(analyticEngine);
+            const Real expected = option.NPV();
+            option.setPricingEngine(chainEngine);
+            const Real calculated = option.NPV();
+
+            const Real tol = 0.02;
+            if (std::fabs(calculated - expected) > tol)
+                BOOST_FAIL("failed to reproduce Heston price"
+                           << "\n   maturity:   " << maturities[i]
+                           << "\n   strike:     " << strikes[j]
+                           << std::fixed << std::setprecision(6)
+                           << "\n   calculated: " << calculated
+                           << "\n   expected:   " << expected
+                           << "\n   tolerance:  " << tol);
+        }
+    }
+}
+
 test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE(
         "Heston Stochastic Local Volatility tests");
@@ -2506,6 +2695,10 @@ test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
         &HestonSLVModelTest::testMonteCarloVsFdmPricing));
     suite->add(QUANTLIB_TEST_CASE(
         &HestonSLVModelTest::testLocalVolsvSLVPropDensity));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonSLVModelTest::testBlackScholesFwdChainEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonSLVModelTest::testHestonFwdChainEngine));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -22,8 +22,13 @@
 #include <ql/instruments/stock.hpp>
 #include <ql/instruments/compositeinstrument.hpp>
 #include <ql/instruments/europeanoption.hpp>
+#include <ql/instruments/portfoliovaluation.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 
 using namespace QuantLib;
@@ -114,11 +119,147 @@ void InstrumentTest::testCompositeWhenShiftingDates() {
         BOOST_FAIL("Composite didn't recalculate");
 }
 
+
+namespace {
+
+    std::vector<shared_ptr<Instrument> > makeOptions(
+                 const shared_ptr<GeneralizedBlackScholesProcess>& process,
+                 const Date& maturity, Size n) {
+        shared_ptr<Exercise> exercise(new EuropeanExercise(maturity));
+        std::vector<shared_ptr<Instrument> > options(n);
+        for (Size i=0; i<n; ++i) {
+            shared_ptr<StrikedTypePayoff> payoff(
+                new PlainVanillaPayoff(i % 2 == 0 ? Option::Call
+                                                  : Option::Put,
+                                       80.0 + i));
+            options[i] = shared_ptr<Instrument>(
+                                        new EuropeanOption(payoff, exercise));
+            // each instrument has its own engine
+            options[i]->setPricingEngine(shared_ptr<PricingEngine>(
+                                         new AnalyticEuropeanEngine(process)));
+        }
+        return options;
+    }
+
+}
+
+void InstrumentTest::testPortfolioValuation() {
+
+    BOOST_TEST_MESSAGE("Testing parallel valuation of a portfolio...");
+
+    SavedSettings backup;
+
+    Date today(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual360();
+
+    // a bootstrapped curve is a lazy object shared by all options
+    std::vector<shared_ptr<RateHelper> > helpers;
+    Rate rates[] = { 0.010, 0.012, 0.015, 0.017 };
+    Integer months[] = { 1, 3, 6, 12 };
+    for (Size i=0; i<LENGTH(rates); ++i)
+        helpers.push_back(shared_ptr<RateHelper>(
+            new DepositRateHelper(rates[i], months[i]*Months, 2, TARGET(),
+                                  ModifiedFollowing, false, dc)));
+    shared_ptr<YieldTermStructure> rTS(
+        new PiecewiseYieldCurve<Discount,LogLinear>(0, TARGET(),
+                                                    helpers, dc));
+    shared_ptr<YieldTermStructure> qTS = flatRate(0.005, dc);
+    shared_ptr<BlackVolTermStructure> volTS = flatVol(0.2, dc);
+
+    Handle<Quote> spot(shared_ptr<Quote>(new SimpleQuote(100.0)));
+    shared_ptr<GeneralizedBlackScholesProcess> process(
+        new BlackScholesMertonProcess(
+                           spot,
+                           Handle<YieldTermStructure>(qTS),
+                           Handle<YieldTermStructure>(rTS),
+                           Handle<BlackVolTermStructure>(volTS)));
+    shared_ptr<GeneralizedBlackScholesProcess> invalidProcess(
+        new BlackScholesMertonProcess(
+                           spot,
+                           Handle<YieldTermStructure>(qTS),
+                           Handle<YieldTermStructure>(rTS),
+                           Handle<BlackVolTermStructure>()));
+
+    Date maturity = today + 9*Months;
+    Size n = 40, failing = 17;
+
+    std::vector<shared_ptr<Instrument> > reference =
+        makeOptions(process, maturity, n);
+    std::vector<shared_ptr<Instrument> > portfolio =
+        makeOptions(process, maturity, n);
+    portfolio[failing]->setPricingEngine(shared_ptr<PricingEngine>(
+                                  new AnalyticEuropeanEngine(invalidProcess)));
+
+    std::vector<shared_ptr<Observable> > dependencies;
+    dependencies.push_back(rTS);
+    dependencies.push_back(qTS);
+    dependencies.push_back(volTS);
+
+    Flag flag;
+    flag.registerWith(portfolio[0]);
+
+    PortfolioValuation valuation(portfolio, dependencies);
+    valuation.calculate();
+
+    // unfreezing the unchanged dependencies doesn't discard the NPVs
+    if (flag.isUp())
+        BOOST_ERROR("instrument notified at the end of the valuation");
+
+    Real expectedTotal = 0.0;
+    for (Size i=0; i<n; ++i) {
+        const PortfolioValuation::Result& result = valuation.result(i);
+        if (result.time < 0.0)
+            BOOST_ERROR("negative valuation time for instrument " << i);
+        if (i == failing) {
+            if (result.error.empty() || result.NPV != Null<Real>())
+                BOOST_ERROR("failure of instrument " << i
+                            << " not reported");
+            continue;
+        }
+        Real expected = reference[i]->NPV();
+        expectedTotal += expected;
+        if (!result.error.empty())
+            BOOST_ERROR("instrument " << i << " failed: " << result.error);
+        else if (result.NPV != expected)
+            BOOST_ERROR("wrong NPV for instrument " << i << ":"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << result.NPV
+                        << "\n    expected:   " << expected);
+    }
+
+    if (valuation.failures() != 1)
+        BOOST_ERROR(valuation.failures() << " failures reported "
+                    "(1 expected)");
+    if (std::fabs(valuation.NPV() - expectedTotal) > 1.0e-8)
+        BOOST_ERROR("wrong portfolio NPV:"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << valuation.NPV()
+                    << "\n    expected:   " << expectedTotal);
+
+    // the shared curve must be unfrozen after the valuation...
+    shared_ptr<LazyObject> curve = boost::dynamic_pointer_cast<LazyObject>(rTS);
+    if (curve->isFrozen())
+        BOOST_ERROR("shared curve still frozen after valuation");
+
+    // ...unless it was frozen by the user
+    curve->freeze();
+    valuation.calculate();
+    if (!curve->isFrozen())
+        BOOST_ERROR("curve frozen by the user unfrozen by valuation");
+    curve->unfreeze();
+
+    Settings::instance().evaluationDate() = today + 1;
+    if (portfolio[0]->NPV() == valuation.result(0).NPV)
+        BOOST_ERROR("instrument not recalculated after valuation");
+}
+
 test_suite* InstrumentTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Instrument tests");
     suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testObservable));
     suite->add(QUANTLIB_TEST_CASE(
                             &InstrumentTest::testCompositeWhenShiftingDates));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testPortfolioValuation));
     return suite;
 }
 
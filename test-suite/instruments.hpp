@@ -30,6 +30,7 @@ class InstrumentTest {
   public:
     static void testObservable();
     static void testCompositeWhenShiftingDates();
+    static void testPortfolioValuation();
     static boost::unit_test_framework::test_suite* suite();
 };
 
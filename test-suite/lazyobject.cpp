@@ -20,7 +20,11 @@
 #include "lazyobject.hpp"
 #include "utilities.hpp"
 #include <ql/instruments/stock.hpp>
+#include <ql/instruments/compositeinstrument.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/utilities/calculationprofiler.hpp>
+#include <sstream>
+#include <algorithm>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -80,12 +84,122 @@ void LazyObjectTest::testForwardingNotifications() {
 }
 
 
+namespace {
+
+    class ProfilerCleaner {
+      public:
+        ~ProfilerCleaner() {
+            CalculationProfiler::instance().disable();
+            CalculationProfiler::instance().reset();
+        }
+    };
+
+}
+
+void LazyObjectTest::testCalculationProfiling() {
+
+    BOOST_TEST_MESSAGE("Testing profiling of lazy-object calculations...");
+
+    ProfilerCleaner cleaner;
+    CalculationProfiler& profiler = CalculationProfiler::instance();
+    profiler.reset();
+
+    boost::shared_ptr<SimpleQuote> q1(new SimpleQuote(1.0));
+    boost::shared_ptr<SimpleQuote> q2(new SimpleQuote(2.0));
+    boost::shared_ptr<Instrument> s1(new Stock(Handle<Quote>(q1)));
+    boost::shared_ptr<Instrument> s2(new Stock(Handle<Quote>(q2)));
+    CompositeInstrument portfolio;
+    portfolio.add(s1);
+    portfolio.add(s2);
+
+#if !defined(QL_ENABLE_CALCULATION_PROFILING)
+
+    BOOST_CHECK_THROW(profiler.enable(), Error);
+    portfolio.NPV();
+    if (!profiler.records().empty())
+        BOOST_FAIL("records available without profiling support");
+
+#else
+
+    profiler.enable();
+
+    portfolio.NPV();
+    q1->setValue(3.0);
+    q1->setValue(4.0);
+    portfolio.NPV();
+
+    // the composite recalculates the first stock only
+    CalculationProfiler::Record r = profiler.record(&portfolio);
+    if (r.calculations != 2 || r.notifications != 2 || r.invalidations != 1)
+        BOOST_ERROR("wrong record for composite instrument:"
+                    << "\n    calculations:  " << r.calculations
+                    << " (expected 2)"
+                    << "\n    notifications: " << r.notifications
+                    << " (expected 2)"
+                    << "\n    invalidations: " << r.invalidations
+                    << " (expected 1)");
+    if (r.ownTime < 0.0 || r.ownTime > r.time)
+        BOOST_ERROR("inconsistent times for composite instrument:"
+                    << "\n    time:     " << r.time
+                    << "\n    own time: " << r.ownTime);
+
+    r = profiler.record(s1.get());
+    if (r.calculations != 2 || r.notifications != 2 || r.invalidations != 1)
+        BOOST_ERROR("wrong record for first stock:"
+                    << "\n    calculations:  " << r.calculations
+                    << " (expected 2)"
+                    << "\n    notifications: " << r.notifications
+                    << " (expected 2)"
+                    << "\n    invalidations: " << r.invalidations
+                    << " (expected 1)");
+
+    r = profiler.record(s2.get());
+    if (r.calculations != 1 || r.notifications != 0)
+        BOOST_ERROR("wrong record for second stock:"
+                    << "\n    calculations:  " << r.calculations
+                    << " (expected 1)"
+                    << "\n    notifications: " << r.notifications
+                    << " (expected 0)");
+
+    std::vector<CalculationProfiler::Record> types =
+        profiler.records(CalculationProfiler::ByType);
+    if (types.size() != 2)
+        BOOST_FAIL(types.size() << " types recorded (2 expected)");
+    for (Size i=0; i<types.size(); ++i) {
+        Size instances =
+            types[i].type.find("Stock") != std::string::npos ? 2 : 1;
+        if (types[i].instances != instances)
+            BOOST_ERROR(types[i].instances << " instances of "
+                        << types[i].type << " recorded ("
+                        << instances << " expected)");
+    }
+
+    std::ostringstream csv, json;
+    profiler.writeCsv(csv);
+    profiler.writeJson(json, CalculationProfiler::ByType);
+    std::string output = csv.str();
+    if (std::count(output.begin(), output.end(), '\n') != 4)
+        BOOST_ERROR("wrong CSV output:\n" << output);
+    output = json.str();
+    if (std::count(output.begin(), output.end(), '{') != 2)
+        BOOST_ERROR("wrong JSON output:\n" << output);
+
+    profiler.reset();
+    if (!profiler.records().empty())
+        BOOST_FAIL("records available after reset");
+
+#endif
+}
+
+
 test_suite* LazyObjectTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("LazyObject tests");
     suite->add(
         QUANTLIB_TEST_CASE(&LazyObjectTest::testDiscardingNotifications));
     suite->add(
         QUANTLIB_TEST_CASE(&LazyObjectTest::testForwardingNotifications));
+    suite->add(
+        QUANTLIB_TEST_CASE(&LazyObjectTest::testCalculationProfiling));
     return suite;
 }
 
@@ -30,6 +30,8 @@
 #include <ql/math/randomnumbers/randomizedlds.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/scrambledsobolrsg.hpp>
+#include <ql/math/randomnumbers/sobolbrownianbridgersg.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <boost/progress.hpp>
 #include <ql/math/randomnumbers/latticerules.hpp>
@@ -1094,6 +1096,169 @@ void LowDiscrepancyTest::testSobolSkipping() {
     }
 }
 
+void LowDiscrepancyTest::testSobolDiscard() {
+
+    BOOST_TEST_MESSAGE("Testing Sobol sequence discard...");
+
+    unsigned long seed = 42;
+    Size dimensionality[] = { 1, 10, 100 };
+    boost::uint_least32_t skip[] = { 0, 1, 42, 511, 512, 100000 };
+    Size drawn[] = { 0, 1, 7 };
+
+    for (Size i=0; i<LENGTH(dimensionality); i++) {
+      for (Size j=0; j<LENGTH(skip); j++) {
+        for (Size k=0; k<LENGTH(drawn); k++) {
+
+            SobolRsg rsg1(dimensionality[i], seed, SobolRsg::JoeKuoD7);
+            SobolRsg rsg2(dimensionality[i], seed, SobolRsg::JoeKuoD7);
+            for (Size l=0; l<drawn[k]; l++) {
+                rsg1.nextSequence();
+                rsg2.nextSequence();
+            }
+
+            // extract n samples
+            for (Size l=0; l<skip[j]; l++)
+                rsg1.nextSequence();
+
+            // discard them at once, in two steps
+            rsg2.discard(skip[j]/2);
+            rsg2.discard(skip[j]-skip[j]/2);
+
+            // the last sample must be the last discarded one
+            if (rsg1.lastSequence().value != rsg2.lastSequence().value)
+                BOOST_FAIL("Last sample not updated after discarding:"
+                           << "\n  size:      " << dimensionality[i]
+                           << "\n  drawn:     " << drawn[k]
+                           << "\n  discarded: " << skip[j]);
+
+            // compare next 100 samples
+            for (Size m=0; m<100; m++) {
+                std::vector<boost::uint_least32_t> s1 = rsg1.nextInt32Sequence();
+                std::vector<boost::uint_least32_t> s2 = rsg2.nextInt32Sequence();
+                for (Size n=0; n<s1.size(); n++) {
+                    if (s1[n] != s2[n]) {
+                        BOOST_FAIL("Mismatch after discarding:"
+                                   << "\n  size:      " << dimensionality[i]
+                                   << "\n  drawn:     " << drawn[k]
+                                   << "\n  discarded: " << skip[j]
+                                   << "\n  at index:  " << n
+                                   << "\n  expected:  " << s1[n]
+                                   << "\n  found:     " << s2[n]);
+                    }
+                }
+            }
+        }
+      }
+    }
+
+    // skips beyond the period are detected rather than truncated
+    SobolRsg rsg(1);
+    rsg.discard(0xFFFFFFFEUL);
+    try {
+        rsg.discard(1);
+        BOOST_FAIL("discarding past the end of the period not detected");
+    } catch (Error&) {}
+    try {
+        SobolRsg(1).discard(boost::uint64_t(1) << 32);
+        BOOST_FAIL("discarding 2^32 samples not detected");
+    } catch (Error&) {}
+
+    // Brownian-bridged sequences built on top of Sobol
+    SobolBrownianBridgeRsg bb1(2, 12), bb2(2, 12);
+    for (Size l=0; l<1000; l++)
+        bb1.nextSequence();
+    bb2.discard(1000);
+    for (Size m=0; m<100; m++) {
+        std::vector<Real> s1 = bb1.nextSequence().value;
+        std::vector<Real> s2 = bb2.nextSequence().value;
+        for (Size n=0; n<s1.size(); n++) {
+            if (s1[n] != s2[n]) {
+                BOOST_FAIL("Mismatch after discarding Brownian-bridged "
+                           "samples:"
+                           << "\n  at index: " << n
+                           << "\n  expected: " << s1[n]
+                           << "\n  found:    " << s2[n]);
+            }
+        }
+    }
+}
+
+
+void LowDiscrepancyTest::testScrambledSobol() {
+
+    BOOST_TEST_MESSAGE("Testing scrambled Sobol sequences...");
+
+    Size dimensionality = 20;
+    Size m = 10;
+    boost::uint_least32_t points = 1 << m;
+
+    // the draws from 2^m-1 to 2^(m+1)-2 are the points from 2^m to
+    // 2^(m+1)-1 of the sequence, which are stratified in each
+    // dimension; the scrambling must preserve the stratification
+    ScrambledSobolRsg rsg(dimensionality, 42, SobolRsg::JoeKuoD7);
+    rsg.discard(points-1);
+    std::vector<std::vector<Size> > hits(dimensionality,
+                                         std::vector<Size>(points, 0));
+    for (Size i=0; i<points; ++i) {
+        const std::vector<Real>& x = rsg.nextSequence().value;
+        for (Size k=0; k<dimensionality; ++k) {
+            if (x[k] <= 0.0 || x[k] >= 1.0)
+                BOOST_FAIL("scrambled point out of (0,1):"
+                           << "\n  point:     " << i
+                           << "\n  dimension: " << k
+                           << "\n  value:     " << x[k]);
+            ++hits[k][Size(x[k]*points)];
+        }
+    }
+    for (Size k=0; k<dimensionality; ++k) {
+        for (Size j=0; j<points; ++j) {
+            if (hits[k][j] != 1)
+                BOOST_FAIL("scrambling failed to preserve stratification:"
+                           << "\n  dimension: " << k
+                           << "\n  interval:  " << j
+                           << "\n  points:    " << hits[k][j]);
+        }
+    }
+
+    // the same seed gives the same scramble, different seeds
+    // give different ones
+    ScrambledSobolRsg rsg1(dimensionality, 42, SobolRsg::JoeKuoD7);
+    ScrambledSobolRsg rsg2(dimensionality, 42, SobolRsg::JoeKuoD7);
+    ScrambledSobolRsg rsg3(dimensionality, 43, SobolRsg::JoeKuoD7);
+    Size differences = 0;
+    for (Size i=0; i<100; ++i) {
+        std::vector<boost::uint_least32_t> s1 = rsg1.nextInt32Sequence();
+        std::vector<boost::uint_least32_t> s2 = rsg2.nextInt32Sequence();
+        std::vector<boost::uint_least32_t> s3 = rsg3.nextInt32Sequence();
+        for (Size k=0; k<dimensionality; ++k) {
+            if (s1[k] != s2[k])
+                BOOST_FAIL("scrambles with the same seed differ:"
+                           << "\n  point:     " << i
+                           << "\n  dimension: " << k);
+            if (s1[k] != s3[k])
+                ++differences;
+        }
+    }
+    if (differences != 100*dimensionality)
+        BOOST_ERROR("scrambles with different seeds share "
+                    << 100*dimensionality-differences << " coordinates");
+
+    // discard() skips the same points as drawing them
+    ScrambledSobolRsg rsg4(dimensionality, 42, SobolRsg::JoeKuoD7);
+    for (Size i=0; i<points+100-1; ++i)
+        rsg4.nextInt32Sequence();
+    const std::vector<boost::uint_least32_t>& s4 = rsg4.nextInt32Sequence();
+    rsg1.discard(points-1);
+    const std::vector<boost::uint_least32_t>& s1 = rsg1.nextInt32Sequence();
+    for (Size k=0; k<dimensionality; ++k) {
+        if (s1[k] != s4[k])
+            BOOST_FAIL("mismatch after discarding scrambled points:"
+                       << "\n  dimension: " << k
+                       << "\n  expected:  " << s4[k]
+                       << "\n  found:     " << s1[k]);
+    }
+}
+
 
 test_suite* LowDiscrepancyTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Low-discrepancy sequence tests");
@@ -1132,6 +1297,8 @@ test_suite* LowDiscrepancyTest::suite() {
            &LowDiscrepancyTest::testSobolLevitanLemieuxSobolDiscrepancy));
 
     suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testSobolSkipping));
+    suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testSobolDiscard));
+    suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testScrambledSobol));
 
     suite->add(QUANTLIB_TEST_CASE(
            &LowDiscrepancyTest::testRandomizedLowDiscrepancySequence));
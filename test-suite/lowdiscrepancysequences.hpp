@@ -48,6 +48,8 @@ class LowDiscrepancyTest {
     static void testRandomizedLowDiscrepancySequence();
 
     static void testSobolSkipping();
+    static void testSobolDiscard();
+    static void testScrambledSobol();
 
     static void testRandomizedLattices();
 
@@ -4861,6 +4861,338 @@ void MarketModelTest::testCovariance() {
     }
 }
 
+namespace {
+
+    MultiStepOptionlets atTheMoneyOptionlets() {
+        std::vector<boost::shared_ptr<Payoff> > payoffs(todaysForwards.size());
+        for (Size i=0; i<todaysForwards.size(); ++i)
+            payoffs[i] = boost::shared_ptr<Payoff>(new
+                PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+        return MultiStepOptionlets(rateTimes, accruals, paymentTimes,
+                                   payoffs);
+    }
+
+    // two calls of different size check that the workers pick up
+    // the random stream where the previous call left it
+    template <class Engine>
+    void checkParallelEngine(Engine& serialEngine, Engine& parallelEngine,
+                             Size dimension, const std::string& name) {
+        Size paths[] = { 1000, 537 };
+        Real tolerance = 1.0e-12;
+
+        SequenceStatisticsInc serialStats(dimension);
+        SequenceStatisticsInc parallelStats(dimension);
+        for (Size i=0; i<LENGTH(paths); ++i) {
+            serialEngine.multiplePathValues(serialStats, paths[i]);
+            parallelEngine.multiplePathValues(parallelStats, paths[i]);
+        }
+
+        std::vector<Real> serialMeans = serialStats.mean();
+        std::vector<Real> parallelMeans = parallelStats.mean();
+        std::vector<Real> serialErrors = serialStats.errorEstimate();
+        std::vector<Real> parallelErrors = parallelStats.errorEstimate();
+        for (Size i=0; i<dimension; ++i) {
+            if (std::fabs(serialMeans[i]-parallelMeans[i]) > tolerance ||
+                std::fabs(serialErrors[i]-parallelErrors[i]) > tolerance)
+                BOOST_ERROR("failed to reproduce serial results "
+                            "with parallel " << name << ":"
+                            << "\n    index:            " << i
+                            << "\n    serial value:     " << serialMeans[i]
+                            << "\n    parallel value:   " << parallelMeans[i]
+                            << "\n    serial error:     " << serialErrors[i]
+                            << "\n    parallel error:   "
+                            << parallelErrors[i]);
+        }
+    }
+
+}
+
+void MarketModelTest::testParallelAccounting() {
+
+    BOOST_TEST_MESSAGE("Testing parallel accounting engines "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    MultiStepOptionlets product = atTheMoneyOptionlets();
+    MarketModelPathwiseMultiCaplet pathwiseProduct(rateTimes, accruals,
+                                                   paymentTimes,
+                                                   todaysForwards);
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationAbcdVolatility);
+    MTBrownianGeneratorFactory generatorFactory(seed_);
+    Size workers = 4;
+
+    AccountingEngine serialEngine(
+        boost::shared_ptr<MarketModelEvolver>(
+            new LogNormalFwdRatePc(marketModel, generatorFactory,
+                                   numeraires)),
+        product, initialNumeraireValue);
+    AccountingEngine parallelEngine(
+        boost::shared_ptr<MarketModelEvolver>(
+            new LogNormalFwdRatePc(marketModel, generatorFactory,
+                                   numeraires)),
+        product, initialNumeraireValue, workers);
+    checkParallelEngine(serialEngine, parallelEngine,
+                        product.numberOfProducts(), "accounting engine");
+
+    PathwiseAccountingEngine serialPathwiseEngine(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                      numeraires)),
+        pathwiseProduct, marketModel, initialNumeraireValue);
+    PathwiseAccountingEngine parallelPathwiseEngine(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                      numeraires)),
+        pathwiseProduct, marketModel, initialNumeraireValue, workers);
+    checkParallelEngine(serialPathwiseEngine, parallelPathwiseEngine,
+                        pathwiseProduct.numberOfProducts()*
+                                               (todaysForwards.size()+1),
+                        "pathwise accounting engine");
+}
+
+namespace {
+
+    template <class Evolver>
+    void checkBlockEvolution(const boost::shared_ptr<MarketModel>& marketModel,
+                             const std::vector<Size>& numeraires,
+                             const MarketModelMultiProduct& product,
+                             const std::string& config) {
+        Size paths = 37;
+        Real tolerance = 1.0e-12;
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        Evolver evolver(marketModel, generatorFactory, numeraires);
+        Evolver blockEvolver(marketModel, generatorFactory, numeraires);
+
+        const EvolutionDescription& evolution = marketModel->evolution();
+        Size steps = evolution.numberOfSteps();
+        const std::vector<Size>& alive = evolution.firstAliveRate();
+
+        std::vector<Matrix> blockForwards;
+        blockEvolver.startNewPaths(paths);
+        for (Size j=0; j<steps; ++j) {
+            blockEvolver.advanceSteps();
+            blockForwards.push_back(blockEvolver.currentForwards());
+        }
+        const std::vector<Real>& blockWeights = blockEvolver.pathWeights();
+
+        for (Size p=0; p<paths; ++p) {
+            Real weight = evolver.startNewPath();
+            for (Size j=0; j<steps; ++j) {
+                weight *= evolver.advanceStep();
+                const std::vector<Rate>& forwards =
+                    evolver.currentState().forwardRates();
+                for (Size i=alive[j]; i<forwards.size(); ++i) {
+                    if (std::fabs(forwards[i]-blockForwards[j][i][p])
+                                                              > tolerance)
+                        BOOST_FAIL("block evolution failed to reproduce "
+                                   "single-path evolution (" << config
+                                   << "):"
+                                   << "\n    path:         " << p
+                                   << "\n    step:         " << j
+                                   << "\n    rate:         " << i
+                                   << "\n    single path:  " << forwards[i]
+                                   << "\n    block:        "
+                                   << blockForwards[j][i][p]);
+                }
+            }
+            if (std::fabs(weight-blockWeights[p]) > tolerance)
+                BOOST_FAIL("block evolution failed to reproduce "
+                           "path weights (" << config << ")");
+        }
+
+        // an engine evolving its paths in blocks gives the same
+        // results, also over successive calls
+        AccountingEngine engine(
+            boost::shared_ptr<MarketModelEvolver>(
+                      new Evolver(marketModel, generatorFactory, numeraires)),
+            product, 1.0);
+        AccountingEngine blockEngine(
+            boost::shared_ptr<MarketModelEvolver>(
+                      new Evolver(marketModel, generatorFactory, numeraires)),
+            product, 1.0, 1, 16);
+        SequenceStatisticsInc stats(product.numberOfProducts());
+        SequenceStatisticsInc blockStats(product.numberOfProducts());
+        for (Size k=0; k<2; ++k) {
+            engine.multiplePathValues(stats, paths);
+            blockEngine.multiplePathValues(blockStats, paths);
+        }
+        std::vector<Real> means = stats.mean();
+        std::vector<Real> blockMeans = blockStats.mean();
+        for (Size i=0; i<means.size(); ++i) {
+            if (std::fabs(means[i]-blockMeans[i]) > tolerance)
+                BOOST_FAIL("accounting engine failed to reproduce "
+                           "single-path results with block evolution ("
+                           << config << "):"
+                           << "\n    product:      " << i
+                           << "\n    single path:  " << means[i]
+                           << "\n    block:        " << blockMeans[i]);
+        }
+    }
+
+}
+
+void MarketModelTest::testBlockEvolution() {
+
+    BOOST_TEST_MESSAGE("Testing block evolution of paths "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    MultiStepOptionlets product = atTheMoneyOptionlets();
+    EvolutionDescription evolution = product.evolution();
+
+    // reduced and full factors exercise both drift computations
+    Size testedFactors[] = { 3, todaysForwards.size() };
+    MeasureType measures[] = { MoneyMarket, Terminal };
+    for (Size m=0; m<LENGTH(testedFactors); ++m) {
+        boost::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, testedFactors[m],
+                            ExponentialCorrelationAbcdVolatility);
+        for (Size k=0; k<LENGTH(measures); ++k) {
+            std::vector<Size> numeraires = makeMeasure(product, measures[k]);
+            std::ostringstream config;
+            config << testedFactors[m] << " factors, "
+                   << measureTypeToString(measures[k]);
+
+            checkBlockEvolution<LogNormalFwdRatePc>(
+                marketModel, numeraires, product, config.str() + ", Pc");
+            checkBlockEvolution<LogNormalFwdRateEuler>(
+                marketModel, numeraires, product, config.str() + ", Euler");
+            if (isInTerminalMeasure(evolution, numeraires))
+                checkBlockEvolution<LogNormalFwdRateIpc>(
+                    marketModel, numeraires, product,
+                    config.str() + ", Ipc");
+        }
+    }
+}
+
+namespace {
+
+    Statistics upperBoundValues(
+                       const boost::shared_ptr<MarketModel>& marketModel,
+                       const std::vector<Size>& numeraires,
+                       const MarketModelMultiProduct& product,
+                       const MarketModelExerciseValue& rebate,
+                       const ExerciseStrategy<CurveState>& strategy,
+                       Size workers,
+                       Size outerPaths,
+                       Size minInnerPaths,
+                       Size maxInnerPaths,
+                       Real innerTolerance) {
+        const EvolutionDescription& evolution = marketModel->evolution();
+
+        MTBrownianGeneratorFactory outerFactory(seed_+142);
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   outerFactory, Pc);
+
+        std::vector<boost::shared_ptr<MarketModelEvolver> > innerEvolvers;
+        std::valarray<bool> isExerciseTime =
+            isInSubset(evolution.evolutionTimes(), strategy.exerciseTimes());
+        for (Size s=0; s<isExerciseTime.size(); ++s) {
+            if (isExerciseTime[s]) {
+                MTBrownianGeneratorFactory innerFactory(seed_+s);
+                innerEvolvers.push_back(
+                    makeMarketModelEvolver(marketModel, numeraires,
+                                           innerFactory, Pc, s));
+            }
+        }
+
+        UpperBoundEngine engine(evolver, innerEvolvers,
+                                product, rebate, product, rebate,
+                                strategy, todaysDiscounts[numeraires.front()],
+                                workers);
+        Statistics stats;
+        engine.multiplePathValues(stats, outerPaths,
+                                  minInnerPaths, maxInnerPaths,
+                                  innerTolerance);
+        return stats;
+    }
+
+}
+
+void MarketModelTest::testParallelUpperBound() {
+
+    BOOST_TEST_MESSAGE("Testing parallel and adaptive inner simulations "
+                       "in the upper-bound engine...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+                               fixedRate, false);
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    EvolutionDescription evolution = receiverSwap.evolution();
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationAbcdVolatility);
+
+    Size outerPaths = 16, minInnerPaths = 32, maxInnerPaths = 128;
+    Size workers = 4;
+    Real tolerance = 1.0e-12;
+
+    Statistics serial =
+        upperBoundValues(marketModel, numeraires, receiverSwap, nullRebate,
+                         naifStrategy, 1, outerPaths,
+                         maxInnerPaths, maxInnerPaths, 0.0);
+    Statistics parallel =
+        upperBoundValues(marketModel, numeraires, receiverSwap, nullRebate,
+                         naifStrategy, workers, outerPaths,
+                         maxInnerPaths, maxInnerPaths, 0.0);
+    if (std::fabs(serial.mean()-parallel.mean()) > tolerance ||
+        std::fabs(serial.errorEstimate()-parallel.errorEstimate())
+                                                              > tolerance)
+        BOOST_ERROR("failed to reproduce serial upper bound "
+                    "with " << workers << " workers:"
+                    << "\n    serial value:     " << serial.mean()
+                    << "\n    parallel value:   " << parallel.mean()
+                    << "\n    serial error:     " << serial.errorEstimate()
+                    << "\n    parallel error:   "
+                    << parallel.errorEstimate());
+
+    // the adaptive simulation doesn't depend on the number of
+    // workers, either...
+    Statistics serialAdaptive =
+        upperBoundValues(marketModel, numeraires, receiverSwap, nullRebate,
+                         naifStrategy, 1, outerPaths,
+                         minInnerPaths, maxInnerPaths, 1.0e-3);
+    Statistics parallelAdaptive =
+        upperBoundValues(marketModel, numeraires, receiverSwap, nullRebate,
+                         naifStrategy, workers, outerPaths,
+                         minInnerPaths, maxInnerPaths, 1.0e-3);
+    if (std::fabs(serialAdaptive.mean()-parallelAdaptive.mean())
+                                                              > tolerance)
+        BOOST_ERROR("failed to reproduce serial adaptive upper bound "
+                    "with " << workers << " workers:"
+                    << "\n    serial value:     " << serialAdaptive.mean()
+                    << "\n    parallel value:   "
+                    << parallelAdaptive.mean());
+
+    // ...and with a null tolerance runs up to the maximum
+    Statistics strictAdaptive =
+        upperBoundValues(marketModel, numeraires, receiverSwap, nullRebate,
+                         naifStrategy, workers, outerPaths,
+                         minInnerPaths, maxInnerPaths, 0.0);
+    if (std::fabs(serial.mean()-strictAdaptive.mean()) > tolerance)
+        BOOST_ERROR("adaptive inner simulation with null tolerance "
+                    "failed to reach the maximum number of paths:"
+                    << "\n    fixed value:      " << serial.mean()
+                    << "\n    adaptive value:   " << strictAdaptive.mean());
+}
+
 // --- Call the desired tests
 test_suite* MarketModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Market-model tests");
@@ -4889,6 +5221,10 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCovariance));
 
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelAccounting));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testBlockEvolution));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelUpperBound));
+
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPathwiseVegas));
 
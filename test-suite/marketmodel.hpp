@@ -55,6 +55,9 @@ class MarketModelTest {
     static void testIsInSubset();
     static void testAbcdDegenerateCases();
     static void testCovariance();
+    static void testParallelAccounting();
+    static void testBlockEvolution();
+    static void testParallelUpperBound();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -730,6 +730,68 @@ void MatricesTest::testInitializers() {
     BOOST_CHECK_EQUAL(m3(1, 1), 4.0);
 }
 
+void MatricesTest::testProducts() {
+
+    BOOST_TEST_MESSAGE("Testing matrix and vector products...");
+
+    // sizes spanning several blocks of the blocked product
+    const Size m = 70, k = 300, n = 270;
+    MersenneTwisterUniformRng rng(1234);
+    Matrix A(m, k), B(k, n);
+    for (Matrix::iterator i=A.begin(); i!=A.end(); ++i)
+        *i = rng.next().value - 0.5;
+    for (Matrix::iterator i=B.begin(); i!=B.end(); ++i)
+        *i = rng.next().value - 0.5;
+    Array v(k), w(m);
+    for (Size i=0; i<k; ++i)
+        v[i] = rng.next().value - 0.5;
+    for (Size i=0; i<m; ++i)
+        w[i] = rng.next().value - 0.5;
+
+    const Matrix C = A*B;
+    const Array Av = A*v, wA = w*A;
+
+    // storage is aligned for vectorised access
+    const Size alignment = 64;
+    if (reinterpret_cast<std::size_t>(C.begin()) % alignment != 0
+        || reinterpret_cast<std::size_t>(Av.begin()) % alignment != 0)
+        BOOST_FAIL("misaligned storage");
+
+    // results are checked against straightforward loops; unless
+    // products are delegated to BLAS, they should be the same
+    const Real tol = 1.0e-12;
+    for (Size i=0; i<m; ++i) {
+        for (Size j=0; j<n; ++j) {
+            Real expected = 0.0;
+            for (Size l=0; l<k; ++l)
+                expected += A[i][l]*B[l][j];
+            if (std::fabs(C[i][j]-expected) > tol)
+                BOOST_FAIL("failed to reproduce matrix product at ("
+                           << i << "," << j << ")"
+                           << "\n    calculated: " << C[i][j]
+                           << "\n    expected:   " << expected);
+        }
+        Real expected = 0.0;
+        for (Size l=0; l<k; ++l)
+            expected += A[i][l]*v[l];
+        if (std::fabs(Av[i]-expected) > tol)
+            BOOST_FAIL("failed to reproduce matrix-vector product at "
+                       << i
+                       << "\n    calculated: " << Av[i]
+                       << "\n    expected:   " << expected);
+    }
+    for (Size l=0; l<k; ++l) {
+        Real expected = 0.0;
+        for (Size i=0; i<m; ++i)
+            expected += w[i]*A[i][l];
+        if (std::fabs(wA[l]-expected) > tol)
+            BOOST_FAIL("failed to reproduce vector-matrix product at "
+                       << l
+                       << "\n    calculated: " << wA[l]
+                       << "\n    expected:   " << expected);
+    }
+}
+
 test_suite* MatricesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Matrix tests");
 
@@ -748,6 +810,7 @@ test_suite* MatricesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testMoorePenroseInverse));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testIterativeSolvers));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testInitializers));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testProducts));
     return suite;
 }
 
@@ -29,6 +29,8 @@
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/mcamericanengine.hpp>
+#include <ql/pricingengines/basket/mcamericanbasketengine.hpp>
+#include <ql/instruments/basketoption.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 
 using namespace QuantLib;
@@ -315,6 +317,138 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testStreamingCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing Longstaff-Schwartz streaming calibration...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+    const Date maturity = today + Period(1, Years);
+
+    boost::shared_ptr<Exercise> exercise(
+                                   new AmericanExercise(today, maturity));
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        flatBlackScholesProcess(today, 36.0, 0.02, 0.06, 0.20, dayCounter);
+
+    const Real tolerance = 1.0e-8;
+    const Size workers[] = { 1, 4 };
+    const Size datesPerPass[] = { 25, 1 };
+
+    // the calibration paths are the same, so the exercise strategy
+    // only differs by the round-off errors in the regression
+    VanillaOption option(
+        boost::shared_ptr<StrikedTypePayoff>(
+                               new PlainVanillaPayoff(Option::Put, 40.0)),
+        exercise);
+
+    const MakeMCAmericanEngine<PseudoRandom> engine =
+        MakeMCAmericanEngine<PseudoRandom>(process)
+        .withSteps(25)
+        .withAntitheticVariate()
+        .withSamples(4096)
+        .withCalibrationSamples(1024)
+        .withSeed(42);
+    option.setPricingEngine(engine);
+    const Real expected = option.NPV();
+
+    for (Size i=0; i<LENGTH(workers); ++i) {
+        option.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(engine)
+            .withStreamingCalibration()
+            .withCalibrationWorkers(workers[i])
+            .withCalibrationDatesPerPass(datesPerPass[i]));
+        const Real calculated = option.NPV();
+
+        if (std::fabs(calculated - expected) > tolerance)
+            BOOST_ERROR("Failed to reproduce American option price "
+                        "with streaming calibration"
+                        << std::setprecision(12)
+                        << "\n    workers:    " << workers[i]
+                        << "\n    dates/pass: " << datesPerPass[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(2,
+                                                                   process);
+    Matrix correlation(2, 2, 0.3);
+    correlation[0][0] = correlation[1][1] = 1.0;
+    boost::shared_ptr<StochasticProcessArray> processArray(
+                      new StochasticProcessArray(processes, correlation));
+
+    BasketOption basketOption(
+        boost::shared_ptr<BasketPayoff>(new MaxBasketPayoff(
+            boost::shared_ptr<Payoff>(
+                new PlainVanillaPayoff(Option::Call, 40.0)))),
+        exercise);
+
+    const MakeMCAmericanBasketEngine<PseudoRandom> basketEngine =
+        MakeMCAmericanBasketEngine<PseudoRandom>(processArray)
+        .withSteps(25)
+        .withAntitheticVariate()
+        .withSamples(2048)
+        .withCalibrationSamples(1024)
+        .withSeed(42);
+    basketOption.setPricingEngine(basketEngine);
+    const Real expectedBasket = basketOption.NPV();
+
+    for (Size i=0; i<LENGTH(workers); ++i) {
+        basketOption.setPricingEngine(
+            MakeMCAmericanBasketEngine<PseudoRandom>(basketEngine)
+            .withStreamingCalibration()
+            .withCalibrationWorkers(workers[i])
+            .withCalibrationDatesPerPass(datesPerPass[i]));
+        const Real calculated = basketOption.NPV();
+
+        if (std::fabs(calculated - expectedBasket) > tolerance)
+            BOOST_ERROR("Failed to reproduce American basket option price "
+                        "with streaming calibration"
+                        << std::setprecision(12)
+                        << "\n    workers:    " << workers[i]
+                        << "\n    dates/pass: " << datesPerPass[i]
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expectedBasket);
+    }
+
+    // the paths are generated once for each group of exercise dates;
+    // the size of the groups doesn't change the exercise strategy
+    TimeGrid grid(1.0, 25);
+    typedef PathGenerator<PseudoRandom::rsg_type> generator_type;
+    generator_type generator(process, grid,
+                             PseudoRandom::make_sequence_generator(25, 42),
+                             false);
+    boost::shared_ptr<EarlyExercisePathPricer<Path> > americanPricer(
+        new AmericanPathPricer(
+            boost::shared_ptr<Payoff>(
+                               new PlainVanillaPayoff(Option::Put, 40.0)),
+            2, LsmBasisSystem::Monomial));
+
+    LongstaffSchwartzPathPricer<Path> allDates(grid, americanPricer,
+                                               process->riskFreeRate().currentLink());
+    allDates.calibrate(generator, 1024, true, 1, 25);
+    LongstaffSchwartzPathPricer<Path> someDates(grid, americanPricer,
+                                                process->riskFreeRate().currentLink());
+    someDates.calibrate(generator, 1024, true, 1, 7);
+
+    generator_type pricingGenerator(
+                             process, grid,
+                             PseudoRandom::make_sequence_generator(25, 7),
+                             false);
+    for (Size i=0; i<100; ++i) {
+        const Path& path = pricingGenerator.next().value;
+        if (allDates(path) != someDates(path))
+            BOOST_FAIL("Exercise strategy depends on the number of "
+                       "exercise dates per calibration pass"
+                       << std::setprecision(12)
+                       << "\n    all dates:   " << allDates(path)
+                       << "\n    7 per pass:  " << someDates(path));
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -322,6 +456,8 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testStreamingCalibration));
     return suite;
 }
 
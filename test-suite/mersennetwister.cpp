@@ -481,10 +481,46 @@ void MersenneTwisterTest::testValues() {
                    "during parallel computation");
 }
 
+void MersenneTwisterTest::testDiscard() {
+
+    BOOST_TEST_MESSAGE("Testing Mersenne twister discard...");
+
+    // the last value is large enough to use the polynomial jump
+    boost::uint64_t skip[] = { 0, 1, 42, 623, 624, 625, 1000, 100000,
+                               (boost::uint64_t(1) << 26) + 1234 };
+    Size drawn[] = { 0, 1, 623, 700 };
+
+    for (Size i=0; i<LENGTH(skip); ++i) {
+        for (Size j=0; j<LENGTH(drawn); ++j) {
+            MersenneTwisterUniformRng mt1(42), mt2(42);
+            for (Size k=0; k<drawn[j]; ++k) {
+                mt1.nextInt32();
+                mt2.nextInt32();
+            }
+
+            for (boost::uint64_t k=0; k<skip[i]; ++k)
+                mt1.nextInt32();
+            mt2.discard(skip[i]);
+
+            for (Size k=0; k<1000; ++k) {
+                unsigned long x1 = mt1.nextInt32(), x2 = mt2.nextInt32();
+                if (x1 != x2)
+                    BOOST_FAIL("Mismatch after discarding:"
+                               << "\n  already drawn: " << drawn[j]
+                               << "\n  discarded:     " << skip[i]
+                               << "\n  at index:      " << k
+                               << "\n  expected:      " << x1
+                               << "\n  found:         " << x2);
+            }
+        }
+    }
+}
+
 
 test_suite* MersenneTwisterTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Mersenne twister tests");
     suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testValues));
+    suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testDiscard));
     return suite;
 }
 
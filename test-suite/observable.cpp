@@ -21,12 +21,17 @@
 #include "utilities.hpp"
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/patterns/observable.hpp>
+#include <ql/patterns/lazyobject.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/volatility/capfloor/capfloortermvolsurface.hpp>
 #include <ql/termstructures/volatility/optionlet/strippedoptionletadapter.hpp>
 #include <ql/termstructures/volatility/optionlet/strippedoptionlet.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/utilities/compactset.hpp>
+#include <boost/timer.hpp>
+#include <algorithm>
+#include <set>
 
 
 using namespace QuantLib;
@@ -113,7 +118,6 @@ void ObservableTest::testObservableSettings() {
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
-#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 #include <list>
 
@@ -263,8 +267,210 @@ void ObservableTest::testMultiThreadingGlobalSettings() {
         }
     }
 }
+
+#endif
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#ifdef _OPENMP
+#include <omp.h>
 #endif
 
+namespace {
+
+    #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    typedef boost::atomic<int> counter_type;
+    #else
+    // only used while holding a PatternLock
+    typedef int counter_type;
+    #endif
+
+    class ContentionCounter : public Observer {
+      public:
+        ContentionCounter() : counter_(0) {
+            ++instanceCounter_;
+        }
+        ~ContentionCounter() {
+            --instanceCounter_;
+        }
+        void update() {
+            ++counter_;
+        }
+        int counter() const { return counter_; }
+        static int instanceCounter() { return instanceCounter_; }
+      private:
+        counter_type counter_;
+        static counter_type instanceCounter_;
+    };
+
+    counter_type ContentionCounter::instanceCounter_(0);
+
+    /* Serializes all uses of the observer pattern in the baseline
+       runs, which is what code sharing observables among threads
+       must do unless the thread-safe implementation is enabled.
+       Without OpenMP, the workers run serially and it does nothing. */
+    class PatternLock {
+      public:
+        PatternLock() {
+            #ifdef _OPENMP
+            omp_init_lock(&lock_);
+            #endif
+        }
+        ~PatternLock() {
+            #ifdef _OPENMP
+            omp_destroy_lock(&lock_);
+            #endif
+        }
+        void acquire() {
+            #ifdef _OPENMP
+            omp_set_lock(&lock_);
+            #endif
+        }
+        void release() {
+            #ifdef _OPENMP
+            omp_unset_lock(&lock_);
+            #endif
+        }
+      private:
+        #ifdef _OPENMP
+        omp_lock_t lock_;
+        #endif
+        PatternLock(const PatternLock&);
+        PatternLock& operator=(const PatternLock&);
+    };
+
+    // holds the lock, if any, for its lifetime
+    class PatternGuard {
+      public:
+        explicit PatternGuard(PatternLock* lock) : lock_(lock) {
+            if (lock_)
+                lock_->acquire();
+        }
+        ~PatternGuard() {
+            if (lock_)
+                lock_->release();
+        }
+      private:
+        PatternLock* lock_;
+    };
+
+    // registers a number of observers with a quote of its own and a
+    // shared one, notifies both and destroys the observers, for a
+    // number of rounds; meanwhile, other workers do the same.  If a
+    // lock is given, it's held while using the observer pattern.
+    class ObserverWorker {
+      public:
+        ObserverWorker(const boost::shared_ptr<SimpleQuote>& shared,
+                       Size id, Size workers,
+                       Size observers, Size rounds, PatternLock* lock)
+        : shared_(shared), id_(id), workers_(workers),
+          observers_(observers), rounds_(rounds), lock_(lock) {}
+        // returns false if some observer was not notified
+        bool operator()() const {
+            boost::shared_ptr<SimpleQuote> own;
+            {
+                PatternGuard guard(lock_);
+                own = boost::make_shared<SimpleQuote>(0.0);
+            }
+            bool notified = true;
+            for (Size r=0; r<rounds_; ++r) {
+                std::vector<boost::shared_ptr<ContentionCounter> >
+                    counters(observers_);
+                for (Size i=0; i<observers_; ++i) {
+                    PatternGuard guard(lock_);
+                    counters[i] = boost::make_shared<ContentionCounter>();
+                    counters[i]->registerWith(shared_);
+                    counters[i]->registerWith(own);
+                }
+                {
+                    PatternGuard guard(lock_);
+                    own->setValue(Real(r+1));
+                    // unique, so that the quote always notifies
+                    shared_->setValue(Real(r*workers_ + id_ + 1));
+                }
+                PatternGuard guard(lock_);
+                for (Size i=0; i<observers_; ++i) {
+                    if (counters[i]->counter() < 2)
+                        notified = false;
+                }
+                counters.clear();
+            }
+            PatternGuard guard(lock_);
+            own.reset();
+            return notified;
+        }
+      private:
+        boost::shared_ptr<SimpleQuote> shared_;
+        Size id_, workers_, observers_, rounds_;
+        PatternLock* lock_;
+    };
+
+    // returns the elapsed time
+    Real runObserverWorkers(Size threads, Size observers, Size rounds,
+                            bool locked) {
+        const boost::shared_ptr<SimpleQuote> shared(new SimpleQuote(0.0));
+        PatternLock lock;
+        int failed = 0;
+
+        boost::posix_time::ptime start =
+            boost::posix_time::microsec_clock::local_time();
+        #pragma omp parallel for num_threads(int(threads)) \
+            reduction(|:failed)
+        for (long i=0; i<long(threads); ++i) {
+            ObserverWorker worker(shared, Size(i), threads,
+                                  observers, rounds, locked ? &lock : 0);
+            if (!worker())
+                failed = 1;
+        }
+        boost::posix_time::ptime stop =
+            boost::posix_time::microsec_clock::local_time();
+
+        if (failed)
+            BOOST_FAIL("observers were not notified");
+        return (stop - start).total_microseconds() * 1.0e-6;
+    }
+
+}
+
+void ObservableTest::testContention() {
+    BOOST_TEST_MESSAGE("Testing observer pattern under contention...");
+
+    // the baseline serializes the workers with a global lock; the
+    // thread-safe implementation doesn't need it
+    const Size observers = 1000, rounds = 50;
+
+    Real serial = runObserverWorkers(1, observers, rounds, true);
+    BOOST_TEST_MESSAGE("    1 thread: " << serial << " s");
+    for (Size threads=2; threads<=8; threads*=2) {
+        Real locked = runObserverWorkers(threads, observers, rounds, true);
+        BOOST_TEST_MESSAGE("    " << threads << " threads, global lock: "
+                           << locked << " s (" << serial*threads/locked
+                           << " times the single-thread throughput)");
+        #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        Real elapsed = runObserverWorkers(threads, observers, rounds, false);
+        BOOST_TEST_MESSAGE("    " << threads << " threads, no lock:     "
+                           << elapsed << " s (" << serial*threads/elapsed
+                           << " times the single-thread throughput)");
+        #endif
+    }
+
+    if (ContentionCounter::instanceCounter() != 0)
+        BOOST_FAIL(ContentionCounter::instanceCounter()
+                   << " observers not destroyed");
+
+    #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    // with no notification running, a retired observer is deleted
+    // together with those retired before
+    {
+        const boost::shared_ptr<SimpleQuote> quote(new SimpleQuote(0.0));
+        ContentionCounter observer;
+        observer.registerWith(quote);
+    }
+    Size retired = ObservableSettings::instance().retiredObservers();
+    if (retired != 0)
+        BOOST_FAIL(retired << " retired observers not deleted");
+    #endif
+}
+
 void ObservableTest::testDeepUpdate() {
 
     SavedSettings backup;
@@ -306,6 +512,338 @@ void ObservableTest::testDeepUpdate() {
     BOOST_CHECK_CLOSE(v4, 0.21, 1E-10);
 }
 
+namespace {
+
+    class RecordingObserver : public Observer {
+      public:
+        RecordingObserver(const std::string& name,
+                          std::vector<std::string>& log)
+        : name_(name), log_(log) {}
+        void update() {
+            log_.push_back(name_);
+        }
+      private:
+        std::string name_;
+        std::vector<std::string>& log_;
+    };
+
+    class RecordingLazyObject : public LazyObject {
+      public:
+        RecordingLazyObject(const std::string& name,
+                            std::vector<std::string>& log)
+        : name_(name), log_(log) {}
+        void update() {
+            log_.push_back(name_);
+            LazyObject::update();
+        }
+        void compute() const { calculate(); }
+      private:
+        void performCalculations() const {}
+        std::string name_;
+        std::vector<std::string>& log_;
+    };
+
+}
+
+void ObservableTest::testNotificationBatch() {
+
+    BOOST_TEST_MESSAGE("Testing notification batches...");
+
+    std::vector<std::string> updates;
+    boost::shared_ptr<SimpleQuote> q1 = boost::make_shared<SimpleQuote>(1.0);
+    boost::shared_ptr<SimpleQuote> q2 = boost::make_shared<SimpleQuote>(2.0);
+
+    // the lazy object depends on both quotes, the observer on the
+    // lazy object and on the first quote
+    boost::shared_ptr<RecordingLazyObject> lazy =
+        boost::make_shared<RecordingLazyObject>("lazy", boost::ref(updates));
+    lazy->registerWith(q1);
+    lazy->registerWith(q2);
+    boost::shared_ptr<RecordingObserver> observer =
+        boost::make_shared<RecordingObserver>("observer", boost::ref(updates));
+    observer->registerWith(lazy);
+    observer->registerWith(q1);
+
+    lazy->compute();
+    #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    ObservableSettings::instance().resetNotificationCounters();
+    #else
+    // the ordering and the counters are not available, and the
+    // latter must say so rather than returning a wrong count
+    if (ObservableSettings::instance().orderedNotificationBatches())
+        BOOST_ERROR("ordered notification batches reported");
+    BOOST_CHECK_THROW(ObservableSettings::instance().notificationsSent(),
+                      Error);
+    #endif
+    {
+        NotificationBatch batch;
+        q1->setValue(1.5);
+        q2->setValue(2.5);
+        q1->setValue(1.6);
+        if (!updates.empty())
+            BOOST_FAIL("observers notified before the end of the batch");
+        batch.commit();
+    }
+
+    #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    if (!ObservableSettings::instance().orderedNotificationBatches())
+        BOOST_ERROR("unordered notification batches reported");
+    bool expected = updates.size() == 2 &&
+                    updates[0] == "lazy" && updates[1] == "observer";
+    #else
+    // the thread-safe implementation doesn't sort the notifications,
+    // so the observer might also be notified by the lazy object
+    bool expected =
+        std::count(updates.begin(), updates.end(), std::string("lazy")) == 1
+        && std::count(updates.begin(), updates.end(),
+                      std::string("observer")) >= 1;
+    #endif
+    if (!expected) {
+        std::ostringstream notified;
+        for (Size i=0; i<updates.size(); ++i)
+            notified << " " << updates[i];
+        BOOST_FAIL("unexpected notifications at the end of the batch:"
+                   << "\n    expected: lazy observer"
+                   << "\n    received:" << notified.str());
+    }
+
+    #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    // without the batch, the three changes would have sent six
+    // notifications: two to the lazy object and one to the observer
+    // for each change of the first quote (including the one
+    // forwarded by the lazy object the first time) and one to the
+    // lazy object for the change of the second quote.
+    Size sent = ObservableSettings::instance().notificationsSent();
+    Size saved = ObservableSettings::instance().notificationsSaved();
+    if (sent != 2 || saved != 4)
+        BOOST_ERROR("unexpected notification counters:"
+                    << "\n    sent:  " << sent << " (expected 2)"
+                    << "\n    saved: " << saved << " (expected 4)");
+
+    // a lazy object which wasn't recalculated doesn't forward
+    // notifications, and neither does a batch; nested batches are
+    // notified at the end of the outermost one
+    updates.clear();
+    {
+        NotificationBatch outer;
+        {
+            NotificationBatch inner;
+            q2->setValue(3.0);
+        }
+        if (!updates.empty())
+            BOOST_FAIL("observers notified at the end of a nested batch");
+    }
+    if (updates.size() != 1 || updates[0] != "lazy")
+        BOOST_FAIL("notification forwarded by a lazy object "
+                   "which wasn't recalculated");
+    #endif
+}
+
+namespace {
+
+    Size allocatedBytes = 0;
+
+    template <class T>
+    class CountingAllocator : public std::allocator<T> {
+      public:
+        template <class U>
+        struct rebind {
+            typedef CountingAllocator<U> other;
+        };
+        CountingAllocator() {}
+        template <class U>
+        CountingAllocator(const CountingAllocator<U>&) {}
+        T* allocate(std::size_t n, const void* = 0) {
+            allocatedBytes += n*sizeof(T);
+            return std::allocator<T>::allocate(n);
+        }
+        void deallocate(T* p, std::size_t n) {
+            allocatedBytes -= n*sizeof(T);
+            std::allocator<T>::deallocate(p, n);
+        }
+    };
+
+    typedef boost::unordered_set<Size, boost::hash<Size>, std::equal_to<Size>,
+                                 CountingAllocator<Size> > HashSet;
+    typedef CompactSet<Size, 4, HashSet> SmallSet;
+
+    // average memory used by a set with the given number of
+    // elements; the overhead of the memory allocator is not included
+    template <class Set>
+    Size footprint(Size elements) {
+        const Size sets = 1000;
+        allocatedBytes = 0;
+        std::vector<Set> v(sets);
+        for (Size i=0; i<sets; ++i) {
+            for (Size j=0; j<elements; ++j)
+                v[i].insert(j);
+        }
+        return sizeof(Set) + allocatedBytes/sets;
+    }
+
+    // time spent filling, scanning and destroying a large number of
+    // sets with the given number of elements
+    template <class Set>
+    Real setTiming(Size elements) {
+        const Size sets = 100000;
+        boost::timer t;
+        Size sum = 0;
+        {
+            std::vector<Set> v(sets);
+            for (Size i=0; i<sets; ++i) {
+                for (Size j=0; j<elements; ++j)
+                    v[i].insert(i+j);
+            }
+            for (Size i=0; i<sets; ++i) {
+                for (typename Set::const_iterator j=v[i].begin();
+                     j!=v[i].end(); ++j)
+                    sum += *j;
+            }
+        }
+        QL_REQUIRE(sum > 0, "empty sets");
+        return t.elapsed();
+    }
+
+    // destroys the other observers of an observable when notified
+    class ObserverDestroyer : public Observer {
+      public:
+        explicit ObserverDestroyer(
+                     std::vector<boost::shared_ptr<UpdateCounter> >& others)
+        : others_(others) {}
+        void update() { others_.clear(); }
+      private:
+        std::vector<boost::shared_ptr<UpdateCounter> >& others_;
+    };
+
+}
+
+void ObservableTest::testCompactSets() {
+
+    BOOST_TEST_MESSAGE("Testing compact observer storage...");
+
+    // the set is checked against a std::set while it grows beyond
+    // its inline storage and shrinks back
+    SmallSet s;
+    std::set<Size> expected;
+    const Size n = 12;
+    for (Size i=0; i<2*n; ++i) {
+        Size x = (7*i) % n;
+        bool inserted = s.insert(x).second;
+        if (inserted != expected.insert(x).second)
+            BOOST_FAIL("wrong insertion result for " << x);
+        if (*s.find(x) != x)
+            BOOST_FAIL("inserted element " << x << " not found");
+    }
+    for (Size i=0; i<=n; ++i) {
+        Size x = (5*i) % (n+1);
+        if (s.erase(x) != expected.erase(x))
+            BOOST_FAIL("wrong removal result for " << x);
+        if (s.size() != expected.size())
+            BOOST_FAIL("wrong size " << s.size()
+                       << " after removing " << x
+                       << " (expected " << expected.size() << ")");
+        std::set<Size> contents(s.begin(), s.end());
+        if (contents != expected || Size(std::distance(s.begin(), s.end()))
+                                                       != expected.size())
+            BOOST_FAIL("wrong contents after removing " << x);
+        if ((s.size() <= 2 && !s.isCompact()) ||
+            (s.size() > 4 && s.isCompact()))
+            BOOST_FAIL("unexpected storage for " << s.size() << " elements");
+        SmallSet copy(s);
+        if (std::set<Size>(copy.begin(), copy.end()) != expected)
+            BOOST_FAIL("wrong contents of copied set");
+    }
+
+    // observers destroyed while the set is being notified, both in
+    // inline and in heap storage; the others are still notified once
+    Size observerCounts[] = { 2, 8 };
+    for (Size i=0; i<LENGTH(observerCounts); ++i) {
+        boost::shared_ptr<SimpleQuote> quote =
+            boost::make_shared<SimpleQuote>();
+        std::vector<boost::shared_ptr<UpdateCounter> > others;
+        for (Size j=0; j<observerCounts[i]; ++j) {
+            others.push_back(boost::make_shared<UpdateCounter>());
+            others.back()->registerWith(quote);
+        }
+        ObserverDestroyer destroyer(others);
+        destroyer.registerWith(quote);
+        UpdateCounter witness;
+        witness.registerWith(quote);
+
+        quote->setValue(1.0);
+        quote->setValue(2.0);
+        if (witness.counter() != 2)
+            BOOST_FAIL("observer received " << witness.counter()
+                       << " notifications (expected 2) when "
+                       << observerCounts[i] << " others were destroyed");
+    }
+
+    // memory used by small sets
+    Size sizes[] = { 1, 2, 3, 4, 16 };
+    for (Size i=0; i<LENGTH(sizes); ++i) {
+        Size hashSet = footprint<HashSet>(sizes[i]);
+        Size compactSet = footprint<SmallSet>(sizes[i]);
+        BOOST_TEST_MESSAGE("    " << sizes[i] << " elements: "
+                           << hashSet << " bytes with a hash set, "
+                           << compactSet << " with a compact set");
+        if (sizes[i] <= 4 && compactSet >= hashSet)
+            BOOST_ERROR("no memory saved for " << sizes[i] << " elements:"
+                        << "\n    hash set:    " << hashSet << " bytes"
+                        << "\n    compact set: " << compactSet << " bytes");
+        // beyond the inline storage, only the size is added
+        if (compactSet > hashSet + sizeof(Size))
+            BOOST_ERROR("memory wasted for " << sizes[i] << " elements:"
+                        << "\n    hash set:    " << hashSet << " bytes"
+                        << "\n    compact set: " << compactSet << " bytes");
+    }
+    BOOST_TEST_MESSAGE("    sets of 3 elements filled, scanned and destroyed"
+                       " in " << setTiming<HashSet>(3) << " s with hash sets, "
+                       << setTiming<SmallSet>(3) << " s with compact sets");
+
+    // costs of the observer pattern when, as for the coupons in a
+    // large portfolio, each observer is registered with a couple of
+    // widely used observables and with one of a few others
+    const Size observers = 200000, curves = 10;
+    boost::shared_ptr<SimpleQuote> index = boost::make_shared<SimpleQuote>();
+    boost::shared_ptr<SimpleQuote> date = boost::make_shared<SimpleQuote>();
+    std::vector<boost::shared_ptr<SimpleQuote> > curve(curves);
+    for (Size i=0; i<curves; ++i)
+        curve[i] = boost::make_shared<SimpleQuote>();
+
+    boost::timer t;
+    std::vector<boost::shared_ptr<UpdateCounter> > counters(observers);
+    for (Size i=0; i<observers; ++i) {
+        counters[i] = boost::make_shared<UpdateCounter>();
+        counters[i]->registerWith(index);
+        counters[i]->registerWith(curve[i % curves]);
+        counters[i]->registerWith(date);
+    }
+    Real registration = t.elapsed();
+
+    t.restart();
+    index->setValue(1.0);
+    for (Size i=0; i<curves; ++i)
+        curve[i]->setValue(1.0);
+    date->setValue(1.0);
+    Real notification = t.elapsed();
+
+    for (Size i=0; i<observers; ++i) {
+        if (counters[i]->counter() != 3)
+            BOOST_FAIL("observer " << i << " received "
+                       << counters[i]->counter()
+                       << " notifications (expected 3)");
+    }
+
+    t.restart();
+    counters.clear();
+    Real destruction = t.elapsed();
+
+    BOOST_TEST_MESSAGE("    " << observers << " observers registered in "
+                       << registration << " s, notified in "
+                       << notification << " s, destroyed in "
+                       << destruction << " s");
+}
+
 test_suite* ObservableTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Observer tests");
 
@@ -316,8 +854,11 @@ test_suite* ObservableTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
         &ObservableTest::testMultiThreadingGlobalSettings));
 #endif
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testContention));
 
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testDeepUpdate));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testNotificationBatch));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testCompactSets));
 
     return suite;
 }
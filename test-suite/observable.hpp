@@ -30,7 +30,10 @@ class ObservableTest {
     static void testObservableSettings();
     static void testAsyncGarbagCollector();
     static void testMultiThreadingGlobalSettings();
+    static void testContention();
     static void testDeepUpdate();
+    static void testNotificationBatch();
+    static void testCompactSets();
 
     static boost::unit_test_framework::test_suite* suite();
 };
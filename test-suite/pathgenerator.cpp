@@ -20,8 +20,11 @@
 #include "pathgenerator.hpp"
 #include "utilities.hpp"
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/multilevelpathgenerator.hpp>
+#include <ql/processes/batesprocess.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
@@ -138,6 +141,150 @@ namespace {
         }
     }
 
+
+    // overrides the exact evolution of the base class
+    class DampedBlackScholesProcess : public BlackScholesMertonProcess {
+      public:
+        DampedBlackScholesProcess(
+                       const Handle<Quote>& x0,
+                       const Handle<YieldTermStructure>& dividendTS,
+                       const Handle<YieldTermStructure>& riskFreeTS,
+                       const Handle<BlackVolTermStructure>& blackVolTS)
+        : BlackScholesMertonProcess(x0, dividendTS, riskFreeTS, blackVolTS) {}
+        Real evolve(Time t0, Real x0, Time dt, Real dw) const {
+            return BlackScholesMertonProcess::evolve(t0, x0, dt, 0.5*dw);
+        }
+        using BlackScholesMertonProcess::evolve;
+    };
+
+
+    void testSingleBatch(
+                    const boost::shared_ptr<StochasticProcess1D>& process,
+                    const std::string& tag, bool brownianBridge) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef PathGenerator<rsg_type>::batch_type batch_type;
+
+        BigNatural seed = 42;
+        Time length = 10;
+        Size timeSteps = 12;
+        Size paths = 37;
+        rsg_type rsg = PseudoRandom::make_sequence_generator(timeSteps, seed);
+        PathGenerator<rsg_type> generator(process, length, timeSteps,
+                                          rsg, brownianBridge);
+        PathGenerator<rsg_type> batchGenerator(process, length, timeSteps,
+                                               rsg, brownianBridge);
+
+        // twice, to check that the batch buffers are reused correctly
+        for (Size k=0; k<2; k++) {
+            std::vector<Path> expected, expectedAntithetic;
+            for (Size j=0; j<paths; j++) {
+                expected.push_back(generator.next().value);
+                expectedAntithetic.push_back(generator.antithetic().value);
+            }
+
+            const batch_type& batch = batchGenerator.nextBatch(paths);
+            for (Size j=0; j<paths; j++) {
+                for (Size i=0; i<expected[j].length(); i++) {
+                    if (batch(i,j) != expected[j][i])
+                        BOOST_FAIL("using " << tag << " process "
+                                   << (brownianBridge ? "with " : "without ")
+                                   << "brownian bridge:\n"
+                                   << std::setprecision(16)
+                                   << "    path:       " << j << "\n"
+                                   << "    point:      " << i << "\n"
+                                   << "    batch:      " << batch(i,j) << "\n"
+                                   << "    single:     " << expected[j][i]);
+                }
+            }
+
+            const batch_type& antithetic = batchGenerator.antitheticBatch();
+            for (Size j=0; j<paths; j++) {
+                for (Size i=0; i<expected[j].length(); i++) {
+                    if (antithetic(i,j) != expectedAntithetic[j][i])
+                        BOOST_FAIL("using " << tag << " process "
+                                   << (brownianBridge ? "with " : "without ")
+                                   << "brownian bridge:\n"
+                                   << "antithetic sample:\n"
+                                   << std::setprecision(16)
+                                   << "    path:       " << j << "\n"
+                                   << "    point:      " << i << "\n"
+                                   << "    batch:      "
+                                   << antithetic(i,j) << "\n"
+                                   << "    single:     "
+                                   << expectedAntithetic[j][i]);
+                }
+            }
+        }
+    }
+
+    void testMultipleBatch(const boost::shared_ptr<StochasticProcess>& process,
+                           const std::string& tag) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef MultiPathGenerator<rsg_type>::batch_type batch_type;
+
+        BigNatural seed = 42;
+        Time length = 10;
+        Size timeSteps = 12;
+        Size paths = 37;
+        Size assets = process->size();
+        rsg_type rsg = PseudoRandom::make_sequence_generator(
+                                       timeSteps*process->factors(), seed);
+        MultiPathGenerator<rsg_type> generator(process,
+                                               TimeGrid(length, timeSteps),
+                                               rsg, false);
+        MultiPathGenerator<rsg_type> batchGenerator(
+                                               process,
+                                               TimeGrid(length, timeSteps),
+                                               rsg, false);
+
+        for (Size k=0; k<2; k++) {
+            std::vector<MultiPath> expected, expectedAntithetic;
+            for (Size j=0; j<paths; j++) {
+                expected.push_back(generator.next().value);
+                expectedAntithetic.push_back(generator.antithetic().value);
+            }
+
+            const batch_type& batch = batchGenerator.nextBatch(paths);
+            for (Size j=0; j<paths; j++) {
+                for (Size a=0; a<assets; a++) {
+                    for (Size i=0; i<batch.pathSize(); i++) {
+                        if (batch(a,i,j) != expected[j][a][i])
+                            BOOST_FAIL("using " << tag << " process "
+                                       << "(" << io::ordinal(a+1)
+                                       << " asset:)\n"
+                                       << std::setprecision(16)
+                                       << "    path:       " << j << "\n"
+                                       << "    point:      " << i << "\n"
+                                       << "    batch:      "
+                                       << batch(a,i,j) << "\n"
+                                       << "    single:     "
+                                       << expected[j][a][i]);
+                    }
+                }
+            }
+
+            const batch_type& antithetic = batchGenerator.antitheticBatch();
+            for (Size j=0; j<paths; j++) {
+                for (Size a=0; a<assets; a++) {
+                    for (Size i=0; i<antithetic.pathSize(); i++) {
+                        if (antithetic(a,i,j) != expectedAntithetic[j][a][i])
+                            BOOST_FAIL("using " << tag << " process "
+                                       << "(" << io::ordinal(a+1)
+                                       << " asset:)\n"
+                                       << "antithetic sample:\n"
+                                       << std::setprecision(16)
+                                       << "    path:       " << j << "\n"
+                                       << "    point:      " << i << "\n"
+                                       << "    batch:      "
+                                       << antithetic(a,i,j) << "\n"
+                                       << "    single:     "
+                                       << expectedAntithetic[j][a][i]);
+                    }
+                }
+            }
+        }
+    }
+
 }
 
 
@@ -290,11 +437,198 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+void PathGeneratorTest::testPathBatch() {
+
+    BOOST_TEST_MESSAGE("Testing 1-D batch path generation...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    boost::shared_ptr<StochasticProcess1D> process(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    testSingleBatch(process, "Black-Scholes", false);
+    testSingleBatch(process, "Black-Scholes", true);
+
+    testSingleBatch(boost::shared_ptr<StochasticProcess1D>(
+                          new DampedBlackScholesProcess(x0,q,r,sigma)),
+                    "derived Black-Scholes", false);
+
+    testSingleBatch(boost::shared_ptr<StochasticProcess1D>(
+                       new GeometricBrownianMotionProcess(100.0, 0.03, 0.20)),
+                    "geometric Brownian", false);
+
+    testSingleBatch(boost::shared_ptr<StochasticProcess1D>(
+                                     new OrnsteinUhlenbeckProcess(0.1, 0.20)),
+                    "Ornstein-Uhlenbeck", false);
+}
+
+
+void PathGeneratorTest::testMultiPathBatch() {
+
+    BOOST_TEST_MESSAGE("Testing n-D batch path generation...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    Matrix correlation(3,3);
+    correlation[0][0] = 1.0; correlation[0][1] = 0.9; correlation[0][2] = 0.7;
+    correlation[1][0] = 0.9; correlation[1][1] = 1.0; correlation[1][2] = 0.4;
+    correlation[2][0] = 0.7; correlation[2][1] = 0.4; correlation[2][2] = 1.0;
+
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(3);
+    processes[0] = boost::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    processes[1] = boost::shared_ptr<StochasticProcess1D>(
+                       new GeometricBrownianMotionProcess(100.0, 0.03, 0.20));
+    processes[2] = boost::shared_ptr<StochasticProcess1D>(
+                                     new OrnsteinUhlenbeckProcess(0.1, 0.20));
+    testMultipleBatch(boost::shared_ptr<StochasticProcess>(
+                          new StochasticProcessArray(processes,correlation)),
+                      "process-array");
+
+    HestonProcess::Discretization schemes[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation,
+        HestonProcess::Reflection,
+        HestonProcess::QuadraticExponential,
+        HestonProcess::QuadraticExponentialMartingale
+    };
+    std::string names[] = {
+        "partial-truncation Heston",
+        "full-truncation Heston",
+        "reflection Heston",
+        "quadratic-exponential Heston",
+        "quadratic-exponential-martingale Heston"
+    };
+    for (Size i=0; i<LENGTH(schemes); i++) {
+        testMultipleBatch(boost::shared_ptr<StochasticProcess>(
+                              new HestonProcess(r, q, x0, 0.04, 1.5, 0.04,
+                                                0.5, -0.7, schemes[i])),
+                          names[i]);
+    }
+
+    // falls back to the path-by-path evolution
+    testMultipleBatch(boost::shared_ptr<StochasticProcess>(
+                          new BatesProcess(r, q, x0, 0.04, 1.5, 0.04,
+                                           0.5, -0.7, 0.5, -0.1, 0.1)),
+                      "Bates");
+}
+
+
+void PathGeneratorTest::testMultiLevelPathGenerator() {
+
+    BOOST_TEST_MESSAGE("Testing coupled fine and coarse path generation...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    Matrix correlation(2,2);
+    correlation[0][0] = 1.0; correlation[0][1] = 0.6;
+    correlation[1][0] = 0.6; correlation[1][1] = 1.0;
+
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(2);
+    processes[0] = boost::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    processes[1] = boost::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,r,q,sigma));
+
+    // the evolution of these processes is exact, so that the coarse
+    // paths must go through the points of the fine ones
+    boost::shared_ptr<StochasticProcess> testedProcesses[] = {
+        processes[0],
+        boost::shared_ptr<StochasticProcess>(
+                          new StochasticProcessArray(processes,correlation))
+    };
+    std::string names[] = { "Black-Scholes", "process-array" };
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    typedef MultiLevelPathGenerator<rsg_type>::sample_type sample_type;
+
+    Time times[] = { 0.25, 0.5, 1.0, 2.0 };
+    TimeGrid coarseGrid(times, times + LENGTH(times), 12);
+    Size refinements[] = { 2, 4 };
+    Real tolerance = 1.0e-10;
+
+    for (Size i=0; i<LENGTH(testedProcesses); ++i) {
+        for (Size k=0; k<LENGTH(refinements); ++k) {
+            Size refinement = refinements[k];
+            Size dimension = testedProcesses[i]->factors() *
+                             (coarseGrid.size()-1) * refinement;
+            MultiLevelPathGenerator<rsg_type> generator(
+                    testedProcesses[i], coarseGrid, refinement,
+                    PseudoRandom::make_sequence_generator(dimension, 42));
+
+            if (generator.fineGrid().size() !=
+                (coarseGrid.size()-1)*refinement+1)
+                BOOST_FAIL("wrong fine grid size for "
+                           << names[i] << " process"
+                           << "\n    refinement: " << refinement
+                           << "\n    calculated: "
+                           << generator.fineGrid().size()
+                           << "\n    expected:   "
+                           << (coarseGrid.size()-1)*refinement+1);
+
+            for (Size j=0; j<10; ++j) {
+                for (Size a=0; a<2; ++a) {
+                    const sample_type& fine =
+                        a == 0 ? generator.next() : generator.antithetic();
+                    const sample_type& coarse = generator.coarse();
+                    for (Size n=0; n<fine.value.assetNumber(); ++n) {
+                        for (Size t=0; t<coarseGrid.size(); ++t) {
+                            Real expected = fine.value[n][t*refinement];
+                            Real calculated = coarse.value[n][t];
+                            if (std::fabs(calculated-expected) >
+                                tolerance*expected)
+                                BOOST_FAIL("coarse path not coupled with "
+                                           "fine path for "
+                                           << names[i] << " process"
+                                           << (a == 1 ? " (antithetic)"
+                                                      : "")
+                                           << "\n    refinement: "
+                                           << refinement
+                                           << "\n    time:       "
+                                           << coarseGrid[t]
+                                           << std::setprecision(13)
+                                           << "\n    fine:       "
+                                           << expected
+                                           << "\n    coarse:     "
+                                           << calculated);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathBatch));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathBatch));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &PathGeneratorTest::testMultiLevelPathGenerator));
     return suite;
 }
 
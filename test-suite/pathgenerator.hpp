@@ -29,6 +29,9 @@ class PathGeneratorTest {
   public:
     static void testPathGenerator();
     static void testMultiPathGenerator();
+    static void testPathBatch();
+    static void testMultiPathBatch();
+    static void testMultiLevelPathGenerator();
     static boost::unit_test_framework::test_suite* suite();
 };
 
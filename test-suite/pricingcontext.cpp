@@ -0,0 +1,196 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "pricingcontext.hpp"
+#include "utilities.hpp"
+#include <ql/patterns/pricingcontext.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/instruments/europeanoption.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <boost/make_shared.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+namespace {
+
+    Date evaluationDate() {
+        return Settings::instance().evaluationDate();
+    }
+
+}
+
+void PricingContextTest::testSwitch() {
+
+    BOOST_TEST_MESSAGE("Testing switches between pricing contexts...");
+
+    SavedSettings backup;
+
+    const std::string name = "PRICING CONTEXT TEST";
+    const Date globalDate(15, March, 2018);
+    const Date firstDate(16, April, 2018), secondDate(17, May, 2018);
+    Settings::instance().evaluationDate() = globalDate;
+
+    boost::shared_ptr<PricingContext> first(new PricingContext);
+    boost::shared_ptr<PricingContext> second(new PricingContext);
+    {
+        PricingContextSwitch inFirst(first);
+        if (PricingContext::current() != first.get())
+            BOOST_FAIL("first context not current");
+        if (evaluationDate() != Date::todaysDate())
+            BOOST_FAIL("evaluation date " << evaluationDate()
+                       << " in new context (expected "
+                       << Date::todaysDate() << ")");
+        Settings::instance().evaluationDate() = firstDate;
+        TimeSeries<Real> fixings;
+        fixings[firstDate] = 0.01;
+        IndexManager::instance().setHistory(name, fixings);
+
+        {
+            PricingContextSwitch inSecond(second);
+            if (evaluationDate() != Date::todaysDate() ||
+                IndexManager::instance().hasHistory(name))
+                BOOST_FAIL("settings of first context "
+                           "visible in second one");
+            Settings::instance().evaluationDate() = secondDate;
+
+            {
+                PricingContextSwitch inGlobal(
+                                       (boost::shared_ptr<PricingContext>()));
+                if (PricingContext::current() != 0)
+                    BOOST_FAIL("global instances not current");
+                if (evaluationDate() != globalDate)
+                    BOOST_FAIL("evaluation date " << evaluationDate()
+                               << " in global instances (expected "
+                               << globalDate << ")");
+            }
+
+            if (evaluationDate() != secondDate)
+                BOOST_FAIL("evaluation date " << evaluationDate()
+                           << " after switching back to second context"
+                           << " (expected " << secondDate << ")");
+        }
+
+        if (PricingContext::current() != first.get() ||
+            evaluationDate() != firstDate ||
+            !IndexManager::instance().hasHistory(name))
+            BOOST_FAIL("settings of first context not restored");
+    }
+
+    if (PricingContext::current() != 0 ||
+        evaluationDate() != globalDate ||
+        IndexManager::instance().hasHistory(name))
+        BOOST_FAIL("global settings not restored");
+
+    // the context keeps its settings between switches
+    PricingContextSwitch inFirst(first);
+    if (evaluationDate() != firstDate)
+        BOOST_FAIL("evaluation date " << evaluationDate()
+                   << " in first context (expected " << firstDate << ")");
+}
+
+
+namespace {
+
+    Real scenarioValue(const boost::shared_ptr<PricingContext>& context,
+                       const Date& evaluationDate, const Date& expiry) {
+        PricingContextSwitch inScenario(context);
+        Settings::instance().evaluationDate() = evaluationDate;
+
+        DayCounter dc = Actual365Fixed();
+        Handle<Quote> spot(boost::make_shared<SimpleQuote>(100.0));
+        Handle<YieldTermStructure> riskFreeRate(
+               boost::make_shared<FlatForward>(0, NullCalendar(), 0.03, dc));
+        Handle<YieldTermStructure> dividendYield(
+               boost::make_shared<FlatForward>(0, NullCalendar(), 0.01, dc));
+        Handle<BlackVolTermStructure> volatility(
+            boost::make_shared<BlackConstantVol>(0, NullCalendar(), 0.2, dc));
+        boost::shared_ptr<BlackScholesMertonProcess> process =
+            boost::make_shared<BlackScholesMertonProcess>(
+                             spot, dividendYield, riskFreeRate, volatility);
+
+        EuropeanOption option(
+                 boost::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+                 boost::make_shared<EuropeanExercise>(expiry));
+        option.setPricingEngine(
+                     boost::make_shared<AnalyticEuropeanEngine>(process));
+        return option.NPV();
+    }
+
+}
+
+void PricingContextTest::testParallelScenarios() {
+
+    BOOST_TEST_MESSAGE("Testing scenarios priced in parallel "
+                       "pricing contexts...");
+
+    SavedSettings backup;
+
+    const Date today(15, March, 2018), expiry(15, March, 2019);
+    Settings::instance().evaluationDate() = today;
+
+    const Size n = 8;
+    std::vector<boost::shared_ptr<PricingContext> > contexts(n);
+    std::vector<Real> expected(n), calculated(n);
+    for (Size i=0; i<n; ++i) {
+        contexts[i] = boost::make_shared<PricingContext>();
+        expected[i] = scenarioValue(contexts[i], today + Integer(30*i),
+                                    expiry);
+    }
+
+    // each thread prices its scenarios in their own contexts, under
+    // their own evaluation date (the loop runs serially when
+    // OpenMP is not enabled)
+    std::vector<std::string> errors(n);
+    #pragma omp parallel for
+    for (long i=0; i<(long)n; ++i) {
+        try {
+            calculated[i] = scenarioValue(contexts[i],
+                                          today + Integer(30*i), expiry);
+        } catch (std::exception& e) {
+            errors[i] = e.what();
+        }
+    }
+
+    for (Size i=0; i<n; ++i) {
+        if (!errors[i].empty())
+            BOOST_FAIL("scenario " << i << " failed: " << errors[i]);
+        if (calculated[i] != expected[i])
+            BOOST_ERROR("scenario " << i << ":"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    expected:   " << expected[i]);
+        if (i > 0 && !(expected[i] < expected[i-1]))
+            BOOST_ERROR("scenario " << i << " not priced at its own "
+                        "evaluation date");
+    }
+
+    if (evaluationDate() != today)
+        BOOST_ERROR("global evaluation date modified");
+}
+
+
+test_suite* PricingContextTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Pricing context tests");
+    suite->add(QUANTLIB_TEST_CASE(&PricingContextTest::testSwitch));
+    suite->add(QUANTLIB_TEST_CASE(&PricingContextTest::testParallelScenarios));
+    return suite;
+}
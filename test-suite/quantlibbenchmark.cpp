@@ -124,6 +124,7 @@
 #include "dividendoption.hpp"
 #include "europeanoption.hpp"
 #include "fdheston.hpp"
+#include "fdmlinearop.hpp"
 #include "hestonmodel.hpp"
 #include "interpolations.hpp"
 #include "jumpdiffusion.hpp"
@@ -270,6 +271,8 @@ test_suite* init_unit_test_suite(int, char*[]) {
         &EuropeanOptionTest::testPriceCurve, 414.76));
     bm.push_back(Benchmark("FdHestonTest::testFdmHestonAmerican",
         &FdHestonTest::testFdmHestonAmerican, 234.21));
+    bm.push_back(Benchmark("FdmLinearOpTest::testCsrMatrix",
+        &FdmLinearOpTest::testCsrMatrix, 148.60));
     bm.push_back(Benchmark("HestonModel::DAXCalibration",
         &HestonModelTest::testDAXCalibration, 555.19));
     bm.push_back(Benchmark("InterpolationTest::testSabrInterpolation",
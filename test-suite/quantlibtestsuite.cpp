@@ -162,6 +162,7 @@
 #include "period.hpp"
 #include "piecewiseyieldcurve.hpp"
 #include "piecewisezerospreadedtermstructure.hpp"
+#include "pricingcontext.hpp"
 #include "quantooption.hpp"
 #include "quotes.hpp"
 #include "rangeaccrual.hpp"
@@ -434,6 +435,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(PeriodTest::suite());
     test->add(PiecewiseYieldCurveTest::suite());
     test->add(PiecewiseZeroSpreadedTermStructureTest::suite());
+    test->add(PricingContextTest::suite());
     test->add(QuantoOptionTest::suite());
     test->add(QuoteTest::suite());
     test->add(RangeAccrualTest::suite());
@@ -22,6 +22,7 @@
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 
 #define CHECK_DOWNCAST(Derived,Description) { \
@@ -115,6 +116,20 @@ namespace QuantLib {
     }
 
 
+    boost::shared_ptr<BlackScholesMertonProcess>
+    flatBlackScholesProcess(const Date& today, Real spot,
+                            Rate dividendYield, Rate riskFreeRate,
+                            Volatility volatility, const DayCounter& dc) {
+        return boost::shared_ptr<BlackScholesMertonProcess>(new
+            BlackScholesMertonProcess(
+                Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(spot))),
+                Handle<YieldTermStructure>(flatRate(today, dividendYield, dc)),
+                Handle<YieldTermStructure>(flatRate(today, riskFreeRate, dc)),
+                Handle<BlackVolTermStructure>(
+                                        flatVol(today, volatility, dc))));
+    }
+
+
     Real relativeError(Real x1, Real x2, Real reference) {
         if (reference != 0.0)
             return std::fabs(x1-x2)/reference;
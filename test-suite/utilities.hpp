@@ -122,6 +122,51 @@ namespace QuantLib {
             const DayCounter& dc);
 
 
+    class BlackScholesMertonProcess;
+
+    boost::shared_ptr<BlackScholesMertonProcess>
+    flatBlackScholesProcess(const Date& today,
+                            Real spot,
+                            Rate dividendYield,
+                            Rate riskFreeRate,
+                            Volatility volatility,
+                            const DayCounter& dc);
+
+
+    /* means of the samples priced by two Monte Carlo models built
+       from copies of the given generator, the first path by path and
+       the second in batches of 64 paths; the second of two calls to
+       addSamples() leaves the last batch partially filled.  Pricers
+       keeping an internal state must not be shared by the models. */
+    template <class Model>
+    std::pair<Real, Real> singleAndBatchMeans(
+           const typename Model::path_generator_type& generator,
+           const boost::shared_ptr<typename Model::path_pricer_type>& pricer,
+           const boost::shared_ptr<typename Model::path_pricer_type>&
+                                                                batchPricer,
+           bool antitheticVariate) {
+        typedef typename Model::path_generator_type generator_type;
+        typedef typename Model::path_pricer_type pricer_type;
+        Real means[2];
+        for (Size k=0; k<2; ++k) {
+            Model model(boost::shared_ptr<generator_type>(
+                                               new generator_type(generator)),
+                        k == 0 ? pricer : batchPricer,
+                        typename Model::stats_type(), antitheticVariate,
+                        boost::shared_ptr<pricer_type>(),
+                        typename Model::result_type(),
+                        boost::shared_ptr<generator_type>(),
+                        k == 0 ? 0 : 64);
+            if (model.usesBatches() != (k == 1))
+                BOOST_FAIL("unexpected pricing mode");
+            model.addSamples(1000);
+            model.addSamples(37);
+            means[k] = model.sampleAccumulator().mean();
+        }
+        return std::make_pair(means[0], means[1]);
+    }
+
+
     Real relativeError(Real x1, Real x2, Real reference);
 
     //bool checkAbsError(Real x1, Real x2, Real tolerance){